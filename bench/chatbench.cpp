@@ -0,0 +1,348 @@
+// End-to-end load benchmark. Starts N senders and M readers against a chat
+// server and reports delivered messages per second and the send-to-delivery
+// latency percentiles.
+//
+// Each message carries the time it was due to be sent, and readers take the
+// latency on arrival. Senders and readers run in this process, so they share
+// the clock even when the server is remote. Messages from anyone else are
+// ignored.
+//
+// --rate is messages per second per sender. At 0 the senders run closed
+// loop: each Send waits for the previous one to return. A positive rate is
+// open loop: sends go out on schedule whether or not earlier ones have
+// completed, and latency is measured from the schedule, so a server that
+// falls behind cannot hide its queueing delay.
+//
+// With --stream=1 each sender writes its messages down one SendStream call
+// instead of making a Send call per message.
+//
+// Without --address a server is started in process on port 9090.
+//
+// Usage: chatbench [--senders=N] [--readers=M] [--rate=MSGS_PER_SEC]
+//                  [--seconds=S] [--payload=BYTES] [--stream=0|1]
+//                  [--address=HOST:PORT]
+
+#include "server/server.h"
+
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+static const char kBenchName[] = "bench";
+
+struct Options {
+  size_t senders = 4;
+  size_t readers = 16;
+  double rate = 0;
+  double seconds = 5;
+  size_t payload = 64;
+  bool stream = false;
+  string address;
+};
+
+static bool ParseOptions(int argc, char **argv, Options *options) {
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *value = strchr(arg, '=');
+    if (strncmp(arg, "--", 2) != 0 || value == nullptr) {
+      return false;
+    }
+    string name(arg + 2, value++);
+    if (name == "senders") {
+      options->senders = strtoul(value, nullptr, 10);
+    } else if (name == "readers") {
+      options->readers = strtoul(value, nullptr, 10);
+    } else if (name == "rate") {
+      options->rate = strtod(value, nullptr);
+    } else if (name == "seconds") {
+      options->seconds = strtod(value, nullptr);
+    } else if (name == "payload") {
+      options->payload = strtoul(value, nullptr, 10);
+    } else if (name == "stream") {
+      options->stream = strtoul(value, nullptr, 10) != 0;
+    } else if (name == "address") {
+      options->address = value;
+    } else {
+      return false;
+    }
+  }
+  return options->senders > 0 && options->seconds > 0;
+}
+
+static int64_t NowNs() {
+  return chrono::duration_cast<chrono::nanoseconds>(
+             chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Every virtual client gets its own connection, as separate processes would.
+static shared_ptr<Channel> NewChannel(const string &address) {
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  return CreateCustomChannel(address, InsecureChannelCredentials(), args);
+}
+
+class BenchReader : public grpc::ClientReadReactor<ChatMessage> {
+public:
+  explicit BenchReader(const string &address)
+      : stub_(ChatService::NewStub(NewChannel(address))) {
+    // The last message is enough to know the stream is live.
+    request_.set_name("bench-reader");
+    request_.set_tail_n(1);
+    stub_->async()->ReadChat(&context_, &request_, this);
+    StartRead(&message_);
+    StartCall();
+  }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) {
+      return;
+    }
+    if (message_.name() == kBenchName) {
+      int64_t due = strtoll(message_.message().c_str(), nullptr, 10);
+      latencies_.push_back(NowNs() - due);
+      received_.fetch_add(1, memory_order_relaxed);
+    }
+    ready_ = true;
+    StartRead(&message_);
+  }
+
+  void OnDone(const Status &) override {
+    lock_guard<mutex> lock(mu_);
+    done_ = true;
+    cv_.notify_one();
+  }
+
+  // Ends the stream. latencies() is stable once this returns.
+  void Stop() {
+    context_.TryCancel();
+    unique_lock<mutex> lock(mu_);
+    cv_.wait(lock, [this] { return done_; });
+  }
+
+  bool ready() const { return ready_; }
+  size_t received() const { return received_.load(memory_order_relaxed); }
+  const vector<int64_t> &latencies() const { return latencies_; }
+
+private:
+  unique_ptr<ChatService::Stub> stub_;
+  ClientContext context_;
+  ChatReader request_;
+  ChatMessage message_;
+  vector<int64_t> latencies_;
+  atomic<size_t> received_{0};
+  atomic<bool> ready_{false};
+  mutex mu_;
+  condition_variable cv_;
+  bool done_ = false;
+};
+
+struct SendCounts {
+  atomic<size_t> ok{0};
+  atomic<size_t> failed{0};
+  atomic<size_t> in_flight{0};
+};
+
+static ChatMessage BenchMessage(int64_t due, size_t payload) {
+  ChatMessage m;
+  m.set_name(kBenchName);
+  string text = to_string(due) + " ";
+  text.resize(max(text.size(), payload), 'x');
+  m.set_message(text);
+  return m;
+}
+
+static void ClosedLoopSender(const string &address, const Options &options,
+                             int64_t deadline, SendCounts *counts) {
+  auto stub = ChatService::NewStub(NewChannel(address));
+  while (NowNs() < deadline) {
+    ClientContext context;
+    Response response;
+    Status status =
+        stub->Send(&context, BenchMessage(NowNs(), options.payload), &response);
+    (status.ok() ? counts->ok : counts->failed)++;
+  }
+}
+
+static void OpenLoopSender(const string &address, const Options &options,
+                           int64_t deadline, SendCounts *counts) {
+  struct Call {
+    ClientContext context;
+    ChatMessage request;
+    Response response;
+  };
+  auto stub = ChatService::NewStub(NewChannel(address));
+  const int64_t interval = static_cast<int64_t>(1e9 / options.rate);
+  for (int64_t due = NowNs(); due < deadline; due += interval) {
+    this_thread::sleep_for(chrono::nanoseconds(due - NowNs()));
+    auto *call = new Call;
+    call->request = BenchMessage(due, options.payload);
+    counts->in_flight++;
+    stub->async()->Send(&call->context, &call->request, &call->response,
+                        [call, counts](Status status) {
+                          (status.ok() ? counts->ok : counts->failed)++;
+                          counts->in_flight--;
+                          delete call;
+                        });
+  }
+  while (counts->in_flight > 0) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+}
+
+// Writes on schedule at a positive rate, back to back otherwise. Writes only
+// wait for flow control; the messages count once the stream has finished.
+static void StreamSender(const string &address, const Options &options,
+                         int64_t deadline, SendCounts *counts) {
+  auto stub = ChatService::NewStub(NewChannel(address));
+  ClientContext context;
+  Response response;
+  auto writer = stub->SendStream(&context, &response);
+  const int64_t interval =
+      options.rate > 0 ? static_cast<int64_t>(1e9 / options.rate) : 0;
+  size_t written = 0;
+  for (int64_t due = NowNs(); due < deadline;
+       due = interval ? due + interval : NowNs()) {
+    if (interval) {
+      this_thread::sleep_for(chrono::nanoseconds(due - NowNs()));
+    }
+    if (!writer->Write(BenchMessage(due, options.payload))) {
+      break;
+    }
+    written++;
+  }
+  writer->WritesDone();
+  (writer->Finish().ok() ? counts->ok : counts->failed) += written;
+}
+
+static bool WaitFor(const function<bool()> &done, chrono::seconds timeout) {
+  auto deadline = chrono::steady_clock::now() + timeout;
+  while (!done()) {
+    if (chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+  return true;
+}
+
+static void Report(const Options &options, const SendCounts &counts,
+                   double send_seconds, double deliver_seconds,
+                   const vector<unique_ptr<BenchReader>> &readers) {
+  vector<int64_t> latencies;
+  size_t delivered = 0;
+  for (const auto &r : readers) {
+    delivered += r->received();
+    latencies.insert(latencies.end(), r->latencies().begin(),
+                     r->latencies().end());
+  }
+  sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) {
+    if (latencies.empty()) {
+      return 0.0;
+    }
+    size_t i = min(latencies.size() - 1, size_t(p * latencies.size()));
+    return latencies[i] / 1e3;
+  };
+
+  printf("%zu %s senders, %zu readers, %s, %zu byte payload, %.1f s\n",
+         options.senders, options.stream ? "streaming" : "unary",
+         options.readers,
+         options.rate > 0
+             ? (to_string(int64_t(options.rate)) + " msgs/s per sender").c_str()
+             : "closed loop",
+         options.payload, options.seconds);
+  printf("sent      %10zu msgs %12.1f msgs/s  (%zu failed)\n", counts.ok.load(),
+         counts.ok / send_seconds, counts.failed.load());
+  printf("delivered %10zu msgs %12.1f msgs/s  (%zu expected)\n", delivered,
+         delivered / deliver_seconds, counts.ok * readers.size());
+  printf("latency us    p50 %.1f  p99 %.1f  p999 %.1f  max %.1f\n",
+         percentile(0.5), percentile(0.99), percentile(0.999),
+         percentile(1.0));
+}
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    fprintf(stderr,
+            "Usage: %s [--senders=N] [--readers=M] [--rate=MSGS_PER_SEC] "
+            "[--seconds=S] [--payload=BYTES] [--stream=0|1] "
+            "[--address=HOST:PORT]\n",
+            argv[0]);
+    return 1;
+  }
+  Logger::Get().SetLevel(LogLevel::kWarning);
+
+  // An in-process server, unless one was given.
+  unique_ptr<ChatServiceImpl> service;
+  unique_ptr<Server> server;
+  thread notify_thread;
+  string address = options.address;
+  if (address.empty()) {
+    address = "localhost:9090";
+    service = make_unique<ChatServiceImpl>();
+    ServerBuilder builder;
+    builder.AddListeningPort("0.0.0.0:9090", InsecureServerCredentials());
+    builder.RegisterService(service.get());
+    server = builder.BuildAndStart();
+    notify_thread =
+        thread(&ChatServiceImpl::NotifyReadersThread, service.get());
+  }
+
+  vector<unique_ptr<BenchReader>> readers;
+  for (size_t i = 0; i < options.readers; i++) {
+    readers.push_back(make_unique<BenchReader>(address));
+  }
+  if (!WaitFor(
+          [&readers] {
+            return all_of(readers.begin(), readers.end(),
+                          [](const auto &r) { return r->ready(); });
+          },
+          chrono::seconds(10))) {
+    fprintf(stderr, "Readers did not connect to %s\n", address.c_str());
+    return 1;
+  }
+
+  SendCounts counts;
+  int64_t start = NowNs();
+  int64_t deadline = start + static_cast<int64_t>(options.seconds * 1e9);
+  vector<thread> senders;
+  for (size_t i = 0; i < options.senders; i++) {
+    senders.emplace_back(options.stream     ? StreamSender
+                         : options.rate > 0 ? OpenLoopSender
+                                            : ClosedLoopSender,
+                         address, cref(options), deadline, &counts);
+  }
+  for (thread &t : senders) {
+    t.join();
+  }
+  double send_seconds = (NowNs() - start) / 1e9;
+
+  size_t expected = counts.ok * readers.size();
+  WaitFor(
+      [&readers, expected] {
+        size_t delivered = 0;
+        for (const auto &r : readers) {
+          delivered += r->received();
+        }
+        return delivered >= expected;
+      },
+      chrono::seconds(10));
+  double deliver_seconds = (NowNs() - start) / 1e9;
+
+  for (auto &r : readers) {
+    r->Stop();
+  }
+  Report(options, counts, send_seconds, deliver_seconds, readers);
+
+  if (service) {
+    service->EndServer();
+    notify_thread.join();
+    server->Shutdown();
+  }
+  return 0;
+}
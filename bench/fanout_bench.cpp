@@ -0,0 +1,65 @@
+// Measures the server-side cost of fanning one chat message out to N readers.
+//
+// per-reader: every reader serializes the ChatMessage itself, which is what
+//             a ServerWriteReactor<ChatMessage> does on each StartWrite.
+// shared:     the message is serialized once and each reader takes a
+//             reference to the same ByteBuffer.
+//
+// The shared cost per write is independent of the payload size, the
+// per-reader cost grows with it.
+//
+// Usage: fanout_bench [MESSAGES] [PAYLOAD_BYTES]
+
+#include "server/server.h"
+
+#include <chrono>
+#include <cstdlib>
+
+static double PerReader(const ChatMessage &message, size_t readers,
+                        size_t messages) {
+  auto start = chrono::steady_clock::now();
+  for (size_t i = 0; i < messages; i++) {
+    for (size_t r = 0; r < readers; r++) {
+      ByteBuffer buffer;
+      bool own_buffer;
+      SerializationTraits<ChatMessage>::Serialize(message, &buffer,
+                                                  &own_buffer);
+    }
+  }
+  return chrono::duration<double, nano>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+static double Shared(const ChatMessage &message, size_t readers,
+                     size_t messages) {
+  auto start = chrono::steady_clock::now();
+  for (size_t i = 0; i < messages; i++) {
+    LoggedMessage m = MakeLoggedMessage(message);
+    for (size_t r = 0; r < readers; r++) {
+      ByteBuffer buffer(m.wire);
+    }
+  }
+  return chrono::duration<double, nano>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+int main(int argc, char **argv) {
+  size_t messages = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200;
+  size_t payload = argc > 2 ? strtoul(argv[2], nullptr, 10) : 256;
+
+  ChatMessage message;
+  message.set_name("bench");
+  message.set_message(string(payload, 'x'));
+
+  printf("%zu messages, %zu byte payload\n", messages, payload);
+  printf("%8s %20s %20s %8s\n", "readers", "per-reader ns/write",
+         "shared ns/write", "speedup");
+  for (size_t readers : {1, 10, 100, 1000, 5000}) {
+    double writes = double(readers) * messages;
+    double per_reader = PerReader(message, readers, messages) / writes;
+    double shared = Shared(message, readers, messages) / writes;
+    printf("%8zu %20.1f %20.1f %7.1fx\n", readers, per_reader, shared,
+           per_reader / shared);
+  }
+  return 0;
+}
@@ -15,16 +15,19 @@ void UserInputThread(ChatServiceClient &client) {
 }
 
 int main(int argc, char **argv) {
-  if (argc != 2) {
-    cerr << "Usage: " << argv[0] << " USER_NAME" << endl;
+  if (argc != 2 && argc != 3) {
+    cerr << "Usage: " << argv[0] << " USER_NAME [ROOM]" << endl;
     return 1;
   }
 
   ChatServiceClient chatter(
       argv[1], CreateChannel("localhost:9090", InsecureChannelCredentials()));
+  if (argc == 3) {
+    chatter.SetRoom(argv[2]);
+  }
 
   thread t(UserInputThread, std::ref(chatter));
   t.detach();
-  chatter.ReadChat();
+  chatter.Chat();
   return 0;
 }
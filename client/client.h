@@ -7,13 +7,18 @@
 #include <grpcpp/security/credentials.h>
 
 #include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <map>
 #include <mutex>
 #include <string>
 #include <thread>
 
 #include "proto/chatservice.grpc.pb.h"
 #include "proto/chatservice.pb.h"
+#include "server/hash_ring.h"
 
 using namespace std;
 using namespace grpc;
@@ -43,21 +48,121 @@ public:
 
   void OnDone(const Status &s) override {
     unique_lock<mutex> l(mu_);
-    status_ = s;
+    status_ = ended_ ? Status::OK : s;
     done_ = true;
     cv_.notify_one();
   }
 
+  // The reactor must outlive the RPC, so ending a read cancels the call and
+  // lets OnDone release Await.
   void EndRead() {
+    {
+      unique_lock<mutex> l(mu_);
+      ended_ = true;
+    }
+    context_.TryCancel();
+  }
+
+  Status Await() {
+    unique_lock<mutex> l(mu_);
+    cv_.wait(l, [this] { return done_; });
+    return status_;
+  }
+
+private:
+  ClientContext context_;
+  mutex mu_;
+  condition_variable cv_;
+  Status status_;
+  bool done_ = false;
+  bool ended_ = false;
+  const ChatReader reader_;
+  ChatMessage message_;
+
+  friend class ChatServiceClient;
+};
+
+// Sends and reads on one Chat call. A stream takes one write at a time, so
+// messages sent while a write is in flight queue up behind it. Messages
+// come back, stamped with their seq, once the server has accepted them.
+class ChatStub : public grpc::ClientBidiReactor<ChatMessage, ChatMessage> {
+public:
+  // The first message names the user and the room, and resumes after
+  // since_seq.
+  ChatStub(ChatService::Stub *stub, const string &user_name,
+           const string &room, uint64_t since_seq) {
+    stub->async()->Chat(&context_, this);
+    ChatMessage hello;
+    hello.set_name(user_name);
+    hello.set_room(room);
+    hello.set_seq(since_seq);
+    outbox_.push_back(hello);
+    writing_ = true;
+    StartWrite(&outbox_.front());
+    StartRead(&message_);
+    StartCall();
+  }
+
+  ~ChatStub() override {
+    context_.TryCancel();
+    cout << "System: ChatStub destroyed" << endl;
+  }
+
+  // Returns false once the call has ended.
+  bool Send(const string &message) {
+    lock_guard<mutex> l(mu_);
+    if (done_) {
+      return false;
+    }
+    ChatMessage chat_message;
+    chat_message.set_message(message);
+    outbox_.push_back(chat_message);
+    if (!writing_) {
+      writing_ = true;
+      StartWrite(&outbox_.front());
+    }
+    return true;
+  }
+
+  void OnWriteDone(bool ok) override {
+    lock_guard<mutex> l(mu_);
+    outbox_.pop_front();
+    if (!ok) {
+      // The call is over; OnDone has the reason.
+      outbox_.clear();
+    }
+    writing_ = !outbox_.empty();
+    if (writing_) {
+      StartWrite(&outbox_.front());
+    }
+  }
+
+  void OnReadDone(bool ok) override {
+    if (ok) {
+      std::cout << message_.name() << ": " << message_.message() << std::endl;
+      StartRead(&message_);
+    }
+  }
+
+  void OnDone(const Status &s) override {
     unique_lock<mutex> l(mu_);
-    status_ = Status::OK;
+    status_ = ended_ ? Status::OK : s;
     done_ = true;
     cv_.notify_one();
   }
 
+  // Like ReadChatStub::EndRead.
+  void EndChat() {
+    {
+      unique_lock<mutex> l(mu_);
+      ended_ = true;
+    }
+    context_.TryCancel();
+  }
+
   Status Await() {
     unique_lock<mutex> l(mu_);
-    cv_.wait(l);
+    cv_.wait(l, [this] { return done_; });
     return status_;
   }
 
@@ -67,59 +172,287 @@ private:
   condition_variable cv_;
   Status status_;
   bool done_ = false;
-  const ChatReader reader_;
+  bool ended_ = false;
+  // The front message is the one being written.
+  deque<ChatMessage> outbox_;
+  bool writing_ = false;
   ChatMessage message_;
 
   friend class ChatServiceClient;
 };
 
+// Sends many messages over one SendStream call. Send only waits for flow
+// control, not for a round trip per message.
+class SendStreamWriter {
+public:
+  SendStreamWriter(ChatService::Stub *stub, const string &user_name,
+                   const string &room)
+      : user_name_(user_name), room_(room),
+        writer_(stub->SendStream(&context_, &response_)) {}
+
+  // Returns false once the stream is broken; Close has the reason.
+  bool Send(const string &message) {
+    ChatMessage chat_message;
+    chat_message.set_message(message);
+    chat_message.set_name(user_name_);
+    chat_message.set_room(room_);
+    return writer_->Write(chat_message);
+  }
+
+  // Ends the stream and waits until the server has accepted every message.
+  Status Close() {
+    writer_->WritesDone();
+    return writer_->Finish();
+  }
+
+private:
+  ClientContext context_;
+  Response response_;
+  const string user_name_;
+  const string room_;
+  unique_ptr<ClientWriter<ChatMessage>> writer_;
+};
+
 class ChatServiceClient {
 public:
-  ChatServiceClient(string user_name, std::shared_ptr<Channel> channel)
-      : stub_(ChatService::NewStub(channel)), user_name_(user_name) {}
+  static constexpr size_t kDefaultMaxInFlight = 64;
+  // How many times Send, ReadChat and Chat follow a server naming another
+  // node as the room's owner before giving up.
+  static constexpr int kMaxRedirects = 2;
+
+  // At most max_in_flight SendAsync calls are outstanding at a time.
+  ChatServiceClient(string user_name, std::shared_ptr<Channel> channel,
+                    size_t max_in_flight = kDefaultMaxInFlight)
+      : user_name_(user_name), max_in_flight_(max(max_in_flight, size_t(1))) {
+    stubs_[""] = ChatService::NewStub(channel);
+    stub_ = stubs_[""].get();
+  }
+
+  // For a sharded deployment: each room is sent to and read from the node
+  // ring gives it, reached without credentials. ring must not be empty.
+  ChatServiceClient(string user_name, HashRing ring,
+                    size_t max_in_flight = kDefaultMaxInFlight)
+      : ring_(std::move(ring)), user_name_(user_name),
+        max_in_flight_(max(max_in_flight, size_t(1))) {
+    stub_ = StubFor(ring_.Owner(room_));
+  }
 
   ~ChatServiceClient() {
     EndChat();
+    Flush();
     cout << "System: ChatServiceClient destroyed" << endl;
   }
 
+  // Goes down the Chat stream while one is open.
   void Send(string message) {
+    {
+      lock_guard<mutex> lock(reader_mu_);
+      if (session_ && session_->Send(message)) {
+        return;
+      }
+    }
     ChatMessage chat_message;
     chat_message.set_message(message);
     chat_message.set_name(user_name_);
-    ClientContext context;
-    Response res;
-    Status status = stub_->Send(&context, chat_message, &res);
+    chat_message.set_room(room_);
+    Status status;
+    for (int redirects = 0;; redirects++) {
+      ClientContext context;
+      Response res;
+      status = Stub()->Send(&context, chat_message, &res);
+      if (redirects == kMaxRedirects || !FollowOwner(status, context)) {
+        break;
+      }
+    }
     cout << "System: Message sent: "
          << (status.ok() ? "OK" : status.error_message()) << endl;
   }
 
+  // Sends without waiting for the reply, so one thread can keep a window of
+  // sends in flight. Blocks only while the window is full. done gets the
+  // message's status on a gRPC thread; messages sent concurrently may reach
+  // the log in any order. A message refused by a node that does not own the
+  // room is not sent on.
+  void SendAsync(const string &message,
+                 function<void(const Status &)> done) {
+    struct Call {
+      ClientContext context;
+      ChatMessage request;
+      Response response;
+    };
+    auto *call = new Call;
+    call->request.set_message(message);
+    call->request.set_name(user_name_);
+    call->request.set_room(room_);
+    {
+      unique_lock<mutex> lock(send_mu_);
+      send_cv_.wait(lock, [this] { return in_flight_ < max_in_flight_; });
+      in_flight_++;
+    }
+    Stub()->async()->Send(
+        &call->context, &call->request, &call->response,
+        [this, call, done = std::move(done)](Status status) {
+          if (done) {
+            done(status);
+          }
+          delete call;
+          lock_guard<mutex> lock(send_mu_);
+          in_flight_--;
+          send_cv_.notify_all();
+        });
+  }
+
+  future<Status> SendAsync(const string &message) {
+    auto result = make_shared<promise<Status>>();
+    future<Status> status = result->get_future();
+    SendAsync(message, [result](const Status &s) { result->set_value(s); });
+    return status;
+  }
+
+  // Waits until every SendAsync has completed.
+  void Flush() {
+    unique_lock<mutex> lock(send_mu_);
+    send_cv_.wait(lock, [this] { return in_flight_ == 0; });
+  }
+
+  unique_ptr<SendStreamWriter> OpenSendStream() {
+    return make_unique<SendStreamWriter>(Stub(), user_name_, room_);
+  }
+
   void ReadChat() {
-    ChatReader reader;
-    reader.set_name(user_name_);
-    if (!reader_) {
-      reader_ = make_unique<ReadChatStub>(stub_.get(), reader);
+    for (int redirects = 0;; redirects++) {
+      ChatReader reader;
+      reader.set_name(user_name_);
+      reader.set_room(room_);
+      ReadChatStub *stub;
+      // A second ReadChat resumes where the previous one stopped.
+      reader.set_since_seq(last_message_.seq());
+      {
+        lock_guard<mutex> lock(reader_mu_);
+        if (!reader_) {
+          reader_ = make_unique<ReadChatStub>(Stub(), reader);
+        }
+        stub = reader_.get();
+      }
+      Status status = stub->Await();
+      bool redirected =
+          redirects < kMaxRedirects && FollowOwner(status, stub->context_);
+      if (!redirected) {
+        cout << "System: Chat ended status: "
+             << (status.ok() ? "OK" : status.error_message()) << endl;
+      }
+
+      lock_guard<mutex> lock(reader_mu_);
+      last_message_.CopyFrom(reader_->message_);
+      reader_.reset();
+      if (!redirected) {
+        return;
+      }
     }
-    Status status = reader_->Await();
-    cout << "System: Chat ended status: "
-         << (status.ok() ? "OK" : status.error_message()) << endl;
+  }
 
-    last_message_.CopyFrom(reader_->message_);
-    reader_.reset();
+  // Sends and reads over one stream until EndChat. Like ReadChat, a second
+  // call resumes where the previous one stopped.
+  void Chat() {
+    for (int redirects = 0;; redirects++) {
+      ChatStub *stub;
+      {
+        lock_guard<mutex> lock(reader_mu_);
+        if (!session_) {
+          session_ = make_unique<ChatStub>(Stub(), user_name_, room_,
+                                           last_message_.seq());
+        }
+        stub = session_.get();
+      }
+      Status status = stub->Await();
+      bool redirected =
+          redirects < kMaxRedirects && FollowOwner(status, stub->context_);
+      if (!redirected) {
+        cout << "System: Chat ended status: "
+             << (status.ok() ? "OK" : status.error_message()) << endl;
+      }
+
+      lock_guard<mutex> lock(reader_mu_);
+      last_message_.CopyFrom(session_->message_);
+      session_.reset();
+      if (!redirected) {
+        return;
+      }
+    }
   }
 
   void EndChat() {
+    lock_guard<mutex> lock(reader_mu_);
     if (reader_) {
       reader_->EndRead();
     }
+    if (session_) {
+      session_->EndChat();
+    }
+  }
+
+  // Where the client sends and reads from now on. Sequence numbers count
+  // within a room, so this forgets where reading stopped.
+  void SetRoom(const string &room) {
+    room_ = room;
+    last_message_.Clear();
+    if (!ring_.empty()) {
+      lock_guard<mutex> lock(stubs_mu_);
+      stub_ = StubFor(ring_.Owner(room_));
+    }
   }
 
   // for testing purposes
   ChatMessage GetLastMessage() { return last_message_; }
 
 private:
-  unique_ptr<ChatService::Stub> stub_;
+  ChatService::Stub *Stub() {
+    lock_guard<mutex> lock(stubs_mu_);
+    return stub_;
+  }
+
+  // Called with stubs_mu_ held, or from a constructor.
+  ChatService::Stub *StubFor(const string &address) {
+    unique_ptr<ChatService::Stub> &stub = stubs_[address];
+    if (!stub) {
+      stub = ChatService::NewStub(
+          CreateChannel(address, InsecureChannelCredentials()));
+    }
+    return stub.get();
+  }
+
+  // Whether the call was refused by a node that named the room's owner, in
+  // which case the client goes to that node from now on.
+  bool FollowOwner(const Status &status, const ClientContext &context) {
+    if (status.error_code() != StatusCode::FAILED_PRECONDITION) {
+      return false;
+    }
+    const auto &trailers = context.GetServerTrailingMetadata();
+    auto it = trailers.find(kOwnerMetadata);
+    if (it == trailers.end()) {
+      return false;
+    }
+    string owner(it->second.data(), it->second.size());
+    cout << "System: Room " << room_ << " is served by " << owner << endl;
+    lock_guard<mutex> lock(stubs_mu_);
+    stub_ = StubFor(owner);
+    return true;
+  }
+
+  // Every node the client has talked to, by address; the one for a plain
+  // channel has no address.
+  mutex stubs_mu_;
+  map<string, unique_ptr<ChatService::Stub>> stubs_;
+  ChatService::Stub *stub_;
+  HashRing ring_;
   string user_name_;
+  string room_;
+  mutex reader_mu_;
   unique_ptr<ReadChatStub> reader_;
+  unique_ptr<ChatStub> session_;
   ChatMessage last_message_;
+  const size_t max_in_flight_;
+  mutex send_mu_;
+  condition_variable send_cv_;
+  size_t in_flight_ = 0;
 };
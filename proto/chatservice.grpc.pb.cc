@@ -23,7 +23,13 @@ namespace chat {
 
 static const char* ChatService_method_names[] = {
   "/chat.ChatService/Send",
+  "/chat.ChatService/SendStream",
   "/chat.ChatService/ReadChat",
+  "/chat.ChatService/ReadChatBatched",
+  "/chat.ChatService/Chat",
+  "/chat.ChatService/Replicate",
+  "/chat.ChatService/HandOff",
+  "/chat.ChatService/Relay",
 };
 
 std::unique_ptr< ChatService::Stub> ChatService::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
@@ -34,7 +40,13 @@ std::unique_ptr< ChatService::Stub> ChatService::NewStub(const std::shared_ptr<
 
 ChatService::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options)
   : channel_(channel), rpcmethod_Send_(ChatService_method_names[0], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
-  , rpcmethod_ReadChat_(ChatService_method_names[1], options.suffix_for_stats(),::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
+  , rpcmethod_SendStream_(ChatService_method_names[1], options.suffix_for_stats(),::grpc::internal::RpcMethod::CLIENT_STREAMING, channel)
+  , rpcmethod_ReadChat_(ChatService_method_names[2], options.suffix_for_stats(),::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
+  , rpcmethod_ReadChatBatched_(ChatService_method_names[3], options.suffix_for_stats(),::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
+  , rpcmethod_Chat_(ChatService_method_names[4], options.suffix_for_stats(),::grpc::internal::RpcMethod::BIDI_STREAMING, channel)
+  , rpcmethod_Replicate_(ChatService_method_names[5], options.suffix_for_stats(),::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
+  , rpcmethod_HandOff_(ChatService_method_names[6], options.suffix_for_stats(),::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
+  , rpcmethod_Relay_(ChatService_method_names[7], options.suffix_for_stats(),::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
   {}
 
 ::grpc::Status ChatService::Stub::Send(::grpc::ClientContext* context, const ::chat::ChatMessage& request, ::chat::Response* response) {
@@ -60,6 +72,22 @@ void ChatService::Stub::async::Send(::grpc::ClientContext* context, const ::chat
   return result;
 }
 
+::grpc::ClientWriter< ::chat::ChatMessage>* ChatService::Stub::SendStreamRaw(::grpc::ClientContext* context, ::chat::Response* response) {
+  return ::grpc::internal::ClientWriterFactory< ::chat::ChatMessage>::Create(channel_.get(), rpcmethod_SendStream_, context, response);
+}
+
+void ChatService::Stub::async::SendStream(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::ClientWriteReactor< ::chat::ChatMessage>* reactor) {
+  ::grpc::internal::ClientCallbackWriterFactory< ::chat::ChatMessage>::Create(stub_->channel_.get(), stub_->rpcmethod_SendStream_, context, response, reactor);
+}
+
+::grpc::ClientAsyncWriter< ::chat::ChatMessage>* ChatService::Stub::AsyncSendStreamRaw(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc::internal::ClientAsyncWriterFactory< ::chat::ChatMessage>::Create(channel_.get(), cq, rpcmethod_SendStream_, context, response, true, tag);
+}
+
+::grpc::ClientAsyncWriter< ::chat::ChatMessage>* ChatService::Stub::PrepareAsyncSendStreamRaw(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncWriterFactory< ::chat::ChatMessage>::Create(channel_.get(), cq, rpcmethod_SendStream_, context, response, false, nullptr);
+}
+
 ::grpc::ClientReader< ::chat::ChatMessage>* ChatService::Stub::ReadChatRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
   return ::grpc::internal::ClientReaderFactory< ::chat::ChatMessage>::Create(channel_.get(), rpcmethod_ReadChat_, context, request);
 }
@@ -76,6 +104,86 @@ void ChatService::Stub::async::ReadChat(::grpc::ClientContext* context, const ::
   return ::grpc::internal::ClientAsyncReaderFactory< ::chat::ChatMessage>::Create(channel_.get(), cq, rpcmethod_ReadChat_, context, request, false, nullptr);
 }
 
+::grpc::ClientReader< ::chat::ChatMessageBatch>* ChatService::Stub::ReadChatBatchedRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
+  return ::grpc::internal::ClientReaderFactory< ::chat::ChatMessageBatch>::Create(channel_.get(), rpcmethod_ReadChatBatched_, context, request);
+}
+
+void ChatService::Stub::async::ReadChatBatched(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::ChatMessageBatch>* reactor) {
+  ::grpc::internal::ClientCallbackReaderFactory< ::chat::ChatMessageBatch>::Create(stub_->channel_.get(), stub_->rpcmethod_ReadChatBatched_, context, request, reactor);
+}
+
+::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>* ChatService::Stub::AsyncReadChatBatchedRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::chat::ChatMessageBatch>::Create(channel_.get(), cq, rpcmethod_ReadChatBatched_, context, request, true, tag);
+}
+
+::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>* ChatService::Stub::PrepareAsyncReadChatBatchedRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::chat::ChatMessageBatch>::Create(channel_.get(), cq, rpcmethod_ReadChatBatched_, context, request, false, nullptr);
+}
+
+::grpc::ClientReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* ChatService::Stub::ChatRaw(::grpc::ClientContext* context) {
+  return ::grpc::internal::ClientReaderWriterFactory< ::chat::ChatMessage, ::chat::ChatMessage>::Create(channel_.get(), rpcmethod_Chat_, context);
+}
+
+void ChatService::Stub::async::Chat(::grpc::ClientContext* context, ::grpc::ClientBidiReactor< ::chat::ChatMessage,::chat::ChatMessage>* reactor) {
+  ::grpc::internal::ClientCallbackReaderWriterFactory< ::chat::ChatMessage,::chat::ChatMessage>::Create(stub_->channel_.get(), stub_->rpcmethod_Chat_, context, reactor);
+}
+
+::grpc::ClientAsyncReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* ChatService::Stub::AsyncChatRaw(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc::internal::ClientAsyncReaderWriterFactory< ::chat::ChatMessage, ::chat::ChatMessage>::Create(channel_.get(), cq, rpcmethod_Chat_, context, true, tag);
+}
+
+::grpc::ClientAsyncReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* ChatService::Stub::PrepareAsyncChatRaw(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncReaderWriterFactory< ::chat::ChatMessage, ::chat::ChatMessage>::Create(channel_.get(), cq, rpcmethod_Chat_, context, false, nullptr);
+}
+
+::grpc::ClientReader< ::chat::ReplicatedBatch>* ChatService::Stub::ReplicateRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
+  return ::grpc::internal::ClientReaderFactory< ::chat::ReplicatedBatch>::Create(channel_.get(), rpcmethod_Replicate_, context, request);
+}
+
+void ChatService::Stub::async::Replicate(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::ReplicatedBatch>* reactor) {
+  ::grpc::internal::ClientCallbackReaderFactory< ::chat::ReplicatedBatch>::Create(stub_->channel_.get(), stub_->rpcmethod_Replicate_, context, request, reactor);
+}
+
+::grpc::ClientAsyncReader< ::chat::ReplicatedBatch>* ChatService::Stub::AsyncReplicateRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::chat::ReplicatedBatch>::Create(channel_.get(), cq, rpcmethod_Replicate_, context, request, true, tag);
+}
+
+::grpc::ClientAsyncReader< ::chat::ReplicatedBatch>* ChatService::Stub::PrepareAsyncReplicateRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::chat::ReplicatedBatch>::Create(channel_.get(), cq, rpcmethod_Replicate_, context, request, false, nullptr);
+}
+
+::grpc::ClientReader< ::chat::ChatMessageBatch>* ChatService::Stub::HandOffRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
+  return ::grpc::internal::ClientReaderFactory< ::chat::ChatMessageBatch>::Create(channel_.get(), rpcmethod_HandOff_, context, request);
+}
+
+void ChatService::Stub::async::HandOff(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::ChatMessageBatch>* reactor) {
+  ::grpc::internal::ClientCallbackReaderFactory< ::chat::ChatMessageBatch>::Create(stub_->channel_.get(), stub_->rpcmethod_HandOff_, context, request, reactor);
+}
+
+::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>* ChatService::Stub::AsyncHandOffRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::chat::ChatMessageBatch>::Create(channel_.get(), cq, rpcmethod_HandOff_, context, request, true, tag);
+}
+
+::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>* ChatService::Stub::PrepareAsyncHandOffRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::chat::ChatMessageBatch>::Create(channel_.get(), cq, rpcmethod_HandOff_, context, request, false, nullptr);
+}
+
+::grpc::ClientReader< ::chat::RelayBatch>* ChatService::Stub::RelayRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
+  return ::grpc::internal::ClientReaderFactory< ::chat::RelayBatch>::Create(channel_.get(), rpcmethod_Relay_, context, request);
+}
+
+void ChatService::Stub::async::Relay(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::RelayBatch>* reactor) {
+  ::grpc::internal::ClientCallbackReaderFactory< ::chat::RelayBatch>::Create(stub_->channel_.get(), stub_->rpcmethod_Relay_, context, request, reactor);
+}
+
+::grpc::ClientAsyncReader< ::chat::RelayBatch>* ChatService::Stub::AsyncRelayRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::chat::RelayBatch>::Create(channel_.get(), cq, rpcmethod_Relay_, context, request, true, tag);
+}
+
+::grpc::ClientAsyncReader< ::chat::RelayBatch>* ChatService::Stub::PrepareAsyncRelayRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::chat::RelayBatch>::Create(channel_.get(), cq, rpcmethod_Relay_, context, request, false, nullptr);
+}
+
 ChatService::Service::Service() {
   AddMethod(new ::grpc::internal::RpcServiceMethod(
       ChatService_method_names[0],
@@ -89,6 +197,16 @@ ChatService::Service::Service() {
              }, this)));
   AddMethod(new ::grpc::internal::RpcServiceMethod(
       ChatService_method_names[1],
+      ::grpc::internal::RpcMethod::CLIENT_STREAMING,
+      new ::grpc::internal::ClientStreamingHandler< ChatService::Service, ::chat::ChatMessage, ::chat::Response>(
+          [](ChatService::Service* service,
+             ::grpc::ServerContext* ctx,
+             ::grpc::ServerReader<::chat::ChatMessage>* reader,
+             ::chat::Response* resp) {
+               return service->SendStream(ctx, reader, resp);
+             }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      ChatService_method_names[2],
       ::grpc::internal::RpcMethod::SERVER_STREAMING,
       new ::grpc::internal::ServerStreamingHandler< ChatService::Service, ::chat::ChatReader, ::chat::ChatMessage>(
           [](ChatService::Service* service,
@@ -97,6 +215,56 @@ ChatService::Service::Service() {
              ::grpc::ServerWriter<::chat::ChatMessage>* writer) {
                return service->ReadChat(ctx, req, writer);
              }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      ChatService_method_names[3],
+      ::grpc::internal::RpcMethod::SERVER_STREAMING,
+      new ::grpc::internal::ServerStreamingHandler< ChatService::Service, ::chat::ChatReader, ::chat::ChatMessageBatch>(
+          [](ChatService::Service* service,
+             ::grpc::ServerContext* ctx,
+             const ::chat::ChatReader* req,
+             ::grpc::ServerWriter<::chat::ChatMessageBatch>* writer) {
+               return service->ReadChatBatched(ctx, req, writer);
+             }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      ChatService_method_names[4],
+      ::grpc::internal::RpcMethod::BIDI_STREAMING,
+      new ::grpc::internal::BidiStreamingHandler< ChatService::Service, ::chat::ChatMessage, ::chat::ChatMessage>(
+          [](ChatService::Service* service,
+             ::grpc::ServerContext* ctx,
+             ::grpc::ServerReaderWriter<::chat::ChatMessage,
+             ::chat::ChatMessage>* stream) {
+               return service->Chat(ctx, stream);
+             }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      ChatService_method_names[5],
+      ::grpc::internal::RpcMethod::SERVER_STREAMING,
+      new ::grpc::internal::ServerStreamingHandler< ChatService::Service, ::chat::ChatReader, ::chat::ReplicatedBatch>(
+          [](ChatService::Service* service,
+             ::grpc::ServerContext* ctx,
+             const ::chat::ChatReader* req,
+             ::grpc::ServerWriter<::chat::ReplicatedBatch>* writer) {
+               return service->Replicate(ctx, req, writer);
+             }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      ChatService_method_names[6],
+      ::grpc::internal::RpcMethod::SERVER_STREAMING,
+      new ::grpc::internal::ServerStreamingHandler< ChatService::Service, ::chat::ChatReader, ::chat::ChatMessageBatch>(
+          [](ChatService::Service* service,
+             ::grpc::ServerContext* ctx,
+             const ::chat::ChatReader* req,
+             ::grpc::ServerWriter<::chat::ChatMessageBatch>* writer) {
+               return service->HandOff(ctx, req, writer);
+             }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      ChatService_method_names[7],
+      ::grpc::internal::RpcMethod::SERVER_STREAMING,
+      new ::grpc::internal::ServerStreamingHandler< ChatService::Service, ::chat::ChatReader, ::chat::RelayBatch>(
+          [](ChatService::Service* service,
+             ::grpc::ServerContext* ctx,
+             const ::chat::ChatReader* req,
+             ::grpc::ServerWriter<::chat::RelayBatch>* writer) {
+               return service->Relay(ctx, req, writer);
+             }, this)));
 }
 
 ChatService::Service::~Service() {
@@ -109,6 +277,13 @@ ChatService::Service::~Service() {
   return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
 }
 
+::grpc::Status ChatService::Service::SendStream(::grpc::ServerContext* context, ::grpc::ServerReader< ::chat::ChatMessage>* reader, ::chat::Response* response) {
+  (void) context;
+  (void) reader;
+  (void) response;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
 ::grpc::Status ChatService::Service::ReadChat(::grpc::ServerContext* context, const ::chat::ChatReader* request, ::grpc::ServerWriter< ::chat::ChatMessage>* writer) {
   (void) context;
   (void) request;
@@ -116,6 +291,40 @@ ChatService::Service::~Service() {
   return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
 }
 
+::grpc::Status ChatService::Service::ReadChatBatched(::grpc::ServerContext* context, const ::chat::ChatReader* request, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* writer) {
+  (void) context;
+  (void) request;
+  (void) writer;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
+::grpc::Status ChatService::Service::Chat(::grpc::ServerContext* context, ::grpc::ServerReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* stream) {
+  (void) context;
+  (void) stream;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
+::grpc::Status ChatService::Service::Replicate(::grpc::ServerContext* context, const ::chat::ChatReader* request, ::grpc::ServerWriter< ::chat::ReplicatedBatch>* writer) {
+  (void) context;
+  (void) request;
+  (void) writer;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
+::grpc::Status ChatService::Service::HandOff(::grpc::ServerContext* context, const ::chat::ChatReader* request, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* writer) {
+  (void) context;
+  (void) request;
+  (void) writer;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
+::grpc::Status ChatService::Service::Relay(::grpc::ServerContext* context, const ::chat::ChatReader* request, ::grpc::ServerWriter< ::chat::RelayBatch>* writer) {
+  (void) context;
+  (void) request;
+  (void) writer;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
 
 }  // namespace chat
 
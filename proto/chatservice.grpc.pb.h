@@ -43,6 +43,15 @@ class ChatService final {
     std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::chat::Response>> PrepareAsyncSend(::grpc::ClientContext* context, const ::chat::ChatMessage& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::chat::Response>>(PrepareAsyncSendRaw(context, request, cq));
     }
+    std::unique_ptr< ::grpc::ClientWriterInterface< ::chat::ChatMessage>> SendStream(::grpc::ClientContext* context, ::chat::Response* response) {
+      return std::unique_ptr< ::grpc::ClientWriterInterface< ::chat::ChatMessage>>(SendStreamRaw(context, response));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncWriterInterface< ::chat::ChatMessage>> AsyncSendStream(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncWriterInterface< ::chat::ChatMessage>>(AsyncSendStreamRaw(context, response, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncWriterInterface< ::chat::ChatMessage>> PrepareAsyncSendStream(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncWriterInterface< ::chat::ChatMessage>>(PrepareAsyncSendStreamRaw(context, response, cq));
+    }
     std::unique_ptr< ::grpc::ClientReaderInterface< ::chat::ChatMessage>> ReadChat(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
       return std::unique_ptr< ::grpc::ClientReaderInterface< ::chat::ChatMessage>>(ReadChatRaw(context, request));
     }
@@ -52,12 +61,63 @@ class ChatService final {
     std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessage>> PrepareAsyncReadChat(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessage>>(PrepareAsyncReadChatRaw(context, request, cq));
     }
+    std::unique_ptr< ::grpc::ClientReaderInterface< ::chat::ChatMessageBatch>> ReadChatBatched(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
+      return std::unique_ptr< ::grpc::ClientReaderInterface< ::chat::ChatMessageBatch>>(ReadChatBatchedRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>> AsyncReadChatBatched(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>>(AsyncReadChatBatchedRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>> PrepareAsyncReadChatBatched(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>>(PrepareAsyncReadChatBatchedRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReaderWriterInterface< ::chat::ChatMessage, ::chat::ChatMessage>> Chat(::grpc::ClientContext* context) {
+      return std::unique_ptr< ::grpc::ClientReaderWriterInterface< ::chat::ChatMessage, ::chat::ChatMessage>>(ChatRaw(context));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderWriterInterface< ::chat::ChatMessage, ::chat::ChatMessage>> AsyncChat(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderWriterInterface< ::chat::ChatMessage, ::chat::ChatMessage>>(AsyncChatRaw(context, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderWriterInterface< ::chat::ChatMessage, ::chat::ChatMessage>> PrepareAsyncChat(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderWriterInterface< ::chat::ChatMessage, ::chat::ChatMessage>>(PrepareAsyncChatRaw(context, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReaderInterface< ::chat::ReplicatedBatch>> Replicate(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
+      return std::unique_ptr< ::grpc::ClientReaderInterface< ::chat::ReplicatedBatch>>(ReplicateRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ReplicatedBatch>> AsyncReplicate(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ReplicatedBatch>>(AsyncReplicateRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ReplicatedBatch>> PrepareAsyncReplicate(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ReplicatedBatch>>(PrepareAsyncReplicateRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReaderInterface< ::chat::ChatMessageBatch>> HandOff(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
+      return std::unique_ptr< ::grpc::ClientReaderInterface< ::chat::ChatMessageBatch>>(HandOffRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>> AsyncHandOff(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>>(AsyncHandOffRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>> PrepareAsyncHandOff(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>>(PrepareAsyncHandOffRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReaderInterface< ::chat::RelayBatch>> Relay(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
+      return std::unique_ptr< ::grpc::ClientReaderInterface< ::chat::RelayBatch>>(RelayRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::RelayBatch>> AsyncRelay(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::RelayBatch>>(AsyncRelayRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::RelayBatch>> PrepareAsyncRelay(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::chat::RelayBatch>>(PrepareAsyncRelayRaw(context, request, cq));
+    }
     class async_interface {
      public:
       virtual ~async_interface() {}
       virtual void Send(::grpc::ClientContext* context, const ::chat::ChatMessage* request, ::chat::Response* response, std::function<void(::grpc::Status)>) = 0;
       virtual void Send(::grpc::ClientContext* context, const ::chat::ChatMessage* request, ::chat::Response* response, ::grpc::ClientUnaryReactor* reactor) = 0;
+      virtual void SendStream(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::ClientWriteReactor< ::chat::ChatMessage>* reactor) = 0;
       virtual void ReadChat(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::ChatMessage>* reactor) = 0;
+      virtual void ReadChatBatched(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::ChatMessageBatch>* reactor) = 0;
+      virtual void Chat(::grpc::ClientContext* context, ::grpc::ClientBidiReactor< ::chat::ChatMessage,::chat::ChatMessage>* reactor) = 0;
+      virtual void Replicate(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::ReplicatedBatch>* reactor) = 0;
+      virtual void HandOff(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::ChatMessageBatch>* reactor) = 0;
+      virtual void Relay(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::RelayBatch>* reactor) = 0;
     };
     typedef class async_interface experimental_async_interface;
     virtual class async_interface* async() { return nullptr; }
@@ -65,9 +125,27 @@ class ChatService final {
    private:
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::chat::Response>* AsyncSendRaw(::grpc::ClientContext* context, const ::chat::ChatMessage& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::chat::Response>* PrepareAsyncSendRaw(::grpc::ClientContext* context, const ::chat::ChatMessage& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientWriterInterface< ::chat::ChatMessage>* SendStreamRaw(::grpc::ClientContext* context, ::chat::Response* response) = 0;
+    virtual ::grpc::ClientAsyncWriterInterface< ::chat::ChatMessage>* AsyncSendStreamRaw(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::CompletionQueue* cq, void* tag) = 0;
+    virtual ::grpc::ClientAsyncWriterInterface< ::chat::ChatMessage>* PrepareAsyncSendStreamRaw(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientReaderInterface< ::chat::ChatMessage>* ReadChatRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) = 0;
     virtual ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessage>* AsyncReadChatRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) = 0;
     virtual ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessage>* PrepareAsyncReadChatRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientReaderInterface< ::chat::ChatMessageBatch>* ReadChatBatchedRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>* AsyncReadChatBatchedRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>* PrepareAsyncReadChatBatchedRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientReaderWriterInterface< ::chat::ChatMessage, ::chat::ChatMessage>* ChatRaw(::grpc::ClientContext* context) = 0;
+    virtual ::grpc::ClientAsyncReaderWriterInterface< ::chat::ChatMessage, ::chat::ChatMessage>* AsyncChatRaw(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq, void* tag) = 0;
+    virtual ::grpc::ClientAsyncReaderWriterInterface< ::chat::ChatMessage, ::chat::ChatMessage>* PrepareAsyncChatRaw(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientReaderInterface< ::chat::ReplicatedBatch>* ReplicateRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::chat::ReplicatedBatch>* AsyncReplicateRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::chat::ReplicatedBatch>* PrepareAsyncReplicateRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientReaderInterface< ::chat::ChatMessageBatch>* HandOffRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>* AsyncHandOffRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>* PrepareAsyncHandOffRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientReaderInterface< ::chat::RelayBatch>* RelayRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::chat::RelayBatch>* AsyncRelayRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::chat::RelayBatch>* PrepareAsyncRelayRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) = 0;
   };
   class Stub final : public StubInterface {
    public:
@@ -79,6 +157,15 @@ class ChatService final {
     std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::chat::Response>> PrepareAsyncSend(::grpc::ClientContext* context, const ::chat::ChatMessage& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::chat::Response>>(PrepareAsyncSendRaw(context, request, cq));
     }
+    std::unique_ptr< ::grpc::ClientWriter< ::chat::ChatMessage>> SendStream(::grpc::ClientContext* context, ::chat::Response* response) {
+      return std::unique_ptr< ::grpc::ClientWriter< ::chat::ChatMessage>>(SendStreamRaw(context, response));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncWriter< ::chat::ChatMessage>> AsyncSendStream(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncWriter< ::chat::ChatMessage>>(AsyncSendStreamRaw(context, response, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncWriter< ::chat::ChatMessage>> PrepareAsyncSendStream(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncWriter< ::chat::ChatMessage>>(PrepareAsyncSendStreamRaw(context, response, cq));
+    }
     std::unique_ptr< ::grpc::ClientReader< ::chat::ChatMessage>> ReadChat(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
       return std::unique_ptr< ::grpc::ClientReader< ::chat::ChatMessage>>(ReadChatRaw(context, request));
     }
@@ -88,12 +175,63 @@ class ChatService final {
     std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ChatMessage>> PrepareAsyncReadChat(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ChatMessage>>(PrepareAsyncReadChatRaw(context, request, cq));
     }
+    std::unique_ptr< ::grpc::ClientReader< ::chat::ChatMessageBatch>> ReadChatBatched(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
+      return std::unique_ptr< ::grpc::ClientReader< ::chat::ChatMessageBatch>>(ReadChatBatchedRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>> AsyncReadChatBatched(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>>(AsyncReadChatBatchedRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>> PrepareAsyncReadChatBatched(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>>(PrepareAsyncReadChatBatchedRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>> Chat(::grpc::ClientContext* context) {
+      return std::unique_ptr< ::grpc::ClientReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>>(ChatRaw(context));
+    }
+    std::unique_ptr<  ::grpc::ClientAsyncReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>> AsyncChat(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>>(AsyncChatRaw(context, cq, tag));
+    }
+    std::unique_ptr<  ::grpc::ClientAsyncReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>> PrepareAsyncChat(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>>(PrepareAsyncChatRaw(context, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReader< ::chat::ReplicatedBatch>> Replicate(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
+      return std::unique_ptr< ::grpc::ClientReader< ::chat::ReplicatedBatch>>(ReplicateRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ReplicatedBatch>> AsyncReplicate(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ReplicatedBatch>>(AsyncReplicateRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ReplicatedBatch>> PrepareAsyncReplicate(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ReplicatedBatch>>(PrepareAsyncReplicateRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReader< ::chat::ChatMessageBatch>> HandOff(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
+      return std::unique_ptr< ::grpc::ClientReader< ::chat::ChatMessageBatch>>(HandOffRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>> AsyncHandOff(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>>(AsyncHandOffRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>> PrepareAsyncHandOff(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>>(PrepareAsyncHandOffRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReader< ::chat::RelayBatch>> Relay(::grpc::ClientContext* context, const ::chat::ChatReader& request) {
+      return std::unique_ptr< ::grpc::ClientReader< ::chat::RelayBatch>>(RelayRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::RelayBatch>> AsyncRelay(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::RelayBatch>>(AsyncRelayRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::RelayBatch>> PrepareAsyncRelay(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::chat::RelayBatch>>(PrepareAsyncRelayRaw(context, request, cq));
+    }
     class async final :
       public StubInterface::async_interface {
      public:
       void Send(::grpc::ClientContext* context, const ::chat::ChatMessage* request, ::chat::Response* response, std::function<void(::grpc::Status)>) override;
       void Send(::grpc::ClientContext* context, const ::chat::ChatMessage* request, ::chat::Response* response, ::grpc::ClientUnaryReactor* reactor) override;
+      void SendStream(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::ClientWriteReactor< ::chat::ChatMessage>* reactor) override;
       void ReadChat(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::ChatMessage>* reactor) override;
+      void ReadChatBatched(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::ChatMessageBatch>* reactor) override;
+      void Chat(::grpc::ClientContext* context, ::grpc::ClientBidiReactor< ::chat::ChatMessage,::chat::ChatMessage>* reactor) override;
+      void Replicate(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::ReplicatedBatch>* reactor) override;
+      void HandOff(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::ChatMessageBatch>* reactor) override;
+      void Relay(::grpc::ClientContext* context, const ::chat::ChatReader* request, ::grpc::ClientReadReactor< ::chat::RelayBatch>* reactor) override;
      private:
       friend class Stub;
       explicit async(Stub* stub): stub_(stub) { }
@@ -107,11 +245,35 @@ class ChatService final {
     class async async_stub_{this};
     ::grpc::ClientAsyncResponseReader< ::chat::Response>* AsyncSendRaw(::grpc::ClientContext* context, const ::chat::ChatMessage& request, ::grpc::CompletionQueue* cq) override;
     ::grpc::ClientAsyncResponseReader< ::chat::Response>* PrepareAsyncSendRaw(::grpc::ClientContext* context, const ::chat::ChatMessage& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientWriter< ::chat::ChatMessage>* SendStreamRaw(::grpc::ClientContext* context, ::chat::Response* response) override;
+    ::grpc::ClientAsyncWriter< ::chat::ChatMessage>* AsyncSendStreamRaw(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::CompletionQueue* cq, void* tag) override;
+    ::grpc::ClientAsyncWriter< ::chat::ChatMessage>* PrepareAsyncSendStreamRaw(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::CompletionQueue* cq) override;
     ::grpc::ClientReader< ::chat::ChatMessage>* ReadChatRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) override;
     ::grpc::ClientAsyncReader< ::chat::ChatMessage>* AsyncReadChatRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) override;
     ::grpc::ClientAsyncReader< ::chat::ChatMessage>* PrepareAsyncReadChatRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientReader< ::chat::ChatMessageBatch>* ReadChatBatchedRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) override;
+    ::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>* AsyncReadChatBatchedRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) override;
+    ::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>* PrepareAsyncReadChatBatchedRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* ChatRaw(::grpc::ClientContext* context) override;
+    ::grpc::ClientAsyncReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* AsyncChatRaw(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq, void* tag) override;
+    ::grpc::ClientAsyncReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* PrepareAsyncChatRaw(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientReader< ::chat::ReplicatedBatch>* ReplicateRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) override;
+    ::grpc::ClientAsyncReader< ::chat::ReplicatedBatch>* AsyncReplicateRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) override;
+    ::grpc::ClientAsyncReader< ::chat::ReplicatedBatch>* PrepareAsyncReplicateRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientReader< ::chat::ChatMessageBatch>* HandOffRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) override;
+    ::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>* AsyncHandOffRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) override;
+    ::grpc::ClientAsyncReader< ::chat::ChatMessageBatch>* PrepareAsyncHandOffRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientReader< ::chat::RelayBatch>* RelayRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request) override;
+    ::grpc::ClientAsyncReader< ::chat::RelayBatch>* AsyncRelayRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag) override;
+    ::grpc::ClientAsyncReader< ::chat::RelayBatch>* PrepareAsyncRelayRaw(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq) override;
     const ::grpc::internal::RpcMethod rpcmethod_Send_;
+    const ::grpc::internal::RpcMethod rpcmethod_SendStream_;
     const ::grpc::internal::RpcMethod rpcmethod_ReadChat_;
+    const ::grpc::internal::RpcMethod rpcmethod_ReadChatBatched_;
+    const ::grpc::internal::RpcMethod rpcmethod_Chat_;
+    const ::grpc::internal::RpcMethod rpcmethod_Replicate_;
+    const ::grpc::internal::RpcMethod rpcmethod_HandOff_;
+    const ::grpc::internal::RpcMethod rpcmethod_Relay_;
   };
   static std::unique_ptr<Stub> NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
 
@@ -120,7 +282,13 @@ class ChatService final {
     Service();
     virtual ~Service();
     virtual ::grpc::Status Send(::grpc::ServerContext* context, const ::chat::ChatMessage* request, ::chat::Response* response);
+    virtual ::grpc::Status SendStream(::grpc::ServerContext* context, ::grpc::ServerReader< ::chat::ChatMessage>* reader, ::chat::Response* response);
     virtual ::grpc::Status ReadChat(::grpc::ServerContext* context, const ::chat::ChatReader* request, ::grpc::ServerWriter< ::chat::ChatMessage>* writer);
+    virtual ::grpc::Status ReadChatBatched(::grpc::ServerContext* context, const ::chat::ChatReader* request, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* writer);
+    virtual ::grpc::Status Chat(::grpc::ServerContext* context, ::grpc::ServerReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* stream);
+    virtual ::grpc::Status Replicate(::grpc::ServerContext* context, const ::chat::ChatReader* request, ::grpc::ServerWriter< ::chat::ReplicatedBatch>* writer);
+    virtual ::grpc::Status HandOff(::grpc::ServerContext* context, const ::chat::ChatReader* request, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* writer);
+    virtual ::grpc::Status Relay(::grpc::ServerContext* context, const ::chat::ChatReader* request, ::grpc::ServerWriter< ::chat::RelayBatch>* writer);
   };
   template <class BaseClass>
   class WithAsyncMethod_Send : public BaseClass {
@@ -143,12 +311,32 @@ class ChatService final {
     }
   };
   template <class BaseClass>
+  class WithAsyncMethod_SendStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_SendStream() {
+      ::grpc::Service::MarkMethodAsync(1);
+    }
+    ~WithAsyncMethod_SendStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SendStream(::grpc::ServerContext* /*context*/, ::grpc::ServerReader< ::chat::ChatMessage>* /*reader*/, ::chat::Response* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestSendStream(::grpc::ServerContext* context, ::grpc::ServerAsyncReader< ::chat::Response, ::chat::ChatMessage>* reader, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncClientStreaming(1, context, reader, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
   class WithAsyncMethod_ReadChat : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
    public:
     WithAsyncMethod_ReadChat() {
-      ::grpc::Service::MarkMethodAsync(1);
+      ::grpc::Service::MarkMethodAsync(2);
     }
     ~WithAsyncMethod_ReadChat() override {
       BaseClassMustBeDerivedFromService(this);
@@ -159,10 +347,110 @@ class ChatService final {
       return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
     }
     void RequestReadChat(::grpc::ServerContext* context, ::chat::ChatReader* request, ::grpc::ServerAsyncWriter< ::chat::ChatMessage>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
-      ::grpc::Service::RequestAsyncServerStreaming(1, context, request, writer, new_call_cq, notification_cq, tag);
+      ::grpc::Service::RequestAsyncServerStreaming(2, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithAsyncMethod_ReadChatBatched : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_ReadChatBatched() {
+      ::grpc::Service::MarkMethodAsync(3);
+    }
+    ~WithAsyncMethod_ReadChatBatched() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status ReadChatBatched(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestReadChatBatched(::grpc::ServerContext* context, ::chat::ChatReader* request, ::grpc::ServerAsyncWriter< ::chat::ChatMessageBatch>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(3, context, request, writer, new_call_cq, notification_cq, tag);
     }
   };
-  typedef WithAsyncMethod_Send<WithAsyncMethod_ReadChat<Service > > AsyncService;
+  template <class BaseClass>
+  class WithAsyncMethod_Chat : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_Chat() {
+      ::grpc::Service::MarkMethodAsync(4);
+    }
+    ~WithAsyncMethod_Chat() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Chat(::grpc::ServerContext* /*context*/, ::grpc::ServerReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* /*stream*/)  override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestChat(::grpc::ServerContext* context, ::grpc::ServerAsyncReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* stream, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncBidiStreaming(4, context, stream, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithAsyncMethod_Replicate : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_Replicate() {
+      ::grpc::Service::MarkMethodAsync(5);
+    }
+    ~WithAsyncMethod_Replicate() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Replicate(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ReplicatedBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestReplicate(::grpc::ServerContext* context, ::chat::ChatReader* request, ::grpc::ServerAsyncWriter< ::chat::ReplicatedBatch>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(5, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithAsyncMethod_HandOff : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_HandOff() {
+      ::grpc::Service::MarkMethodAsync(6);
+    }
+    ~WithAsyncMethod_HandOff() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status HandOff(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestHandOff(::grpc::ServerContext* context, ::chat::ChatReader* request, ::grpc::ServerAsyncWriter< ::chat::ChatMessageBatch>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(6, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithAsyncMethod_Relay : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_Relay() {
+      ::grpc::Service::MarkMethodAsync(7);
+    }
+    ~WithAsyncMethod_Relay() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Relay(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::RelayBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestRelay(::grpc::ServerContext* context, ::chat::ChatReader* request, ::grpc::ServerAsyncWriter< ::chat::RelayBatch>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(7, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  typedef WithAsyncMethod_Send<WithAsyncMethod_SendStream<WithAsyncMethod_ReadChat<WithAsyncMethod_ReadChatBatched<WithAsyncMethod_Chat<WithAsyncMethod_Replicate<WithAsyncMethod_HandOff<WithAsyncMethod_Relay<Service > > > > > > > > AsyncService;
   template <class BaseClass>
   class WithCallbackMethod_Send : public BaseClass {
    private:
@@ -191,12 +479,34 @@ class ChatService final {
       ::grpc::CallbackServerContext* /*context*/, const ::chat::ChatMessage* /*request*/, ::chat::Response* /*response*/)  { return nullptr; }
   };
   template <class BaseClass>
+  class WithCallbackMethod_SendStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithCallbackMethod_SendStream() {
+      ::grpc::Service::MarkMethodCallback(1,
+          new ::grpc::internal::CallbackClientStreamingHandler< ::chat::ChatMessage, ::chat::Response>(
+            [this](
+                   ::grpc::CallbackServerContext* context, ::chat::Response* response) { return this->SendStream(context, response); }));
+    }
+    ~WithCallbackMethod_SendStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SendStream(::grpc::ServerContext* /*context*/, ::grpc::ServerReader< ::chat::ChatMessage>* /*reader*/, ::chat::Response* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerReadReactor< ::chat::ChatMessage>* SendStream(
+      ::grpc::CallbackServerContext* /*context*/, ::chat::Response* /*response*/)  { return nullptr; }
+  };
+  template <class BaseClass>
   class WithCallbackMethod_ReadChat : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
    public:
     WithCallbackMethod_ReadChat() {
-      ::grpc::Service::MarkMethodCallback(1,
+      ::grpc::Service::MarkMethodCallback(2,
           new ::grpc::internal::CallbackServerStreamingHandler< ::chat::ChatReader, ::chat::ChatMessage>(
             [this](
                    ::grpc::CallbackServerContext* context, const ::chat::ChatReader* request) { return this->ReadChat(context, request); }));
@@ -212,94 +522,128 @@ class ChatService final {
     virtual ::grpc::ServerWriteReactor< ::chat::ChatMessage>* ReadChat(
       ::grpc::CallbackServerContext* /*context*/, const ::chat::ChatReader* /*request*/)  { return nullptr; }
   };
-  typedef WithCallbackMethod_Send<WithCallbackMethod_ReadChat<Service > > CallbackService;
-  typedef CallbackService ExperimentalCallbackService;
   template <class BaseClass>
-  class WithGenericMethod_Send : public BaseClass {
+  class WithCallbackMethod_ReadChatBatched : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
    public:
-    WithGenericMethod_Send() {
-      ::grpc::Service::MarkMethodGeneric(0);
+    WithCallbackMethod_ReadChatBatched() {
+      ::grpc::Service::MarkMethodCallback(3,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::chat::ChatReader, ::chat::ChatMessageBatch>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::chat::ChatReader* request) { return this->ReadChatBatched(context, request); }));
     }
-    ~WithGenericMethod_Send() override {
+    ~WithCallbackMethod_ReadChatBatched() override {
       BaseClassMustBeDerivedFromService(this);
     }
     // disable synchronous version of this method
-    ::grpc::Status Send(::grpc::ServerContext* /*context*/, const ::chat::ChatMessage* /*request*/, ::chat::Response* /*response*/) override {
+    ::grpc::Status ReadChatBatched(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* /*writer*/) override {
       abort();
       return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
     }
+    virtual ::grpc::ServerWriteReactor< ::chat::ChatMessageBatch>* ReadChatBatched(
+      ::grpc::CallbackServerContext* /*context*/, const ::chat::ChatReader* /*request*/)  { return nullptr; }
   };
   template <class BaseClass>
-  class WithGenericMethod_ReadChat : public BaseClass {
+  class WithCallbackMethod_Chat : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
    public:
-    WithGenericMethod_ReadChat() {
-      ::grpc::Service::MarkMethodGeneric(1);
+    WithCallbackMethod_Chat() {
+      ::grpc::Service::MarkMethodCallback(4,
+          new ::grpc::internal::CallbackBidiHandler< ::chat::ChatMessage, ::chat::ChatMessage>(
+            [this](
+                   ::grpc::CallbackServerContext* context) { return this->Chat(context); }));
     }
-    ~WithGenericMethod_ReadChat() override {
+    ~WithCallbackMethod_Chat() override {
       BaseClassMustBeDerivedFromService(this);
     }
     // disable synchronous version of this method
-    ::grpc::Status ReadChat(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessage>* /*writer*/) override {
+    ::grpc::Status Chat(::grpc::ServerContext* /*context*/, ::grpc::ServerReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* /*stream*/)  override {
       abort();
       return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
     }
+    virtual ::grpc::ServerBidiReactor< ::chat::ChatMessage, ::chat::ChatMessage>* Chat(
+      ::grpc::CallbackServerContext* /*context*/)
+      { return nullptr; }
   };
   template <class BaseClass>
-  class WithRawMethod_Send : public BaseClass {
+  class WithCallbackMethod_Replicate : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
    public:
-    WithRawMethod_Send() {
-      ::grpc::Service::MarkMethodRaw(0);
+    WithCallbackMethod_Replicate() {
+      ::grpc::Service::MarkMethodCallback(5,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::chat::ChatReader, ::chat::ReplicatedBatch>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::chat::ChatReader* request) { return this->Replicate(context, request); }));
     }
-    ~WithRawMethod_Send() override {
+    ~WithCallbackMethod_Replicate() override {
       BaseClassMustBeDerivedFromService(this);
     }
     // disable synchronous version of this method
-    ::grpc::Status Send(::grpc::ServerContext* /*context*/, const ::chat::ChatMessage* /*request*/, ::chat::Response* /*response*/) override {
+    ::grpc::Status Replicate(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ReplicatedBatch>* /*writer*/) override {
       abort();
       return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
     }
-    void RequestSend(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncResponseWriter< ::grpc::ByteBuffer>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
-      ::grpc::Service::RequestAsyncUnary(0, context, request, response, new_call_cq, notification_cq, tag);
-    }
+    virtual ::grpc::ServerWriteReactor< ::chat::ReplicatedBatch>* Replicate(
+      ::grpc::CallbackServerContext* /*context*/, const ::chat::ChatReader* /*request*/)  { return nullptr; }
   };
   template <class BaseClass>
-  class WithRawMethod_ReadChat : public BaseClass {
+  class WithCallbackMethod_HandOff : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
    public:
-    WithRawMethod_ReadChat() {
-      ::grpc::Service::MarkMethodRaw(1);
+    WithCallbackMethod_HandOff() {
+      ::grpc::Service::MarkMethodCallback(6,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::chat::ChatReader, ::chat::ChatMessageBatch>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::chat::ChatReader* request) { return this->HandOff(context, request); }));
     }
-    ~WithRawMethod_ReadChat() override {
+    ~WithCallbackMethod_HandOff() override {
       BaseClassMustBeDerivedFromService(this);
     }
     // disable synchronous version of this method
-    ::grpc::Status ReadChat(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessage>* /*writer*/) override {
+    ::grpc::Status HandOff(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* /*writer*/) override {
       abort();
       return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
     }
-    void RequestReadChat(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncWriter< ::grpc::ByteBuffer>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
-      ::grpc::Service::RequestAsyncServerStreaming(1, context, request, writer, new_call_cq, notification_cq, tag);
-    }
+    virtual ::grpc::ServerWriteReactor< ::chat::ChatMessageBatch>* HandOff(
+      ::grpc::CallbackServerContext* /*context*/, const ::chat::ChatReader* /*request*/)  { return nullptr; }
   };
   template <class BaseClass>
-  class WithRawCallbackMethod_Send : public BaseClass {
+  class WithCallbackMethod_Relay : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
    public:
-    WithRawCallbackMethod_Send() {
-      ::grpc::Service::MarkMethodRawCallback(0,
-          new ::grpc::internal::CallbackUnaryHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+    WithCallbackMethod_Relay() {
+      ::grpc::Service::MarkMethodCallback(7,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::chat::ChatReader, ::chat::RelayBatch>(
             [this](
-                   ::grpc::CallbackServerContext* context, const ::grpc::ByteBuffer* request, ::grpc::ByteBuffer* response) { return this->Send(context, request, response); }));
+                   ::grpc::CallbackServerContext* context, const ::chat::ChatReader* request) { return this->Relay(context, request); }));
     }
-    ~WithRawCallbackMethod_Send() override {
+    ~WithCallbackMethod_Relay() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Relay(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::RelayBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerWriteReactor< ::chat::RelayBatch>* Relay(
+      ::grpc::CallbackServerContext* /*context*/, const ::chat::ChatReader* /*request*/)  { return nullptr; }
+  };
+  typedef WithCallbackMethod_Send<WithCallbackMethod_SendStream<WithCallbackMethod_ReadChat<WithCallbackMethod_ReadChatBatched<WithCallbackMethod_Chat<WithCallbackMethod_Replicate<WithCallbackMethod_HandOff<WithCallbackMethod_Relay<Service > > > > > > > > CallbackService;
+  typedef CallbackService ExperimentalCallbackService;
+  template <class BaseClass>
+  class WithGenericMethod_Send : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_Send() {
+      ::grpc::Service::MarkMethodGeneric(0);
+    }
+    ~WithGenericMethod_Send() override {
       BaseClassMustBeDerivedFromService(this);
     }
     // disable synchronous version of this method
@@ -307,21 +651,33 @@ class ChatService final {
       abort();
       return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
     }
-    virtual ::grpc::ServerUnaryReactor* Send(
-      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)  { return nullptr; }
   };
   template <class BaseClass>
-  class WithRawCallbackMethod_ReadChat : public BaseClass {
+  class WithGenericMethod_SendStream : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
    public:
-    WithRawCallbackMethod_ReadChat() {
-      ::grpc::Service::MarkMethodRawCallback(1,
-          new ::grpc::internal::CallbackServerStreamingHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
-            [this](
-                   ::grpc::CallbackServerContext* context, const::grpc::ByteBuffer* request) { return this->ReadChat(context, request); }));
+    WithGenericMethod_SendStream() {
+      ::grpc::Service::MarkMethodGeneric(1);
     }
-    ~WithRawCallbackMethod_ReadChat() override {
+    ~WithGenericMethod_SendStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SendStream(::grpc::ServerContext* /*context*/, ::grpc::ServerReader< ::chat::ChatMessage>* /*reader*/, ::chat::Response* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
+  class WithGenericMethod_ReadChat : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_ReadChat() {
+      ::grpc::Service::MarkMethodGeneric(2);
+    }
+    ~WithGenericMethod_ReadChat() override {
       BaseClassMustBeDerivedFromService(this);
     }
     // disable synchronous version of this method
@@ -329,66 +685,594 @@ class ChatService final {
       abort();
       return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
     }
-    virtual ::grpc::ServerWriteReactor< ::grpc::ByteBuffer>* ReadChat(
-      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/)  { return nullptr; }
   };
   template <class BaseClass>
-  class WithStreamedUnaryMethod_Send : public BaseClass {
+  class WithGenericMethod_ReadChatBatched : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
    public:
-    WithStreamedUnaryMethod_Send() {
-      ::grpc::Service::MarkMethodStreamed(0,
-        new ::grpc::internal::StreamedUnaryHandler<
-          ::chat::ChatMessage, ::chat::Response>(
-            [this](::grpc::ServerContext* context,
-                   ::grpc::ServerUnaryStreamer<
-                     ::chat::ChatMessage, ::chat::Response>* streamer) {
-                       return this->StreamedSend(context,
-                         streamer);
-                  }));
+    WithGenericMethod_ReadChatBatched() {
+      ::grpc::Service::MarkMethodGeneric(3);
     }
-    ~WithStreamedUnaryMethod_Send() override {
+    ~WithGenericMethod_ReadChatBatched() override {
       BaseClassMustBeDerivedFromService(this);
     }
-    // disable regular version of this method
-    ::grpc::Status Send(::grpc::ServerContext* /*context*/, const ::chat::ChatMessage* /*request*/, ::chat::Response* /*response*/) override {
+    // disable synchronous version of this method
+    ::grpc::Status ReadChatBatched(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* /*writer*/) override {
       abort();
       return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
     }
-    // replace default version of method with streamed unary
-    virtual ::grpc::Status StreamedSend(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::chat::ChatMessage,::chat::Response>* server_unary_streamer) = 0;
   };
-  typedef WithStreamedUnaryMethod_Send<Service > StreamedUnaryService;
   template <class BaseClass>
-  class WithSplitStreamingMethod_ReadChat : public BaseClass {
+  class WithGenericMethod_Chat : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
    public:
-    WithSplitStreamingMethod_ReadChat() {
-      ::grpc::Service::MarkMethodStreamed(1,
-        new ::grpc::internal::SplitServerStreamingHandler<
-          ::chat::ChatReader, ::chat::ChatMessage>(
-            [this](::grpc::ServerContext* context,
-                   ::grpc::ServerSplitStreamer<
-                     ::chat::ChatReader, ::chat::ChatMessage>* streamer) {
-                       return this->StreamedReadChat(context,
-                         streamer);
-                  }));
+    WithGenericMethod_Chat() {
+      ::grpc::Service::MarkMethodGeneric(4);
     }
-    ~WithSplitStreamingMethod_ReadChat() override {
+    ~WithGenericMethod_Chat() override {
       BaseClassMustBeDerivedFromService(this);
     }
-    // disable regular version of this method
-    ::grpc::Status ReadChat(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessage>* /*writer*/) override {
+    // disable synchronous version of this method
+    ::grpc::Status Chat(::grpc::ServerContext* /*context*/, ::grpc::ServerReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* /*stream*/)  override {
       abort();
       return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
     }
-    // replace default version of method with split streamed
-    virtual ::grpc::Status StreamedReadChat(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::chat::ChatReader,::chat::ChatMessage>* server_split_streamer) = 0;
   };
-  typedef WithSplitStreamingMethod_ReadChat<Service > SplitStreamedService;
-  typedef WithStreamedUnaryMethod_Send<WithSplitStreamingMethod_ReadChat<Service > > StreamedService;
+  template <class BaseClass>
+  class WithGenericMethod_Replicate : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_Replicate() {
+      ::grpc::Service::MarkMethodGeneric(5);
+    }
+    ~WithGenericMethod_Replicate() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Replicate(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ReplicatedBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
+  class WithGenericMethod_HandOff : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_HandOff() {
+      ::grpc::Service::MarkMethodGeneric(6);
+    }
+    ~WithGenericMethod_HandOff() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status HandOff(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
+  class WithGenericMethod_Relay : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_Relay() {
+      ::grpc::Service::MarkMethodGeneric(7);
+    }
+    ~WithGenericMethod_Relay() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Relay(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::RelayBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
+  class WithRawMethod_Send : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_Send() {
+      ::grpc::Service::MarkMethodRaw(0);
+    }
+    ~WithRawMethod_Send() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Send(::grpc::ServerContext* /*context*/, const ::chat::ChatMessage* /*request*/, ::chat::Response* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestSend(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncResponseWriter< ::grpc::ByteBuffer>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncUnary(0, context, request, response, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithRawMethod_SendStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_SendStream() {
+      ::grpc::Service::MarkMethodRaw(1);
+    }
+    ~WithRawMethod_SendStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SendStream(::grpc::ServerContext* /*context*/, ::grpc::ServerReader< ::chat::ChatMessage>* /*reader*/, ::chat::Response* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestSendStream(::grpc::ServerContext* context, ::grpc::ServerAsyncReader< ::grpc::ByteBuffer, ::grpc::ByteBuffer>* reader, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncClientStreaming(1, context, reader, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithRawMethod_ReadChat : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_ReadChat() {
+      ::grpc::Service::MarkMethodRaw(2);
+    }
+    ~WithRawMethod_ReadChat() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status ReadChat(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessage>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestReadChat(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncWriter< ::grpc::ByteBuffer>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(2, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithRawMethod_ReadChatBatched : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_ReadChatBatched() {
+      ::grpc::Service::MarkMethodRaw(3);
+    }
+    ~WithRawMethod_ReadChatBatched() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status ReadChatBatched(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestReadChatBatched(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncWriter< ::grpc::ByteBuffer>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(3, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithRawMethod_Chat : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_Chat() {
+      ::grpc::Service::MarkMethodRaw(4);
+    }
+    ~WithRawMethod_Chat() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Chat(::grpc::ServerContext* /*context*/, ::grpc::ServerReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* /*stream*/)  override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestChat(::grpc::ServerContext* context, ::grpc::ServerAsyncReaderWriter< ::grpc::ByteBuffer, ::grpc::ByteBuffer>* stream, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncBidiStreaming(4, context, stream, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithRawMethod_Replicate : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_Replicate() {
+      ::grpc::Service::MarkMethodRaw(5);
+    }
+    ~WithRawMethod_Replicate() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Replicate(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ReplicatedBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestReplicate(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncWriter< ::grpc::ByteBuffer>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(5, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithRawMethod_HandOff : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_HandOff() {
+      ::grpc::Service::MarkMethodRaw(6);
+    }
+    ~WithRawMethod_HandOff() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status HandOff(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestHandOff(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncWriter< ::grpc::ByteBuffer>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(6, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithRawMethod_Relay : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_Relay() {
+      ::grpc::Service::MarkMethodRaw(7);
+    }
+    ~WithRawMethod_Relay() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Relay(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::RelayBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestRelay(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncWriter< ::grpc::ByteBuffer>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(7, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithRawCallbackMethod_Send : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_Send() {
+      ::grpc::Service::MarkMethodRawCallback(0,
+          new ::grpc::internal::CallbackUnaryHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::grpc::ByteBuffer* request, ::grpc::ByteBuffer* response) { return this->Send(context, request, response); }));
+    }
+    ~WithRawCallbackMethod_Send() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Send(::grpc::ServerContext* /*context*/, const ::chat::ChatMessage* /*request*/, ::chat::Response* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerUnaryReactor* Send(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithRawCallbackMethod_SendStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_SendStream() {
+      ::grpc::Service::MarkMethodRawCallback(1,
+          new ::grpc::internal::CallbackClientStreamingHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, ::grpc::ByteBuffer* response) { return this->SendStream(context, response); }));
+    }
+    ~WithRawCallbackMethod_SendStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SendStream(::grpc::ServerContext* /*context*/, ::grpc::ServerReader< ::chat::ChatMessage>* /*reader*/, ::chat::Response* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerReadReactor< ::grpc::ByteBuffer>* SendStream(
+      ::grpc::CallbackServerContext* /*context*/, ::grpc::ByteBuffer* /*response*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithRawCallbackMethod_ReadChat : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_ReadChat() {
+      ::grpc::Service::MarkMethodRawCallback(2,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const::grpc::ByteBuffer* request) { return this->ReadChat(context, request); }));
+    }
+    ~WithRawCallbackMethod_ReadChat() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status ReadChat(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessage>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerWriteReactor< ::grpc::ByteBuffer>* ReadChat(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithRawCallbackMethod_ReadChatBatched : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_ReadChatBatched() {
+      ::grpc::Service::MarkMethodRawCallback(3,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const::grpc::ByteBuffer* request) { return this->ReadChatBatched(context, request); }));
+    }
+    ~WithRawCallbackMethod_ReadChatBatched() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status ReadChatBatched(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerWriteReactor< ::grpc::ByteBuffer>* ReadChatBatched(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithRawCallbackMethod_Chat : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_Chat() {
+      ::grpc::Service::MarkMethodRawCallback(4,
+          new ::grpc::internal::CallbackBidiHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context) { return this->Chat(context); }));
+    }
+    ~WithRawCallbackMethod_Chat() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Chat(::grpc::ServerContext* /*context*/, ::grpc::ServerReaderWriter< ::chat::ChatMessage, ::chat::ChatMessage>* /*stream*/)  override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerBidiReactor< ::grpc::ByteBuffer, ::grpc::ByteBuffer>* Chat(
+      ::grpc::CallbackServerContext* /*context*/)
+      { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithRawCallbackMethod_Replicate : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_Replicate() {
+      ::grpc::Service::MarkMethodRawCallback(5,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const::grpc::ByteBuffer* request) { return this->Replicate(context, request); }));
+    }
+    ~WithRawCallbackMethod_Replicate() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Replicate(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ReplicatedBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerWriteReactor< ::grpc::ByteBuffer>* Replicate(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithRawCallbackMethod_HandOff : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_HandOff() {
+      ::grpc::Service::MarkMethodRawCallback(6,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const::grpc::ByteBuffer* request) { return this->HandOff(context, request); }));
+    }
+    ~WithRawCallbackMethod_HandOff() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status HandOff(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerWriteReactor< ::grpc::ByteBuffer>* HandOff(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithRawCallbackMethod_Relay : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_Relay() {
+      ::grpc::Service::MarkMethodRawCallback(7,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const::grpc::ByteBuffer* request) { return this->Relay(context, request); }));
+    }
+    ~WithRawCallbackMethod_Relay() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status Relay(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::RelayBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerWriteReactor< ::grpc::ByteBuffer>* Relay(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithStreamedUnaryMethod_Send : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithStreamedUnaryMethod_Send() {
+      ::grpc::Service::MarkMethodStreamed(0,
+        new ::grpc::internal::StreamedUnaryHandler<
+          ::chat::ChatMessage, ::chat::Response>(
+            [this](::grpc::ServerContext* context,
+                   ::grpc::ServerUnaryStreamer<
+                     ::chat::ChatMessage, ::chat::Response>* streamer) {
+                       return this->StreamedSend(context,
+                         streamer);
+                  }));
+    }
+    ~WithStreamedUnaryMethod_Send() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status Send(::grpc::ServerContext* /*context*/, const ::chat::ChatMessage* /*request*/, ::chat::Response* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with streamed unary
+    virtual ::grpc::Status StreamedSend(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::chat::ChatMessage,::chat::Response>* server_unary_streamer) = 0;
+  };
+  typedef WithStreamedUnaryMethod_Send<Service > StreamedUnaryService;
+  template <class BaseClass>
+  class WithSplitStreamingMethod_ReadChat : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithSplitStreamingMethod_ReadChat() {
+      ::grpc::Service::MarkMethodStreamed(2,
+        new ::grpc::internal::SplitServerStreamingHandler<
+          ::chat::ChatReader, ::chat::ChatMessage>(
+            [this](::grpc::ServerContext* context,
+                   ::grpc::ServerSplitStreamer<
+                     ::chat::ChatReader, ::chat::ChatMessage>* streamer) {
+                       return this->StreamedReadChat(context,
+                         streamer);
+                  }));
+    }
+    ~WithSplitStreamingMethod_ReadChat() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status ReadChat(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessage>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with split streamed
+    virtual ::grpc::Status StreamedReadChat(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::chat::ChatReader,::chat::ChatMessage>* server_split_streamer) = 0;
+  };
+  template <class BaseClass>
+  class WithSplitStreamingMethod_ReadChatBatched : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithSplitStreamingMethod_ReadChatBatched() {
+      ::grpc::Service::MarkMethodStreamed(3,
+        new ::grpc::internal::SplitServerStreamingHandler<
+          ::chat::ChatReader, ::chat::ChatMessageBatch>(
+            [this](::grpc::ServerContext* context,
+                   ::grpc::ServerSplitStreamer<
+                     ::chat::ChatReader, ::chat::ChatMessageBatch>* streamer) {
+                       return this->StreamedReadChatBatched(context,
+                         streamer);
+                  }));
+    }
+    ~WithSplitStreamingMethod_ReadChatBatched() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status ReadChatBatched(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with split streamed
+    virtual ::grpc::Status StreamedReadChatBatched(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::chat::ChatReader,::chat::ChatMessageBatch>* server_split_streamer) = 0;
+  };
+  template <class BaseClass>
+  class WithSplitStreamingMethod_Replicate : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithSplitStreamingMethod_Replicate() {
+      ::grpc::Service::MarkMethodStreamed(5,
+        new ::grpc::internal::SplitServerStreamingHandler<
+          ::chat::ChatReader, ::chat::ReplicatedBatch>(
+            [this](::grpc::ServerContext* context,
+                   ::grpc::ServerSplitStreamer<
+                     ::chat::ChatReader, ::chat::ReplicatedBatch>* streamer) {
+                       return this->StreamedReplicate(context,
+                         streamer);
+                  }));
+    }
+    ~WithSplitStreamingMethod_Replicate() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status Replicate(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ReplicatedBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with split streamed
+    virtual ::grpc::Status StreamedReplicate(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::chat::ChatReader,::chat::ReplicatedBatch>* server_split_streamer) = 0;
+  };
+  template <class BaseClass>
+  class WithSplitStreamingMethod_HandOff : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithSplitStreamingMethod_HandOff() {
+      ::grpc::Service::MarkMethodStreamed(6,
+        new ::grpc::internal::SplitServerStreamingHandler<
+          ::chat::ChatReader, ::chat::ChatMessageBatch>(
+            [this](::grpc::ServerContext* context,
+                   ::grpc::ServerSplitStreamer<
+                     ::chat::ChatReader, ::chat::ChatMessageBatch>* streamer) {
+                       return this->StreamedHandOff(context,
+                         streamer);
+                  }));
+    }
+    ~WithSplitStreamingMethod_HandOff() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status HandOff(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::ChatMessageBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with split streamed
+    virtual ::grpc::Status StreamedHandOff(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::chat::ChatReader,::chat::ChatMessageBatch>* server_split_streamer) = 0;
+  };
+  template <class BaseClass>
+  class WithSplitStreamingMethod_Relay : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithSplitStreamingMethod_Relay() {
+      ::grpc::Service::MarkMethodStreamed(7,
+        new ::grpc::internal::SplitServerStreamingHandler<
+          ::chat::ChatReader, ::chat::RelayBatch>(
+            [this](::grpc::ServerContext* context,
+                   ::grpc::ServerSplitStreamer<
+                     ::chat::ChatReader, ::chat::RelayBatch>* streamer) {
+                       return this->StreamedRelay(context,
+                         streamer);
+                  }));
+    }
+    ~WithSplitStreamingMethod_Relay() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status Relay(::grpc::ServerContext* /*context*/, const ::chat::ChatReader* /*request*/, ::grpc::ServerWriter< ::chat::RelayBatch>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with split streamed
+    virtual ::grpc::Status StreamedRelay(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::chat::ChatReader,::chat::RelayBatch>* server_split_streamer) = 0;
+  };
+  typedef WithSplitStreamingMethod_ReadChat<WithSplitStreamingMethod_ReadChatBatched<WithSplitStreamingMethod_Replicate<WithSplitStreamingMethod_HandOff<WithSplitStreamingMethod_Relay<Service > > > > > SplitStreamedService;
+  typedef WithStreamedUnaryMethod_Send<WithSplitStreamingMethod_ReadChat<WithSplitStreamingMethod_ReadChatBatched<WithSplitStreamingMethod_Replicate<WithSplitStreamingMethod_HandOff<WithSplitStreamingMethod_Relay<Service > > > > > > StreamedService;
 };
 
 }  // namespace chat
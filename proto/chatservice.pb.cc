@@ -46,192 +46,2733 @@ struct ResponseDefaultTypeInternal {
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
     PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ResponseDefaultTypeInternal _Response_default_instance_;
 
-inline constexpr ChatReader::Impl_::Impl_(
+inline constexpr SnapshotRoom::Impl_::Impl_(
     ::_pbi::ConstantInitialized) noexcept
       : name_(
             &::google::protobuf::internal::fixed_address_empty_string,
             ::_pbi::ConstantInitialized()),
+        first_{::uint64_t{0u}},
+        messages_{::uint64_t{0u}},
+        _cached_size_{0} {}
+
+template <typename>
+PROTOBUF_CONSTEXPR SnapshotRoom::SnapshotRoom(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct SnapshotRoomDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR SnapshotRoomDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~SnapshotRoomDefaultTypeInternal() {}
+  union {
+    SnapshotRoom _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 SnapshotRoomDefaultTypeInternal _SnapshotRoom_default_instance_;
+
+inline constexpr SnapshotHeader::Impl_::Impl_(
+    ::_pbi::ConstantInitialized) noexcept
+      : wal_generation_{::uint64_t{0u}},
+        rooms_{::uint64_t{0u}},
+        _cached_size_{0} {}
+
+template <typename>
+PROTOBUF_CONSTEXPR SnapshotHeader::SnapshotHeader(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct SnapshotHeaderDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR SnapshotHeaderDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~SnapshotHeaderDefaultTypeInternal() {}
+  union {
+    SnapshotHeader _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 SnapshotHeaderDefaultTypeInternal _SnapshotHeader_default_instance_;
+
+inline constexpr MessageTrace::Impl_::Impl_(
+    ::_pbi::ConstantInitialized) noexcept
+      : received_ns_{::uint64_t{0u}},
+        appended_ns_{::uint64_t{0u}},
+        picked_ns_{::uint64_t{0u}},
+        write_ns_{::uint64_t{0u}},
+        _cached_size_{0} {}
+
+template <typename>
+PROTOBUF_CONSTEXPR MessageTrace::MessageTrace(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct MessageTraceDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR MessageTraceDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~MessageTraceDefaultTypeInternal() {}
+  union {
+    MessageTrace _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 MessageTraceDefaultTypeInternal _MessageTrace_default_instance_;
+
+inline constexpr ChatMessage::Impl_::Impl_(
+    ::_pbi::ConstantInitialized) noexcept
+      : _cached_size_{0},
+        name_(
+            &::google::protobuf::internal::fixed_address_empty_string,
+            ::_pbi::ConstantInitialized()),
+        message_(
+            &::google::protobuf::internal::fixed_address_empty_string,
+            ::_pbi::ConstantInitialized()),
+        room_(
+            &::google::protobuf::internal::fixed_address_empty_string,
+            ::_pbi::ConstantInitialized()),
+        trace_{nullptr},
+        seq_{::uint64_t{0u}} {}
+
+template <typename>
+PROTOBUF_CONSTEXPR ChatMessage::ChatMessage(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct ChatMessageDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR ChatMessageDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~ChatMessageDefaultTypeInternal() {}
+  union {
+    ChatMessage _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ChatMessageDefaultTypeInternal _ChatMessage_default_instance_;
+
+inline constexpr RelayBatch::Impl_::Impl_(
+    ::_pbi::ConstantInitialized) noexcept
+      : messages_{},
+        end_{::uint64_t{0u}},
+        _cached_size_{0} {}
+
+template <typename>
+PROTOBUF_CONSTEXPR RelayBatch::RelayBatch(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct RelayBatchDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR RelayBatchDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~RelayBatchDefaultTypeInternal() {}
+  union {
+    RelayBatch _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 RelayBatchDefaultTypeInternal _RelayBatch_default_instance_;
+
+inline constexpr ReplicatedMessage::Impl_::Impl_(
+    ::_pbi::ConstantInitialized) noexcept
+      : _cached_size_{0},
+        message_{nullptr},
+        position_{::uint64_t{0u}} {}
+
+template <typename>
+PROTOBUF_CONSTEXPR ReplicatedMessage::ReplicatedMessage(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct ReplicatedMessageDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR ReplicatedMessageDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~ReplicatedMessageDefaultTypeInternal() {}
+  union {
+    ReplicatedMessage _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ReplicatedMessageDefaultTypeInternal _ReplicatedMessage_default_instance_;
+
+inline constexpr ReplicatedBatch::Impl_::Impl_(
+    ::_pbi::ConstantInitialized) noexcept
+      : messages_{},
+        end_{::uint64_t{0u}},
+        _cached_size_{0} {}
+
+template <typename>
+PROTOBUF_CONSTEXPR ReplicatedBatch::ReplicatedBatch(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct ReplicatedBatchDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR ReplicatedBatchDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~ReplicatedBatchDefaultTypeInternal() {}
+  union {
+    ReplicatedBatch _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ReplicatedBatchDefaultTypeInternal _ReplicatedBatch_default_instance_;
+
+inline constexpr ChatMessageBatch::Impl_::Impl_(
+    ::_pbi::ConstantInitialized) noexcept
+      : messages_{},
+        _cached_size_{0} {}
+
+template <typename>
+PROTOBUF_CONSTEXPR ChatMessageBatch::ChatMessageBatch(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct ChatMessageBatchDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR ChatMessageBatchDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~ChatMessageBatchDefaultTypeInternal() {}
+  union {
+    ChatMessageBatch _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ChatMessageBatchDefaultTypeInternal _ChatMessageBatch_default_instance_;
+
+inline constexpr ChatFilter::Impl_::Impl_(
+    ::_pbi::ConstantInitialized) noexcept
+      : include_names_{},
+        exclude_names_{},
+        prefix_(
+            &::google::protobuf::internal::fixed_address_empty_string,
+            ::_pbi::ConstantInitialized()),
+        keyword_(
+            &::google::protobuf::internal::fixed_address_empty_string,
+            ::_pbi::ConstantInitialized()),
+        system_only_{false},
         _cached_size_{0} {}
 
-template <typename>
-PROTOBUF_CONSTEXPR ChatReader::ChatReader(::_pbi::ConstantInitialized)
-    : _impl_(::_pbi::ConstantInitialized()) {}
-struct ChatReaderDefaultTypeInternal {
-  PROTOBUF_CONSTEXPR ChatReaderDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
-  ~ChatReaderDefaultTypeInternal() {}
-  union {
-    ChatReader _instance;
-  };
-};
+template <typename>
+PROTOBUF_CONSTEXPR ChatFilter::ChatFilter(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct ChatFilterDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR ChatFilterDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~ChatFilterDefaultTypeInternal() {}
+  union {
+    ChatFilter _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ChatFilterDefaultTypeInternal _ChatFilter_default_instance_;
+
+inline constexpr ChatReader::Impl_::Impl_(
+    ::_pbi::ConstantInitialized) noexcept
+      : _cached_size_{0},
+        name_(
+            &::google::protobuf::internal::fixed_address_empty_string,
+            ::_pbi::ConstantInitialized()),
+        room_(
+            &::google::protobuf::internal::fixed_address_empty_string,
+            ::_pbi::ConstantInitialized()),
+        filter_{nullptr},
+        max_batch_messages_{0u},
+        max_batch_bytes_{0u},
+        since_seq_{::uint64_t{0u}},
+        tail_n_{0u},
+        trace_{false} {}
+
+template <typename>
+PROTOBUF_CONSTEXPR ChatReader::ChatReader(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct ChatReaderDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR ChatReaderDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~ChatReaderDefaultTypeInternal() {}
+  union {
+    ChatReader _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ChatReaderDefaultTypeInternal _ChatReader_default_instance_;
+}  // namespace chat
+static constexpr const ::_pb::EnumDescriptor**
+    file_level_enum_descriptors_proto_2fchatservice_2eproto = nullptr;
+static constexpr const ::_pb::ServiceDescriptor**
+    file_level_service_descriptors_proto_2fchatservice_2eproto = nullptr;
+const ::uint32_t
+    TableStruct_proto_2fchatservice_2eproto::offsets[] ABSL_ATTRIBUTE_SECTION_VARIABLE(
+        protodesc_cold) = {
+        ~0u,  // no _has_bits_
+        PROTOBUF_FIELD_OFFSET(::chat::MessageTrace, _internal_metadata_),
+        ~0u,  // no _extensions_
+        ~0u,  // no _oneof_case_
+        ~0u,  // no _weak_field_map_
+        ~0u,  // no _inlined_string_donated_
+        ~0u,  // no _split_
+        ~0u,  // no sizeof(Split)
+        PROTOBUF_FIELD_OFFSET(::chat::MessageTrace, _impl_.received_ns_),
+        PROTOBUF_FIELD_OFFSET(::chat::MessageTrace, _impl_.appended_ns_),
+        PROTOBUF_FIELD_OFFSET(::chat::MessageTrace, _impl_.picked_ns_),
+        PROTOBUF_FIELD_OFFSET(::chat::MessageTrace, _impl_.write_ns_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatMessage, _impl_._has_bits_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatMessage, _internal_metadata_),
+        ~0u,  // no _extensions_
+        ~0u,  // no _oneof_case_
+        ~0u,  // no _weak_field_map_
+        ~0u,  // no _inlined_string_donated_
+        ~0u,  // no _split_
+        ~0u,  // no sizeof(Split)
+        PROTOBUF_FIELD_OFFSET(::chat::ChatMessage, _impl_.name_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatMessage, _impl_.message_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatMessage, _impl_.seq_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatMessage, _impl_.room_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatMessage, _impl_.trace_),
+        ~0u,
+        ~0u,
+        ~0u,
+        ~0u,
+        0,
+        ~0u,  // no _has_bits_
+        PROTOBUF_FIELD_OFFSET(::chat::ChatFilter, _internal_metadata_),
+        ~0u,  // no _extensions_
+        ~0u,  // no _oneof_case_
+        ~0u,  // no _weak_field_map_
+        ~0u,  // no _inlined_string_donated_
+        ~0u,  // no _split_
+        ~0u,  // no sizeof(Split)
+        PROTOBUF_FIELD_OFFSET(::chat::ChatFilter, _impl_.include_names_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatFilter, _impl_.exclude_names_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatFilter, _impl_.prefix_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatFilter, _impl_.keyword_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatFilter, _impl_.system_only_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatReader, _impl_._has_bits_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatReader, _internal_metadata_),
+        ~0u,  // no _extensions_
+        ~0u,  // no _oneof_case_
+        ~0u,  // no _weak_field_map_
+        ~0u,  // no _inlined_string_donated_
+        ~0u,  // no _split_
+        ~0u,  // no sizeof(Split)
+        PROTOBUF_FIELD_OFFSET(::chat::ChatReader, _impl_.name_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatReader, _impl_.max_batch_messages_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatReader, _impl_.max_batch_bytes_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatReader, _impl_.since_seq_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatReader, _impl_.tail_n_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatReader, _impl_.room_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatReader, _impl_.filter_),
+        PROTOBUF_FIELD_OFFSET(::chat::ChatReader, _impl_.trace_),
+        ~0u,
+        ~0u,
+        ~0u,
+        ~0u,
+        ~0u,
+        ~0u,
+        0,
+        ~0u,
+        ~0u,  // no _has_bits_
+        PROTOBUF_FIELD_OFFSET(::chat::ChatMessageBatch, _internal_metadata_),
+        ~0u,  // no _extensions_
+        ~0u,  // no _oneof_case_
+        ~0u,  // no _weak_field_map_
+        ~0u,  // no _inlined_string_donated_
+        ~0u,  // no _split_
+        ~0u,  // no sizeof(Split)
+        PROTOBUF_FIELD_OFFSET(::chat::ChatMessageBatch, _impl_.messages_),
+        PROTOBUF_FIELD_OFFSET(::chat::ReplicatedMessage, _impl_._has_bits_),
+        PROTOBUF_FIELD_OFFSET(::chat::ReplicatedMessage, _internal_metadata_),
+        ~0u,  // no _extensions_
+        ~0u,  // no _oneof_case_
+        ~0u,  // no _weak_field_map_
+        ~0u,  // no _inlined_string_donated_
+        ~0u,  // no _split_
+        ~0u,  // no sizeof(Split)
+        PROTOBUF_FIELD_OFFSET(::chat::ReplicatedMessage, _impl_.message_),
+        PROTOBUF_FIELD_OFFSET(::chat::ReplicatedMessage, _impl_.position_),
+        0,
+        ~0u,
+        ~0u,  // no _has_bits_
+        PROTOBUF_FIELD_OFFSET(::chat::ReplicatedBatch, _internal_metadata_),
+        ~0u,  // no _extensions_
+        ~0u,  // no _oneof_case_
+        ~0u,  // no _weak_field_map_
+        ~0u,  // no _inlined_string_donated_
+        ~0u,  // no _split_
+        ~0u,  // no sizeof(Split)
+        PROTOBUF_FIELD_OFFSET(::chat::ReplicatedBatch, _impl_.messages_),
+        PROTOBUF_FIELD_OFFSET(::chat::ReplicatedBatch, _impl_.end_),
+        ~0u,  // no _has_bits_
+        PROTOBUF_FIELD_OFFSET(::chat::RelayBatch, _internal_metadata_),
+        ~0u,  // no _extensions_
+        ~0u,  // no _oneof_case_
+        ~0u,  // no _weak_field_map_
+        ~0u,  // no _inlined_string_donated_
+        ~0u,  // no _split_
+        ~0u,  // no sizeof(Split)
+        PROTOBUF_FIELD_OFFSET(::chat::RelayBatch, _impl_.messages_),
+        PROTOBUF_FIELD_OFFSET(::chat::RelayBatch, _impl_.end_),
+        ~0u,  // no _has_bits_
+        PROTOBUF_FIELD_OFFSET(::chat::SnapshotHeader, _internal_metadata_),
+        ~0u,  // no _extensions_
+        ~0u,  // no _oneof_case_
+        ~0u,  // no _weak_field_map_
+        ~0u,  // no _inlined_string_donated_
+        ~0u,  // no _split_
+        ~0u,  // no sizeof(Split)
+        PROTOBUF_FIELD_OFFSET(::chat::SnapshotHeader, _impl_.wal_generation_),
+        PROTOBUF_FIELD_OFFSET(::chat::SnapshotHeader, _impl_.rooms_),
+        ~0u,  // no _has_bits_
+        PROTOBUF_FIELD_OFFSET(::chat::SnapshotRoom, _internal_metadata_),
+        ~0u,  // no _extensions_
+        ~0u,  // no _oneof_case_
+        ~0u,  // no _weak_field_map_
+        ~0u,  // no _inlined_string_donated_
+        ~0u,  // no _split_
+        ~0u,  // no sizeof(Split)
+        PROTOBUF_FIELD_OFFSET(::chat::SnapshotRoom, _impl_.name_),
+        PROTOBUF_FIELD_OFFSET(::chat::SnapshotRoom, _impl_.first_),
+        PROTOBUF_FIELD_OFFSET(::chat::SnapshotRoom, _impl_.messages_),
+        ~0u,  // no _has_bits_
+        PROTOBUF_FIELD_OFFSET(::chat::Response, _internal_metadata_),
+        ~0u,  // no _extensions_
+        ~0u,  // no _oneof_case_
+        ~0u,  // no _weak_field_map_
+        ~0u,  // no _inlined_string_donated_
+        ~0u,  // no _split_
+        ~0u,  // no sizeof(Split)
+        PROTOBUF_FIELD_OFFSET(::chat::Response, _impl_.result_),
+};
+
+static const ::_pbi::MigrationSchema
+    schemas[] ABSL_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
+        {0, -1, -1, sizeof(::chat::MessageTrace)},
+        {12, 25, -1, sizeof(::chat::ChatMessage)},
+        {30, -1, -1, sizeof(::chat::ChatFilter)},
+        {43, 59, -1, sizeof(::chat::ChatReader)},
+        {67, -1, -1, sizeof(::chat::ChatMessageBatch)},
+        {76, 86, -1, sizeof(::chat::ReplicatedMessage)},
+        {88, -1, -1, sizeof(::chat::ReplicatedBatch)},
+        {98, -1, -1, sizeof(::chat::RelayBatch)},
+        {108, -1, -1, sizeof(::chat::SnapshotHeader)},
+        {118, -1, -1, sizeof(::chat::SnapshotRoom)},
+        {129, -1, -1, sizeof(::chat::Response)},
+};
+static const ::_pb::Message* const file_default_instances[] = {
+    &::chat::_MessageTrace_default_instance_._instance,
+    &::chat::_ChatMessage_default_instance_._instance,
+    &::chat::_ChatFilter_default_instance_._instance,
+    &::chat::_ChatReader_default_instance_._instance,
+    &::chat::_ChatMessageBatch_default_instance_._instance,
+    &::chat::_ReplicatedMessage_default_instance_._instance,
+    &::chat::_ReplicatedBatch_default_instance_._instance,
+    &::chat::_RelayBatch_default_instance_._instance,
+    &::chat::_SnapshotHeader_default_instance_._instance,
+    &::chat::_SnapshotRoom_default_instance_._instance,
+    &::chat::_Response_default_instance_._instance,
+};
+const char descriptor_table_protodef_proto_2fchatservice_2eproto[] ABSL_ATTRIBUTE_SECTION_VARIABLE(
+    protodesc_cold) = {
+    "\n\027proto/chatservice.proto\022\004chat\"]\n\014Messa"
+    "geTrace\022\023\n\013received_ns\030\001 \001(\004\022\023\n\013appended"
+    "_ns\030\002 \001(\004\022\021\n\tpicked_ns\030\003 \001(\004\022\020\n\010write_ns"
+    "\030\004 \001(\004\"j\n\013ChatMessage\022\014\n\004name\030\001 \001(\t\022\017\n\007m"
+    "essage\030\002 \001(\t\022\013\n\003seq\030\003 \001(\004\022\014\n\004room\030\004 \001(\t\022"
+    "!\n\005trace\030\005 \001(\0132\022.chat.MessageTrace\"p\n\nCh"
+    "atFilter\022\025\n\rinclude_names\030\001 \003(\t\022\025\n\rexclu"
+    "de_names\030\002 \003(\t\022\016\n\006prefix\030\003 \001(\t\022\017\n\007keywor"
+    "d\030\004 \001(\t\022\023\n\013system_only\030\005 \001(\010\"\261\001\n\nChatRea"
+    "der\022\014\n\004name\030\001 \001(\t\022\032\n\022max_batch_messages\030"
+    "\002 \001(\r\022\027\n\017max_batch_bytes\030\003 \001(\r\022\021\n\tsince_"
+    "seq\030\004 \001(\004\022\016\n\006tail_n\030\005 \001(\r\022\014\n\004room\030\006 \001(\t\022"
+    " \n\006filter\030\007 \001(\0132\020.chat.ChatFilter\022\r\n\005tra"
+    "ce\030\010 \001(\010\"7\n\020ChatMessageBatch\022#\n\010messages"
+    "\030\001 \003(\0132\021.chat.ChatMessage\"I\n\021ReplicatedM"
+    "essage\022\"\n\007message\030\001 \001(\0132\021.chat.ChatMessa"
+    "ge\022\020\n\010position\030\003 \001(\004\"I\n\017ReplicatedBatch\022"
+    ")\n\010messages\030\001 \003(\0132\027.chat.ReplicatedMessa"
+    "ge\022\013\n\003end\030\002 \001(\004\">\n\nRelayBatch\022#\n\010message"
+    "s\030\001 \003(\0132\021.chat.ChatMessage\022\013\n\003end\030\002 \001(\004\""
+    "7\n\016SnapshotHeader\022\026\n\016wal_generation\030\001 \001("
+    "\004\022\r\n\005rooms\030\002 \001(\004\"=\n\014SnapshotRoom\022\014\n\004name"
+    "\030\001 \001(\t\022\r\n\005first\030\002 \001(\004\022\020\n\010messages\030\003 \001(\004\""
+    "\032\n\010Response\022\016\n\006result\030\001 \001(\t2\275\003\n\013ChatServ"
+    "ice\022+\n\004Send\022\021.chat.ChatMessage\032\016.chat.Re"
+    "sponse\"\000\0223\n\nSendStream\022\021.chat.ChatMessag"
+    "e\032\016.chat.Response\"\000(\001\0223\n\010ReadChat\022\020.chat"
+    ".ChatReader\032\021.chat.ChatMessage\"\0000\001\022?\n\017Re"
+    "adChatBatched\022\020.chat.ChatReader\032\026.chat.C"
+    "hatMessageBatch\"\0000\001\0222\n\004Chat\022\021.chat.ChatM"
+    "essage\032\021.chat.ChatMessage\"\000(\0010\001\0228\n\tRepli"
+    "cate\022\020.chat.ChatReader\032\025.chat.Replicated"
+    "Batch\"\0000\001\0227\n\007HandOff\022\020.chat.ChatReader\032\026"
+    ".chat.ChatMessageBatch\"\0000\001\022/\n\005Relay\022\020.ch"
+    "at.ChatReader\032\020.chat.RelayBatch\"\0000\001b\006pro"
+    "to3"
+};
+static ::absl::once_flag descriptor_table_proto_2fchatservice_2eproto_once;
+PROTOBUF_CONSTINIT const ::_pbi::DescriptorTable descriptor_table_proto_2fchatservice_2eproto = {
+    false,
+    false,
+    1403,
+    descriptor_table_protodef_proto_2fchatservice_2eproto,
+    "proto/chatservice.proto",
+    &descriptor_table_proto_2fchatservice_2eproto_once,
+    nullptr,
+    0,
+    11,
+    schemas,
+    file_default_instances,
+    TableStruct_proto_2fchatservice_2eproto::offsets,
+    file_level_enum_descriptors_proto_2fchatservice_2eproto,
+    file_level_service_descriptors_proto_2fchatservice_2eproto,
+};
+namespace chat {
+// ===================================================================
+
+class MessageTrace::_Internal {
+ public:
+};
+
+MessageTrace::MessageTrace(::google::protobuf::Arena* arena)
+    : ::google::protobuf::Message(arena) {
+  SharedCtor(arena);
+  // @@protoc_insertion_point(arena_constructor:chat.MessageTrace)
+}
+inline PROTOBUF_NDEBUG_INLINE MessageTrace::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
+    const Impl_& from, const ::chat::MessageTrace& from_msg)
+      : _cached_size_{0} {}
+
+MessageTrace::MessageTrace(
+    ::google::protobuf::Arena* arena,
+    const MessageTrace& from)
+    : ::google::protobuf::Message(arena) {
+  MessageTrace* const _this = this;
+  (void)_this;
+  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
+      from._internal_metadata_);
+  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
+  ::memcpy(reinterpret_cast<char *>(&_impl_) +
+               offsetof(Impl_, received_ns_),
+           reinterpret_cast<const char *>(&from._impl_) +
+               offsetof(Impl_, received_ns_),
+           offsetof(Impl_, write_ns_) -
+               offsetof(Impl_, received_ns_) +
+               sizeof(Impl_::write_ns_));
+
+  // @@protoc_insertion_point(copy_constructor:chat.MessageTrace)
+}
+inline PROTOBUF_NDEBUG_INLINE MessageTrace::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility,
+    ::google::protobuf::Arena* arena)
+      : _cached_size_{0} {}
+
+inline void MessageTrace::SharedCtor(::_pb::Arena* arena) {
+  new (&_impl_) Impl_(internal_visibility(), arena);
+  ::memset(reinterpret_cast<char *>(&_impl_) +
+               offsetof(Impl_, received_ns_),
+           0,
+           offsetof(Impl_, write_ns_) -
+               offsetof(Impl_, received_ns_) +
+               sizeof(Impl_::write_ns_));
+}
+MessageTrace::~MessageTrace() {
+  // @@protoc_insertion_point(destructor:chat.MessageTrace)
+  _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
+  SharedDtor();
+}
+inline void MessageTrace::SharedDtor() {
+  ABSL_DCHECK(GetArena() == nullptr);
+  _impl_.~Impl_();
+}
+
+const ::google::protobuf::MessageLite::ClassData*
+MessageTrace::GetClassData() const {
+  PROTOBUF_CONSTINIT static const ::google::protobuf::MessageLite::
+      ClassDataFull _data_ = {
+          {
+              &_table_.header,
+              nullptr,  // OnDemandRegisterArenaDtor
+              nullptr,  // IsInitialized
+              PROTOBUF_FIELD_OFFSET(MessageTrace, _impl_._cached_size_),
+              false,
+          },
+          &MessageTrace::MergeImpl,
+          &MessageTrace::kDescriptorMethods,
+          &descriptor_table_proto_2fchatservice_2eproto,
+          nullptr,  // tracker
+      };
+  ::google::protobuf::internal::PrefetchToLocalCache(&_data_);
+  ::google::protobuf::internal::PrefetchToLocalCache(_data_.tc_table);
+  return _data_.base();
+}
+PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
+const ::_pbi::TcParseTable<2, 4, 0, 0, 2> MessageTrace::_table_ = {
+  {
+    0,  // no _has_bits_
+    0, // no _extensions_
+    4, 24,  // max_field_number, fast_idx_mask
+    offsetof(decltype(_table_), field_lookup_table),
+    4294967280,  // skipmap
+    offsetof(decltype(_table_), field_entries),
+    4,  // num_field_entries
+    0,  // num_aux_entries
+    offsetof(decltype(_table_), field_names),  // no aux_entries
+    &_MessageTrace_default_instance_._instance,
+    nullptr,  // post_loop_handler
+    ::_pbi::TcParser::GenericFallback,  // fallback
+    #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
+    ::_pbi::TcParser::GetTable<::chat::MessageTrace>(),  // to_prefetch
+    #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
+  }, {{
+    // uint64 write_ns = 4;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(MessageTrace, _impl_.write_ns_), 63>(),
+     {32, 63, 0, PROTOBUF_FIELD_OFFSET(MessageTrace, _impl_.write_ns_)}},
+    // uint64 received_ns = 1;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(MessageTrace, _impl_.received_ns_), 63>(),
+     {8, 63, 0, PROTOBUF_FIELD_OFFSET(MessageTrace, _impl_.received_ns_)}},
+    // uint64 appended_ns = 2;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(MessageTrace, _impl_.appended_ns_), 63>(),
+     {16, 63, 0, PROTOBUF_FIELD_OFFSET(MessageTrace, _impl_.appended_ns_)}},
+    // uint64 picked_ns = 3;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(MessageTrace, _impl_.picked_ns_), 63>(),
+     {24, 63, 0, PROTOBUF_FIELD_OFFSET(MessageTrace, _impl_.picked_ns_)}},
+  }}, {{
+    65535, 65535
+  }}, {{
+    // uint64 received_ns = 1;
+    {PROTOBUF_FIELD_OFFSET(MessageTrace, _impl_.received_ns_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
+    // uint64 appended_ns = 2;
+    {PROTOBUF_FIELD_OFFSET(MessageTrace, _impl_.appended_ns_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
+    // uint64 picked_ns = 3;
+    {PROTOBUF_FIELD_OFFSET(MessageTrace, _impl_.picked_ns_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
+    // uint64 write_ns = 4;
+    {PROTOBUF_FIELD_OFFSET(MessageTrace, _impl_.write_ns_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
+  }},
+  // no aux_entries
+  {{
+  }},
+};
+
+PROTOBUF_NOINLINE void MessageTrace::Clear() {
+// @@protoc_insertion_point(message_clear_start:chat.MessageTrace)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::memset(&_impl_.received_ns_, 0, static_cast<::size_t>(
+      reinterpret_cast<char*>(&_impl_.write_ns_) -
+      reinterpret_cast<char*>(&_impl_.received_ns_)) + sizeof(_impl_.write_ns_));
+  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
+}
+
+::uint8_t* MessageTrace::_InternalSerialize(
+    ::uint8_t* target,
+    ::google::protobuf::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:chat.MessageTrace)
+  ::uint32_t cached_has_bits = 0;
+  (void)cached_has_bits;
+
+  // uint64 received_ns = 1;
+  if (this->_internal_received_ns() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        1, this->_internal_received_ns(), target);
+  }
+
+  // uint64 appended_ns = 2;
+  if (this->_internal_appended_ns() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        2, this->_internal_appended_ns(), target);
+  }
+
+  // uint64 picked_ns = 3;
+  if (this->_internal_picked_ns() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        3, this->_internal_picked_ns(), target);
+  }
+
+  // uint64 write_ns = 4;
+  if (this->_internal_write_ns() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        4, this->_internal_write_ns(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target =
+        ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+            _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:chat.MessageTrace)
+  return target;
+}
+
+::size_t MessageTrace::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:chat.MessageTrace)
+  ::size_t total_size = 0;
+
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::_pbi::Prefetch5LinesFrom7Lines(reinterpret_cast<const void*>(this));
+  // uint64 received_ns = 1;
+  if (this->_internal_received_ns() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_received_ns());
+  }
+
+  // uint64 appended_ns = 2;
+  if (this->_internal_appended_ns() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_appended_ns());
+  }
+
+  // uint64 picked_ns = 3;
+  if (this->_internal_picked_ns() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_picked_ns());
+  }
+
+  // uint64 write_ns = 4;
+  if (this->_internal_write_ns() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_write_ns());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+
+void MessageTrace::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
+  auto* const _this = static_cast<MessageTrace*>(&to_msg);
+  auto& from = static_cast<const MessageTrace&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:chat.MessageTrace)
+  ABSL_DCHECK_NE(&from, _this);
+  ::uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from._internal_received_ns() != 0) {
+    _this->_impl_.received_ns_ = from._impl_.received_ns_;
+  }
+  if (from._internal_appended_ns() != 0) {
+    _this->_impl_.appended_ns_ = from._impl_.appended_ns_;
+  }
+  if (from._internal_picked_ns() != 0) {
+    _this->_impl_.picked_ns_ = from._impl_.picked_ns_;
+  }
+  if (from._internal_write_ns() != 0) {
+    _this->_impl_.write_ns_ = from._impl_.write_ns_;
+  }
+  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void MessageTrace::CopyFrom(const MessageTrace& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:chat.MessageTrace)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+
+void MessageTrace::InternalSwap(MessageTrace* PROTOBUF_RESTRICT other) {
+  using std::swap;
+  auto* arena = GetArena();
+  ABSL_DCHECK_EQ(arena, other->GetArena());
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  ::google::protobuf::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(MessageTrace, _impl_.write_ns_)
+      + sizeof(MessageTrace::_impl_.write_ns_)
+      - PROTOBUF_FIELD_OFFSET(MessageTrace, _impl_.received_ns_)>(
+          reinterpret_cast<char*>(&_impl_.received_ns_),
+          reinterpret_cast<char*>(&other->_impl_.received_ns_));
+}
+
+::google::protobuf::Metadata MessageTrace::GetMetadata() const {
+  return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
+}
+// ===================================================================
+
+class ChatMessage::_Internal {
+ public:
+  using HasBits =
+      decltype(std::declval<ChatMessage>()._impl_._has_bits_);
+  static constexpr ::int32_t kHasBitsOffset =
+      8 * PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_._has_bits_);
+};
+
+ChatMessage::ChatMessage(::google::protobuf::Arena* arena)
+    : ::google::protobuf::Message(arena) {
+  SharedCtor(arena);
+  // @@protoc_insertion_point(arena_constructor:chat.ChatMessage)
+}
+inline PROTOBUF_NDEBUG_INLINE ChatMessage::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
+    const Impl_& from, const ::chat::ChatMessage& from_msg)
+      : _has_bits_{from._has_bits_},
+        _cached_size_{0},
+        name_(arena, from.name_),
+        message_(arena, from.message_),
+        room_(arena, from.room_) {}
+
+ChatMessage::ChatMessage(
+    ::google::protobuf::Arena* arena,
+    const ChatMessage& from)
+    : ::google::protobuf::Message(arena) {
+  ChatMessage* const _this = this;
+  (void)_this;
+  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
+      from._internal_metadata_);
+  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
+  ::uint32_t cached_has_bits = _impl_._has_bits_[0];
+  _impl_.trace_ = (cached_has_bits & 0x00000001u) ? ::google::protobuf::Message::CopyConstruct<::chat::MessageTrace>(
+                              arena, *from._impl_.trace_)
+                        : nullptr;
+  _impl_.seq_ = from._impl_.seq_;
+
+  // @@protoc_insertion_point(copy_constructor:chat.ChatMessage)
+}
+inline PROTOBUF_NDEBUG_INLINE ChatMessage::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility,
+    ::google::protobuf::Arena* arena)
+      : _cached_size_{0},
+        name_(arena),
+        message_(arena),
+        room_(arena) {}
+
+inline void ChatMessage::SharedCtor(::_pb::Arena* arena) {
+  new (&_impl_) Impl_(internal_visibility(), arena);
+  ::memset(reinterpret_cast<char *>(&_impl_) +
+               offsetof(Impl_, trace_),
+           0,
+           offsetof(Impl_, seq_) -
+               offsetof(Impl_, trace_) +
+               sizeof(Impl_::seq_));
+}
+ChatMessage::~ChatMessage() {
+  // @@protoc_insertion_point(destructor:chat.ChatMessage)
+  _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
+  SharedDtor();
+}
+inline void ChatMessage::SharedDtor() {
+  ABSL_DCHECK(GetArena() == nullptr);
+  _impl_.name_.Destroy();
+  _impl_.message_.Destroy();
+  _impl_.room_.Destroy();
+  delete _impl_.trace_;
+  _impl_.~Impl_();
+}
+
+const ::google::protobuf::MessageLite::ClassData*
+ChatMessage::GetClassData() const {
+  PROTOBUF_CONSTINIT static const ::google::protobuf::MessageLite::
+      ClassDataFull _data_ = {
+          {
+              &_table_.header,
+              nullptr,  // OnDemandRegisterArenaDtor
+              nullptr,  // IsInitialized
+              PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_._cached_size_),
+              false,
+          },
+          &ChatMessage::MergeImpl,
+          &ChatMessage::kDescriptorMethods,
+          &descriptor_table_proto_2fchatservice_2eproto,
+          nullptr,  // tracker
+      };
+  ::google::protobuf::internal::PrefetchToLocalCache(&_data_);
+  ::google::protobuf::internal::PrefetchToLocalCache(_data_.tc_table);
+  return _data_.base();
+}
+PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
+const ::_pbi::TcParseTable<3, 5, 1, 40, 2> ChatMessage::_table_ = {
+  {
+    PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_._has_bits_),
+    0, // no _extensions_
+    5, 56,  // max_field_number, fast_idx_mask
+    offsetof(decltype(_table_), field_lookup_table),
+    4294967264,  // skipmap
+    offsetof(decltype(_table_), field_entries),
+    5,  // num_field_entries
+    1,  // num_aux_entries
+    offsetof(decltype(_table_), aux_entries),
+    &_ChatMessage_default_instance_._instance,
+    nullptr,  // post_loop_handler
+    ::_pbi::TcParser::GenericFallback,  // fallback
+    #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
+    ::_pbi::TcParser::GetTable<::chat::ChatMessage>(),  // to_prefetch
+    #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
+  }, {{
+    {::_pbi::TcParser::MiniParse, {}},
+    // string name = 1;
+    {::_pbi::TcParser::FastUS1,
+     {10, 63, 0, PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.name_)}},
+    // string message = 2;
+    {::_pbi::TcParser::FastUS1,
+     {18, 63, 0, PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.message_)}},
+    // uint64 seq = 3;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(ChatMessage, _impl_.seq_), 63>(),
+     {24, 63, 0, PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.seq_)}},
+    // string room = 4;
+    {::_pbi::TcParser::FastUS1,
+     {34, 63, 0, PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.room_)}},
+    // .chat.MessageTrace trace = 5;
+    {::_pbi::TcParser::FastMtS1,
+     {42, 0, 0, PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.trace_)}},
+    {::_pbi::TcParser::MiniParse, {}},
+    {::_pbi::TcParser::MiniParse, {}},
+  }}, {{
+    65535, 65535
+  }}, {{
+    // string name = 1;
+    {PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.name_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUtf8String | ::_fl::kRepAString)},
+    // string message = 2;
+    {PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.message_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUtf8String | ::_fl::kRepAString)},
+    // uint64 seq = 3;
+    {PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.seq_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
+    // string room = 4;
+    {PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.room_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUtf8String | ::_fl::kRepAString)},
+    // .chat.MessageTrace trace = 5;
+    {PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.trace_), _Internal::kHasBitsOffset + 0, 0,
+    (0 | ::_fl::kFcOptional | ::_fl::kMessage | ::_fl::kTvTable)},
+  }}, {{
+    {::_pbi::TcParser::GetTable<::chat::MessageTrace>()},
+  }}, {{
+    "\20\4\7\0\4\0\0\0"
+    "chat.ChatMessage"
+    "name"
+    "message"
+    "room"
+  }},
+};
+
+PROTOBUF_NOINLINE void ChatMessage::Clear() {
+// @@protoc_insertion_point(message_clear_start:chat.ChatMessage)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.name_.ClearToEmpty();
+  _impl_.message_.ClearToEmpty();
+  _impl_.room_.ClearToEmpty();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    ABSL_DCHECK(_impl_.trace_ != nullptr);
+    _impl_.trace_->Clear();
+  }
+  _impl_.seq_ = ::uint64_t{0u};
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
+}
+
+::uint8_t* ChatMessage::_InternalSerialize(
+    ::uint8_t* target,
+    ::google::protobuf::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:chat.ChatMessage)
+  ::uint32_t cached_has_bits = 0;
+  (void)cached_has_bits;
+
+  // string name = 1;
+  if (!this->_internal_name().empty()) {
+    const std::string& _s = this->_internal_name();
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+        _s.data(), static_cast<int>(_s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.ChatMessage.name");
+    target = stream->WriteStringMaybeAliased(1, _s, target);
+  }
+
+  // string message = 2;
+  if (!this->_internal_message().empty()) {
+    const std::string& _s = this->_internal_message();
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+        _s.data(), static_cast<int>(_s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.ChatMessage.message");
+    target = stream->WriteStringMaybeAliased(2, _s, target);
+  }
+
+  // uint64 seq = 3;
+  if (this->_internal_seq() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        3, this->_internal_seq(), target);
+  }
+
+  // string room = 4;
+  if (!this->_internal_room().empty()) {
+    const std::string& _s = this->_internal_room();
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+        _s.data(), static_cast<int>(_s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.ChatMessage.room");
+    target = stream->WriteStringMaybeAliased(4, _s, target);
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // .chat.MessageTrace trace = 5;
+  if (cached_has_bits & 0x00000001u) {
+    target = ::google::protobuf::internal::WireFormatLite::InternalWriteMessage(
+        5, *_impl_.trace_, _impl_.trace_->GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target =
+        ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+            _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:chat.ChatMessage)
+  return target;
+}
+
+::size_t ChatMessage::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:chat.ChatMessage)
+  ::size_t total_size = 0;
+
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::_pbi::Prefetch5LinesFrom7Lines(reinterpret_cast<const void*>(this));
+  // string name = 1;
+  if (!this->_internal_name().empty()) {
+    total_size += 1 + ::google::protobuf::internal::WireFormatLite::StringSize(
+                                    this->_internal_name());
+  }
+
+  // string message = 2;
+  if (!this->_internal_message().empty()) {
+    total_size += 1 + ::google::protobuf::internal::WireFormatLite::StringSize(
+                                    this->_internal_message());
+  }
+
+  // string room = 4;
+  if (!this->_internal_room().empty()) {
+    total_size += 1 + ::google::protobuf::internal::WireFormatLite::StringSize(
+                                    this->_internal_room());
+  }
+
+  // .chat.MessageTrace trace = 5;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    total_size +=
+        1 + ::google::protobuf::internal::WireFormatLite::MessageSize(*_impl_.trace_);
+  }
+
+  // uint64 seq = 3;
+  if (this->_internal_seq() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_seq());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+
+void ChatMessage::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
+  auto* const _this = static_cast<ChatMessage*>(&to_msg);
+  auto& from = static_cast<const ChatMessage&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:chat.ChatMessage)
+  ::google::protobuf::Arena* arena = _this->GetArena();
+  ABSL_DCHECK_NE(&from, _this);
+  ::uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (!from._internal_name().empty()) {
+    _this->_internal_set_name(from._internal_name());
+  }
+  if (!from._internal_message().empty()) {
+    _this->_internal_set_message(from._internal_message());
+  }
+  if (!from._internal_room().empty()) {
+    _this->_internal_set_room(from._internal_room());
+  }
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    ABSL_DCHECK(from._impl_.trace_ != nullptr);
+    if (_this->_impl_.trace_ == nullptr) {
+      _this->_impl_.trace_ =
+          ::google::protobuf::Message::CopyConstruct<::chat::MessageTrace>(arena, *from._impl_.trace_);
+    } else {
+      _this->_impl_.trace_->MergeFrom(*from._impl_.trace_);
+    }
+  }
+  if (from._internal_seq() != 0) {
+    _this->_impl_.seq_ = from._impl_.seq_;
+  }
+  _this->_impl_._has_bits_[0] |= cached_has_bits;
+  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void ChatMessage::CopyFrom(const ChatMessage& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:chat.ChatMessage)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+
+void ChatMessage::InternalSwap(ChatMessage* PROTOBUF_RESTRICT other) {
+  using std::swap;
+  auto* arena = GetArena();
+  ABSL_DCHECK_EQ(arena, other->GetArena());
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.name_, &other->_impl_.name_, arena);
+  ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.message_, &other->_impl_.message_, arena);
+  ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.room_, &other->_impl_.room_, arena);
+  ::google::protobuf::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.seq_)
+      + sizeof(ChatMessage::_impl_.seq_)
+      - PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.trace_)>(
+          reinterpret_cast<char*>(&_impl_.trace_),
+          reinterpret_cast<char*>(&other->_impl_.trace_));
+}
+
+::google::protobuf::Metadata ChatMessage::GetMetadata() const {
+  return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
+}
+// ===================================================================
+
+class ChatFilter::_Internal {
+ public:
+};
+
+ChatFilter::ChatFilter(::google::protobuf::Arena* arena)
+    : ::google::protobuf::Message(arena) {
+  SharedCtor(arena);
+  // @@protoc_insertion_point(arena_constructor:chat.ChatFilter)
+}
+inline PROTOBUF_NDEBUG_INLINE ChatFilter::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
+    const Impl_& from, const ::chat::ChatFilter& from_msg)
+      : include_names_{visibility, arena, from.include_names_},
+        exclude_names_{visibility, arena, from.exclude_names_},
+        prefix_(arena, from.prefix_),
+        keyword_(arena, from.keyword_),
+        _cached_size_{0} {}
+
+ChatFilter::ChatFilter(
+    ::google::protobuf::Arena* arena,
+    const ChatFilter& from)
+    : ::google::protobuf::Message(arena) {
+  ChatFilter* const _this = this;
+  (void)_this;
+  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
+      from._internal_metadata_);
+  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
+  _impl_.system_only_ = from._impl_.system_only_;
+
+  // @@protoc_insertion_point(copy_constructor:chat.ChatFilter)
+}
+inline PROTOBUF_NDEBUG_INLINE ChatFilter::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility,
+    ::google::protobuf::Arena* arena)
+      : include_names_{visibility, arena},
+        exclude_names_{visibility, arena},
+        prefix_(arena),
+        keyword_(arena),
+        _cached_size_{0} {}
+
+inline void ChatFilter::SharedCtor(::_pb::Arena* arena) {
+  new (&_impl_) Impl_(internal_visibility(), arena);
+  _impl_.system_only_ = {};
+}
+ChatFilter::~ChatFilter() {
+  // @@protoc_insertion_point(destructor:chat.ChatFilter)
+  _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
+  SharedDtor();
+}
+inline void ChatFilter::SharedDtor() {
+  ABSL_DCHECK(GetArena() == nullptr);
+  _impl_.prefix_.Destroy();
+  _impl_.keyword_.Destroy();
+  _impl_.~Impl_();
+}
+
+const ::google::protobuf::MessageLite::ClassData*
+ChatFilter::GetClassData() const {
+  PROTOBUF_CONSTINIT static const ::google::protobuf::MessageLite::
+      ClassDataFull _data_ = {
+          {
+              &_table_.header,
+              nullptr,  // OnDemandRegisterArenaDtor
+              nullptr,  // IsInitialized
+              PROTOBUF_FIELD_OFFSET(ChatFilter, _impl_._cached_size_),
+              false,
+          },
+          &ChatFilter::MergeImpl,
+          &ChatFilter::kDescriptorMethods,
+          &descriptor_table_proto_2fchatservice_2eproto,
+          nullptr,  // tracker
+      };
+  ::google::protobuf::internal::PrefetchToLocalCache(&_data_);
+  ::google::protobuf::internal::PrefetchToLocalCache(_data_.tc_table);
+  return _data_.base();
+}
+PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
+const ::_pbi::TcParseTable<3, 5, 0, 64, 2> ChatFilter::_table_ = {
+  {
+    0,  // no _has_bits_
+    0, // no _extensions_
+    5, 56,  // max_field_number, fast_idx_mask
+    offsetof(decltype(_table_), field_lookup_table),
+    4294967264,  // skipmap
+    offsetof(decltype(_table_), field_entries),
+    5,  // num_field_entries
+    0,  // num_aux_entries
+    offsetof(decltype(_table_), field_names),  // no aux_entries
+    &_ChatFilter_default_instance_._instance,
+    nullptr,  // post_loop_handler
+    ::_pbi::TcParser::GenericFallback,  // fallback
+    #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
+    ::_pbi::TcParser::GetTable<::chat::ChatFilter>(),  // to_prefetch
+    #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
+  }, {{
+    {::_pbi::TcParser::MiniParse, {}},
+    // repeated string include_names = 1;
+    {::_pbi::TcParser::FastUR1,
+     {10, 63, 0, PROTOBUF_FIELD_OFFSET(ChatFilter, _impl_.include_names_)}},
+    // repeated string exclude_names = 2;
+    {::_pbi::TcParser::FastUR1,
+     {18, 63, 0, PROTOBUF_FIELD_OFFSET(ChatFilter, _impl_.exclude_names_)}},
+    // string prefix = 3;
+    {::_pbi::TcParser::FastUS1,
+     {26, 63, 0, PROTOBUF_FIELD_OFFSET(ChatFilter, _impl_.prefix_)}},
+    // string keyword = 4;
+    {::_pbi::TcParser::FastUS1,
+     {34, 63, 0, PROTOBUF_FIELD_OFFSET(ChatFilter, _impl_.keyword_)}},
+    // bool system_only = 5;
+    {::_pbi::TcParser::SingularVarintNoZag1<bool, offsetof(ChatFilter, _impl_.system_only_), 63>(),
+     {40, 63, 0, PROTOBUF_FIELD_OFFSET(ChatFilter, _impl_.system_only_)}},
+    {::_pbi::TcParser::MiniParse, {}},
+    {::_pbi::TcParser::MiniParse, {}},
+  }}, {{
+    65535, 65535
+  }}, {{
+    // repeated string include_names = 1;
+    {PROTOBUF_FIELD_OFFSET(ChatFilter, _impl_.include_names_), 0, 0,
+    (0 | ::_fl::kFcRepeated | ::_fl::kUtf8String | ::_fl::kRepSString)},
+    // repeated string exclude_names = 2;
+    {PROTOBUF_FIELD_OFFSET(ChatFilter, _impl_.exclude_names_), 0, 0,
+    (0 | ::_fl::kFcRepeated | ::_fl::kUtf8String | ::_fl::kRepSString)},
+    // string prefix = 3;
+    {PROTOBUF_FIELD_OFFSET(ChatFilter, _impl_.prefix_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUtf8String | ::_fl::kRepAString)},
+    // string keyword = 4;
+    {PROTOBUF_FIELD_OFFSET(ChatFilter, _impl_.keyword_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUtf8String | ::_fl::kRepAString)},
+    // bool system_only = 5;
+    {PROTOBUF_FIELD_OFFSET(ChatFilter, _impl_.system_only_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kBool)},
+  }},
+  // no aux_entries
+  {{
+    "\17\15\15\6\7\0\0\0"
+    "chat.ChatFilter"
+    "include_names"
+    "exclude_names"
+    "prefix"
+    "keyword"
+  }},
+};
+
+PROTOBUF_NOINLINE void ChatFilter::Clear() {
+// @@protoc_insertion_point(message_clear_start:chat.ChatFilter)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.include_names_.Clear();
+  _impl_.exclude_names_.Clear();
+  _impl_.prefix_.ClearToEmpty();
+  _impl_.keyword_.ClearToEmpty();
+  _impl_.system_only_ = false;
+  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
+}
+
+::uint8_t* ChatFilter::_InternalSerialize(
+    ::uint8_t* target,
+    ::google::protobuf::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:chat.ChatFilter)
+  ::uint32_t cached_has_bits = 0;
+  (void)cached_has_bits;
+
+  // repeated string include_names = 1;
+  for (int i = 0, n = this->_internal_include_names_size(); i < n; ++i) {
+    const auto& s = this->_internal_include_names().Get(i);
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+        s.data(), static_cast<int>(s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.ChatFilter.include_names");
+    target = stream->WriteString(1, s, target);
+  }
+
+  // repeated string exclude_names = 2;
+  for (int i = 0, n = this->_internal_exclude_names_size(); i < n; ++i) {
+    const auto& s = this->_internal_exclude_names().Get(i);
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+        s.data(), static_cast<int>(s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.ChatFilter.exclude_names");
+    target = stream->WriteString(2, s, target);
+  }
+
+  // string prefix = 3;
+  if (!this->_internal_prefix().empty()) {
+    const std::string& _s = this->_internal_prefix();
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+        _s.data(), static_cast<int>(_s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.ChatFilter.prefix");
+    target = stream->WriteStringMaybeAliased(3, _s, target);
+  }
+
+  // string keyword = 4;
+  if (!this->_internal_keyword().empty()) {
+    const std::string& _s = this->_internal_keyword();
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+        _s.data(), static_cast<int>(_s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.ChatFilter.keyword");
+    target = stream->WriteStringMaybeAliased(4, _s, target);
+  }
+
+  // bool system_only = 5;
+  if (this->_internal_system_only() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(
+        5, this->_internal_system_only(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target =
+        ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+            _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:chat.ChatFilter)
+  return target;
+}
+
+::size_t ChatFilter::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:chat.ChatFilter)
+  ::size_t total_size = 0;
+
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::_pbi::Prefetch5LinesFrom7Lines(reinterpret_cast<const void*>(this));
+  // repeated string include_names = 1;
+  total_size += 1 * ::google::protobuf::internal::FromIntSize(_internal_include_names().size());
+  for (int i = 0, n = _internal_include_names().size(); i < n; ++i) {
+    total_size += ::google::protobuf::internal::WireFormatLite::StringSize(
+        _internal_include_names().Get(i));
+  }
+
+  // repeated string exclude_names = 2;
+  total_size += 1 * ::google::protobuf::internal::FromIntSize(_internal_exclude_names().size());
+  for (int i = 0, n = _internal_exclude_names().size(); i < n; ++i) {
+    total_size += ::google::protobuf::internal::WireFormatLite::StringSize(
+        _internal_exclude_names().Get(i));
+  }
+
+  // string prefix = 3;
+  if (!this->_internal_prefix().empty()) {
+    total_size += 1 + ::google::protobuf::internal::WireFormatLite::StringSize(
+                                    this->_internal_prefix());
+  }
+
+  // string keyword = 4;
+  if (!this->_internal_keyword().empty()) {
+    total_size += 1 + ::google::protobuf::internal::WireFormatLite::StringSize(
+                                    this->_internal_keyword());
+  }
+
+  // bool system_only = 5;
+  if (this->_internal_system_only() != 0) {
+    total_size += 2;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+
+void ChatFilter::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
+  auto* const _this = static_cast<ChatFilter*>(&to_msg);
+  auto& from = static_cast<const ChatFilter&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:chat.ChatFilter)
+  ABSL_DCHECK_NE(&from, _this);
+  ::uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_internal_mutable_include_names()->MergeFrom(
+      from._internal_include_names());
+  _this->_internal_mutable_exclude_names()->MergeFrom(
+      from._internal_exclude_names());
+  if (!from._internal_prefix().empty()) {
+    _this->_internal_set_prefix(from._internal_prefix());
+  }
+  if (!from._internal_keyword().empty()) {
+    _this->_internal_set_keyword(from._internal_keyword());
+  }
+  if (from._internal_system_only() != 0) {
+    _this->_impl_.system_only_ = from._impl_.system_only_;
+  }
+  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void ChatFilter::CopyFrom(const ChatFilter& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:chat.ChatFilter)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+
+void ChatFilter::InternalSwap(ChatFilter* PROTOBUF_RESTRICT other) {
+  using std::swap;
+  auto* arena = GetArena();
+  ABSL_DCHECK_EQ(arena, other->GetArena());
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.include_names_.InternalSwap(&other->_impl_.include_names_);
+  _impl_.exclude_names_.InternalSwap(&other->_impl_.exclude_names_);
+  ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.prefix_, &other->_impl_.prefix_, arena);
+  ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.keyword_, &other->_impl_.keyword_, arena);
+        swap(_impl_.system_only_, other->_impl_.system_only_);
+}
+
+::google::protobuf::Metadata ChatFilter::GetMetadata() const {
+  return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
+}
+// ===================================================================
+
+class ChatReader::_Internal {
+ public:
+  using HasBits =
+      decltype(std::declval<ChatReader>()._impl_._has_bits_);
+  static constexpr ::int32_t kHasBitsOffset =
+      8 * PROTOBUF_FIELD_OFFSET(ChatReader, _impl_._has_bits_);
+};
+
+ChatReader::ChatReader(::google::protobuf::Arena* arena)
+    : ::google::protobuf::Message(arena) {
+  SharedCtor(arena);
+  // @@protoc_insertion_point(arena_constructor:chat.ChatReader)
+}
+inline PROTOBUF_NDEBUG_INLINE ChatReader::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
+    const Impl_& from, const ::chat::ChatReader& from_msg)
+      : _has_bits_{from._has_bits_},
+        _cached_size_{0},
+        name_(arena, from.name_),
+        room_(arena, from.room_) {}
+
+ChatReader::ChatReader(
+    ::google::protobuf::Arena* arena,
+    const ChatReader& from)
+    : ::google::protobuf::Message(arena) {
+  ChatReader* const _this = this;
+  (void)_this;
+  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
+      from._internal_metadata_);
+  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
+  ::uint32_t cached_has_bits = _impl_._has_bits_[0];
+  _impl_.filter_ = (cached_has_bits & 0x00000001u) ? ::google::protobuf::Message::CopyConstruct<::chat::ChatFilter>(
+                              arena, *from._impl_.filter_)
+                        : nullptr;
+  ::memcpy(reinterpret_cast<char *>(&_impl_) +
+               offsetof(Impl_, max_batch_messages_),
+           reinterpret_cast<const char *>(&from._impl_) +
+               offsetof(Impl_, max_batch_messages_),
+           offsetof(Impl_, trace_) -
+               offsetof(Impl_, max_batch_messages_) +
+               sizeof(Impl_::trace_));
+
+  // @@protoc_insertion_point(copy_constructor:chat.ChatReader)
+}
+inline PROTOBUF_NDEBUG_INLINE ChatReader::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility,
+    ::google::protobuf::Arena* arena)
+      : _cached_size_{0},
+        name_(arena),
+        room_(arena) {}
+
+inline void ChatReader::SharedCtor(::_pb::Arena* arena) {
+  new (&_impl_) Impl_(internal_visibility(), arena);
+  ::memset(reinterpret_cast<char *>(&_impl_) +
+               offsetof(Impl_, filter_),
+           0,
+           offsetof(Impl_, trace_) -
+               offsetof(Impl_, filter_) +
+               sizeof(Impl_::trace_));
+}
+ChatReader::~ChatReader() {
+  // @@protoc_insertion_point(destructor:chat.ChatReader)
+  _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
+  SharedDtor();
+}
+inline void ChatReader::SharedDtor() {
+  ABSL_DCHECK(GetArena() == nullptr);
+  _impl_.name_.Destroy();
+  _impl_.room_.Destroy();
+  delete _impl_.filter_;
+  _impl_.~Impl_();
+}
+
+const ::google::protobuf::MessageLite::ClassData*
+ChatReader::GetClassData() const {
+  PROTOBUF_CONSTINIT static const ::google::protobuf::MessageLite::
+      ClassDataFull _data_ = {
+          {
+              &_table_.header,
+              nullptr,  // OnDemandRegisterArenaDtor
+              nullptr,  // IsInitialized
+              PROTOBUF_FIELD_OFFSET(ChatReader, _impl_._cached_size_),
+              false,
+          },
+          &ChatReader::MergeImpl,
+          &ChatReader::kDescriptorMethods,
+          &descriptor_table_proto_2fchatservice_2eproto,
+          nullptr,  // tracker
+      };
+  ::google::protobuf::internal::PrefetchToLocalCache(&_data_);
+  ::google::protobuf::internal::PrefetchToLocalCache(_data_.tc_table);
+  return _data_.base();
+}
+PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
+const ::_pbi::TcParseTable<3, 8, 1, 40, 2> ChatReader::_table_ = {
+  {
+    PROTOBUF_FIELD_OFFSET(ChatReader, _impl_._has_bits_),
+    0, // no _extensions_
+    8, 56,  // max_field_number, fast_idx_mask
+    offsetof(decltype(_table_), field_lookup_table),
+    4294967040,  // skipmap
+    offsetof(decltype(_table_), field_entries),
+    8,  // num_field_entries
+    1,  // num_aux_entries
+    offsetof(decltype(_table_), aux_entries),
+    &_ChatReader_default_instance_._instance,
+    nullptr,  // post_loop_handler
+    ::_pbi::TcParser::GenericFallback,  // fallback
+    #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
+    ::_pbi::TcParser::GetTable<::chat::ChatReader>(),  // to_prefetch
+    #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
+  }, {{
+    // bool trace = 8;
+    {::_pbi::TcParser::SingularVarintNoZag1<bool, offsetof(ChatReader, _impl_.trace_), 63>(),
+     {64, 63, 0, PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.trace_)}},
+    // string name = 1;
+    {::_pbi::TcParser::FastUS1,
+     {10, 63, 0, PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.name_)}},
+    // uint32 max_batch_messages = 2;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(ChatReader, _impl_.max_batch_messages_), 63>(),
+     {16, 63, 0, PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.max_batch_messages_)}},
+    // uint32 max_batch_bytes = 3;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(ChatReader, _impl_.max_batch_bytes_), 63>(),
+     {24, 63, 0, PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.max_batch_bytes_)}},
+    // uint64 since_seq = 4;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(ChatReader, _impl_.since_seq_), 63>(),
+     {32, 63, 0, PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.since_seq_)}},
+    // uint32 tail_n = 5;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(ChatReader, _impl_.tail_n_), 63>(),
+     {40, 63, 0, PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.tail_n_)}},
+    // string room = 6;
+    {::_pbi::TcParser::FastUS1,
+     {50, 63, 0, PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.room_)}},
+    // .chat.ChatFilter filter = 7;
+    {::_pbi::TcParser::FastMtS1,
+     {58, 0, 0, PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.filter_)}},
+  }}, {{
+    65535, 65535
+  }}, {{
+    // string name = 1;
+    {PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.name_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUtf8String | ::_fl::kRepAString)},
+    // uint32 max_batch_messages = 2;
+    {PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.max_batch_messages_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt32)},
+    // uint32 max_batch_bytes = 3;
+    {PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.max_batch_bytes_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt32)},
+    // uint64 since_seq = 4;
+    {PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.since_seq_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
+    // uint32 tail_n = 5;
+    {PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.tail_n_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt32)},
+    // string room = 6;
+    {PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.room_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUtf8String | ::_fl::kRepAString)},
+    // .chat.ChatFilter filter = 7;
+    {PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.filter_), _Internal::kHasBitsOffset + 0, 0,
+    (0 | ::_fl::kFcOptional | ::_fl::kMessage | ::_fl::kTvTable)},
+    // bool trace = 8;
+    {PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.trace_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kBool)},
+  }}, {{
+    {::_pbi::TcParser::GetTable<::chat::ChatFilter>()},
+  }}, {{
+    "\17\4\0\0\0\0\4\0"
+    "\0\0\0\0\0\0\0\0"
+    "chat.ChatReader"
+    "name"
+    "room"
+  }},
+};
+
+PROTOBUF_NOINLINE void ChatReader::Clear() {
+// @@protoc_insertion_point(message_clear_start:chat.ChatReader)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.name_.ClearToEmpty();
+  _impl_.room_.ClearToEmpty();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    ABSL_DCHECK(_impl_.filter_ != nullptr);
+    _impl_.filter_->Clear();
+  }
+  ::memset(&_impl_.max_batch_messages_, 0, static_cast<::size_t>(
+      reinterpret_cast<char*>(&_impl_.trace_) -
+      reinterpret_cast<char*>(&_impl_.max_batch_messages_)) + sizeof(_impl_.trace_));
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
+}
+
+::uint8_t* ChatReader::_InternalSerialize(
+    ::uint8_t* target,
+    ::google::protobuf::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:chat.ChatReader)
+  ::uint32_t cached_has_bits = 0;
+  (void)cached_has_bits;
+
+  // string name = 1;
+  if (!this->_internal_name().empty()) {
+    const std::string& _s = this->_internal_name();
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+        _s.data(), static_cast<int>(_s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.ChatReader.name");
+    target = stream->WriteStringMaybeAliased(1, _s, target);
+  }
+
+  // uint32 max_batch_messages = 2;
+  if (this->_internal_max_batch_messages() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+        2, this->_internal_max_batch_messages(), target);
+  }
+
+  // uint32 max_batch_bytes = 3;
+  if (this->_internal_max_batch_bytes() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+        3, this->_internal_max_batch_bytes(), target);
+  }
+
+  // uint64 since_seq = 4;
+  if (this->_internal_since_seq() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        4, this->_internal_since_seq(), target);
+  }
+
+  // uint32 tail_n = 5;
+  if (this->_internal_tail_n() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(
+        5, this->_internal_tail_n(), target);
+  }
+
+  // string room = 6;
+  if (!this->_internal_room().empty()) {
+    const std::string& _s = this->_internal_room();
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+        _s.data(), static_cast<int>(_s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.ChatReader.room");
+    target = stream->WriteStringMaybeAliased(6, _s, target);
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // .chat.ChatFilter filter = 7;
+  if (cached_has_bits & 0x00000001u) {
+    target = ::google::protobuf::internal::WireFormatLite::InternalWriteMessage(
+        7, *_impl_.filter_, _impl_.filter_->GetCachedSize(), target, stream);
+  }
+
+  // bool trace = 8;
+  if (this->_internal_trace() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(
+        8, this->_internal_trace(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target =
+        ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+            _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:chat.ChatReader)
+  return target;
+}
+
+::size_t ChatReader::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:chat.ChatReader)
+  ::size_t total_size = 0;
+
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::_pbi::Prefetch5LinesFrom7Lines(reinterpret_cast<const void*>(this));
+  // string name = 1;
+  if (!this->_internal_name().empty()) {
+    total_size += 1 + ::google::protobuf::internal::WireFormatLite::StringSize(
+                                    this->_internal_name());
+  }
+
+  // string room = 6;
+  if (!this->_internal_room().empty()) {
+    total_size += 1 + ::google::protobuf::internal::WireFormatLite::StringSize(
+                                    this->_internal_room());
+  }
+
+  // .chat.ChatFilter filter = 7;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    total_size +=
+        1 + ::google::protobuf::internal::WireFormatLite::MessageSize(*_impl_.filter_);
+  }
+
+  // uint32 max_batch_messages = 2;
+  if (this->_internal_max_batch_messages() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(
+        this->_internal_max_batch_messages());
+  }
+
+  // uint32 max_batch_bytes = 3;
+  if (this->_internal_max_batch_bytes() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(
+        this->_internal_max_batch_bytes());
+  }
+
+  // uint64 since_seq = 4;
+  if (this->_internal_since_seq() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_since_seq());
+  }
+
+  // uint32 tail_n = 5;
+  if (this->_internal_tail_n() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(
+        this->_internal_tail_n());
+  }
+
+  // bool trace = 8;
+  if (this->_internal_trace() != 0) {
+    total_size += 2;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+
+void ChatReader::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
+  auto* const _this = static_cast<ChatReader*>(&to_msg);
+  auto& from = static_cast<const ChatReader&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:chat.ChatReader)
+  ::google::protobuf::Arena* arena = _this->GetArena();
+  ABSL_DCHECK_NE(&from, _this);
+  ::uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (!from._internal_name().empty()) {
+    _this->_internal_set_name(from._internal_name());
+  }
+  if (!from._internal_room().empty()) {
+    _this->_internal_set_room(from._internal_room());
+  }
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    ABSL_DCHECK(from._impl_.filter_ != nullptr);
+    if (_this->_impl_.filter_ == nullptr) {
+      _this->_impl_.filter_ =
+          ::google::protobuf::Message::CopyConstruct<::chat::ChatFilter>(arena, *from._impl_.filter_);
+    } else {
+      _this->_impl_.filter_->MergeFrom(*from._impl_.filter_);
+    }
+  }
+  if (from._internal_max_batch_messages() != 0) {
+    _this->_impl_.max_batch_messages_ = from._impl_.max_batch_messages_;
+  }
+  if (from._internal_max_batch_bytes() != 0) {
+    _this->_impl_.max_batch_bytes_ = from._impl_.max_batch_bytes_;
+  }
+  if (from._internal_since_seq() != 0) {
+    _this->_impl_.since_seq_ = from._impl_.since_seq_;
+  }
+  if (from._internal_tail_n() != 0) {
+    _this->_impl_.tail_n_ = from._impl_.tail_n_;
+  }
+  if (from._internal_trace() != 0) {
+    _this->_impl_.trace_ = from._impl_.trace_;
+  }
+  _this->_impl_._has_bits_[0] |= cached_has_bits;
+  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void ChatReader::CopyFrom(const ChatReader& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:chat.ChatReader)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+
+void ChatReader::InternalSwap(ChatReader* PROTOBUF_RESTRICT other) {
+  using std::swap;
+  auto* arena = GetArena();
+  ABSL_DCHECK_EQ(arena, other->GetArena());
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.name_, &other->_impl_.name_, arena);
+  ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.room_, &other->_impl_.room_, arena);
+  ::google::protobuf::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.trace_)
+      + sizeof(ChatReader::_impl_.trace_)
+      - PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.filter_)>(
+          reinterpret_cast<char*>(&_impl_.filter_),
+          reinterpret_cast<char*>(&other->_impl_.filter_));
+}
+
+::google::protobuf::Metadata ChatReader::GetMetadata() const {
+  return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
+}
+// ===================================================================
+
+class ChatMessageBatch::_Internal {
+ public:
+};
+
+ChatMessageBatch::ChatMessageBatch(::google::protobuf::Arena* arena)
+    : ::google::protobuf::Message(arena) {
+  SharedCtor(arena);
+  // @@protoc_insertion_point(arena_constructor:chat.ChatMessageBatch)
+}
+inline PROTOBUF_NDEBUG_INLINE ChatMessageBatch::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
+    const Impl_& from, const ::chat::ChatMessageBatch& from_msg)
+      : messages_{visibility, arena, from.messages_},
+        _cached_size_{0} {}
+
+ChatMessageBatch::ChatMessageBatch(
+    ::google::protobuf::Arena* arena,
+    const ChatMessageBatch& from)
+    : ::google::protobuf::Message(arena) {
+  ChatMessageBatch* const _this = this;
+  (void)_this;
+  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
+      from._internal_metadata_);
+  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
+
+  // @@protoc_insertion_point(copy_constructor:chat.ChatMessageBatch)
+}
+inline PROTOBUF_NDEBUG_INLINE ChatMessageBatch::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility,
+    ::google::protobuf::Arena* arena)
+      : messages_{visibility, arena},
+        _cached_size_{0} {}
+
+inline void ChatMessageBatch::SharedCtor(::_pb::Arena* arena) {
+  new (&_impl_) Impl_(internal_visibility(), arena);
+}
+ChatMessageBatch::~ChatMessageBatch() {
+  // @@protoc_insertion_point(destructor:chat.ChatMessageBatch)
+  _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
+  SharedDtor();
+}
+inline void ChatMessageBatch::SharedDtor() {
+  ABSL_DCHECK(GetArena() == nullptr);
+  _impl_.~Impl_();
+}
+
+const ::google::protobuf::MessageLite::ClassData*
+ChatMessageBatch::GetClassData() const {
+  PROTOBUF_CONSTINIT static const ::google::protobuf::MessageLite::
+      ClassDataFull _data_ = {
+          {
+              &_table_.header,
+              nullptr,  // OnDemandRegisterArenaDtor
+              nullptr,  // IsInitialized
+              PROTOBUF_FIELD_OFFSET(ChatMessageBatch, _impl_._cached_size_),
+              false,
+          },
+          &ChatMessageBatch::MergeImpl,
+          &ChatMessageBatch::kDescriptorMethods,
+          &descriptor_table_proto_2fchatservice_2eproto,
+          nullptr,  // tracker
+      };
+  ::google::protobuf::internal::PrefetchToLocalCache(&_data_);
+  ::google::protobuf::internal::PrefetchToLocalCache(_data_.tc_table);
+  return _data_.base();
+}
+PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
+const ::_pbi::TcParseTable<0, 1, 1, 0, 2> ChatMessageBatch::_table_ = {
+  {
+    0,  // no _has_bits_
+    0, // no _extensions_
+    1, 0,  // max_field_number, fast_idx_mask
+    offsetof(decltype(_table_), field_lookup_table),
+    4294967294,  // skipmap
+    offsetof(decltype(_table_), field_entries),
+    1,  // num_field_entries
+    1,  // num_aux_entries
+    offsetof(decltype(_table_), aux_entries),
+    &_ChatMessageBatch_default_instance_._instance,
+    nullptr,  // post_loop_handler
+    ::_pbi::TcParser::GenericFallback,  // fallback
+    #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
+    ::_pbi::TcParser::GetTable<::chat::ChatMessageBatch>(),  // to_prefetch
+    #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
+  }, {{
+    // repeated .chat.ChatMessage messages = 1;
+    {::_pbi::TcParser::FastMtR1,
+     {10, 63, 0, PROTOBUF_FIELD_OFFSET(ChatMessageBatch, _impl_.messages_)}},
+  }}, {{
+    65535, 65535
+  }}, {{
+    // repeated .chat.ChatMessage messages = 1;
+    {PROTOBUF_FIELD_OFFSET(ChatMessageBatch, _impl_.messages_), 0, 0,
+    (0 | ::_fl::kFcRepeated | ::_fl::kMessage | ::_fl::kTvTable)},
+  }}, {{
+    {::_pbi::TcParser::GetTable<::chat::ChatMessage>()},
+  }}, {{
+  }},
+};
+
+PROTOBUF_NOINLINE void ChatMessageBatch::Clear() {
+// @@protoc_insertion_point(message_clear_start:chat.ChatMessageBatch)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.messages_.Clear();
+  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
+}
+
+::uint8_t* ChatMessageBatch::_InternalSerialize(
+    ::uint8_t* target,
+    ::google::protobuf::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:chat.ChatMessageBatch)
+  ::uint32_t cached_has_bits = 0;
+  (void)cached_has_bits;
+
+  // repeated .chat.ChatMessage messages = 1;
+  for (unsigned i = 0, n = static_cast<unsigned>(
+                           this->_internal_messages_size());
+       i < n; i++) {
+    const auto& repfield = this->_internal_messages().Get(i);
+    target =
+        ::google::protobuf::internal::WireFormatLite::InternalWriteMessage(
+            1, repfield, repfield.GetCachedSize(),
+            target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target =
+        ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+            _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:chat.ChatMessageBatch)
+  return target;
+}
+
+::size_t ChatMessageBatch::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:chat.ChatMessageBatch)
+  ::size_t total_size = 0;
+
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::_pbi::Prefetch5LinesFrom7Lines(reinterpret_cast<const void*>(this));
+  // repeated .chat.ChatMessage messages = 1;
+  total_size += 1UL * this->_internal_messages_size();
+  for (const auto& msg : this->_internal_messages()) {
+    total_size += ::google::protobuf::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+
+void ChatMessageBatch::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
+  auto* const _this = static_cast<ChatMessageBatch*>(&to_msg);
+  auto& from = static_cast<const ChatMessageBatch&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:chat.ChatMessageBatch)
+  ABSL_DCHECK_NE(&from, _this);
+  ::uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_internal_mutable_messages()->MergeFrom(
+      from._internal_messages());
+  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void ChatMessageBatch::CopyFrom(const ChatMessageBatch& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:chat.ChatMessageBatch)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+
+void ChatMessageBatch::InternalSwap(ChatMessageBatch* PROTOBUF_RESTRICT other) {
+  using std::swap;
+  auto* arena = GetArena();
+  ABSL_DCHECK_EQ(arena, other->GetArena());
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.messages_.InternalSwap(&other->_impl_.messages_);
+}
+
+::google::protobuf::Metadata ChatMessageBatch::GetMetadata() const {
+  return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
+}
+// ===================================================================
+
+class ReplicatedMessage::_Internal {
+ public:
+  using HasBits =
+      decltype(std::declval<ReplicatedMessage>()._impl_._has_bits_);
+  static constexpr ::int32_t kHasBitsOffset =
+      8 * PROTOBUF_FIELD_OFFSET(ReplicatedMessage, _impl_._has_bits_);
+};
+
+ReplicatedMessage::ReplicatedMessage(::google::protobuf::Arena* arena)
+    : ::google::protobuf::Message(arena) {
+  SharedCtor(arena);
+  // @@protoc_insertion_point(arena_constructor:chat.ReplicatedMessage)
+}
+inline PROTOBUF_NDEBUG_INLINE ReplicatedMessage::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
+    const Impl_& from, const ::chat::ReplicatedMessage& from_msg)
+      : _has_bits_{from._has_bits_},
+        _cached_size_{0} {}
+
+ReplicatedMessage::ReplicatedMessage(
+    ::google::protobuf::Arena* arena,
+    const ReplicatedMessage& from)
+    : ::google::protobuf::Message(arena) {
+  ReplicatedMessage* const _this = this;
+  (void)_this;
+  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
+      from._internal_metadata_);
+  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
+  ::uint32_t cached_has_bits = _impl_._has_bits_[0];
+  _impl_.message_ = (cached_has_bits & 0x00000001u) ? ::google::protobuf::Message::CopyConstruct<::chat::ChatMessage>(
+                              arena, *from._impl_.message_)
+                        : nullptr;
+  _impl_.position_ = from._impl_.position_;
+
+  // @@protoc_insertion_point(copy_constructor:chat.ReplicatedMessage)
+}
+inline PROTOBUF_NDEBUG_INLINE ReplicatedMessage::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility,
+    ::google::protobuf::Arena* arena)
+      : _cached_size_{0} {}
+
+inline void ReplicatedMessage::SharedCtor(::_pb::Arena* arena) {
+  new (&_impl_) Impl_(internal_visibility(), arena);
+  ::memset(reinterpret_cast<char *>(&_impl_) +
+               offsetof(Impl_, message_),
+           0,
+           offsetof(Impl_, position_) -
+               offsetof(Impl_, message_) +
+               sizeof(Impl_::position_));
+}
+ReplicatedMessage::~ReplicatedMessage() {
+  // @@protoc_insertion_point(destructor:chat.ReplicatedMessage)
+  _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
+  SharedDtor();
+}
+inline void ReplicatedMessage::SharedDtor() {
+  ABSL_DCHECK(GetArena() == nullptr);
+  delete _impl_.message_;
+  _impl_.~Impl_();
+}
+
+const ::google::protobuf::MessageLite::ClassData*
+ReplicatedMessage::GetClassData() const {
+  PROTOBUF_CONSTINIT static const ::google::protobuf::MessageLite::
+      ClassDataFull _data_ = {
+          {
+              &_table_.header,
+              nullptr,  // OnDemandRegisterArenaDtor
+              nullptr,  // IsInitialized
+              PROTOBUF_FIELD_OFFSET(ReplicatedMessage, _impl_._cached_size_),
+              false,
+          },
+          &ReplicatedMessage::MergeImpl,
+          &ReplicatedMessage::kDescriptorMethods,
+          &descriptor_table_proto_2fchatservice_2eproto,
+          nullptr,  // tracker
+      };
+  ::google::protobuf::internal::PrefetchToLocalCache(&_data_);
+  ::google::protobuf::internal::PrefetchToLocalCache(_data_.tc_table);
+  return _data_.base();
+}
+PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
+const ::_pbi::TcParseTable<2, 2, 1, 0, 2> ReplicatedMessage::_table_ = {
+  {
+    PROTOBUF_FIELD_OFFSET(ReplicatedMessage, _impl_._has_bits_),
+    0, // no _extensions_
+    3, 24,  // max_field_number, fast_idx_mask
+    offsetof(decltype(_table_), field_lookup_table),
+    4294967290,  // skipmap
+    offsetof(decltype(_table_), field_entries),
+    2,  // num_field_entries
+    1,  // num_aux_entries
+    offsetof(decltype(_table_), aux_entries),
+    &_ReplicatedMessage_default_instance_._instance,
+    nullptr,  // post_loop_handler
+    ::_pbi::TcParser::GenericFallback,  // fallback
+    #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
+    ::_pbi::TcParser::GetTable<::chat::ReplicatedMessage>(),  // to_prefetch
+    #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
+  }, {{
+    {::_pbi::TcParser::MiniParse, {}},
+    // .chat.ChatMessage message = 1;
+    {::_pbi::TcParser::FastMtS1,
+     {10, 0, 0, PROTOBUF_FIELD_OFFSET(ReplicatedMessage, _impl_.message_)}},
+    {::_pbi::TcParser::MiniParse, {}},
+    // uint64 position = 3;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(ReplicatedMessage, _impl_.position_), 63>(),
+     {24, 63, 0, PROTOBUF_FIELD_OFFSET(ReplicatedMessage, _impl_.position_)}},
+  }}, {{
+    65535, 65535
+  }}, {{
+    // .chat.ChatMessage message = 1;
+    {PROTOBUF_FIELD_OFFSET(ReplicatedMessage, _impl_.message_), _Internal::kHasBitsOffset + 0, 0,
+    (0 | ::_fl::kFcOptional | ::_fl::kMessage | ::_fl::kTvTable)},
+    // uint64 position = 3;
+    {PROTOBUF_FIELD_OFFSET(ReplicatedMessage, _impl_.position_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
+  }}, {{
+    {::_pbi::TcParser::GetTable<::chat::ChatMessage>()},
+  }}, {{
+  }},
+};
+
+PROTOBUF_NOINLINE void ReplicatedMessage::Clear() {
+// @@protoc_insertion_point(message_clear_start:chat.ReplicatedMessage)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    ABSL_DCHECK(_impl_.message_ != nullptr);
+    _impl_.message_->Clear();
+  }
+  _impl_.position_ = ::uint64_t{0u};
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
+}
+
+::uint8_t* ReplicatedMessage::_InternalSerialize(
+    ::uint8_t* target,
+    ::google::protobuf::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:chat.ReplicatedMessage)
+  ::uint32_t cached_has_bits = 0;
+  (void)cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // .chat.ChatMessage message = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = ::google::protobuf::internal::WireFormatLite::InternalWriteMessage(
+        1, *_impl_.message_, _impl_.message_->GetCachedSize(), target, stream);
+  }
+
+  // uint64 position = 3;
+  if (this->_internal_position() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        3, this->_internal_position(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target =
+        ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+            _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:chat.ReplicatedMessage)
+  return target;
+}
+
+::size_t ReplicatedMessage::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:chat.ReplicatedMessage)
+  ::size_t total_size = 0;
+
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::_pbi::Prefetch5LinesFrom7Lines(reinterpret_cast<const void*>(this));
+  // .chat.ChatMessage message = 1;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    total_size +=
+        1 + ::google::protobuf::internal::WireFormatLite::MessageSize(*_impl_.message_);
+  }
+
+  // uint64 position = 3;
+  if (this->_internal_position() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_position());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+
+void ReplicatedMessage::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
+  auto* const _this = static_cast<ReplicatedMessage*>(&to_msg);
+  auto& from = static_cast<const ReplicatedMessage&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:chat.ReplicatedMessage)
+  ::google::protobuf::Arena* arena = _this->GetArena();
+  ABSL_DCHECK_NE(&from, _this);
+  ::uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    ABSL_DCHECK(from._impl_.message_ != nullptr);
+    if (_this->_impl_.message_ == nullptr) {
+      _this->_impl_.message_ =
+          ::google::protobuf::Message::CopyConstruct<::chat::ChatMessage>(arena, *from._impl_.message_);
+    } else {
+      _this->_impl_.message_->MergeFrom(*from._impl_.message_);
+    }
+  }
+  if (from._internal_position() != 0) {
+    _this->_impl_.position_ = from._impl_.position_;
+  }
+  _this->_impl_._has_bits_[0] |= cached_has_bits;
+  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void ReplicatedMessage::CopyFrom(const ReplicatedMessage& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:chat.ReplicatedMessage)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+
+void ReplicatedMessage::InternalSwap(ReplicatedMessage* PROTOBUF_RESTRICT other) {
+  using std::swap;
+  auto* arena = GetArena();
+  ABSL_DCHECK_EQ(arena, other->GetArena());
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::google::protobuf::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(ReplicatedMessage, _impl_.position_)
+      + sizeof(ReplicatedMessage::_impl_.position_)
+      - PROTOBUF_FIELD_OFFSET(ReplicatedMessage, _impl_.message_)>(
+          reinterpret_cast<char*>(&_impl_.message_),
+          reinterpret_cast<char*>(&other->_impl_.message_));
+}
+
+::google::protobuf::Metadata ReplicatedMessage::GetMetadata() const {
+  return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
+}
+// ===================================================================
+
+class ReplicatedBatch::_Internal {
+ public:
+};
+
+ReplicatedBatch::ReplicatedBatch(::google::protobuf::Arena* arena)
+    : ::google::protobuf::Message(arena) {
+  SharedCtor(arena);
+  // @@protoc_insertion_point(arena_constructor:chat.ReplicatedBatch)
+}
+inline PROTOBUF_NDEBUG_INLINE ReplicatedBatch::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
+    const Impl_& from, const ::chat::ReplicatedBatch& from_msg)
+      : messages_{visibility, arena, from.messages_},
+        _cached_size_{0} {}
+
+ReplicatedBatch::ReplicatedBatch(
+    ::google::protobuf::Arena* arena,
+    const ReplicatedBatch& from)
+    : ::google::protobuf::Message(arena) {
+  ReplicatedBatch* const _this = this;
+  (void)_this;
+  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
+      from._internal_metadata_);
+  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
+  _impl_.end_ = from._impl_.end_;
+
+  // @@protoc_insertion_point(copy_constructor:chat.ReplicatedBatch)
+}
+inline PROTOBUF_NDEBUG_INLINE ReplicatedBatch::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility,
+    ::google::protobuf::Arena* arena)
+      : messages_{visibility, arena},
+        _cached_size_{0} {}
+
+inline void ReplicatedBatch::SharedCtor(::_pb::Arena* arena) {
+  new (&_impl_) Impl_(internal_visibility(), arena);
+  _impl_.end_ = {};
+}
+ReplicatedBatch::~ReplicatedBatch() {
+  // @@protoc_insertion_point(destructor:chat.ReplicatedBatch)
+  _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
+  SharedDtor();
+}
+inline void ReplicatedBatch::SharedDtor() {
+  ABSL_DCHECK(GetArena() == nullptr);
+  _impl_.~Impl_();
+}
+
+const ::google::protobuf::MessageLite::ClassData*
+ReplicatedBatch::GetClassData() const {
+  PROTOBUF_CONSTINIT static const ::google::protobuf::MessageLite::
+      ClassDataFull _data_ = {
+          {
+              &_table_.header,
+              nullptr,  // OnDemandRegisterArenaDtor
+              nullptr,  // IsInitialized
+              PROTOBUF_FIELD_OFFSET(ReplicatedBatch, _impl_._cached_size_),
+              false,
+          },
+          &ReplicatedBatch::MergeImpl,
+          &ReplicatedBatch::kDescriptorMethods,
+          &descriptor_table_proto_2fchatservice_2eproto,
+          nullptr,  // tracker
+      };
+  ::google::protobuf::internal::PrefetchToLocalCache(&_data_);
+  ::google::protobuf::internal::PrefetchToLocalCache(_data_.tc_table);
+  return _data_.base();
+}
+PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
+const ::_pbi::TcParseTable<1, 2, 1, 0, 2> ReplicatedBatch::_table_ = {
+  {
+    0,  // no _has_bits_
+    0, // no _extensions_
+    2, 8,  // max_field_number, fast_idx_mask
+    offsetof(decltype(_table_), field_lookup_table),
+    4294967292,  // skipmap
+    offsetof(decltype(_table_), field_entries),
+    2,  // num_field_entries
+    1,  // num_aux_entries
+    offsetof(decltype(_table_), aux_entries),
+    &_ReplicatedBatch_default_instance_._instance,
+    nullptr,  // post_loop_handler
+    ::_pbi::TcParser::GenericFallback,  // fallback
+    #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
+    ::_pbi::TcParser::GetTable<::chat::ReplicatedBatch>(),  // to_prefetch
+    #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
+  }, {{
+    // uint64 end = 2;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(ReplicatedBatch, _impl_.end_), 63>(),
+     {16, 63, 0, PROTOBUF_FIELD_OFFSET(ReplicatedBatch, _impl_.end_)}},
+    // repeated .chat.ReplicatedMessage messages = 1;
+    {::_pbi::TcParser::FastMtR1,
+     {10, 63, 0, PROTOBUF_FIELD_OFFSET(ReplicatedBatch, _impl_.messages_)}},
+  }}, {{
+    65535, 65535
+  }}, {{
+    // repeated .chat.ReplicatedMessage messages = 1;
+    {PROTOBUF_FIELD_OFFSET(ReplicatedBatch, _impl_.messages_), 0, 0,
+    (0 | ::_fl::kFcRepeated | ::_fl::kMessage | ::_fl::kTvTable)},
+    // uint64 end = 2;
+    {PROTOBUF_FIELD_OFFSET(ReplicatedBatch, _impl_.end_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
+  }}, {{
+    {::_pbi::TcParser::GetTable<::chat::ReplicatedMessage>()},
+  }}, {{
+  }},
+};
+
+PROTOBUF_NOINLINE void ReplicatedBatch::Clear() {
+// @@protoc_insertion_point(message_clear_start:chat.ReplicatedBatch)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.messages_.Clear();
+  _impl_.end_ = ::uint64_t{0u};
+  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
+}
+
+::uint8_t* ReplicatedBatch::_InternalSerialize(
+    ::uint8_t* target,
+    ::google::protobuf::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:chat.ReplicatedBatch)
+  ::uint32_t cached_has_bits = 0;
+  (void)cached_has_bits;
+
+  // repeated .chat.ReplicatedMessage messages = 1;
+  for (unsigned i = 0, n = static_cast<unsigned>(
+                           this->_internal_messages_size());
+       i < n; i++) {
+    const auto& repfield = this->_internal_messages().Get(i);
+    target =
+        ::google::protobuf::internal::WireFormatLite::InternalWriteMessage(
+            1, repfield, repfield.GetCachedSize(),
+            target, stream);
+  }
+
+  // uint64 end = 2;
+  if (this->_internal_end() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        2, this->_internal_end(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target =
+        ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+            _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:chat.ReplicatedBatch)
+  return target;
+}
+
+::size_t ReplicatedBatch::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:chat.ReplicatedBatch)
+  ::size_t total_size = 0;
+
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::_pbi::Prefetch5LinesFrom7Lines(reinterpret_cast<const void*>(this));
+  // repeated .chat.ReplicatedMessage messages = 1;
+  total_size += 1UL * this->_internal_messages_size();
+  for (const auto& msg : this->_internal_messages()) {
+    total_size += ::google::protobuf::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  // uint64 end = 2;
+  if (this->_internal_end() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_end());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+
+void ReplicatedBatch::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
+  auto* const _this = static_cast<ReplicatedBatch*>(&to_msg);
+  auto& from = static_cast<const ReplicatedBatch&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:chat.ReplicatedBatch)
+  ABSL_DCHECK_NE(&from, _this);
+  ::uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_internal_mutable_messages()->MergeFrom(
+      from._internal_messages());
+  if (from._internal_end() != 0) {
+    _this->_impl_.end_ = from._impl_.end_;
+  }
+  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void ReplicatedBatch::CopyFrom(const ReplicatedBatch& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:chat.ReplicatedBatch)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+
+void ReplicatedBatch::InternalSwap(ReplicatedBatch* PROTOBUF_RESTRICT other) {
+  using std::swap;
+  auto* arena = GetArena();
+  ABSL_DCHECK_EQ(arena, other->GetArena());
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.messages_.InternalSwap(&other->_impl_.messages_);
+        swap(_impl_.end_, other->_impl_.end_);
+}
+
+::google::protobuf::Metadata ReplicatedBatch::GetMetadata() const {
+  return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
+}
+// ===================================================================
+
+class RelayBatch::_Internal {
+ public:
+};
+
+RelayBatch::RelayBatch(::google::protobuf::Arena* arena)
+    : ::google::protobuf::Message(arena) {
+  SharedCtor(arena);
+  // @@protoc_insertion_point(arena_constructor:chat.RelayBatch)
+}
+inline PROTOBUF_NDEBUG_INLINE RelayBatch::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
+    const Impl_& from, const ::chat::RelayBatch& from_msg)
+      : messages_{visibility, arena, from.messages_},
+        _cached_size_{0} {}
+
+RelayBatch::RelayBatch(
+    ::google::protobuf::Arena* arena,
+    const RelayBatch& from)
+    : ::google::protobuf::Message(arena) {
+  RelayBatch* const _this = this;
+  (void)_this;
+  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
+      from._internal_metadata_);
+  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
+  _impl_.end_ = from._impl_.end_;
+
+  // @@protoc_insertion_point(copy_constructor:chat.RelayBatch)
+}
+inline PROTOBUF_NDEBUG_INLINE RelayBatch::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility,
+    ::google::protobuf::Arena* arena)
+      : messages_{visibility, arena},
+        _cached_size_{0} {}
+
+inline void RelayBatch::SharedCtor(::_pb::Arena* arena) {
+  new (&_impl_) Impl_(internal_visibility(), arena);
+  _impl_.end_ = {};
+}
+RelayBatch::~RelayBatch() {
+  // @@protoc_insertion_point(destructor:chat.RelayBatch)
+  _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
+  SharedDtor();
+}
+inline void RelayBatch::SharedDtor() {
+  ABSL_DCHECK(GetArena() == nullptr);
+  _impl_.~Impl_();
+}
+
+const ::google::protobuf::MessageLite::ClassData*
+RelayBatch::GetClassData() const {
+  PROTOBUF_CONSTINIT static const ::google::protobuf::MessageLite::
+      ClassDataFull _data_ = {
+          {
+              &_table_.header,
+              nullptr,  // OnDemandRegisterArenaDtor
+              nullptr,  // IsInitialized
+              PROTOBUF_FIELD_OFFSET(RelayBatch, _impl_._cached_size_),
+              false,
+          },
+          &RelayBatch::MergeImpl,
+          &RelayBatch::kDescriptorMethods,
+          &descriptor_table_proto_2fchatservice_2eproto,
+          nullptr,  // tracker
+      };
+  ::google::protobuf::internal::PrefetchToLocalCache(&_data_);
+  ::google::protobuf::internal::PrefetchToLocalCache(_data_.tc_table);
+  return _data_.base();
+}
+PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
+const ::_pbi::TcParseTable<1, 2, 1, 0, 2> RelayBatch::_table_ = {
+  {
+    0,  // no _has_bits_
+    0, // no _extensions_
+    2, 8,  // max_field_number, fast_idx_mask
+    offsetof(decltype(_table_), field_lookup_table),
+    4294967292,  // skipmap
+    offsetof(decltype(_table_), field_entries),
+    2,  // num_field_entries
+    1,  // num_aux_entries
+    offsetof(decltype(_table_), aux_entries),
+    &_RelayBatch_default_instance_._instance,
+    nullptr,  // post_loop_handler
+    ::_pbi::TcParser::GenericFallback,  // fallback
+    #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
+    ::_pbi::TcParser::GetTable<::chat::RelayBatch>(),  // to_prefetch
+    #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
+  }, {{
+    // uint64 end = 2;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(RelayBatch, _impl_.end_), 63>(),
+     {16, 63, 0, PROTOBUF_FIELD_OFFSET(RelayBatch, _impl_.end_)}},
+    // repeated .chat.ChatMessage messages = 1;
+    {::_pbi::TcParser::FastMtR1,
+     {10, 63, 0, PROTOBUF_FIELD_OFFSET(RelayBatch, _impl_.messages_)}},
+  }}, {{
+    65535, 65535
+  }}, {{
+    // repeated .chat.ChatMessage messages = 1;
+    {PROTOBUF_FIELD_OFFSET(RelayBatch, _impl_.messages_), 0, 0,
+    (0 | ::_fl::kFcRepeated | ::_fl::kMessage | ::_fl::kTvTable)},
+    // uint64 end = 2;
+    {PROTOBUF_FIELD_OFFSET(RelayBatch, _impl_.end_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
+  }}, {{
+    {::_pbi::TcParser::GetTable<::chat::ChatMessage>()},
+  }}, {{
+  }},
+};
+
+PROTOBUF_NOINLINE void RelayBatch::Clear() {
+// @@protoc_insertion_point(message_clear_start:chat.RelayBatch)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.messages_.Clear();
+  _impl_.end_ = ::uint64_t{0u};
+  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
+}
+
+::uint8_t* RelayBatch::_InternalSerialize(
+    ::uint8_t* target,
+    ::google::protobuf::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:chat.RelayBatch)
+  ::uint32_t cached_has_bits = 0;
+  (void)cached_has_bits;
+
+  // repeated .chat.ChatMessage messages = 1;
+  for (unsigned i = 0, n = static_cast<unsigned>(
+                           this->_internal_messages_size());
+       i < n; i++) {
+    const auto& repfield = this->_internal_messages().Get(i);
+    target =
+        ::google::protobuf::internal::WireFormatLite::InternalWriteMessage(
+            1, repfield, repfield.GetCachedSize(),
+            target, stream);
+  }
+
+  // uint64 end = 2;
+  if (this->_internal_end() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        2, this->_internal_end(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target =
+        ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+            _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:chat.RelayBatch)
+  return target;
+}
+
+::size_t RelayBatch::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:chat.RelayBatch)
+  ::size_t total_size = 0;
+
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::_pbi::Prefetch5LinesFrom7Lines(reinterpret_cast<const void*>(this));
+  // repeated .chat.ChatMessage messages = 1;
+  total_size += 1UL * this->_internal_messages_size();
+  for (const auto& msg : this->_internal_messages()) {
+    total_size += ::google::protobuf::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  // uint64 end = 2;
+  if (this->_internal_end() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_end());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
 
-PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
-    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ChatReaderDefaultTypeInternal _ChatReader_default_instance_;
 
-inline constexpr ChatMessage::Impl_::Impl_(
-    ::_pbi::ConstantInitialized) noexcept
-      : name_(
-            &::google::protobuf::internal::fixed_address_empty_string,
-            ::_pbi::ConstantInitialized()),
-        message_(
-            &::google::protobuf::internal::fixed_address_empty_string,
-            ::_pbi::ConstantInitialized()),
-        _cached_size_{0} {}
+void RelayBatch::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
+  auto* const _this = static_cast<RelayBatch*>(&to_msg);
+  auto& from = static_cast<const RelayBatch&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:chat.RelayBatch)
+  ABSL_DCHECK_NE(&from, _this);
+  ::uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
 
-template <typename>
-PROTOBUF_CONSTEXPR ChatMessage::ChatMessage(::_pbi::ConstantInitialized)
-    : _impl_(::_pbi::ConstantInitialized()) {}
-struct ChatMessageDefaultTypeInternal {
-  PROTOBUF_CONSTEXPR ChatMessageDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
-  ~ChatMessageDefaultTypeInternal() {}
-  union {
-    ChatMessage _instance;
-  };
-};
+  _this->_internal_mutable_messages()->MergeFrom(
+      from._internal_messages());
+  if (from._internal_end() != 0) {
+    _this->_impl_.end_ = from._impl_.end_;
+  }
+  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
+}
 
-PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
-    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ChatMessageDefaultTypeInternal _ChatMessage_default_instance_;
-}  // namespace chat
-static constexpr const ::_pb::EnumDescriptor**
-    file_level_enum_descriptors_proto_2fchatservice_2eproto = nullptr;
-static constexpr const ::_pb::ServiceDescriptor**
-    file_level_service_descriptors_proto_2fchatservice_2eproto = nullptr;
-const ::uint32_t
-    TableStruct_proto_2fchatservice_2eproto::offsets[] ABSL_ATTRIBUTE_SECTION_VARIABLE(
-        protodesc_cold) = {
-        ~0u,  // no _has_bits_
-        PROTOBUF_FIELD_OFFSET(::chat::ChatMessage, _internal_metadata_),
-        ~0u,  // no _extensions_
-        ~0u,  // no _oneof_case_
-        ~0u,  // no _weak_field_map_
-        ~0u,  // no _inlined_string_donated_
-        ~0u,  // no _split_
-        ~0u,  // no sizeof(Split)
-        PROTOBUF_FIELD_OFFSET(::chat::ChatMessage, _impl_.name_),
-        PROTOBUF_FIELD_OFFSET(::chat::ChatMessage, _impl_.message_),
-        ~0u,  // no _has_bits_
-        PROTOBUF_FIELD_OFFSET(::chat::ChatReader, _internal_metadata_),
-        ~0u,  // no _extensions_
-        ~0u,  // no _oneof_case_
-        ~0u,  // no _weak_field_map_
-        ~0u,  // no _inlined_string_donated_
-        ~0u,  // no _split_
-        ~0u,  // no sizeof(Split)
-        PROTOBUF_FIELD_OFFSET(::chat::ChatReader, _impl_.name_),
-        ~0u,  // no _has_bits_
-        PROTOBUF_FIELD_OFFSET(::chat::Response, _internal_metadata_),
-        ~0u,  // no _extensions_
-        ~0u,  // no _oneof_case_
-        ~0u,  // no _weak_field_map_
-        ~0u,  // no _inlined_string_donated_
-        ~0u,  // no _split_
-        ~0u,  // no sizeof(Split)
-        PROTOBUF_FIELD_OFFSET(::chat::Response, _impl_.result_),
-};
+void RelayBatch::CopyFrom(const RelayBatch& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:chat.RelayBatch)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
 
-static const ::_pbi::MigrationSchema
-    schemas[] ABSL_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
-        {0, -1, -1, sizeof(::chat::ChatMessage)},
-        {10, -1, -1, sizeof(::chat::ChatReader)},
-        {19, -1, -1, sizeof(::chat::Response)},
-};
-static const ::_pb::Message* const file_default_instances[] = {
-    &::chat::_ChatMessage_default_instance_._instance,
-    &::chat::_ChatReader_default_instance_._instance,
-    &::chat::_Response_default_instance_._instance,
-};
-const char descriptor_table_protodef_proto_2fchatservice_2eproto[] ABSL_ATTRIBUTE_SECTION_VARIABLE(
-    protodesc_cold) = {
-    "\n\027proto/chatservice.proto\022\004chat\",\n\013ChatM"
-    "essage\022\014\n\004name\030\001 \001(\t\022\017\n\007message\030\002 \001(\t\"\032\n"
-    "\nChatReader\022\014\n\004name\030\001 \001(\t\"\032\n\010Response\022\016\n"
-    "\006result\030\001 \001(\t2o\n\013ChatService\022+\n\004Send\022\021.c"
-    "hat.ChatMessage\032\016.chat.Response\"\000\0223\n\010Rea"
-    "dChat\022\020.chat.ChatReader\032\021.chat.ChatMessa"
-    "ge\"\0000\001b\006proto3"
-};
-static ::absl::once_flag descriptor_table_proto_2fchatservice_2eproto_once;
-PROTOBUF_CONSTINIT const ::_pbi::DescriptorTable descriptor_table_proto_2fchatservice_2eproto = {
-    false,
-    false,
-    254,
-    descriptor_table_protodef_proto_2fchatservice_2eproto,
-    "proto/chatservice.proto",
-    &descriptor_table_proto_2fchatservice_2eproto_once,
-    nullptr,
-    0,
-    3,
-    schemas,
-    file_default_instances,
-    TableStruct_proto_2fchatservice_2eproto::offsets,
-    file_level_enum_descriptors_proto_2fchatservice_2eproto,
-    file_level_service_descriptors_proto_2fchatservice_2eproto,
-};
-namespace chat {
+
+void RelayBatch::InternalSwap(RelayBatch* PROTOBUF_RESTRICT other) {
+  using std::swap;
+  auto* arena = GetArena();
+  ABSL_DCHECK_EQ(arena, other->GetArena());
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.messages_.InternalSwap(&other->_impl_.messages_);
+        swap(_impl_.end_, other->_impl_.end_);
+}
+
+::google::protobuf::Metadata RelayBatch::GetMetadata() const {
+  return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
+}
 // ===================================================================
 
-class ChatMessage::_Internal {
+class SnapshotHeader::_Internal {
  public:
 };
 
-ChatMessage::ChatMessage(::google::protobuf::Arena* arena)
+SnapshotHeader::SnapshotHeader(::google::protobuf::Arena* arena)
     : ::google::protobuf::Message(arena) {
   SharedCtor(arena);
-  // @@protoc_insertion_point(arena_constructor:chat.ChatMessage)
+  // @@protoc_insertion_point(arena_constructor:chat.SnapshotHeader)
 }
-inline PROTOBUF_NDEBUG_INLINE ChatMessage::Impl_::Impl_(
+inline PROTOBUF_NDEBUG_INLINE SnapshotHeader::Impl_::Impl_(
     ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
-    const Impl_& from, const ::chat::ChatMessage& from_msg)
-      : name_(arena, from.name_),
-        message_(arena, from.message_),
-        _cached_size_{0} {}
+    const Impl_& from, const ::chat::SnapshotHeader& from_msg)
+      : _cached_size_{0} {}
 
-ChatMessage::ChatMessage(
+SnapshotHeader::SnapshotHeader(
     ::google::protobuf::Arena* arena,
-    const ChatMessage& from)
+    const SnapshotHeader& from)
     : ::google::protobuf::Message(arena) {
-  ChatMessage* const _this = this;
+  SnapshotHeader* const _this = this;
   (void)_this;
   _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
       from._internal_metadata_);
   new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
-
-  // @@protoc_insertion_point(copy_constructor:chat.ChatMessage)
+  ::memcpy(reinterpret_cast<char *>(&_impl_) +
+               offsetof(Impl_, wal_generation_),
+           reinterpret_cast<const char *>(&from._impl_) +
+               offsetof(Impl_, wal_generation_),
+           offsetof(Impl_, rooms_) -
+               offsetof(Impl_, wal_generation_) +
+               sizeof(Impl_::rooms_));
+
+  // @@protoc_insertion_point(copy_constructor:chat.SnapshotHeader)
 }
-inline PROTOBUF_NDEBUG_INLINE ChatMessage::Impl_::Impl_(
+inline PROTOBUF_NDEBUG_INLINE SnapshotHeader::Impl_::Impl_(
     ::google::protobuf::internal::InternalVisibility visibility,
     ::google::protobuf::Arena* arena)
-      : name_(arena),
-        message_(arena),
-        _cached_size_{0} {}
+      : _cached_size_{0} {}
 
-inline void ChatMessage::SharedCtor(::_pb::Arena* arena) {
+inline void SnapshotHeader::SharedCtor(::_pb::Arena* arena) {
   new (&_impl_) Impl_(internal_visibility(), arena);
+  ::memset(reinterpret_cast<char *>(&_impl_) +
+               offsetof(Impl_, wal_generation_),
+           0,
+           offsetof(Impl_, rooms_) -
+               offsetof(Impl_, wal_generation_) +
+               sizeof(Impl_::rooms_));
 }
-ChatMessage::~ChatMessage() {
-  // @@protoc_insertion_point(destructor:chat.ChatMessage)
+SnapshotHeader::~SnapshotHeader() {
+  // @@protoc_insertion_point(destructor:chat.SnapshotHeader)
   _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
   SharedDtor();
 }
-inline void ChatMessage::SharedDtor() {
+inline void SnapshotHeader::SharedDtor() {
   ABSL_DCHECK(GetArena() == nullptr);
-  _impl_.name_.Destroy();
-  _impl_.message_.Destroy();
   _impl_.~Impl_();
 }
 
 const ::google::protobuf::MessageLite::ClassData*
-ChatMessage::GetClassData() const {
+SnapshotHeader::GetClassData() const {
   PROTOBUF_CONSTINIT static const ::google::protobuf::MessageLite::
       ClassDataFull _data_ = {
           {
               &_table_.header,
               nullptr,  // OnDemandRegisterArenaDtor
               nullptr,  // IsInitialized
-              PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_._cached_size_),
+              PROTOBUF_FIELD_OFFSET(SnapshotHeader, _impl_._cached_size_),
               false,
           },
-          &ChatMessage::MergeImpl,
-          &ChatMessage::kDescriptorMethods,
+          &SnapshotHeader::MergeImpl,
+          &SnapshotHeader::kDescriptorMethods,
           &descriptor_table_proto_2fchatservice_2eproto,
           nullptr,  // tracker
       };
@@ -240,7 +2781,7 @@ ChatMessage::GetClassData() const {
   return _data_.base();
 }
 PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
-const ::_pbi::TcParseTable<1, 2, 0, 36, 2> ChatMessage::_table_ = {
+const ::_pbi::TcParseTable<1, 2, 0, 0, 2> SnapshotHeader::_table_ = {
   {
     0,  // no _has_bits_
     0, // no _extensions_
@@ -251,71 +2792,66 @@ const ::_pbi::TcParseTable<1, 2, 0, 36, 2> ChatMessage::_table_ = {
     2,  // num_field_entries
     0,  // num_aux_entries
     offsetof(decltype(_table_), field_names),  // no aux_entries
-    &_ChatMessage_default_instance_._instance,
+    &_SnapshotHeader_default_instance_._instance,
     nullptr,  // post_loop_handler
     ::_pbi::TcParser::GenericFallback,  // fallback
     #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
-    ::_pbi::TcParser::GetTable<::chat::ChatMessage>(),  // to_prefetch
+    ::_pbi::TcParser::GetTable<::chat::SnapshotHeader>(),  // to_prefetch
     #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
   }, {{
-    // string message = 2;
-    {::_pbi::TcParser::FastUS1,
-     {18, 63, 0, PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.message_)}},
-    // string name = 1;
-    {::_pbi::TcParser::FastUS1,
-     {10, 63, 0, PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.name_)}},
+    // uint64 rooms = 2;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(SnapshotHeader, _impl_.rooms_), 63>(),
+     {16, 63, 0, PROTOBUF_FIELD_OFFSET(SnapshotHeader, _impl_.rooms_)}},
+    // uint64 wal_generation = 1;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(SnapshotHeader, _impl_.wal_generation_), 63>(),
+     {8, 63, 0, PROTOBUF_FIELD_OFFSET(SnapshotHeader, _impl_.wal_generation_)}},
   }}, {{
     65535, 65535
   }}, {{
-    // string name = 1;
-    {PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.name_), 0, 0,
-    (0 | ::_fl::kFcSingular | ::_fl::kUtf8String | ::_fl::kRepAString)},
-    // string message = 2;
-    {PROTOBUF_FIELD_OFFSET(ChatMessage, _impl_.message_), 0, 0,
-    (0 | ::_fl::kFcSingular | ::_fl::kUtf8String | ::_fl::kRepAString)},
+    // uint64 wal_generation = 1;
+    {PROTOBUF_FIELD_OFFSET(SnapshotHeader, _impl_.wal_generation_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
+    // uint64 rooms = 2;
+    {PROTOBUF_FIELD_OFFSET(SnapshotHeader, _impl_.rooms_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
   }},
   // no aux_entries
   {{
-    "\20\4\7\0\0\0\0\0"
-    "chat.ChatMessage"
-    "name"
-    "message"
   }},
 };
 
-PROTOBUF_NOINLINE void ChatMessage::Clear() {
-// @@protoc_insertion_point(message_clear_start:chat.ChatMessage)
+PROTOBUF_NOINLINE void SnapshotHeader::Clear() {
+// @@protoc_insertion_point(message_clear_start:chat.SnapshotHeader)
   ::google::protobuf::internal::TSanWrite(&_impl_);
   ::uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
-  _impl_.name_.ClearToEmpty();
-  _impl_.message_.ClearToEmpty();
+  ::memset(&_impl_.wal_generation_, 0, static_cast<::size_t>(
+      reinterpret_cast<char*>(&_impl_.rooms_) -
+      reinterpret_cast<char*>(&_impl_.wal_generation_)) + sizeof(_impl_.rooms_));
   _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
 }
 
-::uint8_t* ChatMessage::_InternalSerialize(
+::uint8_t* SnapshotHeader::_InternalSerialize(
     ::uint8_t* target,
     ::google::protobuf::io::EpsCopyOutputStream* stream) const {
-  // @@protoc_insertion_point(serialize_to_array_start:chat.ChatMessage)
+  // @@protoc_insertion_point(serialize_to_array_start:chat.SnapshotHeader)
   ::uint32_t cached_has_bits = 0;
   (void)cached_has_bits;
 
-  // string name = 1;
-  if (!this->_internal_name().empty()) {
-    const std::string& _s = this->_internal_name();
-    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
-        _s.data(), static_cast<int>(_s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.ChatMessage.name");
-    target = stream->WriteStringMaybeAliased(1, _s, target);
+  // uint64 wal_generation = 1;
+  if (this->_internal_wal_generation() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        1, this->_internal_wal_generation(), target);
   }
 
-  // string message = 2;
-  if (!this->_internal_message().empty()) {
-    const std::string& _s = this->_internal_message();
-    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
-        _s.data(), static_cast<int>(_s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.ChatMessage.message");
-    target = stream->WriteStringMaybeAliased(2, _s, target);
+  // uint64 rooms = 2;
+  if (this->_internal_rooms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        2, this->_internal_rooms(), target);
   }
 
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
@@ -323,12 +2859,12 @@ PROTOBUF_NOINLINE void ChatMessage::Clear() {
         ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
             _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_to_array_end:chat.ChatMessage)
+  // @@protoc_insertion_point(serialize_to_array_end:chat.SnapshotHeader)
   return target;
 }
 
-::size_t ChatMessage::ByteSizeLong() const {
-// @@protoc_insertion_point(message_byte_size_start:chat.ChatMessage)
+::size_t SnapshotHeader::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:chat.SnapshotHeader)
   ::size_t total_size = 0;
 
   ::uint32_t cached_has_bits = 0;
@@ -336,121 +2872,138 @@ PROTOBUF_NOINLINE void ChatMessage::Clear() {
   (void) cached_has_bits;
 
   ::_pbi::Prefetch5LinesFrom7Lines(reinterpret_cast<const void*>(this));
-  // string name = 1;
-  if (!this->_internal_name().empty()) {
-    total_size += 1 + ::google::protobuf::internal::WireFormatLite::StringSize(
-                                    this->_internal_name());
+  // uint64 wal_generation = 1;
+  if (this->_internal_wal_generation() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_wal_generation());
   }
 
-  // string message = 2;
-  if (!this->_internal_message().empty()) {
-    total_size += 1 + ::google::protobuf::internal::WireFormatLite::StringSize(
-                                    this->_internal_message());
+  // uint64 rooms = 2;
+  if (this->_internal_rooms() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_rooms());
   }
 
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
 
-void ChatMessage::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
-  auto* const _this = static_cast<ChatMessage*>(&to_msg);
-  auto& from = static_cast<const ChatMessage&>(from_msg);
-  // @@protoc_insertion_point(class_specific_merge_from_start:chat.ChatMessage)
+void SnapshotHeader::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
+  auto* const _this = static_cast<SnapshotHeader*>(&to_msg);
+  auto& from = static_cast<const SnapshotHeader&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:chat.SnapshotHeader)
   ABSL_DCHECK_NE(&from, _this);
   ::uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
-  if (!from._internal_name().empty()) {
-    _this->_internal_set_name(from._internal_name());
+  if (from._internal_wal_generation() != 0) {
+    _this->_impl_.wal_generation_ = from._impl_.wal_generation_;
   }
-  if (!from._internal_message().empty()) {
-    _this->_internal_set_message(from._internal_message());
+  if (from._internal_rooms() != 0) {
+    _this->_impl_.rooms_ = from._impl_.rooms_;
   }
   _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
 }
 
-void ChatMessage::CopyFrom(const ChatMessage& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:chat.ChatMessage)
+void SnapshotHeader::CopyFrom(const SnapshotHeader& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:chat.SnapshotHeader)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 
-void ChatMessage::InternalSwap(ChatMessage* PROTOBUF_RESTRICT other) {
+void SnapshotHeader::InternalSwap(SnapshotHeader* PROTOBUF_RESTRICT other) {
   using std::swap;
   auto* arena = GetArena();
   ABSL_DCHECK_EQ(arena, other->GetArena());
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
-  ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.name_, &other->_impl_.name_, arena);
-  ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.message_, &other->_impl_.message_, arena);
+  ::google::protobuf::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(SnapshotHeader, _impl_.rooms_)
+      + sizeof(SnapshotHeader::_impl_.rooms_)
+      - PROTOBUF_FIELD_OFFSET(SnapshotHeader, _impl_.wal_generation_)>(
+          reinterpret_cast<char*>(&_impl_.wal_generation_),
+          reinterpret_cast<char*>(&other->_impl_.wal_generation_));
 }
 
-::google::protobuf::Metadata ChatMessage::GetMetadata() const {
+::google::protobuf::Metadata SnapshotHeader::GetMetadata() const {
   return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
 }
 // ===================================================================
 
-class ChatReader::_Internal {
+class SnapshotRoom::_Internal {
  public:
 };
 
-ChatReader::ChatReader(::google::protobuf::Arena* arena)
+SnapshotRoom::SnapshotRoom(::google::protobuf::Arena* arena)
     : ::google::protobuf::Message(arena) {
   SharedCtor(arena);
-  // @@protoc_insertion_point(arena_constructor:chat.ChatReader)
+  // @@protoc_insertion_point(arena_constructor:chat.SnapshotRoom)
 }
-inline PROTOBUF_NDEBUG_INLINE ChatReader::Impl_::Impl_(
+inline PROTOBUF_NDEBUG_INLINE SnapshotRoom::Impl_::Impl_(
     ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
-    const Impl_& from, const ::chat::ChatReader& from_msg)
+    const Impl_& from, const ::chat::SnapshotRoom& from_msg)
       : name_(arena, from.name_),
         _cached_size_{0} {}
 
-ChatReader::ChatReader(
+SnapshotRoom::SnapshotRoom(
     ::google::protobuf::Arena* arena,
-    const ChatReader& from)
+    const SnapshotRoom& from)
     : ::google::protobuf::Message(arena) {
-  ChatReader* const _this = this;
+  SnapshotRoom* const _this = this;
   (void)_this;
   _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
       from._internal_metadata_);
   new (&_impl_) Impl_(internal_visibility(), arena, from._impl_, from);
-
-  // @@protoc_insertion_point(copy_constructor:chat.ChatReader)
+  ::memcpy(reinterpret_cast<char *>(&_impl_) +
+               offsetof(Impl_, first_),
+           reinterpret_cast<const char *>(&from._impl_) +
+               offsetof(Impl_, first_),
+           offsetof(Impl_, messages_) -
+               offsetof(Impl_, first_) +
+               sizeof(Impl_::messages_));
+
+  // @@protoc_insertion_point(copy_constructor:chat.SnapshotRoom)
 }
-inline PROTOBUF_NDEBUG_INLINE ChatReader::Impl_::Impl_(
+inline PROTOBUF_NDEBUG_INLINE SnapshotRoom::Impl_::Impl_(
     ::google::protobuf::internal::InternalVisibility visibility,
     ::google::protobuf::Arena* arena)
       : name_(arena),
         _cached_size_{0} {}
 
-inline void ChatReader::SharedCtor(::_pb::Arena* arena) {
+inline void SnapshotRoom::SharedCtor(::_pb::Arena* arena) {
   new (&_impl_) Impl_(internal_visibility(), arena);
+  ::memset(reinterpret_cast<char *>(&_impl_) +
+               offsetof(Impl_, first_),
+           0,
+           offsetof(Impl_, messages_) -
+               offsetof(Impl_, first_) +
+               sizeof(Impl_::messages_));
 }
-ChatReader::~ChatReader() {
-  // @@protoc_insertion_point(destructor:chat.ChatReader)
+SnapshotRoom::~SnapshotRoom() {
+  // @@protoc_insertion_point(destructor:chat.SnapshotRoom)
   _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
   SharedDtor();
 }
-inline void ChatReader::SharedDtor() {
+inline void SnapshotRoom::SharedDtor() {
   ABSL_DCHECK(GetArena() == nullptr);
   _impl_.name_.Destroy();
   _impl_.~Impl_();
 }
 
 const ::google::protobuf::MessageLite::ClassData*
-ChatReader::GetClassData() const {
+SnapshotRoom::GetClassData() const {
   PROTOBUF_CONSTINIT static const ::google::protobuf::MessageLite::
       ClassDataFull _data_ = {
           {
               &_table_.header,
               nullptr,  // OnDemandRegisterArenaDtor
               nullptr,  // IsInitialized
-              PROTOBUF_FIELD_OFFSET(ChatReader, _impl_._cached_size_),
+              PROTOBUF_FIELD_OFFSET(SnapshotRoom, _impl_._cached_size_),
               false,
           },
-          &ChatReader::MergeImpl,
-          &ChatReader::kDescriptorMethods,
+          &SnapshotRoom::MergeImpl,
+          &SnapshotRoom::kDescriptorMethods,
           &descriptor_table_proto_2fchatservice_2eproto,
           nullptr,  // tracker
       };
@@ -459,57 +3012,73 @@ ChatReader::GetClassData() const {
   return _data_.base();
 }
 PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
-const ::_pbi::TcParseTable<0, 1, 0, 28, 2> ChatReader::_table_ = {
+const ::_pbi::TcParseTable<2, 3, 0, 32, 2> SnapshotRoom::_table_ = {
   {
     0,  // no _has_bits_
     0, // no _extensions_
-    1, 0,  // max_field_number, fast_idx_mask
+    3, 24,  // max_field_number, fast_idx_mask
     offsetof(decltype(_table_), field_lookup_table),
-    4294967294,  // skipmap
+    4294967288,  // skipmap
     offsetof(decltype(_table_), field_entries),
-    1,  // num_field_entries
+    3,  // num_field_entries
     0,  // num_aux_entries
     offsetof(decltype(_table_), field_names),  // no aux_entries
-    &_ChatReader_default_instance_._instance,
+    &_SnapshotRoom_default_instance_._instance,
     nullptr,  // post_loop_handler
     ::_pbi::TcParser::GenericFallback,  // fallback
     #ifdef PROTOBUF_PREFETCH_PARSE_TABLE
-    ::_pbi::TcParser::GetTable<::chat::ChatReader>(),  // to_prefetch
+    ::_pbi::TcParser::GetTable<::chat::SnapshotRoom>(),  // to_prefetch
     #endif  // PROTOBUF_PREFETCH_PARSE_TABLE
   }, {{
+    {::_pbi::TcParser::MiniParse, {}},
     // string name = 1;
     {::_pbi::TcParser::FastUS1,
-     {10, 63, 0, PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.name_)}},
+     {10, 63, 0, PROTOBUF_FIELD_OFFSET(SnapshotRoom, _impl_.name_)}},
+    // uint64 first = 2;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(SnapshotRoom, _impl_.first_), 63>(),
+     {16, 63, 0, PROTOBUF_FIELD_OFFSET(SnapshotRoom, _impl_.first_)}},
+    // uint64 messages = 3;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(SnapshotRoom, _impl_.messages_), 63>(),
+     {24, 63, 0, PROTOBUF_FIELD_OFFSET(SnapshotRoom, _impl_.messages_)}},
   }}, {{
     65535, 65535
   }}, {{
     // string name = 1;
-    {PROTOBUF_FIELD_OFFSET(ChatReader, _impl_.name_), 0, 0,
+    {PROTOBUF_FIELD_OFFSET(SnapshotRoom, _impl_.name_), 0, 0,
     (0 | ::_fl::kFcSingular | ::_fl::kUtf8String | ::_fl::kRepAString)},
+    // uint64 first = 2;
+    {PROTOBUF_FIELD_OFFSET(SnapshotRoom, _impl_.first_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
+    // uint64 messages = 3;
+    {PROTOBUF_FIELD_OFFSET(SnapshotRoom, _impl_.messages_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kUInt64)},
   }},
   // no aux_entries
   {{
-    "\17\4\0\0\0\0\0\0"
-    "chat.ChatReader"
+    "\21\4\0\0\0\0\0\0"
+    "chat.SnapshotRoom"
     "name"
   }},
 };
 
-PROTOBUF_NOINLINE void ChatReader::Clear() {
-// @@protoc_insertion_point(message_clear_start:chat.ChatReader)
+PROTOBUF_NOINLINE void SnapshotRoom::Clear() {
+// @@protoc_insertion_point(message_clear_start:chat.SnapshotRoom)
   ::google::protobuf::internal::TSanWrite(&_impl_);
   ::uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
   _impl_.name_.ClearToEmpty();
+  ::memset(&_impl_.first_, 0, static_cast<::size_t>(
+      reinterpret_cast<char*>(&_impl_.messages_) -
+      reinterpret_cast<char*>(&_impl_.first_)) + sizeof(_impl_.messages_));
   _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
 }
 
-::uint8_t* ChatReader::_InternalSerialize(
+::uint8_t* SnapshotRoom::_InternalSerialize(
     ::uint8_t* target,
     ::google::protobuf::io::EpsCopyOutputStream* stream) const {
-  // @@protoc_insertion_point(serialize_to_array_start:chat.ChatReader)
+  // @@protoc_insertion_point(serialize_to_array_start:chat.SnapshotRoom)
   ::uint32_t cached_has_bits = 0;
   (void)cached_has_bits;
 
@@ -517,41 +3086,68 @@ PROTOBUF_NOINLINE void ChatReader::Clear() {
   if (!this->_internal_name().empty()) {
     const std::string& _s = this->_internal_name();
     ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
-        _s.data(), static_cast<int>(_s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.ChatReader.name");
+        _s.data(), static_cast<int>(_s.length()), ::google::protobuf::internal::WireFormatLite::SERIALIZE, "chat.SnapshotRoom.name");
     target = stream->WriteStringMaybeAliased(1, _s, target);
   }
 
+  // uint64 first = 2;
+  if (this->_internal_first() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        2, this->_internal_first(), target);
+  }
+
+  // uint64 messages = 3;
+  if (this->_internal_messages() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(
+        3, this->_internal_messages(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target =
         ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
             _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_to_array_end:chat.ChatReader)
+  // @@protoc_insertion_point(serialize_to_array_end:chat.SnapshotRoom)
   return target;
 }
 
-::size_t ChatReader::ByteSizeLong() const {
-// @@protoc_insertion_point(message_byte_size_start:chat.ChatReader)
+::size_t SnapshotRoom::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:chat.SnapshotRoom)
   ::size_t total_size = 0;
 
   ::uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  ::_pbi::Prefetch5LinesFrom7Lines(reinterpret_cast<const void*>(this));
   // string name = 1;
   if (!this->_internal_name().empty()) {
     total_size += 1 + ::google::protobuf::internal::WireFormatLite::StringSize(
                                     this->_internal_name());
   }
 
+  // uint64 first = 2;
+  if (this->_internal_first() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_first());
+  }
+
+  // uint64 messages = 3;
+  if (this->_internal_messages() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(
+        this->_internal_messages());
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
 
-void ChatReader::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
-  auto* const _this = static_cast<ChatReader*>(&to_msg);
-  auto& from = static_cast<const ChatReader&>(from_msg);
-  // @@protoc_insertion_point(class_specific_merge_from_start:chat.ChatReader)
+void SnapshotRoom::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::google::protobuf::MessageLite& from_msg) {
+  auto* const _this = static_cast<SnapshotRoom*>(&to_msg);
+  auto& from = static_cast<const SnapshotRoom&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:chat.SnapshotRoom)
   ABSL_DCHECK_NE(&from, _this);
   ::uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
@@ -559,26 +3155,38 @@ void ChatReader::MergeImpl(::google::protobuf::MessageLite& to_msg, const ::goog
   if (!from._internal_name().empty()) {
     _this->_internal_set_name(from._internal_name());
   }
+  if (from._internal_first() != 0) {
+    _this->_impl_.first_ = from._impl_.first_;
+  }
+  if (from._internal_messages() != 0) {
+    _this->_impl_.messages_ = from._impl_.messages_;
+  }
   _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
 }
 
-void ChatReader::CopyFrom(const ChatReader& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:chat.ChatReader)
+void SnapshotRoom::CopyFrom(const SnapshotRoom& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:chat.SnapshotRoom)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
 
-void ChatReader::InternalSwap(ChatReader* PROTOBUF_RESTRICT other) {
+void SnapshotRoom::InternalSwap(SnapshotRoom* PROTOBUF_RESTRICT other) {
   using std::swap;
   auto* arena = GetArena();
   ABSL_DCHECK_EQ(arena, other->GetArena());
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   ::_pbi::ArenaStringPtr::InternalSwap(&_impl_.name_, &other->_impl_.name_, arena);
+  ::google::protobuf::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(SnapshotRoom, _impl_.messages_)
+      + sizeof(SnapshotRoom::_impl_.messages_)
+      - PROTOBUF_FIELD_OFFSET(SnapshotRoom, _impl_.first_)>(
+          reinterpret_cast<char*>(&_impl_.first_),
+          reinterpret_cast<char*>(&other->_impl_.first_));
 }
 
-::google::protobuf::Metadata ChatReader::GetMetadata() const {
+::google::protobuf::Metadata SnapshotRoom::GetMetadata() const {
   return ::google::protobuf::Message::GetMetadataImpl(GetClassData()->full());
 }
 // ===================================================================
@@ -50,15 +50,39 @@ struct TableStruct_proto_2fchatservice_2eproto {
 extern const ::google::protobuf::internal::DescriptorTable
     descriptor_table_proto_2fchatservice_2eproto;
 namespace chat {
+class ChatFilter;
+struct ChatFilterDefaultTypeInternal;
+extern ChatFilterDefaultTypeInternal _ChatFilter_default_instance_;
 class ChatMessage;
 struct ChatMessageDefaultTypeInternal;
 extern ChatMessageDefaultTypeInternal _ChatMessage_default_instance_;
+class ChatMessageBatch;
+struct ChatMessageBatchDefaultTypeInternal;
+extern ChatMessageBatchDefaultTypeInternal _ChatMessageBatch_default_instance_;
 class ChatReader;
 struct ChatReaderDefaultTypeInternal;
 extern ChatReaderDefaultTypeInternal _ChatReader_default_instance_;
+class MessageTrace;
+struct MessageTraceDefaultTypeInternal;
+extern MessageTraceDefaultTypeInternal _MessageTrace_default_instance_;
+class RelayBatch;
+struct RelayBatchDefaultTypeInternal;
+extern RelayBatchDefaultTypeInternal _RelayBatch_default_instance_;
+class ReplicatedBatch;
+struct ReplicatedBatchDefaultTypeInternal;
+extern ReplicatedBatchDefaultTypeInternal _ReplicatedBatch_default_instance_;
+class ReplicatedMessage;
+struct ReplicatedMessageDefaultTypeInternal;
+extern ReplicatedMessageDefaultTypeInternal _ReplicatedMessage_default_instance_;
 class Response;
 struct ResponseDefaultTypeInternal;
 extern ResponseDefaultTypeInternal _Response_default_instance_;
+class SnapshotHeader;
+struct SnapshotHeaderDefaultTypeInternal;
+extern SnapshotHeaderDefaultTypeInternal _SnapshotHeader_default_instance_;
+class SnapshotRoom;
+struct SnapshotRoomDefaultTypeInternal;
+extern SnapshotRoomDefaultTypeInternal _SnapshotRoom_default_instance_;
 }  // namespace chat
 namespace google {
 namespace protobuf {
@@ -127,7 +151,7 @@ class Response final : public ::google::protobuf::Message
     return reinterpret_cast<const Response*>(
         &_Response_default_instance_);
   }
-  static constexpr int kIndexInFileMessages = 2;
+  static constexpr int kIndexInFileMessages = 10;
   friend void swap(Response& a, Response& b) { a.Swap(&b); }
   inline void Swap(Response* other) {
     if (other == this) return;
@@ -249,23 +273,23 @@ class Response final : public ::google::protobuf::Message
 };
 // -------------------------------------------------------------------
 
-class ChatReader final : public ::google::protobuf::Message
-/* @@protoc_insertion_point(class_definition:chat.ChatReader) */ {
+class SnapshotRoom final : public ::google::protobuf::Message
+/* @@protoc_insertion_point(class_definition:chat.SnapshotRoom) */ {
  public:
-  inline ChatReader() : ChatReader(nullptr) {}
-  ~ChatReader() override;
+  inline SnapshotRoom() : SnapshotRoom(nullptr) {}
+  ~SnapshotRoom() override;
   template <typename = void>
-  explicit PROTOBUF_CONSTEXPR ChatReader(
+  explicit PROTOBUF_CONSTEXPR SnapshotRoom(
       ::google::protobuf::internal::ConstantInitialized);
 
-  inline ChatReader(const ChatReader& from) : ChatReader(nullptr, from) {}
-  inline ChatReader(ChatReader&& from) noexcept
-      : ChatReader(nullptr, std::move(from)) {}
-  inline ChatReader& operator=(const ChatReader& from) {
+  inline SnapshotRoom(const SnapshotRoom& from) : SnapshotRoom(nullptr, from) {}
+  inline SnapshotRoom(SnapshotRoom&& from) noexcept
+      : SnapshotRoom(nullptr, std::move(from)) {}
+  inline SnapshotRoom& operator=(const SnapshotRoom& from) {
     CopyFrom(from);
     return *this;
   }
-  inline ChatReader& operator=(ChatReader&& from) noexcept {
+  inline SnapshotRoom& operator=(SnapshotRoom&& from) noexcept {
     if (this == &from) return *this;
     if (GetArena() == from.GetArena()
 #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -297,16 +321,16 @@ class ChatReader final : public ::google::protobuf::Message
   static const ::google::protobuf::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const ChatReader& default_instance() {
+  static const SnapshotRoom& default_instance() {
     return *internal_default_instance();
   }
-  static inline const ChatReader* internal_default_instance() {
-    return reinterpret_cast<const ChatReader*>(
-        &_ChatReader_default_instance_);
+  static inline const SnapshotRoom* internal_default_instance() {
+    return reinterpret_cast<const SnapshotRoom*>(
+        &_SnapshotRoom_default_instance_);
   }
-  static constexpr int kIndexInFileMessages = 1;
-  friend void swap(ChatReader& a, ChatReader& b) { a.Swap(&b); }
-  inline void Swap(ChatReader* other) {
+  static constexpr int kIndexInFileMessages = 9;
+  friend void swap(SnapshotRoom& a, SnapshotRoom& b) { a.Swap(&b); }
+  inline void Swap(SnapshotRoom* other) {
     if (other == this) return;
 #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetArena() != nullptr && GetArena() == other->GetArena()) {
@@ -318,7 +342,7 @@ class ChatReader final : public ::google::protobuf::Message
       ::google::protobuf::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(ChatReader* other) {
+  void UnsafeArenaSwap(SnapshotRoom* other) {
     if (other == this) return;
     ABSL_DCHECK(GetArena() == other->GetArena());
     InternalSwap(other);
@@ -326,13 +350,13 @@ class ChatReader final : public ::google::protobuf::Message
 
   // implements Message ----------------------------------------------
 
-  ChatReader* New(::google::protobuf::Arena* arena = nullptr) const final {
-    return ::google::protobuf::Message::DefaultConstruct<ChatReader>(arena);
+  SnapshotRoom* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return ::google::protobuf::Message::DefaultConstruct<SnapshotRoom>(arena);
   }
   using ::google::protobuf::Message::CopyFrom;
-  void CopyFrom(const ChatReader& from);
+  void CopyFrom(const SnapshotRoom& from);
   using ::google::protobuf::Message::MergeFrom;
-  void MergeFrom(const ChatReader& from) { ChatReader::MergeImpl(*this, from); }
+  void MergeFrom(const SnapshotRoom& from) { SnapshotRoom::MergeImpl(*this, from); }
 
   private:
   static void MergeImpl(
@@ -353,16 +377,16 @@ class ChatReader final : public ::google::protobuf::Message
   private:
   void SharedCtor(::google::protobuf::Arena* arena);
   void SharedDtor();
-  void InternalSwap(ChatReader* other);
+  void InternalSwap(SnapshotRoom* other);
  private:
   friend class ::google::protobuf::internal::AnyMetadata;
-  static ::absl::string_view FullMessageName() { return "chat.ChatReader"; }
+  static ::absl::string_view FullMessageName() { return "chat.SnapshotRoom"; }
 
  protected:
-  explicit ChatReader(::google::protobuf::Arena* arena);
-  ChatReader(::google::protobuf::Arena* arena, const ChatReader& from);
-  ChatReader(::google::protobuf::Arena* arena, ChatReader&& from) noexcept
-      : ChatReader(arena) {
+  explicit SnapshotRoom(::google::protobuf::Arena* arena);
+  SnapshotRoom(::google::protobuf::Arena* arena, const SnapshotRoom& from);
+  SnapshotRoom(::google::protobuf::Arena* arena, SnapshotRoom&& from) noexcept
+      : SnapshotRoom(arena) {
     *this = ::std::move(from);
   }
   const ::google::protobuf::Message::ClassData* GetClassData() const final;
@@ -374,6 +398,8 @@ class ChatReader final : public ::google::protobuf::Message
   // accessors -------------------------------------------------------
   enum : int {
     kNameFieldNumber = 1,
+    kFirstFieldNumber = 2,
+    kMessagesFieldNumber = 3,
   };
   // string name = 1;
   void clear_name() ;
@@ -391,17 +417,37 @@ class ChatReader final : public ::google::protobuf::Message
   std::string* _internal_mutable_name();
 
   public:
-  // @@protoc_insertion_point(class_scope:chat.ChatReader)
+  // uint64 first = 2;
+  void clear_first() ;
+  ::uint64_t first() const;
+  void set_first(::uint64_t value);
+
+  private:
+  ::uint64_t _internal_first() const;
+  void _internal_set_first(::uint64_t value);
+
+  public:
+  // uint64 messages = 3;
+  void clear_messages() ;
+  ::uint64_t messages() const;
+  void set_messages(::uint64_t value);
+
+  private:
+  ::uint64_t _internal_messages() const;
+  void _internal_set_messages(::uint64_t value);
+
+  public:
+  // @@protoc_insertion_point(class_scope:chat.SnapshotRoom)
  private:
   class _Internal;
   friend class ::google::protobuf::internal::TcParser;
   static const ::google::protobuf::internal::TcParseTable<
-      0, 1, 0,
-      28, 2>
+      2, 3, 0,
+      32, 2>
       _table_;
 
   static constexpr const void* _raw_default_instance_ =
-      &_ChatReader_default_instance_;
+      &_SnapshotRoom_default_instance_;
 
   friend class ::google::protobuf::MessageLite;
   friend class ::google::protobuf::Arena;
@@ -416,8 +462,10 @@ class ChatReader final : public ::google::protobuf::Message
                           ::google::protobuf::Arena* arena);
     inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
                           ::google::protobuf::Arena* arena, const Impl_& from,
-                          const ChatReader& from_msg);
+                          const SnapshotRoom& from_msg);
     ::google::protobuf::internal::ArenaStringPtr name_;
+    ::uint64_t first_;
+    ::uint64_t messages_;
     mutable ::google::protobuf::internal::CachedSize _cached_size_;
     PROTOBUF_TSAN_DECLARE_MEMBER
   };
@@ -426,23 +474,23 @@ class ChatReader final : public ::google::protobuf::Message
 };
 // -------------------------------------------------------------------
 
-class ChatMessage final : public ::google::protobuf::Message
-/* @@protoc_insertion_point(class_definition:chat.ChatMessage) */ {
+class SnapshotHeader final : public ::google::protobuf::Message
+/* @@protoc_insertion_point(class_definition:chat.SnapshotHeader) */ {
  public:
-  inline ChatMessage() : ChatMessage(nullptr) {}
-  ~ChatMessage() override;
+  inline SnapshotHeader() : SnapshotHeader(nullptr) {}
+  ~SnapshotHeader() override;
   template <typename = void>
-  explicit PROTOBUF_CONSTEXPR ChatMessage(
+  explicit PROTOBUF_CONSTEXPR SnapshotHeader(
       ::google::protobuf::internal::ConstantInitialized);
 
-  inline ChatMessage(const ChatMessage& from) : ChatMessage(nullptr, from) {}
-  inline ChatMessage(ChatMessage&& from) noexcept
-      : ChatMessage(nullptr, std::move(from)) {}
-  inline ChatMessage& operator=(const ChatMessage& from) {
+  inline SnapshotHeader(const SnapshotHeader& from) : SnapshotHeader(nullptr, from) {}
+  inline SnapshotHeader(SnapshotHeader&& from) noexcept
+      : SnapshotHeader(nullptr, std::move(from)) {}
+  inline SnapshotHeader& operator=(const SnapshotHeader& from) {
     CopyFrom(from);
     return *this;
   }
-  inline ChatMessage& operator=(ChatMessage&& from) noexcept {
+  inline SnapshotHeader& operator=(SnapshotHeader&& from) noexcept {
     if (this == &from) return *this;
     if (GetArena() == from.GetArena()
 #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -474,16 +522,16 @@ class ChatMessage final : public ::google::protobuf::Message
   static const ::google::protobuf::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const ChatMessage& default_instance() {
+  static const SnapshotHeader& default_instance() {
     return *internal_default_instance();
   }
-  static inline const ChatMessage* internal_default_instance() {
-    return reinterpret_cast<const ChatMessage*>(
-        &_ChatMessage_default_instance_);
+  static inline const SnapshotHeader* internal_default_instance() {
+    return reinterpret_cast<const SnapshotHeader*>(
+        &_SnapshotHeader_default_instance_);
   }
-  static constexpr int kIndexInFileMessages = 0;
-  friend void swap(ChatMessage& a, ChatMessage& b) { a.Swap(&b); }
-  inline void Swap(ChatMessage* other) {
+  static constexpr int kIndexInFileMessages = 8;
+  friend void swap(SnapshotHeader& a, SnapshotHeader& b) { a.Swap(&b); }
+  inline void Swap(SnapshotHeader* other) {
     if (other == this) return;
 #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetArena() != nullptr && GetArena() == other->GetArena()) {
@@ -495,7 +543,7 @@ class ChatMessage final : public ::google::protobuf::Message
       ::google::protobuf::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(ChatMessage* other) {
+  void UnsafeArenaSwap(SnapshotHeader* other) {
     if (other == this) return;
     ABSL_DCHECK(GetArena() == other->GetArena());
     InternalSwap(other);
@@ -503,13 +551,13 @@ class ChatMessage final : public ::google::protobuf::Message
 
   // implements Message ----------------------------------------------
 
-  ChatMessage* New(::google::protobuf::Arena* arena = nullptr) const final {
-    return ::google::protobuf::Message::DefaultConstruct<ChatMessage>(arena);
+  SnapshotHeader* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return ::google::protobuf::Message::DefaultConstruct<SnapshotHeader>(arena);
   }
   using ::google::protobuf::Message::CopyFrom;
-  void CopyFrom(const ChatMessage& from);
+  void CopyFrom(const SnapshotHeader& from);
   using ::google::protobuf::Message::MergeFrom;
-  void MergeFrom(const ChatMessage& from) { ChatMessage::MergeImpl(*this, from); }
+  void MergeFrom(const SnapshotHeader& from) { SnapshotHeader::MergeImpl(*this, from); }
 
   private:
   static void MergeImpl(
@@ -530,16 +578,16 @@ class ChatMessage final : public ::google::protobuf::Message
   private:
   void SharedCtor(::google::protobuf::Arena* arena);
   void SharedDtor();
-  void InternalSwap(ChatMessage* other);
+  void InternalSwap(SnapshotHeader* other);
  private:
   friend class ::google::protobuf::internal::AnyMetadata;
-  static ::absl::string_view FullMessageName() { return "chat.ChatMessage"; }
+  static ::absl::string_view FullMessageName() { return "chat.SnapshotHeader"; }
 
  protected:
-  explicit ChatMessage(::google::protobuf::Arena* arena);
-  ChatMessage(::google::protobuf::Arena* arena, const ChatMessage& from);
-  ChatMessage(::google::protobuf::Arena* arena, ChatMessage&& from) noexcept
-      : ChatMessage(arena) {
+  explicit SnapshotHeader(::google::protobuf::Arena* arena);
+  SnapshotHeader(::google::protobuf::Arena* arena, const SnapshotHeader& from);
+  SnapshotHeader(::google::protobuf::Arena* arena, SnapshotHeader&& from) noexcept
+      : SnapshotHeader(arena) {
     *this = ::std::move(from);
   }
   const ::google::protobuf::Message::ClassData* GetClassData() const final;
@@ -550,52 +598,40 @@ class ChatMessage final : public ::google::protobuf::Message
 
   // accessors -------------------------------------------------------
   enum : int {
-    kNameFieldNumber = 1,
-    kMessageFieldNumber = 2,
+    kWalGenerationFieldNumber = 1,
+    kRoomsFieldNumber = 2,
   };
-  // string name = 1;
-  void clear_name() ;
-  const std::string& name() const;
-  template <typename Arg_ = const std::string&, typename... Args_>
-  void set_name(Arg_&& arg, Args_... args);
-  std::string* mutable_name();
-  PROTOBUF_NODISCARD std::string* release_name();
-  void set_allocated_name(std::string* value);
+  // uint64 wal_generation = 1;
+  void clear_wal_generation() ;
+  ::uint64_t wal_generation() const;
+  void set_wal_generation(::uint64_t value);
 
   private:
-  const std::string& _internal_name() const;
-  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(
-      const std::string& value);
-  std::string* _internal_mutable_name();
+  ::uint64_t _internal_wal_generation() const;
+  void _internal_set_wal_generation(::uint64_t value);
 
   public:
-  // string message = 2;
-  void clear_message() ;
-  const std::string& message() const;
-  template <typename Arg_ = const std::string&, typename... Args_>
-  void set_message(Arg_&& arg, Args_... args);
-  std::string* mutable_message();
-  PROTOBUF_NODISCARD std::string* release_message();
-  void set_allocated_message(std::string* value);
+  // uint64 rooms = 2;
+  void clear_rooms() ;
+  ::uint64_t rooms() const;
+  void set_rooms(::uint64_t value);
 
   private:
-  const std::string& _internal_message() const;
-  inline PROTOBUF_ALWAYS_INLINE void _internal_set_message(
-      const std::string& value);
-  std::string* _internal_mutable_message();
+  ::uint64_t _internal_rooms() const;
+  void _internal_set_rooms(::uint64_t value);
 
   public:
-  // @@protoc_insertion_point(class_scope:chat.ChatMessage)
+  // @@protoc_insertion_point(class_scope:chat.SnapshotHeader)
  private:
   class _Internal;
   friend class ::google::protobuf::internal::TcParser;
   static const ::google::protobuf::internal::TcParseTable<
       1, 2, 0,
-      36, 2>
+      0, 2>
       _table_;
 
   static constexpr const void* _raw_default_instance_ =
-      &_ChatMessage_default_instance_;
+      &_SnapshotHeader_default_instance_;
 
   friend class ::google::protobuf::MessageLite;
   friend class ::google::protobuf::Arena;
@@ -610,176 +646,3098 @@ class ChatMessage final : public ::google::protobuf::Message
                           ::google::protobuf::Arena* arena);
     inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
                           ::google::protobuf::Arena* arena, const Impl_& from,
-                          const ChatMessage& from_msg);
-    ::google::protobuf::internal::ArenaStringPtr name_;
-    ::google::protobuf::internal::ArenaStringPtr message_;
+                          const SnapshotHeader& from_msg);
+    ::uint64_t wal_generation_;
+    ::uint64_t rooms_;
     mutable ::google::protobuf::internal::CachedSize _cached_size_;
     PROTOBUF_TSAN_DECLARE_MEMBER
   };
   union { Impl_ _impl_; };
   friend struct ::TableStruct_proto_2fchatservice_2eproto;
 };
+// -------------------------------------------------------------------
 
-// ===================================================================
+class MessageTrace final : public ::google::protobuf::Message
+/* @@protoc_insertion_point(class_definition:chat.MessageTrace) */ {
+ public:
+  inline MessageTrace() : MessageTrace(nullptr) {}
+  ~MessageTrace() override;
+  template <typename = void>
+  explicit PROTOBUF_CONSTEXPR MessageTrace(
+      ::google::protobuf::internal::ConstantInitialized);
 
+  inline MessageTrace(const MessageTrace& from) : MessageTrace(nullptr, from) {}
+  inline MessageTrace(MessageTrace&& from) noexcept
+      : MessageTrace(nullptr, std::move(from)) {}
+  inline MessageTrace& operator=(const MessageTrace& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline MessageTrace& operator=(MessageTrace&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetArena() == from.GetArena()
+#ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetArena() != nullptr
+#endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
 
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields()
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
+  }
 
+  static const ::google::protobuf::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::google::protobuf::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::google::protobuf::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const MessageTrace& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const MessageTrace* internal_default_instance() {
+    return reinterpret_cast<const MessageTrace*>(
+        &_MessageTrace_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages = 0;
+  friend void swap(MessageTrace& a, MessageTrace& b) { a.Swap(&b); }
+  inline void Swap(MessageTrace* other) {
+    if (other == this) return;
+#ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() != nullptr && GetArena() == other->GetArena()) {
+#else   // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() == other->GetArena()) {
+#endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::google::protobuf::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(MessageTrace* other) {
+    if (other == this) return;
+    ABSL_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
 
-// ===================================================================
+  // implements Message ----------------------------------------------
 
+  MessageTrace* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return ::google::protobuf::Message::DefaultConstruct<MessageTrace>(arena);
+  }
+  using ::google::protobuf::Message::CopyFrom;
+  void CopyFrom(const MessageTrace& from);
+  using ::google::protobuf::Message::MergeFrom;
+  void MergeFrom(const MessageTrace& from) { MessageTrace::MergeImpl(*this, from); }
 
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wstrict-aliasing"
-#endif  // __GNUC__
-// -------------------------------------------------------------------
+  private:
+  static void MergeImpl(
+      ::google::protobuf::MessageLite& to_msg,
+      const ::google::protobuf::MessageLite& from_msg);
 
-// ChatMessage
+  public:
+  bool IsInitialized() const {
+    return true;
+  }
+  ABSL_ATTRIBUTE_REINITIALIZES void Clear() final;
+  ::size_t ByteSizeLong() const final;
+  ::uint8_t* _InternalSerialize(
+      ::uint8_t* target,
+      ::google::protobuf::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
 
-// string name = 1;
-inline void ChatMessage::clear_name() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.name_.ClearToEmpty();
-}
-inline const std::string& ChatMessage::name() const
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  // @@protoc_insertion_point(field_get:chat.ChatMessage.name)
-  return _internal_name();
-}
-template <typename Arg_, typename... Args_>
-inline PROTOBUF_ALWAYS_INLINE void ChatMessage::set_name(Arg_&& arg,
-                                                     Args_... args) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.name_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
-  // @@protoc_insertion_point(field_set:chat.ChatMessage.name)
-}
-inline std::string* ChatMessage::mutable_name() ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  std::string* _s = _internal_mutable_name();
-  // @@protoc_insertion_point(field_mutable:chat.ChatMessage.name)
-  return _s;
-}
-inline const std::string& ChatMessage::_internal_name() const {
-  ::google::protobuf::internal::TSanRead(&_impl_);
-  return _impl_.name_.Get();
-}
-inline void ChatMessage::_internal_set_name(const std::string& value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.name_.Set(value, GetArena());
-}
-inline std::string* ChatMessage::_internal_mutable_name() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  return _impl_.name_.Mutable( GetArena());
-}
-inline std::string* ChatMessage::release_name() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  // @@protoc_insertion_point(field_release:chat.ChatMessage.name)
-  return _impl_.name_.Release();
-}
-inline void ChatMessage::set_allocated_name(std::string* value) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.name_.SetAllocated(value, GetArena());
-  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-        if (_impl_.name_.IsDefault()) {
-          _impl_.name_.Set("", GetArena());
-        }
-  #endif  // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  // @@protoc_insertion_point(field_set_allocated:chat.ChatMessage.name)
-}
+  private:
+  void SharedCtor(::google::protobuf::Arena* arena);
+  void SharedDtor();
+  void InternalSwap(MessageTrace* other);
+ private:
+  friend class ::google::protobuf::internal::AnyMetadata;
+  static ::absl::string_view FullMessageName() { return "chat.MessageTrace"; }
 
-// string message = 2;
-inline void ChatMessage::clear_message() {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.message_.ClearToEmpty();
-}
-inline const std::string& ChatMessage::message() const
-    ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  // @@protoc_insertion_point(field_get:chat.ChatMessage.message)
-  return _internal_message();
-}
-template <typename Arg_, typename... Args_>
-inline PROTOBUF_ALWAYS_INLINE void ChatMessage::set_message(Arg_&& arg,
-                                                     Args_... args) {
-  ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.message_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
-  // @@protoc_insertion_point(field_set:chat.ChatMessage.message)
-}
-inline std::string* ChatMessage::mutable_message() ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  std::string* _s = _internal_mutable_message();
-  // @@protoc_insertion_point(field_mutable:chat.ChatMessage.message)
+ protected:
+  explicit MessageTrace(::google::protobuf::Arena* arena);
+  MessageTrace(::google::protobuf::Arena* arena, const MessageTrace& from);
+  MessageTrace(::google::protobuf::Arena* arena, MessageTrace&& from) noexcept
+      : MessageTrace(arena) {
+    *this = ::std::move(from);
+  }
+  const ::google::protobuf::Message::ClassData* GetClassData() const final;
+
+ public:
+  ::google::protobuf::Metadata GetMetadata() const;
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+  enum : int {
+    kReceivedNsFieldNumber = 1,
+    kAppendedNsFieldNumber = 2,
+    kPickedNsFieldNumber = 3,
+    kWriteNsFieldNumber = 4,
+  };
+  // uint64 received_ns = 1;
+  void clear_received_ns() ;
+  ::uint64_t received_ns() const;
+  void set_received_ns(::uint64_t value);
+
+  private:
+  ::uint64_t _internal_received_ns() const;
+  void _internal_set_received_ns(::uint64_t value);
+
+  public:
+  // uint64 appended_ns = 2;
+  void clear_appended_ns() ;
+  ::uint64_t appended_ns() const;
+  void set_appended_ns(::uint64_t value);
+
+  private:
+  ::uint64_t _internal_appended_ns() const;
+  void _internal_set_appended_ns(::uint64_t value);
+
+  public:
+  // uint64 picked_ns = 3;
+  void clear_picked_ns() ;
+  ::uint64_t picked_ns() const;
+  void set_picked_ns(::uint64_t value);
+
+  private:
+  ::uint64_t _internal_picked_ns() const;
+  void _internal_set_picked_ns(::uint64_t value);
+
+  public:
+  // uint64 write_ns = 4;
+  void clear_write_ns() ;
+  ::uint64_t write_ns() const;
+  void set_write_ns(::uint64_t value);
+
+  private:
+  ::uint64_t _internal_write_ns() const;
+  void _internal_set_write_ns(::uint64_t value);
+
+  public:
+  // @@protoc_insertion_point(class_scope:chat.MessageTrace)
+ private:
+  class _Internal;
+  friend class ::google::protobuf::internal::TcParser;
+  static const ::google::protobuf::internal::TcParseTable<
+      2, 4, 0,
+      0, 2>
+      _table_;
+
+  static constexpr const void* _raw_default_instance_ =
+      &_MessageTrace_default_instance_;
+
+  friend class ::google::protobuf::MessageLite;
+  friend class ::google::protobuf::Arena;
+  template <typename T>
+  friend class ::google::protobuf::Arena::InternalHelper;
+  using InternalArenaConstructable_ = void;
+  using DestructorSkippable_ = void;
+  struct Impl_ {
+    inline explicit constexpr Impl_(
+        ::google::protobuf::internal::ConstantInitialized) noexcept;
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena);
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena, const Impl_& from,
+                          const MessageTrace& from_msg);
+    ::uint64_t received_ns_;
+    ::uint64_t appended_ns_;
+    ::uint64_t picked_ns_;
+    ::uint64_t write_ns_;
+    mutable ::google::protobuf::internal::CachedSize _cached_size_;
+    PROTOBUF_TSAN_DECLARE_MEMBER
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_proto_2fchatservice_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ChatMessage final : public ::google::protobuf::Message
+/* @@protoc_insertion_point(class_definition:chat.ChatMessage) */ {
+ public:
+  inline ChatMessage() : ChatMessage(nullptr) {}
+  ~ChatMessage() override;
+  template <typename = void>
+  explicit PROTOBUF_CONSTEXPR ChatMessage(
+      ::google::protobuf::internal::ConstantInitialized);
+
+  inline ChatMessage(const ChatMessage& from) : ChatMessage(nullptr, from) {}
+  inline ChatMessage(ChatMessage&& from) noexcept
+      : ChatMessage(nullptr, std::move(from)) {}
+  inline ChatMessage& operator=(const ChatMessage& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ChatMessage& operator=(ChatMessage&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetArena() == from.GetArena()
+#ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetArena() != nullptr
+#endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields()
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::google::protobuf::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::google::protobuf::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ChatMessage& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ChatMessage* internal_default_instance() {
+    return reinterpret_cast<const ChatMessage*>(
+        &_ChatMessage_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages = 1;
+  friend void swap(ChatMessage& a, ChatMessage& b) { a.Swap(&b); }
+  inline void Swap(ChatMessage* other) {
+    if (other == this) return;
+#ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() != nullptr && GetArena() == other->GetArena()) {
+#else   // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() == other->GetArena()) {
+#endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::google::protobuf::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ChatMessage* other) {
+    if (other == this) return;
+    ABSL_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ChatMessage* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return ::google::protobuf::Message::DefaultConstruct<ChatMessage>(arena);
+  }
+  using ::google::protobuf::Message::CopyFrom;
+  void CopyFrom(const ChatMessage& from);
+  using ::google::protobuf::Message::MergeFrom;
+  void MergeFrom(const ChatMessage& from) { ChatMessage::MergeImpl(*this, from); }
+
+  private:
+  static void MergeImpl(
+      ::google::protobuf::MessageLite& to_msg,
+      const ::google::protobuf::MessageLite& from_msg);
+
+  public:
+  bool IsInitialized() const {
+    return true;
+  }
+  ABSL_ATTRIBUTE_REINITIALIZES void Clear() final;
+  ::size_t ByteSizeLong() const final;
+  ::uint8_t* _InternalSerialize(
+      ::uint8_t* target,
+      ::google::protobuf::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::google::protobuf::Arena* arena);
+  void SharedDtor();
+  void InternalSwap(ChatMessage* other);
+ private:
+  friend class ::google::protobuf::internal::AnyMetadata;
+  static ::absl::string_view FullMessageName() { return "chat.ChatMessage"; }
+
+ protected:
+  explicit ChatMessage(::google::protobuf::Arena* arena);
+  ChatMessage(::google::protobuf::Arena* arena, const ChatMessage& from);
+  ChatMessage(::google::protobuf::Arena* arena, ChatMessage&& from) noexcept
+      : ChatMessage(arena) {
+    *this = ::std::move(from);
+  }
+  const ::google::protobuf::Message::ClassData* GetClassData() const final;
+
+ public:
+  ::google::protobuf::Metadata GetMetadata() const;
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+  enum : int {
+    kNameFieldNumber = 1,
+    kMessageFieldNumber = 2,
+    kRoomFieldNumber = 4,
+    kTraceFieldNumber = 5,
+    kSeqFieldNumber = 3,
+  };
+  // string name = 1;
+  void clear_name() ;
+  const std::string& name() const;
+  template <typename Arg_ = const std::string&, typename... Args_>
+  void set_name(Arg_&& arg, Args_... args);
+  std::string* mutable_name();
+  PROTOBUF_NODISCARD std::string* release_name();
+  void set_allocated_name(std::string* value);
+
+  private:
+  const std::string& _internal_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(
+      const std::string& value);
+  std::string* _internal_mutable_name();
+
+  public:
+  // string message = 2;
+  void clear_message() ;
+  const std::string& message() const;
+  template <typename Arg_ = const std::string&, typename... Args_>
+  void set_message(Arg_&& arg, Args_... args);
+  std::string* mutable_message();
+  PROTOBUF_NODISCARD std::string* release_message();
+  void set_allocated_message(std::string* value);
+
+  private:
+  const std::string& _internal_message() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_message(
+      const std::string& value);
+  std::string* _internal_mutable_message();
+
+  public:
+  // string room = 4;
+  void clear_room() ;
+  const std::string& room() const;
+  template <typename Arg_ = const std::string&, typename... Args_>
+  void set_room(Arg_&& arg, Args_... args);
+  std::string* mutable_room();
+  PROTOBUF_NODISCARD std::string* release_room();
+  void set_allocated_room(std::string* value);
+
+  private:
+  const std::string& _internal_room() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_room(
+      const std::string& value);
+  std::string* _internal_mutable_room();
+
+  public:
+  // .chat.MessageTrace trace = 5;
+  bool has_trace() const;
+  void clear_trace() ;
+  const ::chat::MessageTrace& trace() const;
+  PROTOBUF_NODISCARD ::chat::MessageTrace* release_trace();
+  ::chat::MessageTrace* mutable_trace();
+  void set_allocated_trace(::chat::MessageTrace* value);
+  void unsafe_arena_set_allocated_trace(::chat::MessageTrace* value);
+  ::chat::MessageTrace* unsafe_arena_release_trace();
+
+  private:
+  const ::chat::MessageTrace& _internal_trace() const;
+  ::chat::MessageTrace* _internal_mutable_trace();
+
+  public:
+  // uint64 seq = 3;
+  void clear_seq() ;
+  ::uint64_t seq() const;
+  void set_seq(::uint64_t value);
+
+  private:
+  ::uint64_t _internal_seq() const;
+  void _internal_set_seq(::uint64_t value);
+
+  public:
+  // @@protoc_insertion_point(class_scope:chat.ChatMessage)
+ private:
+  class _Internal;
+  friend class ::google::protobuf::internal::TcParser;
+  static const ::google::protobuf::internal::TcParseTable<
+      3, 5, 1,
+      40, 2>
+      _table_;
+
+  static constexpr const void* _raw_default_instance_ =
+      &_ChatMessage_default_instance_;
+
+  friend class ::google::protobuf::MessageLite;
+  friend class ::google::protobuf::Arena;
+  template <typename T>
+  friend class ::google::protobuf::Arena::InternalHelper;
+  using InternalArenaConstructable_ = void;
+  using DestructorSkippable_ = void;
+  struct Impl_ {
+    inline explicit constexpr Impl_(
+        ::google::protobuf::internal::ConstantInitialized) noexcept;
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena);
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena, const Impl_& from,
+                          const ChatMessage& from_msg);
+    ::google::protobuf::internal::HasBits<1> _has_bits_;
+    mutable ::google::protobuf::internal::CachedSize _cached_size_;
+    ::google::protobuf::internal::ArenaStringPtr name_;
+    ::google::protobuf::internal::ArenaStringPtr message_;
+    ::google::protobuf::internal::ArenaStringPtr room_;
+    ::chat::MessageTrace* trace_;
+    ::uint64_t seq_;
+    PROTOBUF_TSAN_DECLARE_MEMBER
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_proto_2fchatservice_2eproto;
+};
+// -------------------------------------------------------------------
+
+class RelayBatch final : public ::google::protobuf::Message
+/* @@protoc_insertion_point(class_definition:chat.RelayBatch) */ {
+ public:
+  inline RelayBatch() : RelayBatch(nullptr) {}
+  ~RelayBatch() override;
+  template <typename = void>
+  explicit PROTOBUF_CONSTEXPR RelayBatch(
+      ::google::protobuf::internal::ConstantInitialized);
+
+  inline RelayBatch(const RelayBatch& from) : RelayBatch(nullptr, from) {}
+  inline RelayBatch(RelayBatch&& from) noexcept
+      : RelayBatch(nullptr, std::move(from)) {}
+  inline RelayBatch& operator=(const RelayBatch& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline RelayBatch& operator=(RelayBatch&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetArena() == from.GetArena()
+#ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetArena() != nullptr
+#endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields()
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::google::protobuf::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::google::protobuf::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const RelayBatch& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const RelayBatch* internal_default_instance() {
+    return reinterpret_cast<const RelayBatch*>(
+        &_RelayBatch_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages = 7;
+  friend void swap(RelayBatch& a, RelayBatch& b) { a.Swap(&b); }
+  inline void Swap(RelayBatch* other) {
+    if (other == this) return;
+#ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() != nullptr && GetArena() == other->GetArena()) {
+#else   // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() == other->GetArena()) {
+#endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::google::protobuf::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(RelayBatch* other) {
+    if (other == this) return;
+    ABSL_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  RelayBatch* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return ::google::protobuf::Message::DefaultConstruct<RelayBatch>(arena);
+  }
+  using ::google::protobuf::Message::CopyFrom;
+  void CopyFrom(const RelayBatch& from);
+  using ::google::protobuf::Message::MergeFrom;
+  void MergeFrom(const RelayBatch& from) { RelayBatch::MergeImpl(*this, from); }
+
+  private:
+  static void MergeImpl(
+      ::google::protobuf::MessageLite& to_msg,
+      const ::google::protobuf::MessageLite& from_msg);
+
+  public:
+  bool IsInitialized() const {
+    return true;
+  }
+  ABSL_ATTRIBUTE_REINITIALIZES void Clear() final;
+  ::size_t ByteSizeLong() const final;
+  ::uint8_t* _InternalSerialize(
+      ::uint8_t* target,
+      ::google::protobuf::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::google::protobuf::Arena* arena);
+  void SharedDtor();
+  void InternalSwap(RelayBatch* other);
+ private:
+  friend class ::google::protobuf::internal::AnyMetadata;
+  static ::absl::string_view FullMessageName() { return "chat.RelayBatch"; }
+
+ protected:
+  explicit RelayBatch(::google::protobuf::Arena* arena);
+  RelayBatch(::google::protobuf::Arena* arena, const RelayBatch& from);
+  RelayBatch(::google::protobuf::Arena* arena, RelayBatch&& from) noexcept
+      : RelayBatch(arena) {
+    *this = ::std::move(from);
+  }
+  const ::google::protobuf::Message::ClassData* GetClassData() const final;
+
+ public:
+  ::google::protobuf::Metadata GetMetadata() const;
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+  enum : int {
+    kMessagesFieldNumber = 1,
+    kEndFieldNumber = 2,
+  };
+  // repeated .chat.ChatMessage messages = 1;
+  int messages_size() const;
+  private:
+  int _internal_messages_size() const;
+
+  public:
+  void clear_messages() ;
+  ::chat::ChatMessage* mutable_messages(int index);
+  ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>* mutable_messages();
+
+  private:
+  const ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>& _internal_messages() const;
+  ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>* _internal_mutable_messages();
+  public:
+  const ::chat::ChatMessage& messages(int index) const;
+  ::chat::ChatMessage* add_messages();
+  const ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>& messages() const;
+  // uint64 end = 2;
+  void clear_end() ;
+  ::uint64_t end() const;
+  void set_end(::uint64_t value);
+
+  private:
+  ::uint64_t _internal_end() const;
+  void _internal_set_end(::uint64_t value);
+
+  public:
+  // @@protoc_insertion_point(class_scope:chat.RelayBatch)
+ private:
+  class _Internal;
+  friend class ::google::protobuf::internal::TcParser;
+  static const ::google::protobuf::internal::TcParseTable<
+      1, 2, 1,
+      0, 2>
+      _table_;
+
+  static constexpr const void* _raw_default_instance_ =
+      &_RelayBatch_default_instance_;
+
+  friend class ::google::protobuf::MessageLite;
+  friend class ::google::protobuf::Arena;
+  template <typename T>
+  friend class ::google::protobuf::Arena::InternalHelper;
+  using InternalArenaConstructable_ = void;
+  using DestructorSkippable_ = void;
+  struct Impl_ {
+    inline explicit constexpr Impl_(
+        ::google::protobuf::internal::ConstantInitialized) noexcept;
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena);
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena, const Impl_& from,
+                          const RelayBatch& from_msg);
+    ::google::protobuf::RepeatedPtrField< ::chat::ChatMessage > messages_;
+    ::uint64_t end_;
+    mutable ::google::protobuf::internal::CachedSize _cached_size_;
+    PROTOBUF_TSAN_DECLARE_MEMBER
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_proto_2fchatservice_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ReplicatedMessage final : public ::google::protobuf::Message
+/* @@protoc_insertion_point(class_definition:chat.ReplicatedMessage) */ {
+ public:
+  inline ReplicatedMessage() : ReplicatedMessage(nullptr) {}
+  ~ReplicatedMessage() override;
+  template <typename = void>
+  explicit PROTOBUF_CONSTEXPR ReplicatedMessage(
+      ::google::protobuf::internal::ConstantInitialized);
+
+  inline ReplicatedMessage(const ReplicatedMessage& from) : ReplicatedMessage(nullptr, from) {}
+  inline ReplicatedMessage(ReplicatedMessage&& from) noexcept
+      : ReplicatedMessage(nullptr, std::move(from)) {}
+  inline ReplicatedMessage& operator=(const ReplicatedMessage& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ReplicatedMessage& operator=(ReplicatedMessage&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetArena() == from.GetArena()
+#ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetArena() != nullptr
+#endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields()
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::google::protobuf::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::google::protobuf::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ReplicatedMessage& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ReplicatedMessage* internal_default_instance() {
+    return reinterpret_cast<const ReplicatedMessage*>(
+        &_ReplicatedMessage_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages = 5;
+  friend void swap(ReplicatedMessage& a, ReplicatedMessage& b) { a.Swap(&b); }
+  inline void Swap(ReplicatedMessage* other) {
+    if (other == this) return;
+#ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() != nullptr && GetArena() == other->GetArena()) {
+#else   // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() == other->GetArena()) {
+#endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::google::protobuf::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ReplicatedMessage* other) {
+    if (other == this) return;
+    ABSL_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ReplicatedMessage* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return ::google::protobuf::Message::DefaultConstruct<ReplicatedMessage>(arena);
+  }
+  using ::google::protobuf::Message::CopyFrom;
+  void CopyFrom(const ReplicatedMessage& from);
+  using ::google::protobuf::Message::MergeFrom;
+  void MergeFrom(const ReplicatedMessage& from) { ReplicatedMessage::MergeImpl(*this, from); }
+
+  private:
+  static void MergeImpl(
+      ::google::protobuf::MessageLite& to_msg,
+      const ::google::protobuf::MessageLite& from_msg);
+
+  public:
+  bool IsInitialized() const {
+    return true;
+  }
+  ABSL_ATTRIBUTE_REINITIALIZES void Clear() final;
+  ::size_t ByteSizeLong() const final;
+  ::uint8_t* _InternalSerialize(
+      ::uint8_t* target,
+      ::google::protobuf::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::google::protobuf::Arena* arena);
+  void SharedDtor();
+  void InternalSwap(ReplicatedMessage* other);
+ private:
+  friend class ::google::protobuf::internal::AnyMetadata;
+  static ::absl::string_view FullMessageName() { return "chat.ReplicatedMessage"; }
+
+ protected:
+  explicit ReplicatedMessage(::google::protobuf::Arena* arena);
+  ReplicatedMessage(::google::protobuf::Arena* arena, const ReplicatedMessage& from);
+  ReplicatedMessage(::google::protobuf::Arena* arena, ReplicatedMessage&& from) noexcept
+      : ReplicatedMessage(arena) {
+    *this = ::std::move(from);
+  }
+  const ::google::protobuf::Message::ClassData* GetClassData() const final;
+
+ public:
+  ::google::protobuf::Metadata GetMetadata() const;
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+  enum : int {
+    kMessageFieldNumber = 1,
+    kPositionFieldNumber = 3,
+  };
+  // .chat.ChatMessage message = 1;
+  bool has_message() const;
+  void clear_message() ;
+  const ::chat::ChatMessage& message() const;
+  PROTOBUF_NODISCARD ::chat::ChatMessage* release_message();
+  ::chat::ChatMessage* mutable_message();
+  void set_allocated_message(::chat::ChatMessage* value);
+  void unsafe_arena_set_allocated_message(::chat::ChatMessage* value);
+  ::chat::ChatMessage* unsafe_arena_release_message();
+
+  private:
+  const ::chat::ChatMessage& _internal_message() const;
+  ::chat::ChatMessage* _internal_mutable_message();
+
+  public:
+  // uint64 position = 3;
+  void clear_position() ;
+  ::uint64_t position() const;
+  void set_position(::uint64_t value);
+
+  private:
+  ::uint64_t _internal_position() const;
+  void _internal_set_position(::uint64_t value);
+
+  public:
+  // @@protoc_insertion_point(class_scope:chat.ReplicatedMessage)
+ private:
+  class _Internal;
+  friend class ::google::protobuf::internal::TcParser;
+  static const ::google::protobuf::internal::TcParseTable<
+      2, 2, 1,
+      0, 2>
+      _table_;
+
+  static constexpr const void* _raw_default_instance_ =
+      &_ReplicatedMessage_default_instance_;
+
+  friend class ::google::protobuf::MessageLite;
+  friend class ::google::protobuf::Arena;
+  template <typename T>
+  friend class ::google::protobuf::Arena::InternalHelper;
+  using InternalArenaConstructable_ = void;
+  using DestructorSkippable_ = void;
+  struct Impl_ {
+    inline explicit constexpr Impl_(
+        ::google::protobuf::internal::ConstantInitialized) noexcept;
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena);
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena, const Impl_& from,
+                          const ReplicatedMessage& from_msg);
+    ::google::protobuf::internal::HasBits<1> _has_bits_;
+    mutable ::google::protobuf::internal::CachedSize _cached_size_;
+    ::chat::ChatMessage* message_;
+    ::uint64_t position_;
+    PROTOBUF_TSAN_DECLARE_MEMBER
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_proto_2fchatservice_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ReplicatedBatch final : public ::google::protobuf::Message
+/* @@protoc_insertion_point(class_definition:chat.ReplicatedBatch) */ {
+ public:
+  inline ReplicatedBatch() : ReplicatedBatch(nullptr) {}
+  ~ReplicatedBatch() override;
+  template <typename = void>
+  explicit PROTOBUF_CONSTEXPR ReplicatedBatch(
+      ::google::protobuf::internal::ConstantInitialized);
+
+  inline ReplicatedBatch(const ReplicatedBatch& from) : ReplicatedBatch(nullptr, from) {}
+  inline ReplicatedBatch(ReplicatedBatch&& from) noexcept
+      : ReplicatedBatch(nullptr, std::move(from)) {}
+  inline ReplicatedBatch& operator=(const ReplicatedBatch& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ReplicatedBatch& operator=(ReplicatedBatch&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetArena() == from.GetArena()
+#ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetArena() != nullptr
+#endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields()
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::google::protobuf::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::google::protobuf::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ReplicatedBatch& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ReplicatedBatch* internal_default_instance() {
+    return reinterpret_cast<const ReplicatedBatch*>(
+        &_ReplicatedBatch_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages = 6;
+  friend void swap(ReplicatedBatch& a, ReplicatedBatch& b) { a.Swap(&b); }
+  inline void Swap(ReplicatedBatch* other) {
+    if (other == this) return;
+#ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() != nullptr && GetArena() == other->GetArena()) {
+#else   // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() == other->GetArena()) {
+#endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::google::protobuf::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ReplicatedBatch* other) {
+    if (other == this) return;
+    ABSL_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ReplicatedBatch* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return ::google::protobuf::Message::DefaultConstruct<ReplicatedBatch>(arena);
+  }
+  using ::google::protobuf::Message::CopyFrom;
+  void CopyFrom(const ReplicatedBatch& from);
+  using ::google::protobuf::Message::MergeFrom;
+  void MergeFrom(const ReplicatedBatch& from) { ReplicatedBatch::MergeImpl(*this, from); }
+
+  private:
+  static void MergeImpl(
+      ::google::protobuf::MessageLite& to_msg,
+      const ::google::protobuf::MessageLite& from_msg);
+
+  public:
+  bool IsInitialized() const {
+    return true;
+  }
+  ABSL_ATTRIBUTE_REINITIALIZES void Clear() final;
+  ::size_t ByteSizeLong() const final;
+  ::uint8_t* _InternalSerialize(
+      ::uint8_t* target,
+      ::google::protobuf::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::google::protobuf::Arena* arena);
+  void SharedDtor();
+  void InternalSwap(ReplicatedBatch* other);
+ private:
+  friend class ::google::protobuf::internal::AnyMetadata;
+  static ::absl::string_view FullMessageName() { return "chat.ReplicatedBatch"; }
+
+ protected:
+  explicit ReplicatedBatch(::google::protobuf::Arena* arena);
+  ReplicatedBatch(::google::protobuf::Arena* arena, const ReplicatedBatch& from);
+  ReplicatedBatch(::google::protobuf::Arena* arena, ReplicatedBatch&& from) noexcept
+      : ReplicatedBatch(arena) {
+    *this = ::std::move(from);
+  }
+  const ::google::protobuf::Message::ClassData* GetClassData() const final;
+
+ public:
+  ::google::protobuf::Metadata GetMetadata() const;
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+  enum : int {
+    kMessagesFieldNumber = 1,
+    kEndFieldNumber = 2,
+  };
+  // repeated .chat.ReplicatedMessage messages = 1;
+  int messages_size() const;
+  private:
+  int _internal_messages_size() const;
+
+  public:
+  void clear_messages() ;
+  ::chat::ReplicatedMessage* mutable_messages(int index);
+  ::google::protobuf::RepeatedPtrField<::chat::ReplicatedMessage>* mutable_messages();
+
+  private:
+  const ::google::protobuf::RepeatedPtrField<::chat::ReplicatedMessage>& _internal_messages() const;
+  ::google::protobuf::RepeatedPtrField<::chat::ReplicatedMessage>* _internal_mutable_messages();
+  public:
+  const ::chat::ReplicatedMessage& messages(int index) const;
+  ::chat::ReplicatedMessage* add_messages();
+  const ::google::protobuf::RepeatedPtrField<::chat::ReplicatedMessage>& messages() const;
+  // uint64 end = 2;
+  void clear_end() ;
+  ::uint64_t end() const;
+  void set_end(::uint64_t value);
+
+  private:
+  ::uint64_t _internal_end() const;
+  void _internal_set_end(::uint64_t value);
+
+  public:
+  // @@protoc_insertion_point(class_scope:chat.ReplicatedBatch)
+ private:
+  class _Internal;
+  friend class ::google::protobuf::internal::TcParser;
+  static const ::google::protobuf::internal::TcParseTable<
+      1, 2, 1,
+      0, 2>
+      _table_;
+
+  static constexpr const void* _raw_default_instance_ =
+      &_ReplicatedBatch_default_instance_;
+
+  friend class ::google::protobuf::MessageLite;
+  friend class ::google::protobuf::Arena;
+  template <typename T>
+  friend class ::google::protobuf::Arena::InternalHelper;
+  using InternalArenaConstructable_ = void;
+  using DestructorSkippable_ = void;
+  struct Impl_ {
+    inline explicit constexpr Impl_(
+        ::google::protobuf::internal::ConstantInitialized) noexcept;
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena);
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena, const Impl_& from,
+                          const ReplicatedBatch& from_msg);
+    ::google::protobuf::RepeatedPtrField< ::chat::ReplicatedMessage > messages_;
+    ::uint64_t end_;
+    mutable ::google::protobuf::internal::CachedSize _cached_size_;
+    PROTOBUF_TSAN_DECLARE_MEMBER
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_proto_2fchatservice_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ChatMessageBatch final : public ::google::protobuf::Message
+/* @@protoc_insertion_point(class_definition:chat.ChatMessageBatch) */ {
+ public:
+  inline ChatMessageBatch() : ChatMessageBatch(nullptr) {}
+  ~ChatMessageBatch() override;
+  template <typename = void>
+  explicit PROTOBUF_CONSTEXPR ChatMessageBatch(
+      ::google::protobuf::internal::ConstantInitialized);
+
+  inline ChatMessageBatch(const ChatMessageBatch& from) : ChatMessageBatch(nullptr, from) {}
+  inline ChatMessageBatch(ChatMessageBatch&& from) noexcept
+      : ChatMessageBatch(nullptr, std::move(from)) {}
+  inline ChatMessageBatch& operator=(const ChatMessageBatch& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ChatMessageBatch& operator=(ChatMessageBatch&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetArena() == from.GetArena()
+#ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetArena() != nullptr
+#endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields()
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::google::protobuf::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::google::protobuf::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ChatMessageBatch& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ChatMessageBatch* internal_default_instance() {
+    return reinterpret_cast<const ChatMessageBatch*>(
+        &_ChatMessageBatch_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages = 4;
+  friend void swap(ChatMessageBatch& a, ChatMessageBatch& b) { a.Swap(&b); }
+  inline void Swap(ChatMessageBatch* other) {
+    if (other == this) return;
+#ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() != nullptr && GetArena() == other->GetArena()) {
+#else   // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() == other->GetArena()) {
+#endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::google::protobuf::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ChatMessageBatch* other) {
+    if (other == this) return;
+    ABSL_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ChatMessageBatch* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return ::google::protobuf::Message::DefaultConstruct<ChatMessageBatch>(arena);
+  }
+  using ::google::protobuf::Message::CopyFrom;
+  void CopyFrom(const ChatMessageBatch& from);
+  using ::google::protobuf::Message::MergeFrom;
+  void MergeFrom(const ChatMessageBatch& from) { ChatMessageBatch::MergeImpl(*this, from); }
+
+  private:
+  static void MergeImpl(
+      ::google::protobuf::MessageLite& to_msg,
+      const ::google::protobuf::MessageLite& from_msg);
+
+  public:
+  bool IsInitialized() const {
+    return true;
+  }
+  ABSL_ATTRIBUTE_REINITIALIZES void Clear() final;
+  ::size_t ByteSizeLong() const final;
+  ::uint8_t* _InternalSerialize(
+      ::uint8_t* target,
+      ::google::protobuf::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::google::protobuf::Arena* arena);
+  void SharedDtor();
+  void InternalSwap(ChatMessageBatch* other);
+ private:
+  friend class ::google::protobuf::internal::AnyMetadata;
+  static ::absl::string_view FullMessageName() { return "chat.ChatMessageBatch"; }
+
+ protected:
+  explicit ChatMessageBatch(::google::protobuf::Arena* arena);
+  ChatMessageBatch(::google::protobuf::Arena* arena, const ChatMessageBatch& from);
+  ChatMessageBatch(::google::protobuf::Arena* arena, ChatMessageBatch&& from) noexcept
+      : ChatMessageBatch(arena) {
+    *this = ::std::move(from);
+  }
+  const ::google::protobuf::Message::ClassData* GetClassData() const final;
+
+ public:
+  ::google::protobuf::Metadata GetMetadata() const;
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+  enum : int {
+    kMessagesFieldNumber = 1,
+  };
+  // repeated .chat.ChatMessage messages = 1;
+  int messages_size() const;
+  private:
+  int _internal_messages_size() const;
+
+  public:
+  void clear_messages() ;
+  ::chat::ChatMessage* mutable_messages(int index);
+  ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>* mutable_messages();
+
+  private:
+  const ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>& _internal_messages() const;
+  ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>* _internal_mutable_messages();
+  public:
+  const ::chat::ChatMessage& messages(int index) const;
+  ::chat::ChatMessage* add_messages();
+  const ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>& messages() const;
+  // @@protoc_insertion_point(class_scope:chat.ChatMessageBatch)
+ private:
+  class _Internal;
+  friend class ::google::protobuf::internal::TcParser;
+  static const ::google::protobuf::internal::TcParseTable<
+      0, 1, 1,
+      0, 2>
+      _table_;
+
+  static constexpr const void* _raw_default_instance_ =
+      &_ChatMessageBatch_default_instance_;
+
+  friend class ::google::protobuf::MessageLite;
+  friend class ::google::protobuf::Arena;
+  template <typename T>
+  friend class ::google::protobuf::Arena::InternalHelper;
+  using InternalArenaConstructable_ = void;
+  using DestructorSkippable_ = void;
+  struct Impl_ {
+    inline explicit constexpr Impl_(
+        ::google::protobuf::internal::ConstantInitialized) noexcept;
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena);
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena, const Impl_& from,
+                          const ChatMessageBatch& from_msg);
+    ::google::protobuf::RepeatedPtrField< ::chat::ChatMessage > messages_;
+    mutable ::google::protobuf::internal::CachedSize _cached_size_;
+    PROTOBUF_TSAN_DECLARE_MEMBER
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_proto_2fchatservice_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ChatFilter final : public ::google::protobuf::Message
+/* @@protoc_insertion_point(class_definition:chat.ChatFilter) */ {
+ public:
+  inline ChatFilter() : ChatFilter(nullptr) {}
+  ~ChatFilter() override;
+  template <typename = void>
+  explicit PROTOBUF_CONSTEXPR ChatFilter(
+      ::google::protobuf::internal::ConstantInitialized);
+
+  inline ChatFilter(const ChatFilter& from) : ChatFilter(nullptr, from) {}
+  inline ChatFilter(ChatFilter&& from) noexcept
+      : ChatFilter(nullptr, std::move(from)) {}
+  inline ChatFilter& operator=(const ChatFilter& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ChatFilter& operator=(ChatFilter&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetArena() == from.GetArena()
+#ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetArena() != nullptr
+#endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields()
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::google::protobuf::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::google::protobuf::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ChatFilter& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ChatFilter* internal_default_instance() {
+    return reinterpret_cast<const ChatFilter*>(
+        &_ChatFilter_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages = 2;
+  friend void swap(ChatFilter& a, ChatFilter& b) { a.Swap(&b); }
+  inline void Swap(ChatFilter* other) {
+    if (other == this) return;
+#ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() != nullptr && GetArena() == other->GetArena()) {
+#else   // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() == other->GetArena()) {
+#endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::google::protobuf::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ChatFilter* other) {
+    if (other == this) return;
+    ABSL_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ChatFilter* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return ::google::protobuf::Message::DefaultConstruct<ChatFilter>(arena);
+  }
+  using ::google::protobuf::Message::CopyFrom;
+  void CopyFrom(const ChatFilter& from);
+  using ::google::protobuf::Message::MergeFrom;
+  void MergeFrom(const ChatFilter& from) { ChatFilter::MergeImpl(*this, from); }
+
+  private:
+  static void MergeImpl(
+      ::google::protobuf::MessageLite& to_msg,
+      const ::google::protobuf::MessageLite& from_msg);
+
+  public:
+  bool IsInitialized() const {
+    return true;
+  }
+  ABSL_ATTRIBUTE_REINITIALIZES void Clear() final;
+  ::size_t ByteSizeLong() const final;
+  ::uint8_t* _InternalSerialize(
+      ::uint8_t* target,
+      ::google::protobuf::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::google::protobuf::Arena* arena);
+  void SharedDtor();
+  void InternalSwap(ChatFilter* other);
+ private:
+  friend class ::google::protobuf::internal::AnyMetadata;
+  static ::absl::string_view FullMessageName() { return "chat.ChatFilter"; }
+
+ protected:
+  explicit ChatFilter(::google::protobuf::Arena* arena);
+  ChatFilter(::google::protobuf::Arena* arena, const ChatFilter& from);
+  ChatFilter(::google::protobuf::Arena* arena, ChatFilter&& from) noexcept
+      : ChatFilter(arena) {
+    *this = ::std::move(from);
+  }
+  const ::google::protobuf::Message::ClassData* GetClassData() const final;
+
+ public:
+  ::google::protobuf::Metadata GetMetadata() const;
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+  enum : int {
+    kIncludeNamesFieldNumber = 1,
+    kExcludeNamesFieldNumber = 2,
+    kPrefixFieldNumber = 3,
+    kKeywordFieldNumber = 4,
+    kSystemOnlyFieldNumber = 5,
+  };
+  // repeated string include_names = 1;
+  int include_names_size() const;
+  private:
+  int _internal_include_names_size() const;
+
+  public:
+  void clear_include_names() ;
+  const std::string& include_names(int index) const;
+  std::string* mutable_include_names(int index);
+  template <typename Arg_ = const std::string&, typename... Args_>
+  void set_include_names(int index, Arg_&& value, Args_... args);
+  std::string* add_include_names();
+  template <typename Arg_ = const std::string&, typename... Args_>
+  void add_include_names(Arg_&& value, Args_... args);
+  const ::google::protobuf::RepeatedPtrField<std::string>& include_names() const;
+  ::google::protobuf::RepeatedPtrField<std::string>* mutable_include_names();
+
+  private:
+  const ::google::protobuf::RepeatedPtrField<std::string>& _internal_include_names() const;
+  ::google::protobuf::RepeatedPtrField<std::string>* _internal_mutable_include_names();
+
+  public:
+  // repeated string exclude_names = 2;
+  int exclude_names_size() const;
+  private:
+  int _internal_exclude_names_size() const;
+
+  public:
+  void clear_exclude_names() ;
+  const std::string& exclude_names(int index) const;
+  std::string* mutable_exclude_names(int index);
+  template <typename Arg_ = const std::string&, typename... Args_>
+  void set_exclude_names(int index, Arg_&& value, Args_... args);
+  std::string* add_exclude_names();
+  template <typename Arg_ = const std::string&, typename... Args_>
+  void add_exclude_names(Arg_&& value, Args_... args);
+  const ::google::protobuf::RepeatedPtrField<std::string>& exclude_names() const;
+  ::google::protobuf::RepeatedPtrField<std::string>* mutable_exclude_names();
+
+  private:
+  const ::google::protobuf::RepeatedPtrField<std::string>& _internal_exclude_names() const;
+  ::google::protobuf::RepeatedPtrField<std::string>* _internal_mutable_exclude_names();
+
+  public:
+  // string prefix = 3;
+  void clear_prefix() ;
+  const std::string& prefix() const;
+  template <typename Arg_ = const std::string&, typename... Args_>
+  void set_prefix(Arg_&& arg, Args_... args);
+  std::string* mutable_prefix();
+  PROTOBUF_NODISCARD std::string* release_prefix();
+  void set_allocated_prefix(std::string* value);
+
+  private:
+  const std::string& _internal_prefix() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_prefix(
+      const std::string& value);
+  std::string* _internal_mutable_prefix();
+
+  public:
+  // string keyword = 4;
+  void clear_keyword() ;
+  const std::string& keyword() const;
+  template <typename Arg_ = const std::string&, typename... Args_>
+  void set_keyword(Arg_&& arg, Args_... args);
+  std::string* mutable_keyword();
+  PROTOBUF_NODISCARD std::string* release_keyword();
+  void set_allocated_keyword(std::string* value);
+
+  private:
+  const std::string& _internal_keyword() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_keyword(
+      const std::string& value);
+  std::string* _internal_mutable_keyword();
+
+  public:
+  // bool system_only = 5;
+  void clear_system_only() ;
+  bool system_only() const;
+  void set_system_only(bool value);
+
+  private:
+  bool _internal_system_only() const;
+  void _internal_set_system_only(bool value);
+
+  public:
+  // @@protoc_insertion_point(class_scope:chat.ChatFilter)
+ private:
+  class _Internal;
+  friend class ::google::protobuf::internal::TcParser;
+  static const ::google::protobuf::internal::TcParseTable<
+      3, 5, 0,
+      64, 2>
+      _table_;
+
+  static constexpr const void* _raw_default_instance_ =
+      &_ChatFilter_default_instance_;
+
+  friend class ::google::protobuf::MessageLite;
+  friend class ::google::protobuf::Arena;
+  template <typename T>
+  friend class ::google::protobuf::Arena::InternalHelper;
+  using InternalArenaConstructable_ = void;
+  using DestructorSkippable_ = void;
+  struct Impl_ {
+    inline explicit constexpr Impl_(
+        ::google::protobuf::internal::ConstantInitialized) noexcept;
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena);
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena, const Impl_& from,
+                          const ChatFilter& from_msg);
+    ::google::protobuf::RepeatedPtrField<std::string> include_names_;
+    ::google::protobuf::RepeatedPtrField<std::string> exclude_names_;
+    ::google::protobuf::internal::ArenaStringPtr prefix_;
+    ::google::protobuf::internal::ArenaStringPtr keyword_;
+    bool system_only_;
+    mutable ::google::protobuf::internal::CachedSize _cached_size_;
+    PROTOBUF_TSAN_DECLARE_MEMBER
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_proto_2fchatservice_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ChatReader final : public ::google::protobuf::Message
+/* @@protoc_insertion_point(class_definition:chat.ChatReader) */ {
+ public:
+  inline ChatReader() : ChatReader(nullptr) {}
+  ~ChatReader() override;
+  template <typename = void>
+  explicit PROTOBUF_CONSTEXPR ChatReader(
+      ::google::protobuf::internal::ConstantInitialized);
+
+  inline ChatReader(const ChatReader& from) : ChatReader(nullptr, from) {}
+  inline ChatReader(ChatReader&& from) noexcept
+      : ChatReader(nullptr, std::move(from)) {}
+  inline ChatReader& operator=(const ChatReader& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ChatReader& operator=(ChatReader&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetArena() == from.GetArena()
+#ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetArena() != nullptr
+#endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields()
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::google::protobuf::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::google::protobuf::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ChatReader& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ChatReader* internal_default_instance() {
+    return reinterpret_cast<const ChatReader*>(
+        &_ChatReader_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages = 3;
+  friend void swap(ChatReader& a, ChatReader& b) { a.Swap(&b); }
+  inline void Swap(ChatReader* other) {
+    if (other == this) return;
+#ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() != nullptr && GetArena() == other->GetArena()) {
+#else   // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() == other->GetArena()) {
+#endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::google::protobuf::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ChatReader* other) {
+    if (other == this) return;
+    ABSL_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ChatReader* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return ::google::protobuf::Message::DefaultConstruct<ChatReader>(arena);
+  }
+  using ::google::protobuf::Message::CopyFrom;
+  void CopyFrom(const ChatReader& from);
+  using ::google::protobuf::Message::MergeFrom;
+  void MergeFrom(const ChatReader& from) { ChatReader::MergeImpl(*this, from); }
+
+  private:
+  static void MergeImpl(
+      ::google::protobuf::MessageLite& to_msg,
+      const ::google::protobuf::MessageLite& from_msg);
+
+  public:
+  bool IsInitialized() const {
+    return true;
+  }
+  ABSL_ATTRIBUTE_REINITIALIZES void Clear() final;
+  ::size_t ByteSizeLong() const final;
+  ::uint8_t* _InternalSerialize(
+      ::uint8_t* target,
+      ::google::protobuf::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::google::protobuf::Arena* arena);
+  void SharedDtor();
+  void InternalSwap(ChatReader* other);
+ private:
+  friend class ::google::protobuf::internal::AnyMetadata;
+  static ::absl::string_view FullMessageName() { return "chat.ChatReader"; }
+
+ protected:
+  explicit ChatReader(::google::protobuf::Arena* arena);
+  ChatReader(::google::protobuf::Arena* arena, const ChatReader& from);
+  ChatReader(::google::protobuf::Arena* arena, ChatReader&& from) noexcept
+      : ChatReader(arena) {
+    *this = ::std::move(from);
+  }
+  const ::google::protobuf::Message::ClassData* GetClassData() const final;
+
+ public:
+  ::google::protobuf::Metadata GetMetadata() const;
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+  enum : int {
+    kNameFieldNumber = 1,
+    kRoomFieldNumber = 6,
+    kFilterFieldNumber = 7,
+    kMaxBatchMessagesFieldNumber = 2,
+    kMaxBatchBytesFieldNumber = 3,
+    kSinceSeqFieldNumber = 4,
+    kTailNFieldNumber = 5,
+    kTraceFieldNumber = 8,
+  };
+  // string name = 1;
+  void clear_name() ;
+  const std::string& name() const;
+  template <typename Arg_ = const std::string&, typename... Args_>
+  void set_name(Arg_&& arg, Args_... args);
+  std::string* mutable_name();
+  PROTOBUF_NODISCARD std::string* release_name();
+  void set_allocated_name(std::string* value);
+
+  private:
+  const std::string& _internal_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(
+      const std::string& value);
+  std::string* _internal_mutable_name();
+
+  public:
+  // string room = 6;
+  void clear_room() ;
+  const std::string& room() const;
+  template <typename Arg_ = const std::string&, typename... Args_>
+  void set_room(Arg_&& arg, Args_... args);
+  std::string* mutable_room();
+  PROTOBUF_NODISCARD std::string* release_room();
+  void set_allocated_room(std::string* value);
+
+  private:
+  const std::string& _internal_room() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_room(
+      const std::string& value);
+  std::string* _internal_mutable_room();
+
+  public:
+  // .chat.ChatFilter filter = 7;
+  bool has_filter() const;
+  void clear_filter() ;
+  const ::chat::ChatFilter& filter() const;
+  PROTOBUF_NODISCARD ::chat::ChatFilter* release_filter();
+  ::chat::ChatFilter* mutable_filter();
+  void set_allocated_filter(::chat::ChatFilter* value);
+  void unsafe_arena_set_allocated_filter(::chat::ChatFilter* value);
+  ::chat::ChatFilter* unsafe_arena_release_filter();
+
+  private:
+  const ::chat::ChatFilter& _internal_filter() const;
+  ::chat::ChatFilter* _internal_mutable_filter();
+
+  public:
+  // uint32 max_batch_messages = 2;
+  void clear_max_batch_messages() ;
+  ::uint32_t max_batch_messages() const;
+  void set_max_batch_messages(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_max_batch_messages() const;
+  void _internal_set_max_batch_messages(::uint32_t value);
+
+  public:
+  // uint32 max_batch_bytes = 3;
+  void clear_max_batch_bytes() ;
+  ::uint32_t max_batch_bytes() const;
+  void set_max_batch_bytes(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_max_batch_bytes() const;
+  void _internal_set_max_batch_bytes(::uint32_t value);
+
+  public:
+  // uint64 since_seq = 4;
+  void clear_since_seq() ;
+  ::uint64_t since_seq() const;
+  void set_since_seq(::uint64_t value);
+
+  private:
+  ::uint64_t _internal_since_seq() const;
+  void _internal_set_since_seq(::uint64_t value);
+
+  public:
+  // uint32 tail_n = 5;
+  void clear_tail_n() ;
+  ::uint32_t tail_n() const;
+  void set_tail_n(::uint32_t value);
+
+  private:
+  ::uint32_t _internal_tail_n() const;
+  void _internal_set_tail_n(::uint32_t value);
+
+  public:
+  // bool trace = 8;
+  void clear_trace() ;
+  bool trace() const;
+  void set_trace(bool value);
+
+  private:
+  bool _internal_trace() const;
+  void _internal_set_trace(bool value);
+
+  public:
+  // @@protoc_insertion_point(class_scope:chat.ChatReader)
+ private:
+  class _Internal;
+  friend class ::google::protobuf::internal::TcParser;
+  static const ::google::protobuf::internal::TcParseTable<
+      3, 8, 1,
+      40, 2>
+      _table_;
+
+  static constexpr const void* _raw_default_instance_ =
+      &_ChatReader_default_instance_;
+
+  friend class ::google::protobuf::MessageLite;
+  friend class ::google::protobuf::Arena;
+  template <typename T>
+  friend class ::google::protobuf::Arena::InternalHelper;
+  using InternalArenaConstructable_ = void;
+  using DestructorSkippable_ = void;
+  struct Impl_ {
+    inline explicit constexpr Impl_(
+        ::google::protobuf::internal::ConstantInitialized) noexcept;
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena);
+    inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                          ::google::protobuf::Arena* arena, const Impl_& from,
+                          const ChatReader& from_msg);
+    ::google::protobuf::internal::HasBits<1> _has_bits_;
+    mutable ::google::protobuf::internal::CachedSize _cached_size_;
+    ::google::protobuf::internal::ArenaStringPtr name_;
+    ::google::protobuf::internal::ArenaStringPtr room_;
+    ::chat::ChatFilter* filter_;
+    ::uint32_t max_batch_messages_;
+    ::uint32_t max_batch_bytes_;
+    ::uint64_t since_seq_;
+    ::uint32_t tail_n_;
+    bool trace_;
+    PROTOBUF_TSAN_DECLARE_MEMBER
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_proto_2fchatservice_2eproto;
+};
+
+// ===================================================================
+
+
+
+
+// ===================================================================
+
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// -------------------------------------------------------------------
+
+// MessageTrace
+
+// uint64 received_ns = 1;
+inline void MessageTrace::clear_received_ns() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.received_ns_ = ::uint64_t{0u};
+}
+inline ::uint64_t MessageTrace::received_ns() const {
+  // @@protoc_insertion_point(field_get:chat.MessageTrace.received_ns)
+  return _internal_received_ns();
+}
+inline void MessageTrace::set_received_ns(::uint64_t value) {
+  _internal_set_received_ns(value);
+  // @@protoc_insertion_point(field_set:chat.MessageTrace.received_ns)
+}
+inline ::uint64_t MessageTrace::_internal_received_ns() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.received_ns_;
+}
+inline void MessageTrace::_internal_set_received_ns(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.received_ns_ = value;
+}
+
+// uint64 appended_ns = 2;
+inline void MessageTrace::clear_appended_ns() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.appended_ns_ = ::uint64_t{0u};
+}
+inline ::uint64_t MessageTrace::appended_ns() const {
+  // @@protoc_insertion_point(field_get:chat.MessageTrace.appended_ns)
+  return _internal_appended_ns();
+}
+inline void MessageTrace::set_appended_ns(::uint64_t value) {
+  _internal_set_appended_ns(value);
+  // @@protoc_insertion_point(field_set:chat.MessageTrace.appended_ns)
+}
+inline ::uint64_t MessageTrace::_internal_appended_ns() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.appended_ns_;
+}
+inline void MessageTrace::_internal_set_appended_ns(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.appended_ns_ = value;
+}
+
+// uint64 picked_ns = 3;
+inline void MessageTrace::clear_picked_ns() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.picked_ns_ = ::uint64_t{0u};
+}
+inline ::uint64_t MessageTrace::picked_ns() const {
+  // @@protoc_insertion_point(field_get:chat.MessageTrace.picked_ns)
+  return _internal_picked_ns();
+}
+inline void MessageTrace::set_picked_ns(::uint64_t value) {
+  _internal_set_picked_ns(value);
+  // @@protoc_insertion_point(field_set:chat.MessageTrace.picked_ns)
+}
+inline ::uint64_t MessageTrace::_internal_picked_ns() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.picked_ns_;
+}
+inline void MessageTrace::_internal_set_picked_ns(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.picked_ns_ = value;
+}
+
+// uint64 write_ns = 4;
+inline void MessageTrace::clear_write_ns() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.write_ns_ = ::uint64_t{0u};
+}
+inline ::uint64_t MessageTrace::write_ns() const {
+  // @@protoc_insertion_point(field_get:chat.MessageTrace.write_ns)
+  return _internal_write_ns();
+}
+inline void MessageTrace::set_write_ns(::uint64_t value) {
+  _internal_set_write_ns(value);
+  // @@protoc_insertion_point(field_set:chat.MessageTrace.write_ns)
+}
+inline ::uint64_t MessageTrace::_internal_write_ns() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.write_ns_;
+}
+inline void MessageTrace::_internal_set_write_ns(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.write_ns_ = value;
+}
+
+// -------------------------------------------------------------------
+
+// ChatMessage
+
+// string name = 1;
+inline void ChatMessage::clear_name() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.name_.ClearToEmpty();
+}
+inline const std::string& ChatMessage::name() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ChatMessage.name)
+  return _internal_name();
+}
+template <typename Arg_, typename... Args_>
+inline PROTOBUF_ALWAYS_INLINE void ChatMessage::set_name(Arg_&& arg,
+                                                     Args_... args) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.name_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
+  // @@protoc_insertion_point(field_set:chat.ChatMessage.name)
+}
+inline std::string* ChatMessage::mutable_name() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  std::string* _s = _internal_mutable_name();
+  // @@protoc_insertion_point(field_mutable:chat.ChatMessage.name)
+  return _s;
+}
+inline const std::string& ChatMessage::_internal_name() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.name_.Get();
+}
+inline void ChatMessage::_internal_set_name(const std::string& value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.name_.Set(value, GetArena());
+}
+inline std::string* ChatMessage::_internal_mutable_name() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  return _impl_.name_.Mutable( GetArena());
+}
+inline std::string* ChatMessage::release_name() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  // @@protoc_insertion_point(field_release:chat.ChatMessage.name)
+  return _impl_.name_.Release();
+}
+inline void ChatMessage::set_allocated_name(std::string* value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.name_.SetAllocated(value, GetArena());
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+        if (_impl_.name_.IsDefault()) {
+          _impl_.name_.Set("", GetArena());
+        }
+  #endif  // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:chat.ChatMessage.name)
+}
+
+// string message = 2;
+inline void ChatMessage::clear_message() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.message_.ClearToEmpty();
+}
+inline const std::string& ChatMessage::message() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ChatMessage.message)
+  return _internal_message();
+}
+template <typename Arg_, typename... Args_>
+inline PROTOBUF_ALWAYS_INLINE void ChatMessage::set_message(Arg_&& arg,
+                                                     Args_... args) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.message_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
+  // @@protoc_insertion_point(field_set:chat.ChatMessage.message)
+}
+inline std::string* ChatMessage::mutable_message() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  std::string* _s = _internal_mutable_message();
+  // @@protoc_insertion_point(field_mutable:chat.ChatMessage.message)
+  return _s;
+}
+inline const std::string& ChatMessage::_internal_message() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.message_.Get();
+}
+inline void ChatMessage::_internal_set_message(const std::string& value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.message_.Set(value, GetArena());
+}
+inline std::string* ChatMessage::_internal_mutable_message() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  return _impl_.message_.Mutable( GetArena());
+}
+inline std::string* ChatMessage::release_message() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  // @@protoc_insertion_point(field_release:chat.ChatMessage.message)
+  return _impl_.message_.Release();
+}
+inline void ChatMessage::set_allocated_message(std::string* value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.message_.SetAllocated(value, GetArena());
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+        if (_impl_.message_.IsDefault()) {
+          _impl_.message_.Set("", GetArena());
+        }
+  #endif  // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:chat.ChatMessage.message)
+}
+
+// uint64 seq = 3;
+inline void ChatMessage::clear_seq() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.seq_ = ::uint64_t{0u};
+}
+inline ::uint64_t ChatMessage::seq() const {
+  // @@protoc_insertion_point(field_get:chat.ChatMessage.seq)
+  return _internal_seq();
+}
+inline void ChatMessage::set_seq(::uint64_t value) {
+  _internal_set_seq(value);
+  // @@protoc_insertion_point(field_set:chat.ChatMessage.seq)
+}
+inline ::uint64_t ChatMessage::_internal_seq() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.seq_;
+}
+inline void ChatMessage::_internal_set_seq(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.seq_ = value;
+}
+
+// string room = 4;
+inline void ChatMessage::clear_room() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.room_.ClearToEmpty();
+}
+inline const std::string& ChatMessage::room() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ChatMessage.room)
+  return _internal_room();
+}
+template <typename Arg_, typename... Args_>
+inline PROTOBUF_ALWAYS_INLINE void ChatMessage::set_room(Arg_&& arg,
+                                                     Args_... args) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.room_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
+  // @@protoc_insertion_point(field_set:chat.ChatMessage.room)
+}
+inline std::string* ChatMessage::mutable_room() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  std::string* _s = _internal_mutable_room();
+  // @@protoc_insertion_point(field_mutable:chat.ChatMessage.room)
+  return _s;
+}
+inline const std::string& ChatMessage::_internal_room() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.room_.Get();
+}
+inline void ChatMessage::_internal_set_room(const std::string& value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.room_.Set(value, GetArena());
+}
+inline std::string* ChatMessage::_internal_mutable_room() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  return _impl_.room_.Mutable( GetArena());
+}
+inline std::string* ChatMessage::release_room() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  // @@protoc_insertion_point(field_release:chat.ChatMessage.room)
+  return _impl_.room_.Release();
+}
+inline void ChatMessage::set_allocated_room(std::string* value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.room_.SetAllocated(value, GetArena());
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+        if (_impl_.room_.IsDefault()) {
+          _impl_.room_.Set("", GetArena());
+        }
+  #endif  // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:chat.ChatMessage.room)
+}
+
+// .chat.MessageTrace trace = 5;
+inline bool ChatMessage::has_trace() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.trace_ != nullptr);
+  return value;
+}
+inline void ChatMessage::clear_trace() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  if (_impl_.trace_ != nullptr) _impl_.trace_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const ::chat::MessageTrace& ChatMessage::_internal_trace() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  const ::chat::MessageTrace* p = _impl_.trace_;
+  return p != nullptr ? *p : reinterpret_cast<const ::chat::MessageTrace&>(::chat::_MessageTrace_default_instance_);
+}
+inline const ::chat::MessageTrace& ChatMessage::trace() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ChatMessage.trace)
+  return _internal_trace();
+}
+inline void ChatMessage::unsafe_arena_set_allocated_trace(::chat::MessageTrace* value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  if (GetArena() == nullptr) {
+    delete reinterpret_cast<::google::protobuf::MessageLite*>(_impl_.trace_);
+  }
+  _impl_.trace_ = reinterpret_cast<::chat::MessageTrace*>(value);
+  if (value != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:chat.ChatMessage.trace)
+}
+inline ::chat::MessageTrace* ChatMessage::release_trace() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::chat::MessageTrace* released = _impl_.trace_;
+  _impl_.trace_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old = reinterpret_cast<::google::protobuf::MessageLite*>(released);
+  released = ::google::protobuf::internal::DuplicateIfNonNull(released);
+  if (GetArena() == nullptr) {
+    delete old;
+  }
+#else   // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArena() != nullptr) {
+    released = ::google::protobuf::internal::DuplicateIfNonNull(released);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return released;
+}
+inline ::chat::MessageTrace* ChatMessage::unsafe_arena_release_trace() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  // @@protoc_insertion_point(field_release:chat.ChatMessage.trace)
+
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::chat::MessageTrace* temp = _impl_.trace_;
+  _impl_.trace_ = nullptr;
+  return temp;
+}
+inline ::chat::MessageTrace* ChatMessage::_internal_mutable_trace() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  if (_impl_.trace_ == nullptr) {
+    auto* p = ::google::protobuf::Message::DefaultConstruct<::chat::MessageTrace>(GetArena());
+    _impl_.trace_ = reinterpret_cast<::chat::MessageTrace*>(p);
+  }
+  return _impl_.trace_;
+}
+inline ::chat::MessageTrace* ChatMessage::mutable_trace() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  ::chat::MessageTrace* _msg = _internal_mutable_trace();
+  // @@protoc_insertion_point(field_mutable:chat.ChatMessage.trace)
+  return _msg;
+}
+inline void ChatMessage::set_allocated_trace(::chat::MessageTrace* value) {
+  ::google::protobuf::Arena* message_arena = GetArena();
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  if (message_arena == nullptr) {
+    delete reinterpret_cast<::google::protobuf::MessageLite*>(_impl_.trace_);
+  }
+
+  if (value != nullptr) {
+    ::google::protobuf::Arena* submessage_arena = reinterpret_cast<::google::protobuf::MessageLite*>(value)->GetArena();
+    if (message_arena != submessage_arena) {
+      value = ::google::protobuf::internal::GetOwnedMessage(message_arena, value, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+
+  _impl_.trace_ = reinterpret_cast<::chat::MessageTrace*>(value);
+  // @@protoc_insertion_point(field_set_allocated:chat.ChatMessage.trace)
+}
+
+// -------------------------------------------------------------------
+
+// ChatFilter
+
+// repeated string include_names = 1;
+inline int ChatFilter::_internal_include_names_size() const {
+  return _internal_include_names().size();
+}
+inline int ChatFilter::include_names_size() const {
+  return _internal_include_names_size();
+}
+inline void ChatFilter::clear_include_names() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.include_names_.Clear();
+}
+inline std::string* ChatFilter::add_include_names() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  std::string* _s = _internal_mutable_include_names()->Add();
+  // @@protoc_insertion_point(field_add_mutable:chat.ChatFilter.include_names)
+  return _s;
+}
+inline const std::string& ChatFilter::include_names(int index) const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ChatFilter.include_names)
+  return _internal_include_names().Get(index);
+}
+inline std::string* ChatFilter::mutable_include_names(int index)
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable:chat.ChatFilter.include_names)
+  return _internal_mutable_include_names()->Mutable(index);
+}
+template <typename Arg_, typename... Args_>
+inline void ChatFilter::set_include_names(int index, Arg_&& value, Args_... args) {
+  ::google::protobuf::internal::AssignToString(
+      *_internal_mutable_include_names()->Mutable(index),
+      std::forward<Arg_>(value), args... );
+  // @@protoc_insertion_point(field_set:chat.ChatFilter.include_names)
+}
+template <typename Arg_, typename... Args_>
+inline void ChatFilter::add_include_names(Arg_&& value, Args_... args) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::google::protobuf::internal::AddToRepeatedPtrField(*_internal_mutable_include_names(),
+                               std::forward<Arg_>(value),
+                               args... );
+  // @@protoc_insertion_point(field_add:chat.ChatFilter.include_names)
+}
+inline const ::google::protobuf::RepeatedPtrField<std::string>&
+ChatFilter::include_names() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_list:chat.ChatFilter.include_names)
+  return _internal_include_names();
+}
+inline ::google::protobuf::RepeatedPtrField<std::string>*
+ChatFilter::mutable_include_names() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable_list:chat.ChatFilter.include_names)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  return _internal_mutable_include_names();
+}
+inline const ::google::protobuf::RepeatedPtrField<std::string>&
+ChatFilter::_internal_include_names() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.include_names_;
+}
+inline ::google::protobuf::RepeatedPtrField<std::string>*
+ChatFilter::_internal_mutable_include_names() {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return &_impl_.include_names_;
+}
+
+// repeated string exclude_names = 2;
+inline int ChatFilter::_internal_exclude_names_size() const {
+  return _internal_exclude_names().size();
+}
+inline int ChatFilter::exclude_names_size() const {
+  return _internal_exclude_names_size();
+}
+inline void ChatFilter::clear_exclude_names() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.exclude_names_.Clear();
+}
+inline std::string* ChatFilter::add_exclude_names() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  std::string* _s = _internal_mutable_exclude_names()->Add();
+  // @@protoc_insertion_point(field_add_mutable:chat.ChatFilter.exclude_names)
+  return _s;
+}
+inline const std::string& ChatFilter::exclude_names(int index) const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ChatFilter.exclude_names)
+  return _internal_exclude_names().Get(index);
+}
+inline std::string* ChatFilter::mutable_exclude_names(int index)
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable:chat.ChatFilter.exclude_names)
+  return _internal_mutable_exclude_names()->Mutable(index);
+}
+template <typename Arg_, typename... Args_>
+inline void ChatFilter::set_exclude_names(int index, Arg_&& value, Args_... args) {
+  ::google::protobuf::internal::AssignToString(
+      *_internal_mutable_exclude_names()->Mutable(index),
+      std::forward<Arg_>(value), args... );
+  // @@protoc_insertion_point(field_set:chat.ChatFilter.exclude_names)
+}
+template <typename Arg_, typename... Args_>
+inline void ChatFilter::add_exclude_names(Arg_&& value, Args_... args) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::google::protobuf::internal::AddToRepeatedPtrField(*_internal_mutable_exclude_names(),
+                               std::forward<Arg_>(value),
+                               args... );
+  // @@protoc_insertion_point(field_add:chat.ChatFilter.exclude_names)
+}
+inline const ::google::protobuf::RepeatedPtrField<std::string>&
+ChatFilter::exclude_names() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_list:chat.ChatFilter.exclude_names)
+  return _internal_exclude_names();
+}
+inline ::google::protobuf::RepeatedPtrField<std::string>*
+ChatFilter::mutable_exclude_names() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable_list:chat.ChatFilter.exclude_names)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  return _internal_mutable_exclude_names();
+}
+inline const ::google::protobuf::RepeatedPtrField<std::string>&
+ChatFilter::_internal_exclude_names() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.exclude_names_;
+}
+inline ::google::protobuf::RepeatedPtrField<std::string>*
+ChatFilter::_internal_mutable_exclude_names() {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return &_impl_.exclude_names_;
+}
+
+// string prefix = 3;
+inline void ChatFilter::clear_prefix() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.prefix_.ClearToEmpty();
+}
+inline const std::string& ChatFilter::prefix() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ChatFilter.prefix)
+  return _internal_prefix();
+}
+template <typename Arg_, typename... Args_>
+inline PROTOBUF_ALWAYS_INLINE void ChatFilter::set_prefix(Arg_&& arg,
+                                                     Args_... args) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.prefix_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
+  // @@protoc_insertion_point(field_set:chat.ChatFilter.prefix)
+}
+inline std::string* ChatFilter::mutable_prefix() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  std::string* _s = _internal_mutable_prefix();
+  // @@protoc_insertion_point(field_mutable:chat.ChatFilter.prefix)
+  return _s;
+}
+inline const std::string& ChatFilter::_internal_prefix() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.prefix_.Get();
+}
+inline void ChatFilter::_internal_set_prefix(const std::string& value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.prefix_.Set(value, GetArena());
+}
+inline std::string* ChatFilter::_internal_mutable_prefix() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  return _impl_.prefix_.Mutable( GetArena());
+}
+inline std::string* ChatFilter::release_prefix() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  // @@protoc_insertion_point(field_release:chat.ChatFilter.prefix)
+  return _impl_.prefix_.Release();
+}
+inline void ChatFilter::set_allocated_prefix(std::string* value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.prefix_.SetAllocated(value, GetArena());
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+        if (_impl_.prefix_.IsDefault()) {
+          _impl_.prefix_.Set("", GetArena());
+        }
+  #endif  // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:chat.ChatFilter.prefix)
+}
+
+// string keyword = 4;
+inline void ChatFilter::clear_keyword() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.keyword_.ClearToEmpty();
+}
+inline const std::string& ChatFilter::keyword() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ChatFilter.keyword)
+  return _internal_keyword();
+}
+template <typename Arg_, typename... Args_>
+inline PROTOBUF_ALWAYS_INLINE void ChatFilter::set_keyword(Arg_&& arg,
+                                                     Args_... args) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.keyword_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
+  // @@protoc_insertion_point(field_set:chat.ChatFilter.keyword)
+}
+inline std::string* ChatFilter::mutable_keyword() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  std::string* _s = _internal_mutable_keyword();
+  // @@protoc_insertion_point(field_mutable:chat.ChatFilter.keyword)
+  return _s;
+}
+inline const std::string& ChatFilter::_internal_keyword() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.keyword_.Get();
+}
+inline void ChatFilter::_internal_set_keyword(const std::string& value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.keyword_.Set(value, GetArena());
+}
+inline std::string* ChatFilter::_internal_mutable_keyword() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  return _impl_.keyword_.Mutable( GetArena());
+}
+inline std::string* ChatFilter::release_keyword() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  // @@protoc_insertion_point(field_release:chat.ChatFilter.keyword)
+  return _impl_.keyword_.Release();
+}
+inline void ChatFilter::set_allocated_keyword(std::string* value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.keyword_.SetAllocated(value, GetArena());
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+        if (_impl_.keyword_.IsDefault()) {
+          _impl_.keyword_.Set("", GetArena());
+        }
+  #endif  // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:chat.ChatFilter.keyword)
+}
+
+// bool system_only = 5;
+inline void ChatFilter::clear_system_only() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.system_only_ = false;
+}
+inline bool ChatFilter::system_only() const {
+  // @@protoc_insertion_point(field_get:chat.ChatFilter.system_only)
+  return _internal_system_only();
+}
+inline void ChatFilter::set_system_only(bool value) {
+  _internal_set_system_only(value);
+  // @@protoc_insertion_point(field_set:chat.ChatFilter.system_only)
+}
+inline bool ChatFilter::_internal_system_only() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.system_only_;
+}
+inline void ChatFilter::_internal_set_system_only(bool value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.system_only_ = value;
+}
+
+// -------------------------------------------------------------------
+
+// ChatReader
+
+// string name = 1;
+inline void ChatReader::clear_name() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.name_.ClearToEmpty();
+}
+inline const std::string& ChatReader::name() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ChatReader.name)
+  return _internal_name();
+}
+template <typename Arg_, typename... Args_>
+inline PROTOBUF_ALWAYS_INLINE void ChatReader::set_name(Arg_&& arg,
+                                                     Args_... args) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.name_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
+  // @@protoc_insertion_point(field_set:chat.ChatReader.name)
+}
+inline std::string* ChatReader::mutable_name() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  std::string* _s = _internal_mutable_name();
+  // @@protoc_insertion_point(field_mutable:chat.ChatReader.name)
+  return _s;
+}
+inline const std::string& ChatReader::_internal_name() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.name_.Get();
+}
+inline void ChatReader::_internal_set_name(const std::string& value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.name_.Set(value, GetArena());
+}
+inline std::string* ChatReader::_internal_mutable_name() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  return _impl_.name_.Mutable( GetArena());
+}
+inline std::string* ChatReader::release_name() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  // @@protoc_insertion_point(field_release:chat.ChatReader.name)
+  return _impl_.name_.Release();
+}
+inline void ChatReader::set_allocated_name(std::string* value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.name_.SetAllocated(value, GetArena());
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+        if (_impl_.name_.IsDefault()) {
+          _impl_.name_.Set("", GetArena());
+        }
+  #endif  // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:chat.ChatReader.name)
+}
+
+// uint32 max_batch_messages = 2;
+inline void ChatReader::clear_max_batch_messages() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.max_batch_messages_ = 0u;
+}
+inline ::uint32_t ChatReader::max_batch_messages() const {
+  // @@protoc_insertion_point(field_get:chat.ChatReader.max_batch_messages)
+  return _internal_max_batch_messages();
+}
+inline void ChatReader::set_max_batch_messages(::uint32_t value) {
+  _internal_set_max_batch_messages(value);
+  // @@protoc_insertion_point(field_set:chat.ChatReader.max_batch_messages)
+}
+inline ::uint32_t ChatReader::_internal_max_batch_messages() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.max_batch_messages_;
+}
+inline void ChatReader::_internal_set_max_batch_messages(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.max_batch_messages_ = value;
+}
+
+// uint32 max_batch_bytes = 3;
+inline void ChatReader::clear_max_batch_bytes() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.max_batch_bytes_ = 0u;
+}
+inline ::uint32_t ChatReader::max_batch_bytes() const {
+  // @@protoc_insertion_point(field_get:chat.ChatReader.max_batch_bytes)
+  return _internal_max_batch_bytes();
+}
+inline void ChatReader::set_max_batch_bytes(::uint32_t value) {
+  _internal_set_max_batch_bytes(value);
+  // @@protoc_insertion_point(field_set:chat.ChatReader.max_batch_bytes)
+}
+inline ::uint32_t ChatReader::_internal_max_batch_bytes() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.max_batch_bytes_;
+}
+inline void ChatReader::_internal_set_max_batch_bytes(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.max_batch_bytes_ = value;
+}
+
+// uint64 since_seq = 4;
+inline void ChatReader::clear_since_seq() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.since_seq_ = ::uint64_t{0u};
+}
+inline ::uint64_t ChatReader::since_seq() const {
+  // @@protoc_insertion_point(field_get:chat.ChatReader.since_seq)
+  return _internal_since_seq();
+}
+inline void ChatReader::set_since_seq(::uint64_t value) {
+  _internal_set_since_seq(value);
+  // @@protoc_insertion_point(field_set:chat.ChatReader.since_seq)
+}
+inline ::uint64_t ChatReader::_internal_since_seq() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.since_seq_;
+}
+inline void ChatReader::_internal_set_since_seq(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.since_seq_ = value;
+}
+
+// uint32 tail_n = 5;
+inline void ChatReader::clear_tail_n() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.tail_n_ = 0u;
+}
+inline ::uint32_t ChatReader::tail_n() const {
+  // @@protoc_insertion_point(field_get:chat.ChatReader.tail_n)
+  return _internal_tail_n();
+}
+inline void ChatReader::set_tail_n(::uint32_t value) {
+  _internal_set_tail_n(value);
+  // @@protoc_insertion_point(field_set:chat.ChatReader.tail_n)
+}
+inline ::uint32_t ChatReader::_internal_tail_n() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.tail_n_;
+}
+inline void ChatReader::_internal_set_tail_n(::uint32_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.tail_n_ = value;
+}
+
+// string room = 6;
+inline void ChatReader::clear_room() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.room_.ClearToEmpty();
+}
+inline const std::string& ChatReader::room() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ChatReader.room)
+  return _internal_room();
+}
+template <typename Arg_, typename... Args_>
+inline PROTOBUF_ALWAYS_INLINE void ChatReader::set_room(Arg_&& arg,
+                                                     Args_... args) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.room_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
+  // @@protoc_insertion_point(field_set:chat.ChatReader.room)
+}
+inline std::string* ChatReader::mutable_room() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  std::string* _s = _internal_mutable_room();
+  // @@protoc_insertion_point(field_mutable:chat.ChatReader.room)
   return _s;
 }
-inline const std::string& ChatMessage::_internal_message() const {
+inline const std::string& ChatReader::_internal_room() const {
   ::google::protobuf::internal::TSanRead(&_impl_);
-  return _impl_.message_.Get();
+  return _impl_.room_.Get();
 }
-inline void ChatMessage::_internal_set_message(const std::string& value) {
+inline void ChatReader::_internal_set_room(const std::string& value) {
   ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.message_.Set(value, GetArena());
+  _impl_.room_.Set(value, GetArena());
 }
-inline std::string* ChatMessage::_internal_mutable_message() {
+inline std::string* ChatReader::_internal_mutable_room() {
   ::google::protobuf::internal::TSanWrite(&_impl_);
-  return _impl_.message_.Mutable( GetArena());
+  return _impl_.room_.Mutable( GetArena());
 }
-inline std::string* ChatMessage::release_message() {
+inline std::string* ChatReader::release_room() {
   ::google::protobuf::internal::TSanWrite(&_impl_);
-  // @@protoc_insertion_point(field_release:chat.ChatMessage.message)
-  return _impl_.message_.Release();
+  // @@protoc_insertion_point(field_release:chat.ChatReader.room)
+  return _impl_.room_.Release();
 }
-inline void ChatMessage::set_allocated_message(std::string* value) {
+inline void ChatReader::set_allocated_room(std::string* value) {
   ::google::protobuf::internal::TSanWrite(&_impl_);
-  _impl_.message_.SetAllocated(value, GetArena());
+  _impl_.room_.SetAllocated(value, GetArena());
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-        if (_impl_.message_.IsDefault()) {
-          _impl_.message_.Set("", GetArena());
+        if (_impl_.room_.IsDefault()) {
+          _impl_.room_.Set("", GetArena());
         }
   #endif  // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  // @@protoc_insertion_point(field_set_allocated:chat.ChatMessage.message)
+  // @@protoc_insertion_point(field_set_allocated:chat.ChatReader.room)
+}
+
+// .chat.ChatFilter filter = 7;
+inline bool ChatReader::has_filter() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.filter_ != nullptr);
+  return value;
+}
+inline void ChatReader::clear_filter() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  if (_impl_.filter_ != nullptr) _impl_.filter_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const ::chat::ChatFilter& ChatReader::_internal_filter() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  const ::chat::ChatFilter* p = _impl_.filter_;
+  return p != nullptr ? *p : reinterpret_cast<const ::chat::ChatFilter&>(::chat::_ChatFilter_default_instance_);
+}
+inline const ::chat::ChatFilter& ChatReader::filter() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ChatReader.filter)
+  return _internal_filter();
+}
+inline void ChatReader::unsafe_arena_set_allocated_filter(::chat::ChatFilter* value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  if (GetArena() == nullptr) {
+    delete reinterpret_cast<::google::protobuf::MessageLite*>(_impl_.filter_);
+  }
+  _impl_.filter_ = reinterpret_cast<::chat::ChatFilter*>(value);
+  if (value != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:chat.ChatReader.filter)
+}
+inline ::chat::ChatFilter* ChatReader::release_filter() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::chat::ChatFilter* released = _impl_.filter_;
+  _impl_.filter_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old = reinterpret_cast<::google::protobuf::MessageLite*>(released);
+  released = ::google::protobuf::internal::DuplicateIfNonNull(released);
+  if (GetArena() == nullptr) {
+    delete old;
+  }
+#else   // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArena() != nullptr) {
+    released = ::google::protobuf::internal::DuplicateIfNonNull(released);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return released;
+}
+inline ::chat::ChatFilter* ChatReader::unsafe_arena_release_filter() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  // @@protoc_insertion_point(field_release:chat.ChatReader.filter)
+
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::chat::ChatFilter* temp = _impl_.filter_;
+  _impl_.filter_ = nullptr;
+  return temp;
+}
+inline ::chat::ChatFilter* ChatReader::_internal_mutable_filter() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  if (_impl_.filter_ == nullptr) {
+    auto* p = ::google::protobuf::Message::DefaultConstruct<::chat::ChatFilter>(GetArena());
+    _impl_.filter_ = reinterpret_cast<::chat::ChatFilter*>(p);
+  }
+  return _impl_.filter_;
+}
+inline ::chat::ChatFilter* ChatReader::mutable_filter() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  ::chat::ChatFilter* _msg = _internal_mutable_filter();
+  // @@protoc_insertion_point(field_mutable:chat.ChatReader.filter)
+  return _msg;
+}
+inline void ChatReader::set_allocated_filter(::chat::ChatFilter* value) {
+  ::google::protobuf::Arena* message_arena = GetArena();
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  if (message_arena == nullptr) {
+    delete reinterpret_cast<::google::protobuf::MessageLite*>(_impl_.filter_);
+  }
+
+  if (value != nullptr) {
+    ::google::protobuf::Arena* submessage_arena = reinterpret_cast<::google::protobuf::MessageLite*>(value)->GetArena();
+    if (message_arena != submessage_arena) {
+      value = ::google::protobuf::internal::GetOwnedMessage(message_arena, value, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+
+  _impl_.filter_ = reinterpret_cast<::chat::ChatFilter*>(value);
+  // @@protoc_insertion_point(field_set_allocated:chat.ChatReader.filter)
+}
+
+// bool trace = 8;
+inline void ChatReader::clear_trace() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.trace_ = false;
+}
+inline bool ChatReader::trace() const {
+  // @@protoc_insertion_point(field_get:chat.ChatReader.trace)
+  return _internal_trace();
+}
+inline void ChatReader::set_trace(bool value) {
+  _internal_set_trace(value);
+  // @@protoc_insertion_point(field_set:chat.ChatReader.trace)
+}
+inline bool ChatReader::_internal_trace() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.trace_;
+}
+inline void ChatReader::_internal_set_trace(bool value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.trace_ = value;
 }
 
 // -------------------------------------------------------------------
 
-// ChatReader
+// ChatMessageBatch
+
+// repeated .chat.ChatMessage messages = 1;
+inline int ChatMessageBatch::_internal_messages_size() const {
+  return _internal_messages().size();
+}
+inline int ChatMessageBatch::messages_size() const {
+  return _internal_messages_size();
+}
+inline void ChatMessageBatch::clear_messages() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.messages_.Clear();
+}
+inline ::chat::ChatMessage* ChatMessageBatch::mutable_messages(int index)
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable:chat.ChatMessageBatch.messages)
+  return _internal_mutable_messages()->Mutable(index);
+}
+inline ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>* ChatMessageBatch::mutable_messages()
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable_list:chat.ChatMessageBatch.messages)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  return _internal_mutable_messages();
+}
+inline const ::chat::ChatMessage& ChatMessageBatch::messages(int index) const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ChatMessageBatch.messages)
+  return _internal_messages().Get(index);
+}
+inline ::chat::ChatMessage* ChatMessageBatch::add_messages() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::chat::ChatMessage* _add = _internal_mutable_messages()->Add();
+  // @@protoc_insertion_point(field_add:chat.ChatMessageBatch.messages)
+  return _add;
+}
+inline const ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>& ChatMessageBatch::messages() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_list:chat.ChatMessageBatch.messages)
+  return _internal_messages();
+}
+inline const ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>&
+ChatMessageBatch::_internal_messages() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.messages_;
+}
+inline ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>*
+ChatMessageBatch::_internal_mutable_messages() {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return &_impl_.messages_;
+}
+
+// -------------------------------------------------------------------
+
+// ReplicatedMessage
+
+// .chat.ChatMessage message = 1;
+inline bool ReplicatedMessage::has_message() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.message_ != nullptr);
+  return value;
+}
+inline void ReplicatedMessage::clear_message() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  if (_impl_.message_ != nullptr) _impl_.message_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const ::chat::ChatMessage& ReplicatedMessage::_internal_message() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  const ::chat::ChatMessage* p = _impl_.message_;
+  return p != nullptr ? *p : reinterpret_cast<const ::chat::ChatMessage&>(::chat::_ChatMessage_default_instance_);
+}
+inline const ::chat::ChatMessage& ReplicatedMessage::message() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ReplicatedMessage.message)
+  return _internal_message();
+}
+inline void ReplicatedMessage::unsafe_arena_set_allocated_message(::chat::ChatMessage* value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  if (GetArena() == nullptr) {
+    delete reinterpret_cast<::google::protobuf::MessageLite*>(_impl_.message_);
+  }
+  _impl_.message_ = reinterpret_cast<::chat::ChatMessage*>(value);
+  if (value != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:chat.ReplicatedMessage.message)
+}
+inline ::chat::ChatMessage* ReplicatedMessage::release_message() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::chat::ChatMessage* released = _impl_.message_;
+  _impl_.message_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old = reinterpret_cast<::google::protobuf::MessageLite*>(released);
+  released = ::google::protobuf::internal::DuplicateIfNonNull(released);
+  if (GetArena() == nullptr) {
+    delete old;
+  }
+#else   // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArena() != nullptr) {
+    released = ::google::protobuf::internal::DuplicateIfNonNull(released);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return released;
+}
+inline ::chat::ChatMessage* ReplicatedMessage::unsafe_arena_release_message() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  // @@protoc_insertion_point(field_release:chat.ReplicatedMessage.message)
+
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::chat::ChatMessage* temp = _impl_.message_;
+  _impl_.message_ = nullptr;
+  return temp;
+}
+inline ::chat::ChatMessage* ReplicatedMessage::_internal_mutable_message() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  if (_impl_.message_ == nullptr) {
+    auto* p = ::google::protobuf::Message::DefaultConstruct<::chat::ChatMessage>(GetArena());
+    _impl_.message_ = reinterpret_cast<::chat::ChatMessage*>(p);
+  }
+  return _impl_.message_;
+}
+inline ::chat::ChatMessage* ReplicatedMessage::mutable_message() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  ::chat::ChatMessage* _msg = _internal_mutable_message();
+  // @@protoc_insertion_point(field_mutable:chat.ReplicatedMessage.message)
+  return _msg;
+}
+inline void ReplicatedMessage::set_allocated_message(::chat::ChatMessage* value) {
+  ::google::protobuf::Arena* message_arena = GetArena();
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  if (message_arena == nullptr) {
+    delete reinterpret_cast<::google::protobuf::MessageLite*>(_impl_.message_);
+  }
+
+  if (value != nullptr) {
+    ::google::protobuf::Arena* submessage_arena = reinterpret_cast<::google::protobuf::MessageLite*>(value)->GetArena();
+    if (message_arena != submessage_arena) {
+      value = ::google::protobuf::internal::GetOwnedMessage(message_arena, value, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+
+  _impl_.message_ = reinterpret_cast<::chat::ChatMessage*>(value);
+  // @@protoc_insertion_point(field_set_allocated:chat.ReplicatedMessage.message)
+}
+
+// uint64 position = 3;
+inline void ReplicatedMessage::clear_position() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.position_ = ::uint64_t{0u};
+}
+inline ::uint64_t ReplicatedMessage::position() const {
+  // @@protoc_insertion_point(field_get:chat.ReplicatedMessage.position)
+  return _internal_position();
+}
+inline void ReplicatedMessage::set_position(::uint64_t value) {
+  _internal_set_position(value);
+  // @@protoc_insertion_point(field_set:chat.ReplicatedMessage.position)
+}
+inline ::uint64_t ReplicatedMessage::_internal_position() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.position_;
+}
+inline void ReplicatedMessage::_internal_set_position(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.position_ = value;
+}
+
+// -------------------------------------------------------------------
+
+// ReplicatedBatch
+
+// repeated .chat.ReplicatedMessage messages = 1;
+inline int ReplicatedBatch::_internal_messages_size() const {
+  return _internal_messages().size();
+}
+inline int ReplicatedBatch::messages_size() const {
+  return _internal_messages_size();
+}
+inline void ReplicatedBatch::clear_messages() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.messages_.Clear();
+}
+inline ::chat::ReplicatedMessage* ReplicatedBatch::mutable_messages(int index)
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable:chat.ReplicatedBatch.messages)
+  return _internal_mutable_messages()->Mutable(index);
+}
+inline ::google::protobuf::RepeatedPtrField<::chat::ReplicatedMessage>* ReplicatedBatch::mutable_messages()
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable_list:chat.ReplicatedBatch.messages)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  return _internal_mutable_messages();
+}
+inline const ::chat::ReplicatedMessage& ReplicatedBatch::messages(int index) const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.ReplicatedBatch.messages)
+  return _internal_messages().Get(index);
+}
+inline ::chat::ReplicatedMessage* ReplicatedBatch::add_messages() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::chat::ReplicatedMessage* _add = _internal_mutable_messages()->Add();
+  // @@protoc_insertion_point(field_add:chat.ReplicatedBatch.messages)
+  return _add;
+}
+inline const ::google::protobuf::RepeatedPtrField<::chat::ReplicatedMessage>& ReplicatedBatch::messages() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_list:chat.ReplicatedBatch.messages)
+  return _internal_messages();
+}
+inline const ::google::protobuf::RepeatedPtrField<::chat::ReplicatedMessage>&
+ReplicatedBatch::_internal_messages() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.messages_;
+}
+inline ::google::protobuf::RepeatedPtrField<::chat::ReplicatedMessage>*
+ReplicatedBatch::_internal_mutable_messages() {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return &_impl_.messages_;
+}
+
+// uint64 end = 2;
+inline void ReplicatedBatch::clear_end() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.end_ = ::uint64_t{0u};
+}
+inline ::uint64_t ReplicatedBatch::end() const {
+  // @@protoc_insertion_point(field_get:chat.ReplicatedBatch.end)
+  return _internal_end();
+}
+inline void ReplicatedBatch::set_end(::uint64_t value) {
+  _internal_set_end(value);
+  // @@protoc_insertion_point(field_set:chat.ReplicatedBatch.end)
+}
+inline ::uint64_t ReplicatedBatch::_internal_end() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.end_;
+}
+inline void ReplicatedBatch::_internal_set_end(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.end_ = value;
+}
+
+// -------------------------------------------------------------------
+
+// RelayBatch
+
+// repeated .chat.ChatMessage messages = 1;
+inline int RelayBatch::_internal_messages_size() const {
+  return _internal_messages().size();
+}
+inline int RelayBatch::messages_size() const {
+  return _internal_messages_size();
+}
+inline void RelayBatch::clear_messages() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.messages_.Clear();
+}
+inline ::chat::ChatMessage* RelayBatch::mutable_messages(int index)
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable:chat.RelayBatch.messages)
+  return _internal_mutable_messages()->Mutable(index);
+}
+inline ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>* RelayBatch::mutable_messages()
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable_list:chat.RelayBatch.messages)
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  return _internal_mutable_messages();
+}
+inline const ::chat::ChatMessage& RelayBatch::messages(int index) const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:chat.RelayBatch.messages)
+  return _internal_messages().Get(index);
+}
+inline ::chat::ChatMessage* RelayBatch::add_messages() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  ::chat::ChatMessage* _add = _internal_mutable_messages()->Add();
+  // @@protoc_insertion_point(field_add:chat.RelayBatch.messages)
+  return _add;
+}
+inline const ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>& RelayBatch::messages() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_list:chat.RelayBatch.messages)
+  return _internal_messages();
+}
+inline const ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>&
+RelayBatch::_internal_messages() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.messages_;
+}
+inline ::google::protobuf::RepeatedPtrField<::chat::ChatMessage>*
+RelayBatch::_internal_mutable_messages() {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return &_impl_.messages_;
+}
+
+// uint64 end = 2;
+inline void RelayBatch::clear_end() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.end_ = ::uint64_t{0u};
+}
+inline ::uint64_t RelayBatch::end() const {
+  // @@protoc_insertion_point(field_get:chat.RelayBatch.end)
+  return _internal_end();
+}
+inline void RelayBatch::set_end(::uint64_t value) {
+  _internal_set_end(value);
+  // @@protoc_insertion_point(field_set:chat.RelayBatch.end)
+}
+inline ::uint64_t RelayBatch::_internal_end() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.end_;
+}
+inline void RelayBatch::_internal_set_end(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.end_ = value;
+}
+
+// -------------------------------------------------------------------
+
+// SnapshotHeader
+
+// uint64 wal_generation = 1;
+inline void SnapshotHeader::clear_wal_generation() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.wal_generation_ = ::uint64_t{0u};
+}
+inline ::uint64_t SnapshotHeader::wal_generation() const {
+  // @@protoc_insertion_point(field_get:chat.SnapshotHeader.wal_generation)
+  return _internal_wal_generation();
+}
+inline void SnapshotHeader::set_wal_generation(::uint64_t value) {
+  _internal_set_wal_generation(value);
+  // @@protoc_insertion_point(field_set:chat.SnapshotHeader.wal_generation)
+}
+inline ::uint64_t SnapshotHeader::_internal_wal_generation() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.wal_generation_;
+}
+inline void SnapshotHeader::_internal_set_wal_generation(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.wal_generation_ = value;
+}
+
+// uint64 rooms = 2;
+inline void SnapshotHeader::clear_rooms() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.rooms_ = ::uint64_t{0u};
+}
+inline ::uint64_t SnapshotHeader::rooms() const {
+  // @@protoc_insertion_point(field_get:chat.SnapshotHeader.rooms)
+  return _internal_rooms();
+}
+inline void SnapshotHeader::set_rooms(::uint64_t value) {
+  _internal_set_rooms(value);
+  // @@protoc_insertion_point(field_set:chat.SnapshotHeader.rooms)
+}
+inline ::uint64_t SnapshotHeader::_internal_rooms() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.rooms_;
+}
+inline void SnapshotHeader::_internal_set_rooms(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.rooms_ = value;
+}
+
+// -------------------------------------------------------------------
+
+// SnapshotRoom
 
 // string name = 1;
-inline void ChatReader::clear_name() {
+inline void SnapshotRoom::clear_name() {
   ::google::protobuf::internal::TSanWrite(&_impl_);
   _impl_.name_.ClearToEmpty();
 }
-inline const std::string& ChatReader::name() const
+inline const std::string& SnapshotRoom::name() const
     ABSL_ATTRIBUTE_LIFETIME_BOUND {
-  // @@protoc_insertion_point(field_get:chat.ChatReader.name)
+  // @@protoc_insertion_point(field_get:chat.SnapshotRoom.name)
   return _internal_name();
 }
 template <typename Arg_, typename... Args_>
-inline PROTOBUF_ALWAYS_INLINE void ChatReader::set_name(Arg_&& arg,
+inline PROTOBUF_ALWAYS_INLINE void SnapshotRoom::set_name(Arg_&& arg,
                                                      Args_... args) {
   ::google::protobuf::internal::TSanWrite(&_impl_);
   _impl_.name_.Set(static_cast<Arg_&&>(arg), args..., GetArena());
-  // @@protoc_insertion_point(field_set:chat.ChatReader.name)
+  // @@protoc_insertion_point(field_set:chat.SnapshotRoom.name)
 }
-inline std::string* ChatReader::mutable_name() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+inline std::string* SnapshotRoom::mutable_name() ABSL_ATTRIBUTE_LIFETIME_BOUND {
   std::string* _s = _internal_mutable_name();
-  // @@protoc_insertion_point(field_mutable:chat.ChatReader.name)
+  // @@protoc_insertion_point(field_mutable:chat.SnapshotRoom.name)
   return _s;
 }
-inline const std::string& ChatReader::_internal_name() const {
+inline const std::string& SnapshotRoom::_internal_name() const {
   ::google::protobuf::internal::TSanRead(&_impl_);
   return _impl_.name_.Get();
 }
-inline void ChatReader::_internal_set_name(const std::string& value) {
+inline void SnapshotRoom::_internal_set_name(const std::string& value) {
   ::google::protobuf::internal::TSanWrite(&_impl_);
   _impl_.name_.Set(value, GetArena());
 }
-inline std::string* ChatReader::_internal_mutable_name() {
+inline std::string* SnapshotRoom::_internal_mutable_name() {
   ::google::protobuf::internal::TSanWrite(&_impl_);
   return _impl_.name_.Mutable( GetArena());
 }
-inline std::string* ChatReader::release_name() {
+inline std::string* SnapshotRoom::release_name() {
   ::google::protobuf::internal::TSanWrite(&_impl_);
-  // @@protoc_insertion_point(field_release:chat.ChatReader.name)
+  // @@protoc_insertion_point(field_release:chat.SnapshotRoom.name)
   return _impl_.name_.Release();
 }
-inline void ChatReader::set_allocated_name(std::string* value) {
+inline void SnapshotRoom::set_allocated_name(std::string* value) {
   ::google::protobuf::internal::TSanWrite(&_impl_);
   _impl_.name_.SetAllocated(value, GetArena());
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
@@ -787,7 +3745,51 @@ inline void ChatReader::set_allocated_name(std::string* value) {
           _impl_.name_.Set("", GetArena());
         }
   #endif  // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  // @@protoc_insertion_point(field_set_allocated:chat.ChatReader.name)
+  // @@protoc_insertion_point(field_set_allocated:chat.SnapshotRoom.name)
+}
+
+// uint64 first = 2;
+inline void SnapshotRoom::clear_first() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.first_ = ::uint64_t{0u};
+}
+inline ::uint64_t SnapshotRoom::first() const {
+  // @@protoc_insertion_point(field_get:chat.SnapshotRoom.first)
+  return _internal_first();
+}
+inline void SnapshotRoom::set_first(::uint64_t value) {
+  _internal_set_first(value);
+  // @@protoc_insertion_point(field_set:chat.SnapshotRoom.first)
+}
+inline ::uint64_t SnapshotRoom::_internal_first() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.first_;
+}
+inline void SnapshotRoom::_internal_set_first(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.first_ = value;
+}
+
+// uint64 messages = 3;
+inline void SnapshotRoom::clear_messages() {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.messages_ = ::uint64_t{0u};
+}
+inline ::uint64_t SnapshotRoom::messages() const {
+  // @@protoc_insertion_point(field_get:chat.SnapshotRoom.messages)
+  return _internal_messages();
+}
+inline void SnapshotRoom::set_messages(::uint64_t value) {
+  _internal_set_messages(value);
+  // @@protoc_insertion_point(field_set:chat.SnapshotRoom.messages)
+}
+inline ::uint64_t SnapshotRoom::_internal_messages() const {
+  ::google::protobuf::internal::TSanRead(&_impl_);
+  return _impl_.messages_;
+}
+inline void SnapshotRoom::_internal_set_messages(::uint64_t value) {
+  ::google::protobuf::internal::TSanWrite(&_impl_);
+  _impl_.messages_ = value;
 }
 
 // -------------------------------------------------------------------
@@ -18,9 +18,27 @@ class MockChatServiceStub : public ChatService::StubInterface {
   MOCK_METHOD3(Send, ::grpc::Status(::grpc::ClientContext* context, const ::chat::ChatMessage& request, ::chat::Response* response));
   MOCK_METHOD3(AsyncSendRaw, ::grpc::ClientAsyncResponseReaderInterface< ::chat::Response>*(::grpc::ClientContext* context, const ::chat::ChatMessage& request, ::grpc::CompletionQueue* cq));
   MOCK_METHOD3(PrepareAsyncSendRaw, ::grpc::ClientAsyncResponseReaderInterface< ::chat::Response>*(::grpc::ClientContext* context, const ::chat::ChatMessage& request, ::grpc::CompletionQueue* cq));
+  MOCK_METHOD2(SendStreamRaw, ::grpc::ClientWriterInterface< ::chat::ChatMessage>*(::grpc::ClientContext* context, ::chat::Response* response));
+  MOCK_METHOD4(AsyncSendStreamRaw, ::grpc::ClientAsyncWriterInterface< ::chat::ChatMessage>*(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::CompletionQueue* cq, void* tag));
+  MOCK_METHOD3(PrepareAsyncSendStreamRaw, ::grpc::ClientAsyncWriterInterface< ::chat::ChatMessage>*(::grpc::ClientContext* context, ::chat::Response* response, ::grpc::CompletionQueue* cq));
   MOCK_METHOD2(ReadChatRaw, ::grpc::ClientReaderInterface< ::chat::ChatMessage>*(::grpc::ClientContext* context, const ::chat::ChatReader& request));
   MOCK_METHOD4(AsyncReadChatRaw, ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessage>*(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag));
   MOCK_METHOD3(PrepareAsyncReadChatRaw, ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessage>*(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq));
+  MOCK_METHOD2(ReadChatBatchedRaw, ::grpc::ClientReaderInterface< ::chat::ChatMessageBatch>*(::grpc::ClientContext* context, const ::chat::ChatReader& request));
+  MOCK_METHOD4(AsyncReadChatBatchedRaw, ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>*(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag));
+  MOCK_METHOD3(PrepareAsyncReadChatBatchedRaw, ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>*(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq));
+  MOCK_METHOD1(ChatRaw, ::grpc::ClientReaderWriterInterface< ::chat::ChatMessage, ::chat::ChatMessage>*(::grpc::ClientContext* context));
+  MOCK_METHOD3(AsyncChatRaw, ::grpc::ClientAsyncReaderWriterInterface<::chat::ChatMessage, ::chat::ChatMessage>*(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq, void* tag));
+  MOCK_METHOD2(PrepareAsyncChatRaw, ::grpc::ClientAsyncReaderWriterInterface<::chat::ChatMessage, ::chat::ChatMessage>*(::grpc::ClientContext* context, ::grpc::CompletionQueue* cq));
+  MOCK_METHOD2(ReplicateRaw, ::grpc::ClientReaderInterface< ::chat::ReplicatedBatch>*(::grpc::ClientContext* context, const ::chat::ChatReader& request));
+  MOCK_METHOD4(AsyncReplicateRaw, ::grpc::ClientAsyncReaderInterface< ::chat::ReplicatedBatch>*(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag));
+  MOCK_METHOD3(PrepareAsyncReplicateRaw, ::grpc::ClientAsyncReaderInterface< ::chat::ReplicatedBatch>*(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq));
+  MOCK_METHOD2(HandOffRaw, ::grpc::ClientReaderInterface< ::chat::ChatMessageBatch>*(::grpc::ClientContext* context, const ::chat::ChatReader& request));
+  MOCK_METHOD4(AsyncHandOffRaw, ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>*(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag));
+  MOCK_METHOD3(PrepareAsyncHandOffRaw, ::grpc::ClientAsyncReaderInterface< ::chat::ChatMessageBatch>*(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq));
+  MOCK_METHOD2(RelayRaw, ::grpc::ClientReaderInterface< ::chat::RelayBatch>*(::grpc::ClientContext* context, const ::chat::ChatReader& request));
+  MOCK_METHOD4(AsyncRelayRaw, ::grpc::ClientAsyncReaderInterface< ::chat::RelayBatch>*(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq, void* tag));
+  MOCK_METHOD3(PrepareAsyncRelayRaw, ::grpc::ClientAsyncReaderInterface< ::chat::RelayBatch>*(::grpc::ClientContext* context, const ::chat::ChatReader& request, ::grpc::CompletionQueue* cq));
 };
 
 }  // namespace chat
@@ -0,0 +1,91 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Maps rooms to the nodes that own them by consistent hashing. Every node is
+// hashed to many points on a ring and a room belongs to the node of the
+// first point at or after the room's own hash. Adding a node only takes over
+// the rooms just before its points, and removing one only hands its rooms to
+// the nodes after them; every other room stays where it is.
+class HashRing {
+public:
+  static constexpr size_t kDefaultPoints = 128;
+
+  HashRing() = default;
+
+  // nodes are addresses, as clients and the other nodes reach them. Their
+  // order and any duplicates do not matter.
+  explicit HashRing(std::vector<std::string> nodes,
+                    size_t points = kDefaultPoints)
+      : nodes_(std::move(nodes)) {
+    std::sort(nodes_.begin(), nodes_.end());
+    nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+    for (size_t i = 0; i < nodes_.size(); i++) {
+      for (size_t point = 0; point < points; point++) {
+        points_.emplace_back(Hash(nodes_[i] + "#" + std::to_string(point)), i);
+      }
+    }
+    std::sort(points_.begin(), points_.end());
+  }
+
+  bool empty() const { return nodes_.empty(); }
+
+  const std::vector<std::string> &nodes() const { return nodes_; }
+
+  bool Contains(const std::string &node) const {
+    return std::binary_search(nodes_.begin(), nodes_.end(), node);
+  }
+
+  // The node that owns room. The ring must not be empty.
+  const std::string &Owner(const std::string &room) const {
+    auto it = std::lower_bound(points_.begin(), points_.end(),
+                               std::make_pair(Hash(room), size_t(0)));
+    if (it == points_.end()) {
+      it = points_.begin();
+    }
+    return nodes_[it->second];
+  }
+
+  // FNV-1a, which is the same in every build, mixed so that keys differing
+  // only in their last characters land far apart.
+  static uint64_t Hash(const std::string &key) {
+    uint64_t h = 0xcbf29ce484222325;
+    for (char c : key) {
+      h = (h ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccd;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53;
+    h ^= h >> 33;
+    return h;
+  }
+
+private:
+  std::vector<std::string> nodes_;
+  // Sorted by hash, each with the index of its node.
+  std::vector<std::pair<uint64_t, size_t>> points_;
+};
+
+// Splits a comma-separated list of node addresses, dropping blanks.
+inline std::vector<std::string> ParseNodeList(const std::string &list) {
+  std::vector<std::string> nodes;
+  size_t begin = 0;
+  while (begin <= list.size()) {
+    size_t end = std::min(list.find(',', begin), list.size());
+    size_t first = list.find_first_not_of(" \t", begin);
+    if (first < end) {
+      size_t last = list.find_last_not_of(" \t", end - 1);
+      nodes.push_back(list.substr(first, last - first + 1));
+    }
+    begin = end + 1;
+  }
+  return nodes;
+}
+
+// Trailing metadata naming the node that owns a room, sent with the
+// FAILED_PRECONDITION a node answers with for a room that is not its own.
+constexpr char kOwnerMetadata[] = "chat-owner";
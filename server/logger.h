@@ -0,0 +1,177 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class LogLevel : int { kDebug, kInfo, kWarning, kError, kOff };
+
+// Asynchronous logger. Every thread that logs gets its own single-producer
+// ring of fixed-size records, so logging never takes a lock or does I/O on
+// the calling thread. A background thread drains the rings to stdout. When a
+// ring is full the record is dropped and counted rather than blocking.
+//
+// Lines from different threads are written ring by ring, so their relative
+// order is only as good as their timestamps.
+class Logger {
+public:
+  static constexpr size_t kRingSize = 512;
+  static constexpr size_t kMaxLineSize = 240;
+  static constexpr std::chrono::milliseconds kFlushInterval{5};
+
+  // Never destroyed, so threads that outlive main can still log. Whatever is
+  // buffered at exit is flushed by an atexit handler.
+  static Logger &Get() {
+    static Logger *logger = [] {
+      auto *l = new Logger();
+      std::atexit([] { Get().Flush(); });
+      return l;
+    }();
+    return *logger;
+  }
+
+  bool Enabled(LogLevel level) const {
+    return level >= level_.load(std::memory_order_relaxed);
+  }
+
+  void SetLevel(LogLevel level) { level_.store(level); }
+
+  void Write(LogLevel level, const std::string &text) {
+    Ring *ring = LocalRing();
+    size_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) == kRingSize) {
+      ring->dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    Record &r = ring->records[head % kRingSize];
+    r.time = std::chrono::system_clock::now();
+    r.level = level;
+    r.size = std::min(text.size(), kMaxLineSize);
+    text.copy(r.text, r.size);
+    ring->head.store(head + 1, std::memory_order_release);
+  }
+
+  // Writes out everything logged so far.
+  void Flush() {
+    std::lock_guard<std::mutex> lock(flush_mu_);
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+      std::lock_guard<std::mutex> lock(rings_mu_);
+      rings = rings_;
+    }
+    for (const std::shared_ptr<Ring> &ring : rings) {
+      size_t tail = ring->tail.load(std::memory_order_relaxed);
+      size_t head = ring->head.load(std::memory_order_acquire);
+      for (; tail != head; tail++) {
+        Print(ring->records[tail % kRingSize]);
+      }
+      ring->tail.store(tail, std::memory_order_release);
+      if (uint64_t dropped = ring->dropped.exchange(0)) {
+        std::cout << "System: " << dropped << " log lines dropped\n";
+      }
+    }
+    std::cout.flush();
+    rings.clear();
+
+    // Forget rings whose thread has exited once they are drained.
+    std::lock_guard<std::mutex> rings_lock(rings_mu_);
+    for (size_t i = 0; i < rings_.size();) {
+      if (rings_[i].use_count() == 1 &&
+          rings_[i]->tail.load() == rings_[i]->head.load()) {
+        rings_[i] = std::move(rings_.back());
+        rings_.pop_back();
+      } else {
+        i++;
+      }
+    }
+  }
+
+private:
+  struct Record {
+    std::chrono::system_clock::time_point time;
+    LogLevel level;
+    size_t size;
+    char text[kMaxLineSize];
+  };
+
+  struct Ring {
+    Record records[kRingSize];
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+  };
+
+  Logger() { std::thread(&Logger::WriterLoop, this).detach(); }
+
+  Ring *LocalRing() {
+    thread_local std::shared_ptr<Ring> ring = [this] {
+      auto r = std::make_shared<Ring>();
+      std::lock_guard<std::mutex> lock(rings_mu_);
+      rings_.push_back(r);
+      return r;
+    }();
+    return ring.get();
+  }
+
+  void WriterLoop() {
+    while (true) {
+      std::this_thread::sleep_for(kFlushInterval);
+      Flush();
+    }
+  }
+
+  static void Print(const Record &r) {
+    static const char kLevels[] = "DIWE";
+    std::time_t seconds = std::chrono::system_clock::to_time_t(r.time);
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      r.time.time_since_epoch())
+                      .count() %
+                  1000;
+    std::tm tm;
+    localtime_r(&seconds, &tm);
+    char prefix[32];
+    snprintf(prefix, sizeof(prefix), "%c %02d:%02d:%02d.%03d ",
+             kLevels[static_cast<int>(r.level)], tm.tm_hour, tm.tm_min,
+             tm.tm_sec, static_cast<int>(millis));
+    std::cout << prefix;
+    std::cout.write(r.text, r.size);
+    std::cout << '\n';
+  }
+
+  std::atomic<LogLevel> level_{LogLevel::kInfo};
+  std::mutex flush_mu_;
+  std::mutex rings_mu_;
+  std::vector<std::shared_ptr<Ring>> rings_;
+};
+
+// Formats one log line and hands it to the logger when it goes out of scope.
+class LogLine {
+public:
+  explicit LogLine(LogLevel level) : level_(level) {}
+  ~LogLine() { Logger::Get().Write(level_, stream_.str()); }
+
+  template <typename T> LogLine &operator<<(const T &value) {
+    stream_ << value;
+    return *this;
+  }
+
+private:
+  const LogLevel level_;
+  std::ostringstream stream_;
+};
+
+// CHAT_LOG(kInfo) << "System: ...";
+// The arguments are not evaluated when the level is disabled.
+#define CHAT_LOG(level)                                                        \
+  if (!Logger::Get().Enabled(LogLevel::level)) {                               \
+  } else                                                                       \
+    LogLine(LogLevel::level)
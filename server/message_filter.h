@@ -0,0 +1,55 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include "proto/chatservice.pb.h"
+
+// A reader's ChatFilter, compiled once when its stream opens: the name
+// lists become hash sets and the keyword gets a prebuilt searcher.
+class MessageFilter {
+public:
+  explicit MessageFilter(const chat::ChatFilter &filter)
+      : include_(filter.include_names().begin(),
+                 filter.include_names().end()),
+        exclude_(filter.exclude_names().begin(),
+                 filter.exclude_names().end()),
+        prefix_(filter.prefix()), keyword_(filter.keyword()),
+        searcher_(keyword_.begin(), keyword_.end()),
+        system_only_(filter.system_only()) {}
+
+  // Not copyable: the searcher points into keyword_.
+  MessageFilter(const MessageFilter &) = delete;
+  MessageFilter &operator=(const MessageFilter &) = delete;
+
+  bool Matches(const chat::ChatMessage &m) const {
+    if (system_only_ && m.name() != "System") {
+      return false;
+    }
+    if (!include_.empty() && include_.count(m.name()) == 0) {
+      return false;
+    }
+    if (exclude_.count(m.name()) > 0) {
+      return false;
+    }
+    std::string_view text = m.message();
+    if (text.substr(0, prefix_.size()) != prefix_) {
+      return false;
+    }
+    return keyword_.empty() ||
+           std::search(text.begin(), text.end(), searcher_) != text.end();
+  }
+
+private:
+  using Searcher =
+      std::boyer_moore_horspool_searcher<std::string::const_iterator>;
+
+  const std::unordered_set<std::string> include_;
+  const std::unordered_set<std::string> exclude_;
+  const std::string prefix_;
+  const std::string keyword_;
+  const Searcher searcher_;
+  const bool system_only_;
+};
@@ -0,0 +1,298 @@
+#pragma once
+#include <grpcpp/support/byte_buffer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "proto/chatservice.grpc.pb.h"
+#include "proto/chatservice.pb.h"
+
+// Nanoseconds on the steady clock, for stage timestamps.
+inline uint64_t MonotonicNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Writes v as a protobuf varint and returns its length, at most 10.
+inline size_t EncodeVarint(uint64_t v, uint8_t *out) {
+  size_t n = 0;
+  for (;; v >>= 7) {
+    out[n++] = static_cast<uint8_t>(v < 0x80 ? v : (v & 0x7F) | 0x80);
+    if (v < 0x80) {
+      return n;
+    }
+  }
+}
+
+// A chat message together with its wire encoding. The message is serialized
+// once when it enters the server and every reader streams the same
+// ref-counted buffer.
+struct LoggedMessage {
+  chat::ChatMessage message;
+  grpc::ByteBuffer wire;
+  // Bytes appended to the log before this entry, stamped on append.
+  uint64_t offset = 0;
+  // When the server received the message and when it was appended, in
+  // MonotonicNs.
+  uint64_t received_ns = 0;
+  uint64_t appended_ns = 0;
+};
+
+inline LoggedMessage MakeLoggedMessage(const chat::ChatMessage &message) {
+  LoggedMessage m{message, {}};
+  bool own_buffer;
+  grpc::SerializationTraits<chat::ChatMessage>::Serialize(message, &m.wire,
+                                                          &own_buffer);
+  m.received_ns = MonotonicNs();
+  return m;
+}
+
+// Stamps a logged message with its sequence number. The field is appended
+// to the cached encoding as an extra slice, which protobuf parsers accept in
+// any position, so the message is not serialized again.
+inline void SetSequence(uint64_t seq, LoggedMessage *m) {
+  m->message.set_seq(seq);
+  uint8_t field[1 + 10];
+  field[0] = 0x18; // field 3, varint
+  size_t n = 1 + EncodeVarint(seq, field + 1);
+  std::vector<grpc::Slice> slices;
+  m->wire.Dump(&slices);
+  slices.emplace_back(field, n);
+  m->wire = grpc::ByteBuffer(slices.data(), slices.size());
+}
+
+// How much history a MessageLog keeps. A zero limit is unlimited. History is
+// evicted a whole segment at a time and the segment being appended to is
+// never evicted, so the limits are only as precise as the segment size.
+struct RetentionPolicy {
+  size_t max_messages = 0;
+  size_t max_bytes = 0;
+  std::chrono::milliseconds max_age{0};
+};
+
+// Append-only message log made of fixed-size segments. Entries never move
+// once written, so a pointer returned by Next stays valid for as long as the
+// cursor that produced it. Appends are serialized by an internal lock;
+// readers only load the published size and never take that lock.
+//
+// The entry at index i has sequence number i + 1, stamped on append.
+//
+// The retained history is the window [First(), Size()). Appends drop the
+// oldest segments once the log is over its retention policy. A cursor that
+// falls behind the window is moved to its oldest entry and counts the
+// entries it missed in skipped.
+class MessageLog {
+public:
+  static constexpr size_t kDefaultSegmentSize = 1024;
+
+  struct Segment {
+    explicit Segment(size_t base, size_t capacity)
+        : base(base), entries(new LoggedMessage[capacity]) {}
+
+    const size_t base;
+    std::unique_ptr<LoggedMessage[]> entries;
+    std::shared_ptr<Segment> next;
+    // Guarded by the log's append lock.
+    size_t bytes = 0;
+    std::chrono::steady_clock::time_point last_append;
+  };
+
+  // A reader's position in the log. Holding the segment keeps it alive.
+  struct Cursor {
+    std::shared_ptr<Segment> segment;
+    size_t index = 0;
+    size_t skipped = 0;
+  };
+
+  // first_index is the index of the first entry appended, for a log that
+  // takes up numbering where another left off.
+  explicit MessageLog(size_t segment_size = kDefaultSegmentSize,
+                      RetentionPolicy retention = {}, size_t first_index = 0)
+      : segment_size_(segment_size), retention_(retention),
+        head_(std::make_shared<Segment>(first_index, segment_size)),
+        tail_(head_), directory_{head_}, size_(first_index),
+        first_(first_index) {}
+
+  size_t Append(LoggedMessage message) {
+    std::unique_lock<std::mutex> lock(append_mu_, std::defer_lock);
+    LockForAppend(lock);
+    auto now = std::chrono::steady_clock::now();
+    size_t index = size_.load(std::memory_order_relaxed);
+    AppendLocked(index, std::move(message), now);
+    size_.store(index + 1, std::memory_order_release);
+    TrimLocked(now);
+    return index;
+  }
+
+  // Appends consecutive entries under one lock acquisition and publishes
+  // them together. Returns the index of the first.
+  size_t Append(std::vector<LoggedMessage> messages) {
+    std::unique_lock<std::mutex> lock(append_mu_, std::defer_lock);
+    LockForAppend(lock);
+    auto now = std::chrono::steady_clock::now();
+    size_t first = size_.load(std::memory_order_relaxed);
+    size_t index = first;
+    for (LoggedMessage &message : messages) {
+      AppendLocked(index++, std::move(message), now);
+    }
+    size_.store(index, std::memory_order_release);
+    TrimLocked(now);
+    return first;
+  }
+
+  // Applies the age limit without waiting for the next append.
+  void Trim() {
+    std::lock_guard<std::mutex> lock(append_mu_);
+    TrimLocked(std::chrono::steady_clock::now());
+  }
+
+  size_t Size() const { return size_.load(std::memory_order_acquire); }
+
+  // Index of the oldest retained entry.
+  size_t First() const { return first_.load(std::memory_order_acquire); }
+
+  // Encoded size of the retained history.
+  size_t Bytes() {
+    std::lock_guard<std::mutex> lock(append_mu_);
+    return bytes_;
+  }
+
+  // Encoded size of everything ever appended. Together with an entry's
+  // offset, tells how many bytes a reader is behind.
+  uint64_t AppendedBytes() const {
+    return appended_bytes_.load(std::memory_order_acquire);
+  }
+
+  // Time appends have spent waiting for the append lock, in ns.
+  uint64_t AppendWaitNs() const {
+    return append_wait_ns_.load(std::memory_order_relaxed);
+  }
+
+  Cursor Begin() const {
+    std::shared_ptr<Segment> head = std::atomic_load(&head_);
+    return Cursor{head, head->base};
+  }
+
+  // Returns a cursor at index, found in constant time through the segment
+  // directory. An index past the end is clamped to it; one before the
+  // retained window leaves the cursor behind it, so the first Peek reports
+  // the entries that are gone as skipped.
+  Cursor Seek(size_t index) {
+    std::lock_guard<std::mutex> lock(append_mu_);
+    const size_t first = directory_.front()->base;
+    if (index < first) {
+      return Cursor{directory_.front(), index};
+    }
+    index = std::min(index, size_.load(std::memory_order_relaxed));
+    size_t segment =
+        std::min((index - first) / segment_size_, directory_.size() - 1);
+    return Cursor{directory_[segment], index};
+  }
+
+  // Returns the entry at the cursor without advancing it, or nullptr when
+  // the cursor has caught up with the published tail.
+  const LoggedMessage *Peek(Cursor *cursor) const {
+    if (cursor->index < First()) {
+      // head_ is published before first_, so this is at least as new.
+      std::shared_ptr<Segment> head = std::atomic_load(&head_);
+      cursor->skipped += head->base - cursor->index;
+      cursor->index = head->base;
+      cursor->segment = std::move(head);
+    }
+    if (cursor->index >= Size()) {
+      return nullptr;
+    }
+    if (cursor->index - cursor->segment->base == segment_size_) {
+      cursor->segment = std::atomic_load(&cursor->segment->next);
+    }
+    return &cursor->segment->entries[cursor->index - cursor->segment->base];
+  }
+
+  // Moves past the entry returned by the last Peek.
+  static void Advance(Cursor *cursor) { cursor->index++; }
+
+  const LoggedMessage *Next(Cursor *cursor) const {
+    const LoggedMessage *m = Peek(cursor);
+    if (m != nullptr) {
+      Advance(cursor);
+    }
+    return m;
+  }
+
+private:
+  // An uncontended append reads no clock.
+  void LockForAppend(std::unique_lock<std::mutex> &lock) {
+    if (lock.try_lock()) {
+      return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    lock.lock();
+    append_wait_ns_.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count(),
+        std::memory_order_relaxed);
+  }
+
+  void AppendLocked(size_t index, LoggedMessage message,
+                    std::chrono::steady_clock::time_point now) {
+    if (index - tail_->base == segment_size_) {
+      auto segment = std::make_shared<Segment>(index, segment_size_);
+      std::atomic_store(&tail_->next, segment);
+      directory_.push_back(segment);
+      tail_ = std::move(segment);
+    }
+    SetSequence(index + 1, &message);
+    size_t length = message.wire.Length();
+    message.offset = appended_bytes_.load(std::memory_order_relaxed);
+    appended_bytes_.store(message.offset + length, std::memory_order_release);
+    tail_->bytes += length;
+    tail_->last_append = now;
+    message.appended_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now.time_since_epoch())
+            .count();
+    bytes_ += length;
+    tail_->entries[index - tail_->base] = std::move(message);
+  }
+
+  bool OverLimit(std::chrono::steady_clock::time_point now) const {
+    const Segment &head = *head_;
+    size_t retained = size_.load(std::memory_order_relaxed) - head.base;
+    return (retention_.max_messages && retained > retention_.max_messages) ||
+           (retention_.max_bytes && bytes_ > retention_.max_bytes) ||
+           (retention_.max_age.count() &&
+            now - head.last_append > retention_.max_age);
+  }
+
+  void TrimLocked(std::chrono::steady_clock::time_point now) {
+    while (head_ != tail_ && OverLimit(now)) {
+      bytes_ -= head_->bytes;
+      std::shared_ptr<Segment> next = std::atomic_load(&head_->next);
+      size_t first = next->base;
+      std::atomic_store(&head_, std::move(next));
+      directory_.pop_front();
+      first_.store(first, std::memory_order_release);
+    }
+  }
+
+  const size_t segment_size_;
+  const RetentionPolicy retention_;
+  // Only replaced under append_mu_; readers load it atomically.
+  std::shared_ptr<Segment> head_;
+  std::mutex append_mu_;
+  std::shared_ptr<Segment> tail_;
+  // Every retained segment in order, for Seek.
+  std::deque<std::shared_ptr<Segment>> directory_;
+  size_t bytes_ = 0;
+  std::atomic<size_t> size_{0};
+  std::atomic<size_t> first_{0};
+  std::atomic<uint64_t> appended_bytes_{0};
+  std::atomic<uint64_t> append_wait_ns_{0};
+};
@@ -0,0 +1,237 @@
+#pragma once
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "logger.h"
+
+// A counter split across cache lines. Each thread adds to its own stripe, so
+// a counter bumped on every message from many threads never bounces a line
+// between cores; reading it sums the stripes. Adding a negative amount makes
+// it a gauge.
+class StripedCounter {
+public:
+  static constexpr size_t kStripes = 16;
+
+  void Add(int64_t n = 1) {
+    stripes_[Stripe()].value.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  int64_t Value() const {
+    int64_t sum = 0;
+    for (const Cell &cell : stripes_) {
+      sum += cell.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+private:
+  struct alignas(64) Cell {
+    std::atomic<int64_t> value{0};
+  };
+
+  static size_t Stripe() {
+    static std::atomic<size_t> next{0};
+    thread_local size_t stripe =
+        next.fetch_add(1, std::memory_order_relaxed) % kStripes;
+    return stripe;
+  }
+
+  Cell stripes_[kStripes];
+};
+
+// A fixed-bucket histogram of integer observations, striped like
+// StripedCounter. bounds are the inclusive upper bounds of the buckets, in
+// the unit observed; scale converts that unit to the one exported.
+class Histogram {
+public:
+  explicit Histogram(std::vector<int64_t> bounds, double scale = 1)
+      : bounds_(std::move(bounds)), scale_(scale),
+        counts_(new StripedCounter[bounds_.size() + 1]) {}
+
+  void Observe(int64_t value) {
+    size_t bucket =
+        std::lower_bound(bounds_.begin(), bounds_.end(), value) -
+        bounds_.begin();
+    counts_[bucket].Add();
+    sum_.Add(value);
+  }
+
+  void Write(std::ostream &out, const std::string &name,
+             const std::string &help) const;
+
+private:
+  const std::vector<int64_t> bounds_;
+  const double scale_;
+  std::unique_ptr<StripedCounter[]> counts_;
+  StripedCounter sum_;
+};
+
+// Latency buckets from 1 us to 100 ms, in ns, for a Histogram with a scale
+// of 1e-9.
+inline std::vector<int64_t> LatencyBoundsNs() {
+  return {1000,    5000,    10000,    50000,    100000,   500000,
+          1000000, 5000000, 10000000, 50000000, 100000000};
+}
+
+// Prometheus text exposition format, version 0.0.4.
+inline std::string FormatMetricValue(double value) {
+  char text[32];
+  snprintf(text, sizeof(text), "%.9g", value);
+  return text;
+}
+
+inline void WriteMetricHeader(std::ostream &out, const std::string &name,
+                              const char *type, const std::string &help) {
+  out << "# HELP " << name << ' ' << help << '\n'
+      << "# TYPE " << name << ' ' << type << '\n';
+}
+
+inline void WriteMetric(std::ostream &out, const std::string &name,
+                        const char *type, const std::string &help,
+                        int64_t value) {
+  WriteMetricHeader(out, name, type, help);
+  out << name << ' ' << value << '\n';
+}
+
+inline void Histogram::Write(std::ostream &out, const std::string &name,
+                             const std::string &help) const {
+  WriteMetricHeader(out, name, "histogram", help);
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i <= bounds_.size(); i++) {
+    cumulative += counts_[i].Value();
+    out << name << "_bucket{le=\""
+        << (i < bounds_.size() ? FormatMetricValue(bounds_[i] * scale_)
+                               : "+Inf")
+        << "\"} " << cumulative << '\n';
+  }
+  out << name << "_sum " << FormatMetricValue(sum_.Value() * scale_) << '\n'
+      << name << "_count " << cumulative << '\n';
+}
+
+// Locks lock, adding however long it had to wait to wait_ns. An uncontended
+// lock costs no clock reads.
+template <class Lock> void LockTimed(Lock &lock, StripedCounter &wait_ns) {
+  if (lock.try_lock()) {
+    return;
+  }
+  auto start = std::chrono::steady_clock::now();
+  lock.lock();
+  wait_ns.Add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count());
+}
+
+// Serves GET /metrics on a loopback port, one request at a time on its own
+// thread, which is all a scraper needs. Port 0 picks a free port.
+class MetricsServer {
+public:
+  MetricsServer(uint16_t port, std::function<std::string()> render)
+      : render_(std::move(render)),
+        fd_(socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0)) {
+    int one = 1;
+    setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    socklen_t length = sizeof(addr);
+    if (fd_ < 0 ||
+        bind(fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        listen(fd_, 16) != 0 ||
+        getsockname(fd_, reinterpret_cast<sockaddr *>(&addr), &length) != 0) {
+      CHAT_LOG(kError) << "System: Failed to serve metrics on port " << port;
+      return;
+    }
+    port_ = ntohs(addr.sin_port);
+    CHAT_LOG(kInfo) << "System: Serving metrics on 127.0.0.1:" << port_;
+    thread_ = std::thread(&MetricsServer::AcceptLoop, this);
+  }
+
+  ~MetricsServer() {
+    stopped_ = true;
+    if (fd_ >= 0) {
+      // Wakes the accept.
+      shutdown(fd_, SHUT_RDWR);
+    }
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  bool ok() const { return port_ != 0; }
+
+  uint16_t port() const { return port_; }
+
+private:
+  void AcceptLoop() {
+    while (!stopped_) {
+      int client = accept4(fd_, nullptr, nullptr, SOCK_CLOEXEC);
+      if (client < 0) {
+        continue;
+      }
+      Serve(client);
+      close(client);
+    }
+  }
+
+  void Serve(int client) {
+    // A scraper that stalls must not hold up the next one forever.
+    timeval timeout{1, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos &&
+           request.size() < 8192) {
+      ssize_t n = read(client, buffer, sizeof(buffer));
+      if (n <= 0) {
+        return;
+      }
+      request.append(buffer, n);
+    }
+
+    std::string status = "200 OK";
+    std::string body;
+    if (request.compare(0, 13, "GET /metrics ") == 0) {
+      body = render_();
+    } else {
+      status = "404 Not Found";
+      body = "Not found\n";
+    }
+    std::string response =
+        "HTTP/1.1 " + status +
+        "\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+        std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+    for (size_t sent = 0; sent < response.size();) {
+      ssize_t n = send(client, response.data() + sent, response.size() - sent,
+                       MSG_NOSIGNAL);
+      if (n <= 0) {
+        return;
+      }
+      sent += n;
+    }
+  }
+
+  const std::function<std::string()> render_;
+  const int fd_;
+  uint16_t port_ = 0;
+  std::atomic<bool> stopped_{false};
+  std::thread thread_;
+};
@@ -1,22 +1,180 @@
+#include "server_options.h"
 
-#include "server.h"
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+
+// Reads the options afresh, as main did.
+using OptionsLoader = function<bool(ServerOptions *, string *)>;
+
+// Applies the nodes of the options reload reads each time the process gets
+// SIGHUP, which has to be blocked in every thread. Nothing else is reloaded.
+void ReloadNodesOnHangup(ChatServiceImpl *service, OptionsLoader reload) {
+  sigset_t hangup;
+  sigemptyset(&hangup);
+  sigaddset(&hangup, SIGHUP);
+  while (true) {
+    int signal;
+    if (sigwait(&hangup, &signal) != 0) {
+      continue;
+    }
+    ServerOptions options;
+    string error;
+    if (!reload(&options, &error)) {
+      CHAT_LOG(kError) << "System: Keeping the nodes: " << error;
+      continue;
+    }
+    if (options.nodes.empty()) {
+      CHAT_LOG(kError) << "System: Keeping the nodes: a sharded node cannot "
+                          "stop being sharded";
+      continue;
+    }
+    service->SetMembership(options.node, HashRing(options.nodes));
+    CHAT_LOG(kInfo) << "System: Sharding rooms over " << options.nodes.size()
+                    << " nodes";
+  }
+}
+
+// Returns non-zero if the server could not start.
+int RunServer(const ServerOptions &options, SharedLog *shared_log = nullptr,
+              OptionsLoader reload = nullptr) {
+  if (!options.nodes.empty() && reload) {
+    // Before the logger or gRPC start any threads, so they all inherit the
+    // mask.
+    sigset_t hangup;
+    sigemptyset(&hangup);
+    sigaddset(&hangup, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &hangup, nullptr);
+  }
+  Logger::Get().SetLevel(options.log_level);
+  unique_ptr<WriteAheadLog> wal;
+  if (!options.wal_path.empty()) {
+    wal = make_unique<WriteAheadLog>(options.wal_path, options.durability);
+    if (!wal->ok()) {
+      CHAT_LOG(kError) << "System: Cannot keep history without the "
+                          "write-ahead log";
+      return 1;
+    }
+  }
+  size_t shards = options.notifier_shards
+                      ? options.notifier_shards
+                      : max(1u, thread::hardware_concurrency());
+  ChatServiceImpl service(
+      shards, options.retention, options.segment_size, std::move(wal),
+      options.lag, shared_log,
+      ReplicationOptions{options.replication_feed, options.leader,
+                         options.address});
+  if (!options.previous_nodes.empty()) {
+    service.SetMembership(options.node, HashRing(options.previous_nodes));
+  }
+  if (!options.nodes.empty()) {
+    service.SetMembership(options.node, HashRing(options.nodes));
+  }
+  service.SetSnapshotInterval(options.snapshot_interval);
 
-void RunServer(const std::string &server_address) {
   ServerBuilder builder;
-  ChatServiceImpl service;
-  builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
+  ConfigureServerBuilder(options, &builder);
+  builder.AddListeningPort(options.address,
+                           grpc::InsecureServerCredentials());
   builder.RegisterService(&service);
-  cout << "Server listening on " << server_address << endl;
+  CHAT_LOG(kInfo) << "Server listening on " << options.address;
   std::unique_ptr<Server> server(builder.BuildAndStart());
+  if (!server) {
+    CHAT_LOG(kError) << "System: Failed to start the server";
+    return 1;
+  }
+  unique_ptr<MetricsServer> metrics;
+  if (options.metrics_port != 0) {
+    metrics = make_unique<MetricsServer>(
+        options.metrics_port, [&service] { return service.Metrics(); });
+  }
 
   thread notify_thread(&ChatServiceImpl::NotifyReadersThread, &service);
   notify_thread.detach();
+  if (!options.nodes.empty() && reload) {
+    thread(ReloadNodesOnHangup, &service, std::move(reload)).detach();
+  }
   server->Wait();
+  return 0;
 }
 
-int main(int argc, char **argv) {
-  std::string server_address = "0.0.0.0:9090";
-  RunServer(server_address);
+// The named bus if there is one, otherwise a shared log only processes
+// forked from this one can see.
+unique_ptr<SharedLog> OpenSharedLog(const ServerOptions &options) {
+  auto shared_log =
+      options.bus.empty()
+          ? make_unique<SharedLog>(options.shared_log_bytes)
+          : make_unique<SharedLog>(options.bus, options.shared_log_bytes);
+  if (!shared_log->ok()) {
+    fprintf(stderr, "Failed to map a %zu byte shared log %s\n",
+            options.shared_log_bytes, options.bus.c_str());
+    return nullptr;
+  }
+  return shared_log;
+}
 
-  return 0;
+// Forks the workers, which all listen on the same port, and waits for them.
+// Nothing here may start gRPC or log: neither survives a fork.
+int RunWorkers(ServerOptions options) {
+  unique_ptr<SharedLog> shared_log = OpenSharedLog(options);
+  if (!shared_log) {
+    return 1;
+  }
+  if (options.notifier_shards == 0) {
+    options.notifier_shards =
+        max<size_t>(1, thread::hardware_concurrency() / options.workers);
+  }
+  vector<pid_t> workers;
+  for (size_t i = 0; i < options.workers; i++) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      perror("fork");
+      break;
+    }
+    if (pid == 0) {
+      // Workers do not outlive the parent.
+      prctl(PR_SET_PDEATHSIG, SIGTERM);
+      ServerOptions worker = options;
+      if (worker.metrics_port != 0) {
+        worker.metrics_port += i;
+      }
+      RunServer(worker, shared_log.get());
+      _exit(1);
+    }
+    workers.push_back(pid);
+  }
+  int failed = workers.size() < options.workers;
+  for (pid_t pid : workers) {
+    int status;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != 0) {
+      failed++;
+    }
+  }
+  return failed > 0;
+}
+
+int main(int argc, char **argv) {
+  // Chat history is kept in memory only unless a write-ahead log is given.
+  ServerOptions options;
+  std::string error;
+  if (!ParseServerOptions(argc, argv, &options, &error)) {
+    fprintf(stderr, "%s\nUsage: %s [--config=FILE] [--name=value ...] [WAL]\n",
+            error.c_str(), argv[0]);
+    return 1;
+  }
+  if (options.workers > 1) {
+    return RunWorkers(options);
+  }
+  if (!options.bus.empty()) {
+    unique_ptr<SharedLog> shared_log = OpenSharedLog(options);
+    if (!shared_log) {
+      return 1;
+    }
+    return RunServer(options, shared_log.get());
+  }
+  return RunServer(options, nullptr, [argc, argv](ServerOptions *reloaded,
+                                                  string *error) {
+    return ParseServerOptions(argc, argv, reloaded, error);
+  });
 }
@@ -1,17 +1,35 @@
 #pragma once
 #define GRPC_CALLBACK_API_NONEXPERIMENTAL
 #include <grpc/grpc.h>
+#include <grpcpp/alarm.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
 #include <grpcpp/security/server_credentials.h>
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
 #include <grpcpp/server_context.h>
+#include <grpcpp/support/byte_buffer.h>
 
 #include <condition_variable>
+#include <deque>
+#include <future>
 #include <iostream>
 #include <mutex>
+#include <shared_mutex>
+#include <sstream>
 #include <stdio.h>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
+#include "hash_ring.h"
+#include "logger.h"
+#include "message_filter.h"
+#include "message_log.h"
+#include "metrics.h"
+#include "shared_log.h"
+#include "snapshot.h"
+#include "wal.h"
 #include "proto/chatservice.grpc.pb.h"
 #include "proto/chatservice.pb.h"
 
@@ -20,167 +38,2767 @@ using namespace grpc;
 using namespace grpc::experimental;
 using namespace chat;
 
-class Reader : public grpc::ServerWriteReactor<ChatMessage> {
+// Size of a log entry once framed as a ChatMessageBatch.messages element.
+inline size_t BatchEntrySize(const LoggedMessage &m) {
+  size_t length = m.wire.Length();
+  size_t header = 2;
+  for (size_t v = length; v >= 0x80; v >>= 7) {
+    header++;
+  }
+  return header + length;
+}
+
+// Appends a log entry to a ChatMessageBatch frame without re-encoding it:
+// the field tag and length go in a small slice, followed by the entry's
+// cached wire slices.
+inline void AppendToBatch(const LoggedMessage &m, vector<Slice> *slices) {
+  uint8_t header[1 + 10];
+  header[0] = 0x0A; // field 1, length-delimited
+  size_t n = 1 + EncodeVarint(m.wire.Length(), header + 1);
+  slices->emplace_back(header, n);
+  vector<Slice> wire;
+  m.wire.Dump(&wire);
+  slices->insert(slices->end(), wire.begin(), wire.end());
+}
+
+// A log entry's cached encoding with a MessageTrace for one reader appended
+// as an extra slice, the same way SetSequence adds the seq.
+inline ByteBuffer WithTrace(const LoggedMessage &m, uint64_t picked_ns,
+                            uint64_t write_ns) {
+  MessageTrace trace;
+  trace.set_received_ns(m.received_ns);
+  trace.set_appended_ns(m.appended_ns);
+  trace.set_picked_ns(picked_ns);
+  trace.set_write_ns(write_ns);
+  string encoded = trace.SerializeAsString();
+  uint8_t header[1 + 10];
+  header[0] = 0x2A; // field 5, length-delimited
+  size_t n = 1 + EncodeVarint(encoded.size(), header + 1);
+  vector<Slice> slices;
+  m.wire.Dump(&slices);
+  slices.emplace_back(header, n);
+  slices.emplace_back(encoded);
+  return ByteBuffer(slices.data(), slices.size());
+}
+
+class Subscriber;
+
+// What the service counts as it runs, exported by ChatServiceImpl::Metrics.
+// Everything on a per-message path is striped, so counting adds no
+// contention.
+struct ServerMetrics {
+  StripedCounter messages_received;
+  StripedCounter bytes_received;
+  StripedCounter bytes_sent;
+  StripedCounter writes_in_flight;
+  // From a notifier shard being handed work to its thread waking, in ns.
+  Histogram wake_latency{LatencyBoundsNs(), 1e-9};
+  // The stages of every delivery of a message to a reader, in ns: received
+  // to appended, appended to picked up for the reader, picked up to
+  // StartWrite, StartWrite to OnWriteDone, and received to OnWriteDone.
+  Histogram ingest_latency{LatencyBoundsNs(), 1e-9};
+  Histogram pickup_latency{LatencyBoundsNs(), 1e-9};
+  Histogram dispatch_latency{LatencyBoundsNs(), 1e-9};
+  Histogram write_latency{LatencyBoundsNs(), 1e-9};
+  Histogram delivery_latency{LatencyBoundsNs(), 1e-9};
+  StripedCounter shared_log_lost_bytes;
+  StripedCounter rooms_handed_off;
+  StripedCounter rooms_taken_over;
+  StripedCounter relayed_messages;
+  StripedCounter snapshots;
+  StripedCounter rooms_lock_wait_ns;
+  StripedCounter room_lock_wait_ns;
+  StripedCounter shard_lock_wait_ns;
+};
+
+// A chat room: its own history and its own members. A message only wakes
+// the members of its room, so a busy room costs other rooms nothing.
+struct Room {
+  Room(const string &name, size_t shards, size_t segment_size,
+       RetentionPolicy retention, size_t first_index = 0)
+      : name(name), log(segment_size, retention, first_index), idle(shards) {}
+
+  const string name;
+  MessageLog log;
+  // Members with nothing left to write, one lock-free stack per notifier
+  // shard. Each is drained whole by its shard's notifier, so there is no
+  // ABA problem.
+  vector<atomic<Subscriber *>> idle;
+  mutex mu;
+  unordered_set<Subscriber *> members;
+  // Set once the room has been handed off to moved_to, another node of a
+  // sharded deployment, and is no longer served here, and while it is taken
+  // back over from moved_to. moved_to is guarded by mu.
+  atomic<bool> moved{false};
+  string moved_to;
+  // Appends admitted before the room moved and not yet in its log. Once it
+  // has moved, the last of them to finish runs drained, so a handoff images
+  // a history nothing more will be added to. drained is guarded by mu.
+  atomic<size_t> appending{0};
+  function<void()> drained;
+  // For a copy of a room another node owns, relayed here for this node's
+  // readers: the owner, and whether the relay is running. Guarded by mu.
+  string owner;
+  bool relaying = false;
+};
+
+// One partition of the connected readers. Each shard has its own lock,
+// wakeup and thread, so fan-out work spreads across cores.
+//
+// Readers with nothing left to write park themselves on their room's idle
+// stack for this shard, and finished readers go on the shard's lock-free
+// retired stack.
+struct NotifierShard {
+  NotifierShard(size_t index, ServerMetrics *metrics)
+      : index(index), metrics(metrics) {}
+
+  const size_t index;
+  ServerMetrics *const metrics;
+  mutex mu;
+  condition_variable wakeup;
+  // Rooms with parked members and new messages since the last wakeup.
+  unordered_set<Room *> ready;
+  bool pending = false;
+  bool stopped = false;
+  // When the shard was first handed work since its last wakeup.
+  chrono::steady_clock::time_point scheduled;
+  atomic<Subscriber *> retired{nullptr};
+
+  void Wake() {
+    unique_lock<mutex> lock(mu, defer_lock);
+    LockTimed(lock, metrics->shard_lock_wait_ns);
+    MarkScheduled();
+    pending = true;
+    wakeup.notify_one();
+  }
+
+  void Schedule(Room *room) {
+    unique_lock<mutex> lock(mu, defer_lock);
+    LockTimed(lock, metrics->shard_lock_wait_ns);
+    MarkScheduled();
+    ready.insert(room);
+    wakeup.notify_one();
+  }
+
+  void MarkScheduled() {
+    if (!pending && ready.empty()) {
+      scheduled = chrono::steady_clock::now();
+    }
+  }
+
+  void Stop() {
+    lock_guard<mutex> lock(mu);
+    stopped = true;
+    wakeup.notify_all();
+  }
+
+  inline void PushIdle(Subscriber *r);
+  inline void Retire(Subscriber *r);
+};
+
+// A connected reader as its notifier shard sees it, whichever kind of
+// stream it reads on.
+class Subscriber {
 public:
-  atomic<bool> done{false};
   string name;
+  NotifierShard *const shard;
+  // Set before the subscriber is registered with its room.
+  Room *room = nullptr;
+  atomic<bool> done{false};
+  // Index of the next log entry it will write, published for metrics.
+  atomic<size_t> position{0};
+  // Whether its join was posted to the room, so that its leave is too.
+  bool announced = false;
+
+  explicit Subscriber(NotifierShard *shard) : shard(shard) {}
+  virtual ~Subscriber() = default;
+
+  // Starts a write if the reader is parked.
+  virtual void NextWrite() = 0;
+  // Ends the reader's stream with status.
+  virtual void EndChat(const Status &status) = 0;
+
+private:
+  friend struct NotifierShard;
+  friend class ChatServiceImpl;
+
+  atomic<bool> queued_{false};
+  Subscriber *next_idle_ = nullptr;
+  Subscriber *next_retired_ = nullptr;
+};
+
+// What happens to a reader that falls behind its lag limit.
+enum class LagAction {
+  // Jump to the newest message, reporting what was skipped.
+  kSkipToLatest,
+  // Drop chat messages until back within the limit, reporting how many.
+  // System messages still go through.
+  kDropChat,
+  // Finish the stream with RESOURCE_EXHAUSTED.
+  kDisconnect,
+};
+
+// How far a reader may trail the newest message in its room, counted from
+// the next message it would be sent. A zero limit is unlimited. Checked once
+// per write, so readers that keep up pay two loads for it.
+struct LagPolicy {
+  size_t max_messages = 0;
+  size_t max_bytes = 0;
+  LagAction action = LagAction::kSkipToLatest;
+};
+
+// Streams the message log to one client. Stream is the gRPC reactor it is
+// written to, so ReadChat and the two-way Chat share the same delivery.
+template <class Stream> class LogReader : public Stream, public Subscriber {
+public:
+  static constexpr uint32_t kDefaultBatchMessages = 64;
+  static constexpr uint32_t kDefaultBatchBytes = 64 * 1024;
+  static constexpr uint32_t kMaxBatchBytes = 1024 * 1024;
+
+  // A batched reader coalesces everything it is behind on into
+  // ChatMessageBatch frames, bounded by the limits in the ChatReader.
+  explicit LogReader(NotifierShard *shard, bool batched = false)
+      : Subscriber(shard), batched_(batched) {}
 
-  Reader(const ChatReader *reader, mutex *mu, condition_variable *notifying,
-         std::vector<ChatMessage> *received_messages)
-      : name(reader->name()), mu_(mu), reader_(reader), notifying_(notifying),
-        received_messages_(received_messages) {
-    // NextWrite();
+  // Sets who is reading, which room, from where and what, and how far
+  // behind it may fall. Must happen before the reader is registered with the
+  // room.
+  void Subscribe(const ChatReader &reader, Room *room, const LagPolicy &lag) {
+    name = reader.name();
+    lag_ = lag;
+    trace_ = reader.trace() && !batched_;
+    this->room = room;
+    received_messages_ = &room->log;
+    cursor_ = StartCursor(reader, received_messages_);
+    position.store(cursor_.index, memory_order_relaxed);
+    if (reader.has_filter()) {
+      filter_ = make_unique<MessageFilter>(reader.filter());
+    }
+    max_batch_messages_ = reader.max_batch_messages()
+                              ? reader.max_batch_messages()
+                              : kDefaultBatchMessages;
+    max_batch_bytes_ =
+        min(reader.max_batch_bytes() ? reader.max_batch_bytes()
+                                     : kDefaultBatchBytes,
+            kMaxBatchBytes);
   }
 
-  ~Reader() override {
-    cout << "System: Reader for " << name << " destroyed" << endl;
+  ~LogReader() override {
+    CHAT_LOG(kInfo) << "System: Reader for " << name << " destroyed";
   }
 
   void OnWriteDone(bool ok) override {
+    shard->metrics->writes_in_flight.Add(-1);
+    picked_ns_ = MonotonicNs();
+    if (frame_received_ns_ != 0) {
+      ServerMetrics *metrics = shard->metrics;
+      metrics->write_latency.Observe(picked_ns_ - write_ns_);
+      metrics->delivery_latency.Observe(picked_ns_ - frame_received_ns_);
+    }
     if (!ok) {
-      Finish(Status(grpc::StatusCode::UNKNOWN, "Unexpected Failure"));
-      return;
+      // This reader still holds the writing state, so WriteOrPark has to be
+      // the one to finish it.
+      FinishOnce(Status(grpc::StatusCode::UNKNOWN, "Unexpected Failure"));
     }
-    NextWrite();
+    WriteOrPark();
   }
 
+  // The reactor is deleted by its shard's notifier once it has been retired,
+  // which waits for every Hold to be released.
   void OnDone() override {
-    cout << "System: RPC Completed" << endl;
+    CHAT_LOG(kInfo) << "System: RPC Completed";
     done = true;
-    notifying_->notify_one();
+    Release();
+  }
+
+  // Keeps the reader from being retired until a matching Release, for work
+  // on it that may outlive the call, such as joining a room once it has
+  // been taken over. Only while the call is running.
+  void Hold() { holds_.fetch_add(1, memory_order_relaxed); }
+
+  void Release() {
+    if (holds_.fetch_sub(1, memory_order_acq_rel) == 1) {
+      shard->Retire(this);
+    }
   }
 
   void OnCancel() override {
-    Finish(Status::CANCELLED);
-    cerr << "System: RPC Cancelled" << endl;
+    FinishOnce(Status::CANCELLED);
+    CHAT_LOG(kInfo) << "System: RPC Cancelled";
+  }
+
+  // Starts a write if the reader is parked. A reader that is already writing
+  // keeps going from OnWriteDone, so this is a no-op for it.
+  void NextWrite() override {
+    int expected = kIdle;
+    if (state_.compare_exchange_strong(expected, kWriting)) {
+      picked_ns_ = MonotonicNs();
+      WriteOrPark();
+    }
+  }
+
+  void EndChat(const Status &status) override { FinishOnce(status); }
+
+  // Finish may not race with StartWrite. An idle reader finishes right away,
+  // a writing one finishes once its write completes.
+  void FinishOnce(const Status &status) {
+    {
+      lock_guard<mutex> lock(finish_mu_);
+      finish_status_ = status;
+    }
+    int state = state_.load();
+    while (true) {
+      if (state == kIdle) {
+        if (state_.compare_exchange_weak(state, kFinished)) {
+          this->Finish(status);
+          return;
+        }
+      } else if (state == kWriting) {
+        if (state_.compare_exchange_weak(state, kFinishPending)) {
+          return;
+        }
+      } else {
+        return;
+      }
+    }
+  }
+
+protected:
+  enum : int { kIdle, kWriting, kFinishPending, kFinished };
+
+  // Resuming starts right after since_seq, and reports a gap if that is no
+  // longer retained. Otherwise the reader gets the last tail_n messages, or
+  // everything that is retained.
+  static MessageLog::Cursor StartCursor(const ChatReader &reader,
+                                        MessageLog *log) {
+    if (reader.since_seq() > 0) {
+      return log->Seek(reader.since_seq());
+    }
+    if (reader.tail_n() > 0) {
+      size_t size = log->Size();
+      size_t start = size > reader.tail_n() ? size - reader.tail_n() : 0;
+      return log->Seek(max(start, log->First()));
+    }
+    return log->Begin();
+  }
+
+  // Runs while this reader holds the writing state.
+  void WriteOrPark() {
+    while (true) {
+      if (state_.load() == kFinishPending) {
+        FinishPending();
+        return;
+      }
+      if (!CheckLag()) {
+        continue;
+      }
+      frame_received_ns_ = 0;
+      const ByteBuffer *frame = NextFrame();
+      position.store(cursor_.index, memory_order_relaxed);
+      if (frame != nullptr) {
+        ServerMetrics *metrics = shard->metrics;
+        if (frame_received_ns_ != 0) {
+          uint64_t picked = max(picked_ns_, frame_appended_ns_);
+          metrics->ingest_latency.Observe(frame_appended_ns_ -
+                                          frame_received_ns_);
+          metrics->pickup_latency.Observe(picked - frame_appended_ns_);
+          metrics->dispatch_latency.Observe(write_ns_ - picked);
+        }
+        metrics->bytes_sent.Add(frame->Length());
+        metrics->writes_in_flight.Add();
+        this->StartWrite(frame);
+        return;
+      }
+
+      int expected = kWriting;
+      if (!state_.compare_exchange_strong(expected, kIdle)) {
+        FinishPending();
+        return;
+      }
+      // Park before looking at the log again: an append that this check
+      // misses is guaranteed to find the reader on the idle stack. The
+      // fence pairs with the one in ChatServiceImpl::WakeRoom.
+      shard->PushIdle(this);
+      atomic_thread_fence(memory_order_seq_cst);
+      if (cursor_.index >= received_messages_->Size()) {
+        return;
+      }
+      expected = kIdle;
+      if (!state_.compare_exchange_strong(expected, kWriting)) {
+        return;
+      }
+      picked_ns_ = MonotonicNs();
+    }
+  }
+
+  void FinishPending() {
+    state_ = kFinished;
+    lock_guard<mutex> lock(finish_mu_);
+    this->Finish(finish_status_);
+  }
+
+  // Applies the lag policy before the next write. Returns false once the
+  // reader is being disconnected.
+  bool CheckLag() {
+    lagging_ = false;
+    if (!lag_.max_messages && !lag_.max_bytes) {
+      return true;
+    }
+    lag_size_ = received_messages_->Size();
+    lag_bytes_ = received_messages_->AppendedBytes();
+    const LoggedMessage *next = received_messages_->Peek(&cursor_);
+    if (next == nullptr || !Behind(*next)) {
+      return true;
+    }
+    switch (lag_.action) {
+    case LagAction::kSkipToLatest: {
+      size_t from = cursor_.index;
+      size_t skipped = cursor_.skipped;
+      cursor_ = received_messages_->Seek(lag_size_ - 1);
+      cursor_.skipped = skipped + (lag_size_ - 1 - from);
+      return true;
+    }
+    case LagAction::kDropChat:
+      lagging_ = true;
+      return true;
+    case LagAction::kDisconnect:
+      CHAT_LOG(kInfo) << "System: Disconnecting " << name << ", "
+                      << lag_size_ - cursor_.index << " messages behind";
+      FinishOnce(Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                        "Reader fell too far behind"));
+      return false;
+    }
+    return true;
+  }
+
+  // Whether the entry at the cursor is past the lag limit, measured against
+  // the log as CheckLag last saw it. The newest entry never is, however
+  // large.
+  bool Behind(const LoggedMessage &m) const {
+    if (cursor_.index + 1 >= lag_size_) {
+      return false;
+    }
+    return (lag_.max_messages &&
+            lag_size_ - cursor_.index > lag_.max_messages) ||
+           (lag_.max_bytes && lag_bytes_ - m.offset > lag_.max_bytes);
+  }
+
+  // Under kDropChat, chat messages past the lag limit are stepped over and
+  // counted; the count goes out as a gap notice before the next message
+  // that is sent.
+  bool DropLagging(const LoggedMessage *next) {
+    if (next == nullptr || !lagging_ || !Behind(*next) ||
+        next->message.name() == "System") {
+      cursor_.skipped += dropped_;
+      dropped_ = 0;
+      return false;
+    }
+    MessageLog::Advance(&cursor_);
+    if (Wanted(*next)) {
+      dropped_++;
+    }
+    return true;
+  }
+
+  virtual const ByteBuffer *NextFrame() {
+    return batched_ ? NextBatch() : NextMessage();
+  }
+
+  const ByteBuffer *NextMessage() {
+    while (true) {
+      const LoggedMessage *next = received_messages_->Peek(&cursor_);
+      if (DropLagging(next)) {
+        continue;
+      }
+      if (cursor_.skipped > 0) {
+        return &TakeGap().wire;
+      }
+      if (next == nullptr) {
+        return nullptr;
+      }
+      MessageLog::Advance(&cursor_);
+      if (Wanted(*next)) {
+        return Deliver(*next);
+      }
+    }
+  }
+
+  // Notes when the frame's message was received and appended for the stage
+  // latencies, and attaches them for a reader that asked for traces.
+  const ByteBuffer *Deliver(const LoggedMessage &m) {
+    StampFrame(m);
+    if (!trace_) {
+      return &m.wire;
+    }
+    traced_ = WithTrace(m, max(picked_ns_, m.appended_ns), write_ns_);
+    return &traced_;
+  }
+
+  void StampFrame(const LoggedMessage &m) {
+    frame_received_ns_ = m.received_ns;
+    frame_appended_ns_ = m.appended_ns;
+    write_ns_ = MonotonicNs();
+  }
+
+  // Filtered-out entries are skipped in place; their cached encoding is
+  // never touched.
+  bool Wanted(const LoggedMessage &m) const {
+    return !filter_ || filter_->Matches(m.message);
+  }
+
+  const ByteBuffer *NextBatch() {
+    vector<Slice> slices;
+    size_t count = 0;
+    size_t bytes = 0;
+    while (count < max_batch_messages_) {
+      const LoggedMessage *next = received_messages_->Peek(&cursor_);
+      if (DropLagging(next)) {
+        continue;
+      }
+      if (cursor_.skipped > 0) {
+        // The gap marker has to come before anything after the jump.
+        if (count > 0) {
+          break;
+        }
+        const LoggedMessage &gap = TakeGap();
+        AppendToBatch(gap, &slices);
+        count++;
+        bytes += BatchEntrySize(gap);
+        continue;
+      }
+      if (next == nullptr) {
+        break;
+      }
+      if (!Wanted(*next)) {
+        MessageLog::Advance(&cursor_);
+        continue;
+      }
+      size_t size = BatchEntrySize(*next);
+      if (count > 0 && bytes + size > max_batch_bytes_) {
+        break;
+      }
+      if (frame_received_ns_ == 0) {
+        StampFrame(*next);
+      }
+      AppendToBatch(*next, &slices);
+      MessageLog::Advance(&cursor_);
+      count++;
+      bytes += size;
+    }
+    if (count == 0) {
+      return nullptr;
+    }
+    batch_ = ByteBuffer(slices.data(), slices.size());
+    return &batch_;
+  }
+
+  // The cursor fell behind the retained history and was moved to its oldest
+  // message. Tells the reader how many messages it missed.
+  virtual const LoggedMessage &TakeGap() {
+    ChatMessage m;
+    m.set_name("System");
+    m.set_message(to_string(cursor_.skipped) +
+                  " messages were dropped from the history");
+    cursor_.skipped = 0;
+    gap_ = MakeLoggedMessage(m);
+    return gap_;
+  }
+
+  MessageLog *received_messages_ = nullptr;
+  // Only touched by whoever holds the writing state.
+  MessageLog::Cursor cursor_;
+  atomic<int> state_{kIdle};
+  mutex finish_mu_;
+  Status finish_status_;
+  const bool batched_;
+  uint32_t max_batch_messages_ = kDefaultBatchMessages;
+  uint32_t max_batch_bytes_ = kDefaultBatchBytes;
+  unique_ptr<MessageFilter> filter_;
+  LagPolicy lag_;
+  // The log's size and appended bytes when CheckLag last ran.
+  size_t lag_size_ = 0;
+  uint64_t lag_bytes_ = 0;
+  bool lagging_ = false;
+  size_t dropped_ = 0;
+  bool trace_ = false;
+  // Stage timestamps of the write in progress, in MonotonicNs: when this
+  // reader picked the log up, when the write started, and when its first
+  // message was received and appended, 0 for a frame with only a gap.
+  uint64_t picked_ns_ = 0;
+  uint64_t write_ns_ = 0;
+  uint64_t frame_received_ns_ = 0;
+  uint64_t frame_appended_ns_ = 0;
+  ByteBuffer batch_;
+  ByteBuffer traced_;
+  LoggedMessage gap_;
+  // One for the call itself, released by OnDone.
+  atomic<int> holds_{1};
+};
+
+using Reader = LogReader<grpc::ServerWriteReactor<ByteBuffer>>;
+
+// Streams a log to another server. Frames are batches as a batched Reader
+// sends them, each with the log's size added so the other end knows how far
+// behind it is. The first frame goes out right away, even if it has no
+// messages, so the other end learns the size without waiting for one.
+class SizedBatchReader : public Reader {
+public:
+  explicit SizedBatchReader(NotifierShard *shard) : Reader(shard, true) {}
+
+protected:
+  const ByteBuffer *NextFrame() override {
+    vector<Slice> slices;
+    if (NextBatch() != nullptr) {
+      batch_.Dump(&slices);
+    } else if (started_) {
+      return nullptr;
+    }
+    started_ = true;
+    uint8_t field[1 + 10];
+    field[0] = 0x10; // field 2, varint
+    size_t n = 1 + EncodeVarint(received_messages_->Size(), field + 1);
+    slices.emplace_back(field, n);
+    batch_ = ByteBuffer(slices.data(), slices.size());
+    return &batch_;
+  }
+
+private:
+  bool started_ = false;
+};
+
+// Streams a leader's replication feed to a follower.
+class ReplicaReader : public SizedBatchReader {
+public:
+  explicit ReplicaReader(NotifierShard *shard) : SizedBatchReader(shard) {}
+
+protected:
+  // The notice has no position, so the follower can tell it apart.
+  const LoggedMessage &TakeGap() override {
+    ReplicatedMessage notice;
+    notice.mutable_message()->set_name("System");
+    notice.mutable_message()->set_message(
+        to_string(cursor_.skipped) +
+        " messages were dropped from the replication feed");
+    cursor_.skipped = 0;
+    gap_ = LoggedMessage{};
+    bool own_buffer;
+    SerializationTraits<ReplicatedMessage>::Serialize(notice, &gap_.wire,
+                                                      &own_buffer);
+    return gap_;
+  }
+};
+
+void NotifierShard::PushIdle(Subscriber *r) {
+  if (r->queued_.exchange(true)) {
+    return;
+  }
+  atomic<Subscriber *> &idle = r->room->idle[index];
+  r->next_idle_ = idle.load(memory_order_relaxed);
+  while (!idle.compare_exchange_weak(r->next_idle_, r, memory_order_acq_rel)) {
+  }
+}
+
+void NotifierShard::Retire(Subscriber *r) {
+  r->next_retired_ = retired.load(memory_order_relaxed);
+  while (!retired.compare_exchange_weak(r->next_retired_, r,
+                                        memory_order_acq_rel)) {
+  }
+  Wake();
+}
+
+// How a service takes part in leader-follower replication.
+struct ReplicationOptions {
+  // Keep a feed of every room's messages, in the order they got their seqs,
+  // for followers to read with Replicate.
+  bool feed = false;
+  // Address of a leader to follow, empty for none. A follower replicates the
+  // leader's rooms into its own, serves reads from them, and forwards
+  // everything sent to it to the leader.
+  string leader;
+  // How a follower is named in its leader's metrics.
+  string name = "follower";
+};
+
+// Which rooms a node of a sharded deployment serves: those its ring gives
+// self. previous is the ring before the last change, which says where a room
+// that has just moved here was. It is empty until the ring first changes, so
+// a node that has just started takes no rooms over and starts those it does
+// not have afresh, whether or not the other nodes are up.
+struct Membership {
+  string self;
+  HashRing ring;
+  HashRing previous;
+};
+
+// A copy of a room another node owns, kept for this node's readers of it
+// from one Relay stream, which a thread of its own starts and reads. mu
+// guards room, the readers waiting for the relay to start and the thread;
+// context_mu guards context, to cancel the stream, and starting, set until
+// the first batch arrives.
+struct RoomRelay {
+  using Waiter = function<void(Status started, Room *room)>;
+
+  mutex mu;
+  unique_ptr<Room> room;
+  vector<Waiter> waiters;
+  mutex context_mu;
+  unique_ptr<ClientContext> context;
+  bool starting = false;
+  unique_ptr<ClientReader<RelayBatch>> stream;
+  thread reader;
+};
+
+// A room that has moved here being taken over by a thread of its own: the
+// requests waiting for it, and its HandOff call, to cancel.
+struct RoomTakeOver {
+  vector<function<void(Status)>> waiters;
+  ClientContext *context = nullptr;
+};
+
+// Writes frames that are ready up front, then finishes with status. One
+// made without frames waits for Start to get them.
+class FrameWriter : public grpc::ServerWriteReactor<ByteBuffer> {
+public:
+  explicit FrameWriter(vector<ByteBuffer> frames, Status status = Status::OK)
+      : status_(std::move(status)) {
+    Start(std::move(frames));
+  }
+
+  FrameWriter() = default;
+
+  void Start(vector<ByteBuffer> frames) {
+    frames_ = std::move(frames);
+    WriteNext();
   }
 
-  void NextWrite() {
-    lock_guard<mutex> lock(*mu_);
-    if (next_message_ < received_messages_->size()) {
-      StartWrite(&received_messages_->at(next_message_++));
+  void OnWriteDone(bool ok) override {
+    if (!ok) {
+      Finish(Status(grpc::StatusCode::UNKNOWN, "Unexpected Failure"));
+      return;
     }
+    next_++;
+    WriteNext();
   }
 
-  void EndChat() { Finish(Status::OK); }
+  void OnDone() override { delete this; }
 
 private:
-  mutex *mu_;
-  const ChatReader *reader_;
-  condition_variable *notifying_;
-  std::vector<ChatMessage> *received_messages_;
-  size_t next_message_{0};
+  void WriteNext() {
+    if (next_ < frames_.size()) {
+      StartWrite(&frames_[next_]);
+    } else {
+      Finish(status_);
+    }
+  }
+
+  vector<ByteBuffer> frames_;
+  const Status status_;
+  size_t next_ = 0;
 };
 
-class ChatServiceImpl final : public ChatService::CallbackService {
+// Send uses the generated callback handler; the methods that stream the log
+// are registered raw so their streams carry pre-serialized ByteBuffers.
+using ChatServiceBase = ChatService::WithRawCallbackMethod_Relay<
+    ChatService::WithRawCallbackMethod_HandOff<
+        ChatService::WithRawCallbackMethod_Replicate<
+            ChatService::WithRawCallbackMethod_Chat<
+                ChatService::WithRawCallbackMethod_ReadChatBatched<
+                    ChatService::WithRawCallbackMethod_ReadChat<
+                        ChatService::WithCallbackMethod_SendStream<
+                            ChatService::WithCallbackMethod_Send<
+                                ChatService::Service>>>>>>>>;
+
+class StreamSender;
+class ChatSession;
+
+class ChatServiceImpl final : public ChatServiceBase {
 public:
-  explicit ChatServiceImpl() {}
+  // Readers are spread over notifier_shards shards, each served by its own
+  // thread once NotifyReadersThread runs. Each room's history is bounded by
+  // retention; readers that fall behind it skip ahead and are told so.
+  //
+  // With a write-ahead log, the snapshot beside it is loaded and the log's
+  // history since the snapshot replayed first, and every new message is
+  // only published, and its Send answered, once it has committed.
+  //
+  // Readers that fall further behind than lag allows are handled by its
+  // action.
+  //
+  // With a shared log, messages are appended to it instead, and every
+  // service tailing it publishes them to its rooms in the order they were
+  // appended, so services in other processes have the same history with the
+  // same seqs. It takes the place of the write-ahead log. The service
+  // starts with whatever the shared log still holds.
+  //
+  // replication makes the service a leader, a follower, or both. A
+  // follower's history comes from its leader, so it is meant to run without
+  // a write-ahead log or shared log of its own.
+  explicit ChatServiceImpl(
+      size_t notifier_shards = max(1u, thread::hardware_concurrency()),
+      RetentionPolicy retention = {},
+      size_t segment_size = MessageLog::kDefaultSegmentSize,
+      unique_ptr<WriteAheadLog> wal = nullptr, LagPolicy lag = {},
+      SharedLog *shared_log = nullptr, ReplicationOptions replication = {})
+      : retention_(retention), segment_size_(segment_size), lag_(lag),
+        shared_log_(shared_log), leader_address_(replication.leader),
+        follower_name_(replication.name),
+        wal_(shared_log ? nullptr : std::move(wal)) {
+    for (size_t i = 0; i < max<size_t>(notifier_shards, 1); i++) {
+      shards_.push_back(make_unique<NotifierShard>(i, &metrics_));
+    }
+    if (replication.feed) {
+      feed_ = make_unique<Room>("", shards_.size(), segment_size_, retention_);
+    }
+    if (!leader_address_.empty()) {
+      leader_ = ChatService::NewStub(
+          CreateChannel(leader_address_, InsecureChannelCredentials()));
+    }
+    if (wal_) {
+      uint64_t generation = LoadSnapshot();
+      // The size of each room a copied message has been replayed into,
+      // kept up to date as the replay appends to it.
+      unordered_map<string, size_t> sizes;
+      size_t replayed = wal_->Replay(
+          [this, &sizes](const ChatMessage &m) {
+            if (m.seq() == 0) {
+              AppendToRoom(GetRoom(m.room()), MakeLoggedMessage(m));
+              auto it = sizes.find(m.room());
+              if (it != sizes.end()) {
+                it->second++;
+              }
+              return;
+            }
+            // Copied from another node when the room moved here, and
+            // numbered as it was there.
+            if (Numbered(m.room(), m.seq(), &sizes)) {
+              ChatMessage copy = m;
+              copy.clear_seq();
+              AppendToRoom(GetRoom(m.room()), MakeLoggedMessage(copy));
+            }
+          },
+          generation);
+      CHAT_LOG(kInfo) << "System: Replayed " << replayed << " messages from "
+                      << wal_->path();
+    }
+    if (shared_log_) {
+      uint64_t head = shared_position_ = shared_log_->Head();
+      uint64_t end;
+      shared_counts_ = shared_log_->Counts(&end);
+      while (shared_position_ < end) {
+        PublishShared();
+      }
+      CHAT_LOG(kInfo) << "System: Caught up on " << end - head
+                      << " bytes of the shared log";
+    }
+  }
 
   ~ChatServiceImpl() override {
-    done_ = true;
-    notifying_.notify_all();
-    lock_guard<mutex> lock(readers_mu_);
-    cout << "System: ChatServiceImpl destroyed" << endl;
+    EndServer();
+    CHAT_LOG(kInfo) << "System: ChatServiceImpl destroyed";
   }
 
   void EndServer() {
-    done_ = true;
-    notifying_.notify_all();
+    shared_stopped_ = true;
+    {
+      lock_guard<mutex> lock(stop_mu_);
+      stopped_ = true;
+      if (follow_context_ != nullptr) {
+        follow_context_->TryCancel();
+      }
+      stop_wakeup_.notify_all();
+    }
+    StopTakeOvers();
+    StopRelays();
+    for (auto &shard : shards_) {
+      shard->Stop();
+    }
   }
 
   ServerUnaryReactor *Send(CallbackServerContext *context,
                            const ChatMessage *message,
                            Response *response) override {
-    mu_.lock();
-    received_messages_.push_back(*message);
-    mu_.unlock();
-
-    cout << "System: Received message from " << message->name() << ": "
-         << message->message() << endl;
+    CHAT_LOG(kDebug) << "System: Received message from " << message->name()
+                     << ": " << message->message();
+    CountReceived(message->ByteSizeLong());
 
-    notifying_.notify_one();
-    response->set_result("OK");
     auto *reactor = context->DefaultReactor();
-    reactor->Finish(Status::OK);
+    Route(message->room(), context,
+          [this, reactor, message, response](Status routed) {
+            if (!routed.ok()) {
+              reactor->Finish(routed);
+              return;
+            }
+            AppendMessage(*message, [reactor, response](bool committed) {
+              if (!committed) {
+                reactor->Finish(Status(grpc::StatusCode::UNAVAILABLE,
+                                       "Failed to persist message"));
+                return;
+              }
+              response->set_result("OK");
+              reactor->Finish(Status::OK);
+            });
+          });
     return reactor;
   }
 
-  grpc::ServerWriteReactor<ChatMessage> *
-  ReadChat(CallbackServerContext *context, const ChatReader *reader) override {
-    ChatMessage m;
-    m.set_name("System");
-    m.set_message(reader->name() + " has joined the chat!");
-    mu_.lock();
-    received_messages_.push_back(m);
-    mu_.unlock();
-
-    Reader *r = new Reader(reader, &mu_, &notifying_, &received_messages_);
-    readers_mu_.lock();
-    received_readers_.push_back(r);
-    readers_mu_.unlock();
-    notifying_.notify_one();
+  grpc::ServerReadReactor<ChatMessage> *
+  SendStream(CallbackServerContext *context, Response *response) override;
+
+  grpc::ServerWriteReactor<ByteBuffer> *
+  ReadChat(CallbackServerContext *context, const ByteBuffer *request) override {
+    return StartReader(request, false, context);
+  }
+
+  grpc::ServerWriteReactor<ByteBuffer> *
+  ReadChatBatched(CallbackServerContext *context,
+                  const ByteBuffer *request) override {
+    return StartReader(request, true, context);
+  }
+
+  grpc::ServerBidiReactor<ByteBuffer, ByteBuffer> *
+  Chat(CallbackServerContext *context) override;
+
+  // A follower reads the feed like a batched reader of a room of its own,
+  // without the join and leave messages.
+  grpc::ServerWriteReactor<ByteBuffer> *
+  Replicate(CallbackServerContext *, const ByteBuffer *request) override {
+    ChatReader reader;
+    ByteBuffer buffer(*request);
+    auto *r = new ReplicaReader(NextShard());
+    if (!SerializationTraits<ChatReader>::Deserialize(&buffer, &reader).ok()) {
+      r->FinishOnce(Status(grpc::StatusCode::INVALID_ARGUMENT,
+                           "Malformed ChatReader"));
+      return r;
+    }
+    if (!feed_) {
+      r->FinishOnce(Status(grpc::StatusCode::FAILED_PRECONDITION,
+                           "Not keeping a replication feed"));
+      return r;
+    }
+    CHAT_LOG(kInfo) << "System: Replicating to " << reader.name()
+                    << " from position " << reader.since_seq();
+    Listen(r, reader, feed_.get());
+    return r;
+  }
+
+  // Another node reads a room this one owns for all of its readers of the
+  // room at once.
+  grpc::ServerWriteReactor<ByteBuffer> *
+  Relay(CallbackServerContext *context, const ByteBuffer *request) override {
+    ChatReader reader;
+    ByteBuffer buffer(*request);
+    auto *r = new SizedBatchReader(NextShard());
+    if (!SerializationTraits<ChatReader>::Deserialize(&buffer, &reader).ok()) {
+      r->FinishOnce(Status(grpc::StatusCode::INVALID_ARGUMENT,
+                           "Malformed ChatReader"));
+      return r;
+    }
+    reader.clear_filter();
+    reader.clear_tail_n();
+    r->Hold();
+    Route(reader.room(), context, [this, r, reader](Status routed) {
+      if (routed.ok()) {
+        CHAT_LOG(kInfo) << "System: Relaying room " << reader.room() << " to "
+                        << reader.name() << " from seq "
+                        << reader.since_seq();
+        Listen(r, reader, GetRoom(reader.room()));
+      } else {
+        r->FinishOnce(routed);
+      }
+      r->Release();
+    });
     return r;
   }
 
-  void EndChat(const Reader *reader) {
-    unique_lock<mutex> lock(readers_mu_);
-    auto it = find_if(received_readers_.begin(), received_readers_.end(),
-                      [reader](Reader *r) { return r == reader; });
+  // The old owner's side of moving a room: from here on the room is
+  // refused, its readers are ended so they reconnect to the new owner, and
+  // its retained history goes to the new owner once the appends already
+  // admitted are in it. Only the owner this node's ring names is handed the
+  // room.
+  grpc::ServerWriteReactor<ByteBuffer> *
+  HandOff(CallbackServerContext *, const ByteBuffer *request) override {
+    ChatReader reader;
+    ByteBuffer buffer(*request);
+    if (!SerializationTraits<ChatReader>::Deserialize(&buffer, &reader).ok()) {
+      return new FrameWriter({}, Status(grpc::StatusCode::INVALID_ARGUMENT,
+                                        "Malformed ChatReader"));
+    }
+    if (sharded_.load(memory_order_acquire)) {
+      shared_ptr<const Membership> membership = atomic_load(&membership_);
+      const string &owner = membership->ring.Owner(reader.room());
+      if (owner != reader.name()) {
+        return new FrameWriter(
+            {}, Status(grpc::StatusCode::FAILED_PRECONDITION,
+                       "Room " + reader.room() + " is served by " + owner));
+      }
+    }
+    Room *room = FindRoom(reader.room());
+    if (room == nullptr) {
+      return new FrameWriter(vector<ByteBuffer>());
+    }
+    auto *writer = new FrameWriter();
+    auto image = [this, room, writer, to = reader.name()] {
+      vector<ByteBuffer> frames = HistoryFrames(room);
+      metrics_.rooms_handed_off.Add();
+      CHAT_LOG(kInfo) << "System: Handed room " << room->name << " off to "
+                      << to << " in " << frames.size() << " batches";
+      writer->Start(std::move(frames));
+    };
+    {
+      lock_guard<mutex> lock(room->mu);
+      room->moved_to = reader.name();
+      room->moved = true;
+      Status moved(grpc::StatusCode::UNAVAILABLE,
+                   "Room " + room->name + " has moved to " + reader.name());
+      for (Subscriber *r : room->members) {
+        r->EndChat(moved);
+      }
+      if (room->appending > 0) {
+        // The last append in flight images the room.
+        room->drained = [earlier = std::move(room->drained), image] {
+          if (earlier) {
+            earlier();
+          }
+          image();
+        };
+        return writer;
+      }
+    }
+    image();
+    return writer;
+  }
+
+  // Shards rooms across the nodes of ring, self being this node's address
+  // in it. The service then serves only the rooms the ring gives it. It
+  // refuses the others, naming their owner, and takes a room that has moved
+  // here over from the node that had it on the room's first request, so a
+  // change to the ring only moves the rooms whose owner changed. Called
+  // again with the new ring as nodes are added and removed; a node joining
+  // is first given the ring without it, and one leaving the ring without
+  // it.
+  void SetMembership(const string &self, HashRing ring) {
+    auto membership = make_shared<Membership>();
+    membership->self = self;
+    shared_ptr<const Membership> current = atomic_load(&membership_);
+    if (current && current->ring.nodes() == ring.nodes()) {
+      membership->previous = current->previous;
+    } else if (current) {
+      membership->previous = current->ring;
+    }
+    membership->ring = std::move(ring);
+    atomic_store(&membership_,
+                 shared_ptr<const Membership>(std::move(membership)));
+    sharded_.store(true, memory_order_release);
+  }
+
+  // With a write-ahead log, takes a snapshot every interval once
+  // NotifyReadersThread runs. Must be called before then.
+  void SetSnapshotInterval(chrono::milliseconds interval) {
+    snapshot_interval_ = interval;
+  }
+
+  // Saves every room's retained history and numbering to a snapshot beside
+  // the write-ahead log and deletes the log files it covers, so a restart
+  // reads the snapshot and replays only what came after it rather than
+  // everything ever sent. Appends pause while the rooms are copied, which
+  // takes no copies of the messages themselves, but not while the snapshot
+  // is written. Returns whether a snapshot was taken.
+  bool Snapshot() {
+    if (!wal_) {
+      return false;
+    }
+    lock_guard<mutex> lock(snapshot_mu_);
+    auto start = chrono::steady_clock::now();
+    vector<RoomImage> rooms;
+    uint64_t generation =
+        wal_->Rotate([this, &rooms] { rooms = ImageRooms(); });
+    if (generation == 0 ||
+        !WriteSnapshot(SnapshotPath(), generation, rooms)) {
+      return false;
+    }
+    wal_->Compact(generation);
+    size_t messages = 0;
+    for (const RoomImage &room : rooms) {
+      messages += room.entries.size();
+    }
+    metrics_.snapshots.Add();
+    CHAT_LOG(kInfo) << "System: Snapshot of " << rooms.size() << " rooms and "
+                    << messages << " messages took "
+                    << chrono::duration_cast<chrono::milliseconds>(
+                           chrono::steady_clock::now() - start)
+                           .count()
+                    << " ms";
+    return true;
+  }
+
+  void EndChat(const Subscriber *reader) {
+    Room *room = reader->room;
+    if (room == nullptr) {
+      return;
+    }
+    unique_lock<mutex> lock(room->mu, defer_lock);
+    LockTimed(lock, metrics_.room_lock_wait_ns);
+    auto it = room->members.find(const_cast<Subscriber *>(reader));
     ChatMessage m;
-    if (it != received_readers_.end()) {
+    m.set_room(room->name);
+    if (it != room->members.end()) {
       m.set_name("System");
       m.set_message((*it)->name + " has left the chat!");
-      received_readers_.erase(it);
+      room->members.erase(it);
     }
+    lock.unlock();
 
-    mu_.lock();
-    received_messages_.push_back(m);
-    mu_.unlock();
+    AppendMessage(m);
   }
 
+  // Serves shard 0 on the calling thread and one extra thread per remaining
+  // shard, plus one tailing the shared log and one following the leader if
+  // there are any, one taking snapshots if they are on, and one expiring
+  // history if it has an age limit. Returns once EndServer has stopped
+  // every shard.
   void NotifyReadersThread() {
-    while (true) {
-      unique_lock<mutex> lock(readers_mu_);
-      notifying_.wait(lock);
-      if (done_)
-        break;
-
-      for (Reader *r : received_readers_) {
-        if (r->done) {
-          ChatMessage m;
-          m.set_name("System");
-          m.set_message(r->name + " has left the chat!");
+    std::vector<thread> threads;
+    for (size_t i = 1; i < shards_.size(); i++) {
+      threads.emplace_back(&ChatServiceImpl::NotifyShard, this,
+                           shards_[i].get());
+    }
+    if (shared_log_) {
+      threads.emplace_back(&ChatServiceImpl::TailSharedLog, this);
+    }
+    if (leader_) {
+      threads.emplace_back(&ChatServiceImpl::FollowLeader, this);
+    }
+    if (wal_ && snapshot_interval_.count() > 0) {
+      threads.emplace_back(&ChatServiceImpl::SnapshotPeriodically, this);
+    }
+    if (retention_.max_age.count() > 0) {
+      threads.emplace_back(&ChatServiceImpl::TrimPeriodically, this);
+    }
+    NotifyShard(shards_[0].get());
+    for (thread &t : threads) {
+      t.join();
+    }
+  }
 
-          mu_.lock();
-          received_messages_.push_back(m);
-          mu_.unlock();
+  // Renders the service's metrics in the Prometheus text format. The reader
+  // counts and lag distribution are taken now by walking every room.
+  string Metrics() {
+    Histogram lag({0, 1, 10, 100, 1000, 10000, 100000});
+    int64_t rooms = 0;
+    int64_t readers = 0;
+    uint64_t append_wait_ns = feed_ ? feed_->log.AppendWaitNs() : 0;
+    {
+      shared_lock<shared_mutex> lock(rooms_mu_);
+      for (auto &entry : rooms_) {
+        Room *room = entry.second.get();
+        append_wait_ns += room->log.AppendWaitNs();
+        size_t size = room->log.Size();
+        lock_guard<mutex> room_lock(room->mu);
+        for (Subscriber *r : room->members) {
+          size_t position = r->position.load(memory_order_relaxed);
+          lag.Observe(size > position ? size - position : 0);
         }
+        readers += room->members.size();
+        rooms++;
       }
+    }
 
-      received_readers_.erase(
-          std::remove_if(received_readers_.begin(), received_readers_.end(),
-                         [](Reader *r) { return r->done.load(); }),
-          received_readers_.end());
-
-      for (Reader *r : received_readers_) {
-        cout << "System: Notifying reader " << r->name << endl;
-        r->NextWrite();
+    ostringstream out;
+    WriteMetric(out, "chat_messages_received_total", "counter",
+                "Messages received from clients.",
+                metrics_.messages_received.Value());
+    WriteMetric(out, "chat_received_bytes_total", "counter",
+                "Encoded size of the messages received from clients.",
+                metrics_.bytes_received.Value());
+    WriteMetric(out, "chat_sent_bytes_total", "counter",
+                "Bytes written to reader streams.",
+                metrics_.bytes_sent.Value());
+    WriteMetric(out, "chat_rooms", "gauge", "Rooms with a log.", rooms);
+    WriteMetric(out, "chat_active_readers", "gauge",
+                "Readers registered with a room.", readers);
+    WriteMetric(out, "chat_writes_in_flight", "gauge",
+                "Reader writes started and not yet completed.",
+                metrics_.writes_in_flight.Value());
+    lag.Write(out, "chat_reader_lag_messages",
+              "Messages each reader has yet to be sent.");
+    metrics_.wake_latency.Write(
+        out, "chat_notifier_wake_latency_seconds",
+        "Time from a notifier shard being handed work to it waking.");
+    metrics_.ingest_latency.Write(
+        out, "chat_ingest_latency_seconds",
+        "Per delivery, time from receiving a message to appending it.");
+    metrics_.pickup_latency.Write(
+        out, "chat_pickup_latency_seconds",
+        "Per delivery, time from appending a message to a reader picking it "
+        "up.");
+    metrics_.dispatch_latency.Write(
+        out, "chat_dispatch_latency_seconds",
+        "Per delivery, time from a reader picking a message up to starting "
+        "its write.");
+    metrics_.write_latency.Write(
+        out, "chat_write_latency_seconds",
+        "Per delivery, time from starting a write to its completion.");
+    metrics_.delivery_latency.Write(
+        out, "chat_delivery_latency_seconds",
+        "Per delivery, time from receiving a message to its write "
+        "completing.");
+    WriteMetric(out, "chat_shared_log_lost_bytes_total", "counter",
+                "Shared log bytes overwritten before this process read them.",
+                metrics_.shared_log_lost_bytes.Value());
+    WriteMetricHeader(out, "chat_lock_wait_seconds_total", "counter",
+                      "Time spent waiting for contended locks.");
+    const pair<const char *, const StripedCounter *> waits[] = {
+        {"rooms", &metrics_.rooms_lock_wait_ns},
+        {"room", &metrics_.room_lock_wait_ns},
+        {"shard", &metrics_.shard_lock_wait_ns},
+    };
+    for (const auto &wait : waits) {
+      out << "chat_lock_wait_seconds_total{lock=\"" << wait.first << "\"} "
+          << FormatMetricValue(wait.second->Value() * 1e-9) << '\n';
+    }
+    // Each log's append lock, summed over the rooms.
+    out << "chat_lock_wait_seconds_total{lock=\"append\"} "
+        << FormatMetricValue(append_wait_ns * 1e-9) << '\n';
+    if (feed_) {
+      WriteMetricHeader(out, "chat_replica_lag_messages", "gauge",
+                        "Feed entries each follower has yet to be sent.");
+      size_t size = feed_->log.Size();
+      lock_guard<mutex> lock(feed_->mu);
+      for (Subscriber *r : feed_->members) {
+        size_t position = r->position.load(memory_order_relaxed);
+        out << "chat_replica_lag_messages{replica=\"" << r->name << "\"} "
+            << (size > position ? size - position : 0) << '\n';
+      }
+    }
+    if (wal_) {
+      WriteMetric(out, "chat_snapshots_total", "counter",
+                  "Snapshots taken of the retained history.",
+                  metrics_.snapshots.Value());
+    }
+    if (sharded_.load(memory_order_relaxed)) {
+      WriteMetric(out, "chat_rooms_handed_off_total", "counter",
+                  "Rooms handed off to the node that took them over.",
+                  metrics_.rooms_handed_off.Value());
+      WriteMetric(out, "chat_rooms_taken_over_total", "counter",
+                  "Rooms taken over, with history, from the node that had "
+                  "them.",
+                  metrics_.rooms_taken_over.Value());
+      int64_t relays = 0;
+      {
+        lock_guard<mutex> lock(relays_mu_);
+        for (auto &entry : relays_) {
+          lock_guard<mutex> relay_lock(entry.second->mu);
+          if (Room *room = entry.second->room.get()) {
+            lock_guard<mutex> room_lock(room->mu);
+            relays += room->relaying;
+          }
+        }
       }
+      WriteMetric(out, "chat_relays", "gauge",
+                  "Rooms owned elsewhere relayed here for local readers.",
+                  relays);
+      WriteMetric(out, "chat_relayed_messages_total", "counter",
+                  "Messages received over relays.",
+                  metrics_.relayed_messages.Value());
+    }
+    if (leader_) {
+      uint64_t end = replica_end_.load(memory_order_relaxed);
+      uint64_t position = replica_position_.load(memory_order_relaxed);
+      WriteMetric(out, "chat_replication_connected", "gauge",
+                  "Whether the stream from the leader is up.",
+                  replica_connected_.load(memory_order_relaxed));
+      WriteMetric(out, "chat_replication_lag_messages", "gauge",
+                  "Leader feed entries not yet replicated, as of the last "
+                  "batch received.",
+                  end > position ? end - position : 0);
     }
+    return out.str();
   }
 
   // for testing purposes
-  std::vector<ChatMessage> GetReceivedMessages() {
-    lock_guard<mutex> lock(mu_);
-    return received_messages_;
+  std::vector<ChatMessage> GetReceivedMessages(const string &room = "") {
+    std::vector<ChatMessage> messages;
+    MessageLog &log = GetRoom(room)->log;
+    MessageLog::Cursor cursor = log.Begin();
+    while (const LoggedMessage *m = log.Next(&cursor)) {
+      messages.push_back(m->message);
+    }
+    return messages;
   }
 
 private:
-  mutex mu_;
-  mutex readers_mu_;
-  condition_variable notifying_{};
-  std::vector<ChatMessage> received_messages_;
-  std::vector<Reader *> received_readers_;
-  atomic_bool done_{false};
-  friend class Reader;
-};
+  // Each wakeup only touches readers that parked since the last one in
+  // rooms that have new messages, plus readers whose RPC has completed,
+  // which are deleted here.
+  void NotifyShard(NotifierShard *shard) {
+    while (true) {
+      unique_lock<mutex> lock(shard->mu);
+      shard->wakeup.wait(lock, [shard] {
+        return shard->pending || !shard->ready.empty() || shard->stopped;
+      });
+      if (shard->stopped)
+        break;
+      metrics_.wake_latency.Observe(
+          chrono::duration_cast<chrono::nanoseconds>(
+              chrono::steady_clock::now() - shard->scheduled)
+              .count());
+      shard->pending = false;
+      unordered_set<Room *> rooms;
+      rooms.swap(shard->ready);
+      lock.unlock();
+
+      // Take the retired list first: a retired reader can no longer park, so
+      // once its room's idle stack has been drained below it is no longer
+      // referenced from any stack.
+      Subscriber *retired =
+          shard->retired.exchange(nullptr, memory_order_acq_rel);
+      for (Subscriber *r = retired; r != nullptr; r = r->next_retired_) {
+        if (r->room != nullptr) {
+          rooms.insert(r->room);
+        }
+      }
+      for (Room *room : rooms) {
+        Subscriber *idle =
+            room->idle[shard->index].exchange(nullptr, memory_order_acq_rel);
+        while (idle != nullptr) {
+          Subscriber *r = idle;
+          idle = r->next_idle_;
+          r->queued_ = false;
+          r->NextWrite();
+        }
+      }
+
+      while (retired != nullptr) {
+        Subscriber *r = retired;
+        retired = r->next_retired_;
+        if (Room *room = r->room) {
+          unique_lock<mutex> room_lock(room->mu, defer_lock);
+          LockTimed(room_lock, metrics_.room_lock_wait_ns);
+          bool registered = room->members.erase(r) > 0;
+          bool unread = room->relaying && room->members.empty();
+          room_lock.unlock();
+          if (registered && r->announced && !room->moved) {
+            Announce(room, r->name + " has left the chat!");
+          }
+          if (unread) {
+            StopRelay(room);
+          }
+        }
+        delete r;
+      }
+    }
+  }
+
+  // Rooms are created on first use and live as long as the service. With a
+  // shared log, a new room's numbering carries on from what had been
+  // appended to it there before the tail's position; what the tail has yet
+  // to publish follows.
+  Room *GetRoom(const string &name) {
+    return GetRoom(name, shared_log_ ? shared_counts_.Appended(name) : 0);
+  }
+
+  // first_index and moved_to only apply if the room is created, which is
+  // created moved to moved_to unless that is empty.
+  Room *GetRoom(const string &name, size_t first_index,
+                const string &moved_to = string()) {
+    if (Room *room = FindRoom(name)) {
+      return room;
+    }
+    unique_lock<shared_mutex> lock(rooms_mu_, defer_lock);
+    LockTimed(lock, metrics_.rooms_lock_wait_ns);
+    unique_ptr<Room> &room = rooms_[name];
+    if (!room) {
+      room = make_unique<Room>(name, shards_.size(), segment_size_,
+                               retention_, first_index);
+      room->moved_to = moved_to;
+      room->moved = !moved_to.empty();
+    }
+    return room.get();
+  }
+
+  string SnapshotPath() const { return wal_->path() + ".snapshot"; }
+
+  // Restores the rooms saved by the last snapshot, if there is one, and
+  // returns the write-ahead log generation that carries on from it.
+  uint64_t LoadSnapshot() {
+    uint64_t generation = 0;
+    vector<SavedRoom> rooms;
+    if (!ReadSnapshot(SnapshotPath(), &generation, &rooms)) {
+      return 0;
+    }
+    size_t messages = 0;
+    for (SavedRoom &saved : rooms) {
+      Room *room = GetRoom(saved.name, saved.first);
+      vector<LoggedMessage> history;
+      history.reserve(saved.messages.size());
+      for (ChatMessage &m : saved.messages) {
+        // The log stamps it again.
+        m.clear_seq();
+        history.push_back(MakeLoggedMessage(m));
+      }
+      messages += history.size();
+      if (!history.empty()) {
+        AppendToRoom(room, std::move(history));
+      }
+    }
+    CHAT_LOG(kInfo) << "System: Loaded " << rooms.size() << " rooms and "
+                    << messages << " messages from " << SnapshotPath();
+    return generation;
+  }
+
+  // Every room's retained history, for a snapshot. Rooms are walked while
+  // nothing is being appended, so each entry is copied by reference.
+  vector<RoomImage> ImageRooms() {
+    vector<RoomImage> rooms;
+    shared_lock<shared_mutex> lock(rooms_mu_);
+    rooms.reserve(rooms_.size());
+    for (auto &entry : rooms_) {
+      MessageLog &log = entry.second->log;
+      RoomImage image;
+      image.name = entry.first;
+      MessageLog::Cursor cursor = log.Seek(log.First());
+      while (const LoggedMessage *m = log.Next(&cursor)) {
+        image.entries.push_back(m->wire);
+      }
+      // An age limit may have trimmed the window meanwhile.
+      image.first = cursor.index - image.entries.size();
+      rooms.push_back(std::move(image));
+    }
+    return rooms;
+  }
+
+  // Skips an interval with nothing new since the last snapshot, but not
+  // the first, which covers whatever the log held at startup.
+  void SnapshotPeriodically() {
+    bool taken = false;
+    uint64_t appended = 0;
+    unique_lock<mutex> lock(stop_mu_);
+    while (!stop_wakeup_.wait_for(lock, snapshot_interval_,
+                                  [this] { return stopped_; })) {
+      lock.unlock();
+      uint64_t now_appended = wal_->appended();
+      if (!taken || now_appended != appended) {
+        taken = Snapshot();
+        appended = now_appended;
+      }
+      lock.lock();
+    }
+  }
+
+  // Appends apply the age limit as they go, but a room nobody posts to would
+  // keep its expired history forever, so every room is trimmed a few times
+  // per max_age as well.
+  void TrimPeriodically() {
+    auto interval = max(retention_.max_age / 4, chrono::milliseconds(1));
+    unique_lock<mutex> lock(stop_mu_);
+    while (!stop_wakeup_.wait_for(lock, interval,
+                                  [this] { return stopped_; })) {
+      lock.unlock();
+      {
+        shared_lock<shared_mutex> rooms_lock(rooms_mu_);
+        for (auto &entry : rooms_) {
+          entry.second->log.Trim();
+        }
+      }
+      if (feed_) {
+        feed_->log.Trim();
+      }
+      lock.lock();
+    }
+  }
+
+  Room *FindRoom(const string &name) {
+    shared_lock<shared_mutex> lock(rooms_mu_, defer_lock);
+    LockTimed(lock, metrics_.rooms_lock_wait_ns);
+    auto it = rooms_.find(name);
+    return it != rooms_.end() ? it->second.get() : nullptr;
+  }
+
+  // Calls done with whether this node serves room: every room unless it is
+  // sharded, and otherwise the rooms its ring gives it, taking one that has
+  // just moved here over first. For any other room the status names the
+  // owner, which also goes in the kOwnerMetadata trailer for clients to
+  // follow. done runs right away, unless the room has to be taken over, when
+  // it runs on the thread taking it over once that is done.
+  void Route(const string &room, ServerContextBase *context,
+             function<void(Status routed)> done) {
+    if (!sharded_.load(memory_order_acquire)) {
+      done(Status::OK);
+      return;
+    }
+    shared_ptr<const Membership> membership = atomic_load(&membership_);
+    const string &owner = membership->ring.Owner(room);
+    if (owner != membership->self) {
+      context->AddTrailingMetadata(kOwnerMetadata, owner);
+      done(Status(grpc::StatusCode::FAILED_PRECONDITION,
+                  "Room " + room + " is served by " + owner));
+      return;
+    }
+    Room *local = FindRoom(room);
+    if (local != nullptr && !local->moved) {
+      done(Status::OK);
+      return;
+    }
+    TakeOver(room, std::move(membership), std::move(done));
+  }
+
+  // Takes a room that has moved here over on a thread of its own, so no
+  // callback thread waits for the copy, and calls done once it has. Each
+  // room is taken over once at a time: requests for it meanwhile wait with
+  // the first, and other rooms are not held up.
+  void TakeOver(const string &name, shared_ptr<const Membership> membership,
+                function<void(Status)> done) {
+    {
+      unique_lock<mutex> lock(takeovers_mu_);
+      if (takeovers_stopped_) {
+        lock.unlock();
+        done(Status(grpc::StatusCode::UNAVAILABLE, "Shutting down"));
+        return;
+      }
+      vector<function<void(Status)>> &waiters = takeovers_[name].waiters;
+      waiters.push_back(std::move(done));
+      if (waiters.size() > 1) {
+        return;
+      }
+      takeover_threads_++;
+    }
+    thread(&ChatServiceImpl::RunTakeOver, this, name, std::move(membership))
+        .detach();
+  }
+
+  void RunTakeOver(const string &name,
+                   shared_ptr<const Membership> membership) {
+    Status status = CopyRoom(name, *membership);
+    vector<function<void(Status)>> waiters;
+    {
+      lock_guard<mutex> lock(takeovers_mu_);
+      auto it = takeovers_.find(name);
+      waiters = std::move(it->second.waiters);
+      takeovers_.erase(it);
+    }
+    for (auto &done : waiters) {
+      done(status);
+    }
+    lock_guard<mutex> lock(takeovers_mu_);
+    if (--takeover_threads_ == 0) {
+      takeovers_done_.notify_all();
+    }
+  }
+
+  // Cancels the takeovers under way and waits for their threads.
+  void StopTakeOvers() {
+    unique_lock<mutex> lock(takeovers_mu_);
+    takeovers_stopped_ = true;
+    for (auto &entry : takeovers_) {
+      if (entry.second.context != nullptr) {
+        entry.second.context->TryCancel();
+      }
+    }
+    takeovers_done_.wait(lock, [this] { return takeover_threads_ == 0; });
+  }
+
+  // Takes over a room that has moved here, copying its history from the
+  // node that had it. The room is served once the copy is in, unless it has
+  // been handed off again meanwhile. A failed copy fails the room's waiting
+  // requests, unless the old node has left the ring and cannot be reached,
+  // when the room starts afresh.
+  Status CopyRoom(const string &name, const Membership &membership) {
+    string from;
+    Room *room = FindRoom(name);
+    if (room != nullptr) {
+      lock_guard<mutex> room_lock(room->mu);
+      if (!room->moved) {
+        return Status::OK;
+      }
+      from = room->moved_to;
+      // Counts as an append, so a handoff meanwhile images the room once
+      // the copy is in.
+      room->appending.fetch_add(1);
+    }
+    if (from.empty() && !membership.previous.empty()) {
+      from = membership.previous.Owner(name);
+    }
+    Status status;
+    if (!from.empty() && from != membership.self) {
+      status = CopyHistory(name, membership, from, &room);
+    }
+    if (room == nullptr) {
+      if (status.ok()) {
+        GetRoom(name);
+      }
+      return status;
+    }
+    {
+      lock_guard<mutex> room_lock(room->mu);
+      if (status.ok() && room->moved_to != from) {
+        status = Status(grpc::StatusCode::UNAVAILABLE,
+                        "Room " + name + " has moved to " + room->moved_to);
+      } else if (status.ok()) {
+        room->moved = false;
+      }
+    }
+    EndAppend(room);
+    return status;
+  }
+
+  // Copies the history of room name from the node from, which stops
+  // serving it. The copy goes through the write-ahead log, with its seqs,
+  // and only returns once it has committed. A room the copy creates is
+  // created moved, counting as an append as CopyRoom's does, and goes in
+  // room.
+  Status CopyHistory(const string &name, const Membership &membership,
+                     const string &from, Room **room) {
+    ClientContext context;
+    context.set_deadline(chrono::system_clock::now() + kHandOffTimeout);
+    ChatReader request;
+    request.set_name(membership.self);
+    request.set_room(name);
+    {
+      lock_guard<mutex> lock(takeovers_mu_);
+      if (takeovers_stopped_) {
+        return Status(grpc::StatusCode::UNAVAILABLE, "Shutting down");
+      }
+      takeovers_.at(name).context = &context;
+    }
+    auto stream = PeerStub(from)->HandOff(&context, request);
+    ChatMessageBatch batch;
+    size_t copied = 0;
+    unordered_map<string, size_t> sizes;
+    vector<future<bool>> commits;
+    while (stream->Read(&batch)) {
+      vector<LoggedMessage> messages;
+      vector<ByteBuffer> records;
+      for (ChatMessage &m : *batch.mutable_messages()) {
+        uint64_t seq = m.seq();
+        m.clear_seq();
+        if (*room == nullptr) {
+          // Not served before the copy is in.
+          *room = GetRoom(name, seq - 1, from);
+          (*room)->appending.fetch_add(1);
+        }
+        if (Numbered(name, seq, &sizes)) {
+          messages.push_back(MakeLoggedMessage(m));
+          LoggedMessage record = messages.back();
+          SetSequence(seq, &record);
+          records.push_back(std::move(record.wire));
+        }
+      }
+      copied += messages.size();
+      auto committed = make_shared<promise<bool>>();
+      commits.push_back(committed->get_future());
+      AppendCopied(std::move(records), std::move(messages),
+                   [committed](bool durable) {
+                     committed->set_value(durable);
+                   });
+    }
+    Status status = stream->Finish();
+    {
+      lock_guard<mutex> lock(takeovers_mu_);
+      takeovers_.at(name).context = nullptr;
+    }
+    bool durable = true;
+    for (future<bool> &committed : commits) {
+      durable = committed.get() && durable;
+    }
+    if (status.ok() && !durable) {
+      return Status(grpc::StatusCode::UNAVAILABLE,
+                    "Failed to persist room " + name);
+    }
+    if (status.ok()) {
+      if (copied > 0) {
+        metrics_.rooms_taken_over.Add();
+      }
+      CHAT_LOG(kInfo) << "System: Took room " << name << " over from "
+                      << from << " with " << copied << " messages";
+    } else if (membership.ring.Contains(from) ||
+               (status.error_code() != grpc::StatusCode::UNAVAILABLE &&
+                status.error_code() !=
+                    grpc::StatusCode::DEADLINE_EXCEEDED)) {
+      return Status(grpc::StatusCode::UNAVAILABLE,
+                    "Cannot take room " + name + " over from " + from +
+                        ": " + status.error_message());
+    } else {
+      CHAT_LOG(kWarning) << "System: " << from << " has left and cannot "
+                         << "hand room " << name << " off, starting it "
+                         << "afresh: " << status.error_message();
+    }
+    return Status::OK;
+  }
+
+  // Appends messages copied from another node to their rooms, once records,
+  // their encodings with the seqs they had there, have committed to the
+  // write-ahead log if there is one. A replay then numbers them the same.
+  void AppendCopied(vector<ByteBuffer> records, vector<LoggedMessage> messages,
+                    function<void(bool committed)> done) {
+    if (!wal_ || messages.empty()) {
+      Publish(std::move(messages));
+      done(true);
+      return;
+    }
+    auto batch = make_shared<vector<LoggedMessage>>(std::move(messages));
+    wal_->Append(records, [this, batch, done](bool committed) {
+      if (committed) {
+        Publish(std::move(*batch));
+      }
+      done(committed);
+    });
+  }
+
+  // A room's retained history as ChatMessageBatch frames, with its seqs.
+  vector<ByteBuffer> HistoryFrames(Room *room) {
+    vector<ByteBuffer> frames;
+    vector<Slice> slices;
+    size_t bytes = 0;
+    MessageLog::Cursor cursor = room->log.Begin();
+    while (const LoggedMessage *m = room->log.Next(&cursor)) {
+      size_t size = BatchEntrySize(*m);
+      if (!slices.empty() && bytes + size > Reader::kDefaultBatchBytes) {
+        frames.emplace_back(slices.data(), slices.size());
+        slices.clear();
+        bytes = 0;
+      }
+      AppendToBatch(*m, &slices);
+      bytes += size;
+    }
+    if (!slices.empty()) {
+      frames.emplace_back(slices.data(), slices.size());
+    }
+    return frames;
+  }
+
+  // Like Route, for a reader, which is served here whichever node owns the
+  // room: one owned elsewhere is read from this node's relay of it. done
+  // gets the room to read if it is routed.
+  void RouteReader(const string &name, ServerContextBase *context,
+                   function<void(Status routed, Room *room)> done) {
+    if (sharded_.load(memory_order_acquire)) {
+      shared_ptr<const Membership> membership = atomic_load(&membership_);
+      const string &owner = membership->ring.Owner(name);
+      if (owner != membership->self) {
+        Relayed(name, owner, membership->self, std::move(done));
+        return;
+      }
+    }
+    Route(name, context, [this, name, done](Status routed) {
+      done(routed, routed.ok() ? GetRoom(name) : nullptr);
+    });
+  }
+
+  // Calls done with the copy of a room relayed from its owner, starting the
+  // relay unless it is running. The relay's thread connects and waits for
+  // the first batch, up to kRelayStartTimeout, and calls done from there, so
+  // no callback thread waits for the owner. Readers arriving meanwhile wait
+  // with the first. A new copy starts where the owner's retained history
+  // does; a restarted one resumes after its last message. A running relay
+  // stays with its owner until its stream ends.
+  void Relayed(const string &name, const string &owner, const string &self,
+               RoomRelay::Waiter done) {
+    RoomRelay *relay;
+    {
+      lock_guard<mutex> lock(relays_mu_);
+      unique_ptr<RoomRelay> &entry = relays_[name];
+      if (!entry) {
+        entry = make_unique<RoomRelay>();
+      }
+      relay = entry.get();
+    }
+    Room *running = nullptr;
+    {
+      lock_guard<mutex> lock(relay->mu);
+      if (relay->room) {
+        lock_guard<mutex> room_lock(relay->room->mu);
+        if (relay->room->relaying) {
+          running = relay->room.get();
+        }
+      }
+      if (running == nullptr && !relays_stopped_) {
+        relay->waiters.push_back(std::move(done));
+        if (relay->waiters.size() == 1) {
+          // The thread of the relay's last run is joined by the new one.
+          relay->reader = thread(&ChatServiceImpl::RunRelay, this, relay, name,
+                                 owner, self, std::move(relay->reader));
+        }
+        return;
+      }
+    }
+    if (running != nullptr) {
+      done(Status::OK, running);
+    } else {
+      done(Status(grpc::StatusCode::UNAVAILABLE, "Shutting down"), nullptr);
+    }
+  }
+
+  // Starts a relay and answers the readers waiting for it, then reads its
+  // stream until it ends and ends this node's readers of the room. They
+  // reconnect, which starts the relay again, from whichever node owns the
+  // room by then.
+  void RunRelay(RoomRelay *relay, const string &name, const string &owner,
+                const string &self, thread previous) {
+    if (previous.joinable()) {
+      previous.join();
+    }
+    Status started = StartRelay(relay, name, owner, self);
+    vector<RoomRelay::Waiter> waiters;
+    Room *room;
+    {
+      lock_guard<mutex> lock(relay->mu);
+      waiters.swap(relay->waiters);
+      room = relay->room.get();
+    }
+    for (RoomRelay::Waiter &done : waiters) {
+      done(started, started.ok() ? room : nullptr);
+    }
+    if (!started.ok()) {
+      return;
+    }
+    RelayBatch batch;
+    while (relay->stream->Read(&batch)) {
+      ApplyRelayed(room, &batch);
+    }
+    Status status = relay->stream->Finish();
+    CHAT_LOG(kInfo) << "System: Stopped relaying room " << room->name << ": "
+                    << status.error_message();
+    Status ended(grpc::StatusCode::UNAVAILABLE,
+                 "The relay of room " + room->name + " ended");
+    lock_guard<mutex> lock(room->mu);
+    room->relaying = false;
+    for (Subscriber *r : room->members) {
+      r->EndChat(ended);
+    }
+  }
+
+  // Opens the relay's stream and applies its first batch. An alarm cancels
+  // the stream if the batch is not there by kRelayStartTimeout.
+  Status StartRelay(RoomRelay *relay, const string &name, const string &owner,
+                    const string &self) {
+    ChatReader request;
+    request.set_name(self);
+    request.set_room(name);
+    request.set_since_seq(relay->room ? relay->room->log.Size() : 0);
+    ClientContext *context;
+    {
+      lock_guard<mutex> context_lock(relay->context_mu);
+      if (relays_stopped_) {
+        return Status(grpc::StatusCode::UNAVAILABLE, "Shutting down");
+      }
+      relay->context = make_unique<ClientContext>();
+      relay->starting = true;
+      context = relay->context.get();
+      relay->stream = PeerStub(owner)->Relay(context, request);
+    }
+    grpc::Alarm deadline;
+    deadline.Set(chrono::system_clock::now() + kRelayStartTimeout,
+                 [relay, context](bool expired) {
+                   lock_guard<mutex> lock(relay->context_mu);
+                   if (expired && relay->starting &&
+                       relay->context.get() == context) {
+                     context->TryCancel();
+                   }
+                 });
+    RelayBatch batch;
+    bool read = relay->stream->Read(&batch);
+    {
+      lock_guard<mutex> context_lock(relay->context_mu);
+      relay->starting = false;
+    }
+    deadline.Cancel();
+    if (!read) {
+      Status status = relay->stream->Finish();
+      return Status(grpc::StatusCode::UNAVAILABLE,
+                    "Cannot relay room " + name + " from " + owner + ": " +
+                        status.error_message());
+    }
+    if (!relay->room) {
+      size_t first = batch.messages_size() > 0 ? batch.messages(0).seq() - 1
+                                               : batch.end();
+      auto room = make_unique<Room>(name, shards_.size(), segment_size_,
+                                    retention_, first);
+      lock_guard<mutex> lock(relay->mu);
+      relay->room = std::move(room);
+    }
+    ApplyRelayed(relay->room.get(), &batch);
+    {
+      lock_guard<mutex> room_lock(relay->room->mu);
+      relay->room->owner = owner;
+      relay->room->relaying = true;
+    }
+    CHAT_LOG(kInfo) << "System: Relaying room " << name << " from " << owner;
+    return Status::OK;
+  }
+
+  // Appends what a relayed batch adds to the room's copy. A gap notice is
+  // only logged; the copy numbers whatever follows a gap on from its own
+  // end.
+  void ApplyRelayed(Room *room, RelayBatch *batch) {
+    vector<LoggedMessage> messages;
+    size_t size = room->log.Size();
+    for (ChatMessage &m : *batch->mutable_messages()) {
+      if (m.seq() == 0) {
+        CHAT_LOG(kWarning) << "System: Relay of room " << room->name << ": "
+                           << m.message();
+        continue;
+      }
+      if (m.seq() <= size) {
+        continue;
+      }
+      m.clear_seq();
+      messages.push_back(MakeLoggedMessage(m));
+      size++;
+    }
+    if (messages.empty()) {
+      return;
+    }
+    metrics_.relayed_messages.Add(messages.size());
+    room->log.Append(std::move(messages));
+    WakeRoom(room);
+  }
+
+  // Stops relaying a room whose last reader here has left, unless another
+  // has joined since.
+  void StopRelay(Room *room) {
+    RoomRelay *relay;
+    {
+      lock_guard<mutex> lock(relays_mu_);
+      relay = relays_.at(room->name).get();
+    }
+    lock_guard<mutex> lock(relay->context_mu);
+    lock_guard<mutex> room_lock(room->mu);
+    if (room->members.empty() && relay->context) {
+      relay->context->TryCancel();
+    }
+  }
+
+  void StopRelays() {
+    relays_stopped_ = true;
+    vector<thread> readers;
+    {
+      lock_guard<mutex> lock(relays_mu_);
+      for (auto &entry : relays_) {
+        // Under mu, no relay is starting, so every stream is cancelled.
+        RoomRelay *relay = entry.second.get();
+        lock_guard<mutex> relay_lock(relay->mu);
+        {
+          lock_guard<mutex> context_lock(relay->context_mu);
+          if (relay->context) {
+            relay->context->TryCancel();
+          }
+        }
+        readers.push_back(std::move(relay->reader));
+      }
+    }
+    for (thread &t : readers) {
+      if (t.joinable()) {
+        t.join();
+      }
+    }
+  }
+
+  ChatService::Stub *PeerStub(const string &address) {
+    lock_guard<mutex> lock(peers_mu_);
+    unique_ptr<ChatService::Stub> &stub = peers_[address];
+    if (!stub) {
+      stub = ChatService::NewStub(
+          CreateChannel(address, InsecureChannelCredentials()));
+    }
+    return stub.get();
+  }
+
+  // Hands the room to every shard where some of its members are parked.
+  // The fence pairs with the one in LogReader::WriteOrPark: either the
+  // append is seen by the parking reader or the reader is seen here.
+  void WakeRoom(Room *room) {
+    atomic_thread_fence(memory_order_seq_cst);
+    for (auto &shard : shards_) {
+      if (room->idle[shard->index].load(memory_order_relaxed) != nullptr) {
+        shard->Schedule(room);
+      }
+    }
+  }
+
+  NotifierShard *NextShard() {
+    return shards_[next_shard_.fetch_add(1) % shards_.size()].get();
+  }
+
+  Reader *StartReader(const ByteBuffer *request, bool batched,
+                      CallbackServerContext *context) {
+    ChatReader reader;
+    ByteBuffer buffer(*request);
+    if (!SerializationTraits<ChatReader>::Deserialize(&buffer, &reader).ok()) {
+      auto *reactor = new Reader(shards_[0].get());
+      reactor->FinishOnce(Status(grpc::StatusCode::INVALID_ARGUMENT,
+                                 "Malformed ChatReader"));
+      return reactor;
+    }
+
+    Reader *r = new Reader(NextShard(), batched);
+    r->Hold();
+    RouteReader(reader.room(), context,
+                [this, r, reader](Status routed, Room *room) {
+                  if (routed.ok()) {
+                    Join(r, reader, room);
+                  } else {
+                    r->FinishOnce(routed);
+                  }
+                  r->Release();
+                });
+    return r;
+  }
+
+  // Announces a reader in its room and starts delivering the room's log to
+  // it. The reader's history includes its own join message.
+  template <class LogReaderType>
+  void Join(LogReaderType *r, const ChatReader &reader, Room *room) {
+    Announce(room, reader.name() + " has joined the chat!");
+    r->announced = true;
+
+    r->Subscribe(reader, room, lag_);
+    {
+      unique_lock<mutex> lock(room->mu, defer_lock);
+      LockTimed(lock, metrics_.room_lock_wait_ns);
+      if (!room->owner.empty() && !room->relaying) {
+        lock.unlock();
+        r->EndChat(Status(grpc::StatusCode::UNAVAILABLE,
+                          "The relay of room " + room->name + " ended"));
+        return;
+      }
+      room->members.insert(r);
+    }
+    r->shard->PushIdle(r);
+    WakeRoom(room);
+  }
+
+  // Registers another server's reader with the room, without a join
+  // message, and starts it. Servers get everything, however far behind.
+  void Listen(Reader *r, const ChatReader &reader, Room *room) {
+    r->Subscribe(reader, room, LagPolicy{});
+    {
+      lock_guard<mutex> lock(room->mu);
+      room->members.insert(r);
+    }
+    r->shard->PushIdle(r);
+    WakeRoom(room);
+  }
+
+  // Posts a System message to the room, through its owner if it is a relay.
+  void Announce(Room *room, const string &text) {
+    ChatMessage m;
+    m.set_name("System");
+    m.set_message(text);
+    m.set_room(room->name);
+    string owner;
+    {
+      lock_guard<mutex> lock(room->mu);
+      owner = room->owner;
+    }
+    if (owner.empty()) {
+      AppendMessage(m);
+    } else {
+      Forward(PeerStub(owner), m, nullptr);
+    }
+  }
+
+  void CountReceived(size_t bytes) {
+    metrics_.messages_received.Add();
+    metrics_.bytes_received.Add(bytes);
+  }
+
+  // Publishes the message to its room once it has committed to the
+  // write-ahead log, if there is one, then calls done. A follower forwards
+  // it to the leader instead.
+  void AppendMessage(const ChatMessage &message,
+                     function<void(bool committed)> done = nullptr) {
+    if (message.seq() != 0) {
+      // Seqs are the server's to give. In the write-ahead log, one marks a
+      // message copied from another node.
+      ChatMessage unnumbered = message;
+      unnumbered.clear_seq();
+      AppendMessage(unnumbered, std::move(done));
+      return;
+    }
+    if (leader_) {
+      Forward(leader_.get(), message, std::move(done));
+      return;
+    }
+    if (shared_log_) {
+      AppendShared({MakeLoggedMessage(message)}, std::move(done));
+      return;
+    }
+    Room *room = GetRoom(message.room());
+    if (!BeginAppend(room)) {
+      if (done) {
+        done(false);
+      }
+      return;
+    }
+    if (!wal_) {
+      AppendToRoom(room, MakeLoggedMessage(message));
+      EndAppend(room);
+      if (done) {
+        done(true);
+      }
+      return;
+    }
+    auto logged = make_shared<LoggedMessage>(MakeLoggedMessage(message));
+    wal_->Append(logged->wire, [this, room, logged, done](bool committed) {
+      if (committed) {
+        AppendToRoom(room, std::move(*logged));
+      }
+      EndAppend(room);
+      if (done) {
+        done(committed);
+      }
+    });
+  }
+
+  // Like AppendMessage for consecutive messages, which go into the
+  // write-ahead log together.
+  void AppendMessages(vector<LoggedMessage> messages,
+                      function<void(bool committed)> done) {
+    if (leader_) {
+      ForwardAll(make_shared<vector<LoggedMessage>>(std::move(messages)), 0,
+                 std::move(done));
+      return;
+    }
+    if (shared_log_) {
+      AppendShared(messages, std::move(done));
+      return;
+    }
+    vector<Room *> rooms;
+    if (!BeginAppends(messages, &rooms)) {
+      done(false);
+      return;
+    }
+    if (!wal_) {
+      Publish(std::move(messages));
+      EndAppends(rooms);
+      done(true);
+      return;
+    }
+    vector<ByteBuffer> records;
+    records.reserve(messages.size());
+    for (const LoggedMessage &m : messages) {
+      records.push_back(m.wire);
+    }
+    auto batch = make_shared<vector<LoggedMessage>>(std::move(messages));
+    wal_->Append(records, [this, batch, rooms, done](bool committed) {
+      if (committed) {
+        Publish(std::move(*batch));
+      }
+      EndAppends(rooms);
+      done(committed);
+    });
+  }
+
+  // Admits an append to room, which counts as in flight until EndAppend,
+  // unless the room has been handed off. The room's moved flag and count
+  // are checked in opposite orders here and in HandOff, so either the
+  // append sees the room moved or the handoff sees the append.
+  bool BeginAppend(Room *room) {
+    room->appending.fetch_add(1);
+    if (room->moved) {
+      EndAppend(room);
+      return false;
+    }
+    return true;
+  }
+
+  void EndAppend(Room *room) {
+    if (room->appending.fetch_sub(1) != 1 || !room->moved) {
+      return;
+    }
+    function<void()> drained;
+    {
+      lock_guard<mutex> lock(room->mu);
+      drained.swap(room->drained);
+    }
+    if (drained) {
+      drained();
+    }
+  }
+
+  // BeginAppend for the room of each run of messages to the same room, as
+  // Publish will append them, into rooms. Admits none if any is refused.
+  bool BeginAppends(const vector<LoggedMessage> &messages,
+                    vector<Room *> *rooms) {
+    const string *name = nullptr;
+    for (const LoggedMessage &m : messages) {
+      if (name != nullptr && m.message.room() == *name) {
+        continue;
+      }
+      name = &m.message.room();
+      Room *room = GetRoom(*name);
+      if (!BeginAppend(room)) {
+        EndAppends(*rooms);
+        rooms->clear();
+        return false;
+      }
+      rooms->push_back(room);
+    }
+    return true;
+  }
+
+  void EndAppends(const vector<Room *> &rooms) {
+    for (Room *room : rooms) {
+      EndAppend(room);
+    }
+  }
+
+  // Appends to the shared log. done runs once this service has published
+  // the records, so the sender's own readers already have them.
+  void AppendShared(const vector<LoggedMessage> &messages,
+                    function<void(bool committed)> done) {
+    unique_lock<mutex> lock(shared_mu_);
+    uint64_t end = shared_log_->Append(messages);
+    if (end == 0) {
+      lock.unlock();
+      CHAT_LOG(kWarning) << "System: Too large for the shared log";
+      if (done) {
+        done(false);
+      }
+      return;
+    }
+    if (done) {
+      shared_pending_.emplace_back(end, std::move(done));
+    }
+  }
+
+  // Publishes whatever any process appends to the shared log, in order, and
+  // answers this service's appends once they are published.
+  void TailSharedLog() {
+    while (!shared_stopped_) {
+      shared_log_->Wait(shared_position_, chrono::milliseconds(50));
+      PublishShared();
+
+      vector<function<void(bool)>> published;
+      {
+        lock_guard<mutex> lock(shared_mu_);
+        while (!shared_pending_.empty() &&
+               shared_pending_.front().first <= shared_position_) {
+          published.push_back(std::move(shared_pending_.front().second));
+          shared_pending_.pop_front();
+        }
+      }
+      for (auto &done : published) {
+        done(true);
+      }
+    }
+  }
+
+  // Publishes up to kMaxSharedBatch records past shared_position_, numbered
+  // by the seqs they carry.
+  void PublishShared() {
+    vector<LoggedMessage> messages;
+    unordered_map<string, size_t> sizes;
+    SharedLog::Record record;
+    uint64_t lost = 0;
+    while (messages.size() < kMaxSharedBatch &&
+           shared_log_->Read(&shared_position_, &record, &lost)) {
+      LoggedMessage m;
+      if (!m.message.ParseFromString(record.payload)) {
+        CHAT_LOG(kWarning) << "System: Skipping malformed shared log record";
+        continue;
+      }
+      if (record.seq != 0 && !Numbered(m.message.room(), record.seq, &sizes)) {
+        continue;
+      }
+      Slice wire(record.payload);
+      m.wire = ByteBuffer(&wire, 1);
+      m.received_ns = record.received_ns;
+      messages.push_back(std::move(m));
+    }
+    if (lost > 0) {
+      metrics_.shared_log_lost_bytes.Add(lost);
+      CHAT_LOG(kWarning) << "System: Lost " << lost
+                         << " bytes of the shared log to overwriting";
+    }
+    Publish(std::move(messages));
+  }
+
+  // Whether a message numbered seq elsewhere goes into its room, where sizes
+  // holds the size each room will have once the batch being built is
+  // published. One that creates its room starts the room at its seq; one
+  // the room already covers, as a replay can meet again, is skipped. A room
+  // that missed messages numbers the rest its own way.
+  bool Numbered(const string &room, uint64_t seq,
+                unordered_map<string, size_t> *sizes) {
+    auto it = sizes->find(room);
+    if (it == sizes->end()) {
+      it = sizes->emplace(room, GetRoom(room, seq - 1)->log.Size()).first;
+    }
+    if (seq <= it->second) {
+      return false;
+    }
+    it->second++;
+    return true;
+  }
+
+  // Sends the message on to the leader, or a relayed room's owner, from
+  // which it comes back through replication or the relay. done gets whether
+  // it was accepted.
+  void Forward(ChatService::Stub *to, const ChatMessage &message,
+               function<void(bool)> done) {
+    struct Call {
+      ClientContext context;
+      ChatMessage request;
+      Response response;
+    };
+    auto call = make_shared<Call>();
+    call->request = message;
+    to->async()->Send(
+        &call->context, &call->request, &call->response,
+        [call, done](Status status) {
+          if (!status.ok()) {
+            CHAT_LOG(kWarning) << "System: Failed to forward a message: "
+                               << status.error_message();
+          }
+          if (done) {
+            done(status.ok());
+          }
+        });
+  }
+
+  // Forwards messages from i on one at a time, so the leader gets them in
+  // order.
+  void ForwardAll(shared_ptr<vector<LoggedMessage>> messages, size_t i,
+                  function<void(bool)> done) {
+    if (i == messages->size()) {
+      done(true);
+      return;
+    }
+    Forward(leader_.get(), (*messages)[i].message,
+            [this, messages, i, done](bool forwarded) {
+              if (!forwarded) {
+                done(false);
+                return;
+              }
+              ForwardAll(messages, i + 1, done);
+            });
+  }
+
+  // Replicates the leader's feed into this service's rooms until EndServer,
+  // resuming from the last position received whenever the stream breaks.
+  void FollowLeader() {
+    while (true) {
+      ClientContext context;
+      {
+        lock_guard<mutex> lock(stop_mu_);
+        if (stopped_) {
+          return;
+        }
+        follow_context_ = &context;
+      }
+      ChatReader request;
+      request.set_name(follower_name_);
+      request.set_since_seq(replica_position_.load(memory_order_relaxed));
+      auto stream = leader_->Replicate(&context, request);
+      ReplicatedBatch batch;
+      while (stream->Read(&batch)) {
+        replica_connected_ = true;
+        ApplyReplicated(&batch);
+      }
+      Status status = stream->Finish();
+      replica_connected_ = false;
+
+      unique_lock<mutex> lock(stop_mu_);
+      follow_context_ = nullptr;
+      if (stopped_) {
+        return;
+      }
+      CHAT_LOG(kWarning) << "System: Lost the leader at " << leader_address_
+                         << ": " << status.error_message() << ", retrying";
+      stop_wakeup_.wait_for(lock, chrono::seconds(1),
+                              [this] { return stopped_; });
+    }
+  }
+
+  void ApplyReplicated(ReplicatedBatch *batch) {
+    vector<LoggedMessage> messages;
+    unordered_map<string, size_t> sizes;
+    for (ReplicatedMessage &r : *batch->mutable_messages()) {
+      if (r.position() == 0) {
+        CHAT_LOG(kWarning) << "System: " << r.message().message();
+        continue;
+      }
+      replica_position_.store(r.position(), memory_order_relaxed);
+      uint64_t seq = r.message().seq();
+      r.mutable_message()->clear_seq();
+      if (Numbered(r.message().room(), seq, &sizes)) {
+        messages.push_back(MakeLoggedMessage(r.message()));
+      }
+    }
+    replica_end_.store(batch->end(), memory_order_relaxed);
+    Publish(std::move(messages));
+  }
+
+  // Each run of messages for the same room goes into its log together.
+  void Publish(vector<LoggedMessage> messages) {
+    for (size_t begin = 0, end; begin < messages.size(); begin = end) {
+      const string &name = messages[begin].message.room();
+      for (end = begin + 1;
+           end < messages.size() && messages[end].message.room() == name;
+           end++) {
+      }
+      Room *room = GetRoom(name);
+      if (begin == 0 && end == messages.size()) {
+        AppendToRoom(room, std::move(messages));
+      } else {
+        AppendToRoom(room, vector<LoggedMessage>(
+                               make_move_iterator(messages.begin() + begin),
+                               make_move_iterator(messages.begin() + end)));
+      }
+    }
+  }
+
+  // Appends to the room's log and wakes its readers. With a replication
+  // feed the new entries go into the feed too, wrapped as
+  // ReplicatedMessages around their cached encoding. feed_mu_ keeps the
+  // feed in the order the entries got their seqs.
+  template <class Messages> void AppendToRoom(Room *room, Messages messages) {
+    if (!feed_) {
+      room->log.Append(std::move(messages));
+      WakeRoom(room);
+      return;
+    }
+    {
+      lock_guard<mutex> lock(feed_mu_);
+      MessageLog::Cursor cursor =
+          room->log.Seek(room->log.Append(std::move(messages)));
+      vector<LoggedMessage> entries;
+      while (const LoggedMessage *m = room->log.Next(&cursor)) {
+        vector<Slice> slices;
+        AppendToBatch(*m, &slices);
+        LoggedMessage entry;
+        entry.wire = ByteBuffer(slices.data(), slices.size());
+        entry.received_ns = m->received_ns;
+        entries.push_back(std::move(entry));
+      }
+      feed_->log.Append(std::move(entries));
+    }
+    WakeRoom(room);
+    WakeRoom(feed_.get());
+  }
+
+  ServerMetrics metrics_;
+  static constexpr size_t kMaxSharedBatch = 1024;
+  static constexpr chrono::seconds kHandOffTimeout{10};
+  // Longer than the owner may take to take the room over itself.
+  static constexpr chrono::seconds kRelayStartTimeout{15};
+
+  std::vector<unique_ptr<NotifierShard>> shards_;
+  atomic<size_t> next_shard_{0};
+  const RetentionPolicy retention_;
+  const size_t segment_size_;
+  const LagPolicy lag_;
+  shared_mutex rooms_mu_;
+  unordered_map<string, unique_ptr<Room>> rooms_;
+  SharedLog *const shared_log_;
+  // Only touched by the constructor and then the tailing thread.
+  uint64_t shared_position_ = 0;
+  // Each room's count in the shared log where the constructor caught up to.
+  // The rooms with records since are created by the tail as it meets them,
+  // so these number any other room created here.
+  SharedLog::RoomCounts shared_counts_;
+  atomic<bool> shared_stopped_{false};
+  mutex shared_mu_;
+  // This service's appends to the shared log, by the position they end at.
+  deque<pair<uint64_t, function<void(bool)>>> shared_pending_;
+  // A leader's replication feed, and the lock that orders it.
+  unique_ptr<Room> feed_;
+  mutex feed_mu_;
+  // A follower's leader and its state, the position and end as of the last
+  // batch received.
+  const string leader_address_;
+  const string follower_name_;
+  unique_ptr<ChatService::Stub> leader_;
+  // Set by EndServer, waking the threads that wait between retries or
+  // snapshots.
+  mutex stop_mu_;
+  condition_variable stop_wakeup_;
+  bool stopped_ = false;
+  ClientContext *follow_context_ = nullptr;
+  atomic<uint64_t> replica_position_{0};
+  atomic<uint64_t> replica_end_{0};
+  atomic<bool> replica_connected_{false};
+  // A sharded deployment's membership, null until SetMembership. It is
+  // swapped whole with atomic_store, so a request sees one ring throughout.
+  shared_ptr<const Membership> membership_;
+  atomic<bool> sharded_{false};
+  // Rooms being taken over, by name, and how many threads are taking them
+  // over.
+  mutex takeovers_mu_;
+  condition_variable takeovers_done_;
+  unordered_map<string, RoomTakeOver> takeovers_;
+  size_t takeover_threads_ = 0;
+  bool takeovers_stopped_ = false;
+  mutex peers_mu_;
+  unordered_map<string, unique_ptr<ChatService::Stub>> peers_;
+  // Rooms owned elsewhere relayed for this node's readers, by name.
+  mutex relays_mu_;
+  unordered_map<string, unique_ptr<RoomRelay>> relays_;
+  atomic<bool> relays_stopped_{false};
+  // Snapshots of the write-ahead log, taken one at a time.
+  chrono::milliseconds snapshot_interval_{0};
+  mutex snapshot_mu_;
+  // Declared last so the flusher stops before anything it publishes to.
+  unique_ptr<WriteAheadLog> wal_;
+  friend class StreamSender;
+  friend class ChatSession;
+};
+
+// Reads a client's SendStream and appends what it sends. Messages that
+// arrive while an earlier batch is being appended queue up and go into the
+// log together under one lock, so batches grow with the load and nothing is
+// held back waiting for one to fill.
+class StreamSender : public grpc::ServerReadReactor<ChatMessage> {
+public:
+  StreamSender(ChatServiceImpl *service, CallbackServerContext *context,
+               Response *response)
+      : service_(service), context_(context), response_(response) {
+    StartRead(&message_);
+  }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) {
+      // The client closed the stream, or the call is gone.
+      {
+        lock_guard<mutex> lock(mu_);
+        reads_done_ = true;
+      }
+      MaybeFinish();
+      return;
+    }
+    // The next read waits for the message to be routed, which may finish
+    // on a thread taking its room over.
+    service_->Route(message_.room(), context_,
+                    [this](Status routed) { Routed(routed); });
+  }
+
+  void OnDone() override { delete this; }
+
+private:
+  // A message for a room served elsewhere ends the stream; what came before
+  // it is still appended. Off the reactions, the reactor may be finished by
+  // a commit callback as soon as mu_ is let go with nothing outstanding, so
+  // the decision to finish is made under the same lock.
+  void Routed(const Status &routed) {
+    if (!routed.ok()) {
+      Status status;
+      bool finish;
+      {
+        lock_guard<mutex> lock(mu_);
+        reads_done_ = true;
+        routed_ = routed;
+        finish = FinishingLocked(&status);
+      }
+      if (finish) {
+        Finish(status);
+      }
+      return;
+    }
+    message_.clear_seq();
+    LoggedMessage m = MakeLoggedMessage(message_);
+    service_->CountReceived(m.wire.Length());
+    {
+      lock_guard<mutex> lock(mu_);
+      pending_.push_back(std::move(m));
+    }
+    // The next read may complete on another thread while this one appends.
+    StartRead(&message_);
+    Drain();
+  }
+
+  void Drain() {
+    unique_lock<mutex> lock(mu_);
+    if (appending_) {
+      return;
+    }
+    appending_ = true;
+    while (!pending_.empty()) {
+      vector<LoggedMessage> batch;
+      batch.swap(pending_);
+      uncommitted_++;
+      lock.unlock();
+      // The commit may come on another thread after every reaction has
+      // returned, so it decides whether to finish under the same lock as
+      // its update: once it lets go, the reactor may already be gone.
+      service_->AppendMessages(std::move(batch), [this](bool committed) {
+        Status status;
+        bool finish;
+        {
+          lock_guard<mutex> lock(mu_);
+          uncommitted_--;
+          failed_ |= !committed;
+          finish = FinishingLocked(&status);
+        }
+        if (finish) {
+          Finish(status);
+        }
+      });
+      lock.lock();
+    }
+    appending_ = false;
+    Status status;
+    bool finish = FinishingLocked(&status);
+    lock.unlock();
+    if (finish) {
+      Finish(status);
+    }
+  }
+
+  // Answers once the stream has ended and everything read has committed.
+  // Only called from reactions, which gRPC lets return before OnDone.
+  void MaybeFinish() {
+    Status status;
+    bool finish;
+    {
+      lock_guard<mutex> lock(mu_);
+      finish = FinishingLocked(&status);
+    }
+    if (finish) {
+      Finish(status);
+    }
+  }
+
+  // Whether the stream has ended and everything read has committed, in
+  // which case it is marked finished and the caller, the only one to be
+  // told so, must Finish with status.
+  bool FinishingLocked(Status *status) {
+    if (!reads_done_ || appending_ || !pending_.empty() || uncommitted_ > 0 ||
+        finished_) {
+      return false;
+    }
+    finished_ = true;
+    if (!routed_.ok()) {
+      *status = routed_;
+    } else if (failed_) {
+      *status = Status(grpc::StatusCode::UNAVAILABLE,
+                       "Failed to persist message");
+    } else {
+      response_->set_result("OK");
+    }
+    return true;
+  }
+
+  ChatServiceImpl *const service_;
+  CallbackServerContext *const context_;
+  Response *const response_;
+  ChatMessage message_;
+  mutex mu_;
+  vector<LoggedMessage> pending_;
+  bool appending_ = false;
+  size_t uncommitted_ = 0;
+  bool reads_done_ = false;
+  bool failed_ = false;
+  Status routed_;
+  bool finished_ = false;
+};
+
+inline grpc::ServerReadReactor<ChatMessage> *
+ChatServiceImpl::SendStream(CallbackServerContext *context,
+                            Response *response) {
+  return new StreamSender(this, context, response);
+}
+
+// Sends and reads on one stream. The first message from the client names the
+// user, the room and, through its seq, where to resume reading, and asks for
+// traces if it carries one; its text is posted only if it has any. Every
+// later message is posted under that name to that room.
+//
+// Writes deliver the log exactly as ReadChat would, so a client's own
+// messages come back to it stamped with their seq once they have committed.
+// That echo is the acknowledgement; a message that fails to commit ends the
+// call with UNAVAILABLE instead. Reads and writes run independently, and a
+// client that closes its side keeps reading until it cancels.
+class ChatSession
+    : public LogReader<grpc::ServerBidiReactor<ByteBuffer, ByteBuffer>> {
+public:
+  using Base = LogReader<grpc::ServerBidiReactor<ByteBuffer, ByteBuffer>>;
+
+  ChatSession(ChatServiceImpl *service, NotifierShard *shard,
+              CallbackServerContext *context)
+      : Base(shard), service_(service), context_(context) {
+    StartRead(&request_);
+  }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) {
+      return;
+    }
+    size_t bytes = request_.Length();
+    ChatMessage message;
+    if (!SerializationTraits<ChatMessage>::Deserialize(&request_, &message)
+             .ok()) {
+      FinishOnce(Status(grpc::StatusCode::INVALID_ARGUMENT,
+                        "Malformed ChatMessage"));
+      return;
+    }
+    if (!joined_) {
+      joined_ = true;
+      // Held until it has joined, which may finish on a thread taking the
+      // room over.
+      Hold();
+      service_->Route(message.room(), context_,
+                      [this, message, bytes](Status routed) {
+                        Start(routed, message, bytes);
+                      });
+      return;
+    }
+    if (!message.message().empty()) {
+      service_->CountReceived(bytes);
+      Post(std::move(message));
+    }
+    StartRead(&request_);
+  }
+
+private:
+  // Joins the room the first message names, posts it and reads on, then
+  // lets go of the session.
+  void Start(const Status &routed, ChatMessage message, size_t bytes) {
+    if (!routed.ok()) {
+      FinishOnce(routed);
+      Release();
+      return;
+    }
+    ChatReader reader;
+    reader.set_name(message.name());
+    reader.set_since_seq(message.seq());
+    reader.set_room(message.room());
+    reader.set_trace(message.has_trace());
+    service_->Join(this, reader, service_->GetRoom(message.room()));
+    if (!message.message().empty()) {
+      service_->CountReceived(bytes);
+      Post(std::move(message));
+    }
+    StartRead(&request_);
+    Release();
+  }
+
+  void Post(ChatMessage message) {
+    message.set_name(name);
+    message.set_room(room->name);
+    message.clear_seq();
+    message.clear_trace();
+    // A message still committing holds on to the session, so the shard only
+    // gets it once the last commit callback has run.
+    Hold();
+    service_->AppendMessage(message, [this](bool committed) {
+      if (!committed) {
+        // A no-op once the call has finished.
+        FinishOnce(Status(grpc::StatusCode::UNAVAILABLE,
+                          "Failed to persist message"));
+      }
+      Release();
+    });
+  }
+
+  ChatServiceImpl *const service_;
+  CallbackServerContext *const context_;
+  // Only touched by the read reactions, which never overlap.
+  ByteBuffer request_;
+  bool joined_ = false;
+};
+
+inline grpc::ServerBidiReactor<ByteBuffer, ByteBuffer> *
+ChatServiceImpl::Chat(CallbackServerContext *context) {
+  return new ChatSession(this, NextShard(), context);
+}
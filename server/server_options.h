@@ -0,0 +1,430 @@
+#pragma once
+#include <grpcpp/resource_quota.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+
+#include "server.h"
+
+// Everything RunServer can be told. Each field is also a flag, --name=value,
+// and a line of a config file, name = value, named as in the comments.
+struct ServerOptions {
+  // address
+  string address = "0.0.0.0:9090";
+  // metrics_port: loopback port for Prometheus metrics, 0 to not serve them
+  uint16_t metrics_port = 9091;
+  // log_level: debug, info, warning, error or off
+  LogLevel log_level = LogLevel::kInfo;
+  // notifier_shards: threads fanning messages out to readers, 0 for one
+  // per core, split between the workers
+  size_t notifier_shards = 0;
+  // workers: processes serving the same port through SO_REUSEPORT, sharing
+  // one message log in shared memory. Each serves metrics on its own port,
+  // counting up from metrics_port.
+  size_t workers = 1;
+  // shared_log_bytes: size of that shared log; the newest messages that fit
+  // are kept
+  size_t shared_log_bytes = 64 * 1024 * 1024;
+  // bus: name of a shared log in /dev/shm for servers started separately on
+  // this host to share, workers or not. Whichever starts first creates it
+  // with shared_log_bytes.
+  string bus;
+
+  // replication_feed: true to keep a feed of every room for followers
+  bool replication_feed = false;
+  // leader: address of a server with a replication feed to follow, empty
+  // for none. A follower serves reads from its replica and forwards what is
+  // sent to it to the leader.
+  string leader;
+
+  // nodes: comma-separated addresses of every node of a sharded deployment,
+  // which splits the rooms between them by consistent hashing. Empty to
+  // serve every room here. Reloaded on SIGHUP.
+  vector<string> nodes;
+  // node: this node's address in nodes, if it is not address
+  string node;
+  // previous_nodes: the nodes before this node joined or is leaving. A node
+  // only takes rooms over from other nodes once the nodes change while it
+  // runs, so one joining a running deployment is started with the nodes as
+  // they were, and one leaving it is sent the nodes without it.
+  vector<string> previous_nodes;
+
+  // wal: path of the write-ahead log, empty to keep history in memory only
+  string wal_path;
+  // durability: none, batched or per-message
+  Durability durability = Durability::kBatched;
+  // snapshot_ms: how often to snapshot the retained history and delete the
+  // wal files it covers, so startup need not replay them. 0 for never.
+  chrono::milliseconds snapshot_interval{0};
+
+  // segment_size, retain_messages, retain_bytes, retain_ms
+  size_t segment_size = MessageLog::kDefaultSegmentSize;
+  RetentionPolicy retention;
+  // lag_messages, lag_bytes, lag_action: skip, drop or disconnect
+  LagPolicy lag;
+
+  // gRPC. Zero leaves gRPC's default.
+  //
+  // max_concurrent_streams: per connection
+  int max_concurrent_streams = 0;
+  // max_receive_message_size, max_send_message_size: in bytes
+  int max_receive_message_size = 0;
+  int max_send_message_size = 0;
+  // keepalive_ms, keepalive_timeout_ms: ping idle connections this often and
+  // drop those that do not answer in time
+  int keepalive_ms = 0;
+  int keepalive_timeout_ms = 0;
+  // memory_limit: bytes gRPC may allocate for its buffers, via the
+  // ResourceQuota
+  size_t memory_limit = 0;
+};
+
+namespace server_options {
+
+inline bool ParseSize(const string &value, size_t *out) {
+  char *end;
+  errno = 0;
+  unsigned long long v = strtoull(value.c_str(), &end, 10);
+  if (value.empty() || *end != '\0' || errno != 0 || value[0] == '-') {
+    return false;
+  }
+  *out = v;
+  return true;
+}
+
+template <class Int> bool ParseInt(const string &value, Int *out) {
+  size_t v;
+  if (!ParseSize(value, &v) || v > size_t(numeric_limits<Int>::max())) {
+    return false;
+  }
+  *out = static_cast<Int>(v);
+  return true;
+}
+
+template <class Enum>
+bool ParseEnum(const string &value, const map<string, Enum> &names,
+               Enum *out) {
+  auto it = names.find(value);
+  if (it == names.end()) {
+    return false;
+  }
+  *out = it->second;
+  return true;
+}
+
+using Setter = function<bool(ServerOptions *, const string &)>;
+
+inline const map<string, Setter> &Setters() {
+  static const map<string, Setter> setters = {
+      {"address",
+       [](ServerOptions *o, const string &v) {
+         o->address = v;
+         return !v.empty();
+       }},
+      {"metrics_port",
+       [](ServerOptions *o, const string &v) {
+         return ParseInt(v, &o->metrics_port);
+       }},
+      {"log_level",
+       [](ServerOptions *o, const string &v) {
+         return ParseEnum(v,
+                          map<string, LogLevel>{{"debug", LogLevel::kDebug},
+                                                {"info", LogLevel::kInfo},
+                                                {"warning", LogLevel::kWarning},
+                                                {"error", LogLevel::kError},
+                                                {"off", LogLevel::kOff}},
+                          &o->log_level);
+       }},
+      {"notifier_shards",
+       [](ServerOptions *o, const string &v) {
+         return ParseSize(v, &o->notifier_shards);
+       }},
+      {"workers",
+       [](ServerOptions *o, const string &v) {
+         return ParseSize(v, &o->workers) && o->workers > 0;
+       }},
+      {"shared_log_bytes",
+       [](ServerOptions *o, const string &v) {
+         return ParseSize(v, &o->shared_log_bytes);
+       }},
+      {"bus",
+       [](ServerOptions *o, const string &v) {
+         o->bus = v;
+         return v.find('/', 1) == string::npos;
+       }},
+      {"replication_feed",
+       [](ServerOptions *o, const string &v) {
+         return ParseEnum(v,
+                          map<string, bool>{{"true", true}, {"false", false}},
+                          &o->replication_feed);
+       }},
+      {"leader",
+       [](ServerOptions *o, const string &v) {
+         o->leader = v;
+         return true;
+       }},
+      {"nodes",
+       [](ServerOptions *o, const string &v) {
+         o->nodes = ParseNodeList(v);
+         return true;
+       }},
+      {"node",
+       [](ServerOptions *o, const string &v) {
+         o->node = v;
+         return !v.empty();
+       }},
+      {"previous_nodes",
+       [](ServerOptions *o, const string &v) {
+         o->previous_nodes = ParseNodeList(v);
+         return true;
+       }},
+      {"wal",
+       [](ServerOptions *o, const string &v) {
+         o->wal_path = v;
+         return true;
+       }},
+      {"durability",
+       [](ServerOptions *o, const string &v) {
+         return ParseEnum(
+             v,
+             map<string, Durability>{{"none", Durability::kNone},
+                                     {"batched", Durability::kBatched},
+                                     {"per-message", Durability::kPerMessage}},
+             &o->durability);
+       }},
+      {"snapshot_ms",
+       [](ServerOptions *o, const string &v) {
+         size_t ms;
+         if (!ParseSize(v, &ms)) {
+           return false;
+         }
+         o->snapshot_interval = chrono::milliseconds(ms);
+         return true;
+       }},
+      {"segment_size",
+       [](ServerOptions *o, const string &v) {
+         return ParseSize(v, &o->segment_size) && o->segment_size > 0;
+       }},
+      {"retain_messages",
+       [](ServerOptions *o, const string &v) {
+         return ParseSize(v, &o->retention.max_messages);
+       }},
+      {"retain_bytes",
+       [](ServerOptions *o, const string &v) {
+         return ParseSize(v, &o->retention.max_bytes);
+       }},
+      {"retain_ms",
+       [](ServerOptions *o, const string &v) {
+         size_t ms;
+         if (!ParseSize(v, &ms)) {
+           return false;
+         }
+         o->retention.max_age = chrono::milliseconds(ms);
+         return true;
+       }},
+      {"lag_messages",
+       [](ServerOptions *o, const string &v) {
+         return ParseSize(v, &o->lag.max_messages);
+       }},
+      {"lag_bytes",
+       [](ServerOptions *o, const string &v) {
+         return ParseSize(v, &o->lag.max_bytes);
+       }},
+      {"lag_action",
+       [](ServerOptions *o, const string &v) {
+         return ParseEnum(
+             v,
+             map<string, LagAction>{{"skip", LagAction::kSkipToLatest},
+                                    {"drop", LagAction::kDropChat},
+                                    {"disconnect", LagAction::kDisconnect}},
+             &o->lag.action);
+       }},
+      {"max_concurrent_streams",
+       [](ServerOptions *o, const string &v) {
+         return ParseInt(v, &o->max_concurrent_streams);
+       }},
+      {"max_receive_message_size",
+       [](ServerOptions *o, const string &v) {
+         return ParseInt(v, &o->max_receive_message_size);
+       }},
+      {"max_send_message_size",
+       [](ServerOptions *o, const string &v) {
+         return ParseInt(v, &o->max_send_message_size);
+       }},
+      {"keepalive_ms",
+       [](ServerOptions *o, const string &v) {
+         return ParseInt(v, &o->keepalive_ms);
+       }},
+      {"keepalive_timeout_ms",
+       [](ServerOptions *o, const string &v) {
+         return ParseInt(v, &o->keepalive_timeout_ms);
+       }},
+      {"memory_limit",
+       [](ServerOptions *o, const string &v) {
+         return ParseSize(v, &o->memory_limit);
+       }},
+  };
+  return setters;
+}
+
+inline bool Set(const string &name, const string &value,
+                ServerOptions *options, string *error) {
+  auto it = Setters().find(name);
+  if (it == Setters().end()) {
+    *error = "unknown option " + name;
+    return false;
+  }
+  if (!it->second(options, value)) {
+    *error = "bad value for " + name + ": " + value;
+    return false;
+  }
+  return true;
+}
+
+inline string Trim(const string &s) {
+  size_t begin = s.find_first_not_of(" \t\r");
+  if (begin == string::npos) {
+    return "";
+  }
+  return s.substr(begin, s.find_last_not_of(" \t\r") - begin + 1);
+}
+
+} // namespace server_options
+
+// Reads name = value lines into options. Blank lines and lines starting
+// with # are skipped.
+inline bool LoadServerConfig(const string &path, ServerOptions *options,
+                             string *error) {
+  ifstream file(path);
+  if (!file) {
+    *error = "cannot read " + path;
+    return false;
+  }
+  string line;
+  for (int number = 1; getline(file, line); number++) {
+    line = server_options::Trim(line);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    size_t equals = line.find('=');
+    if (equals == string::npos) {
+      *error = path + ":" + to_string(number) + ": expected name = value";
+      return false;
+    }
+    if (!server_options::Set(server_options::Trim(line.substr(0, equals)),
+                             server_options::Trim(line.substr(equals + 1)),
+                             options, error)) {
+      *error = path + ":" + to_string(number) + ": " + *error;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Parses --name=value flags, and --config=FILE, which is applied where it
+// appears so later flags override it. A bare argument is the write-ahead
+// log path, as it was before there were flags.
+inline bool ParseServerOptions(int argc, char **argv, ServerOptions *options,
+                               string *error) {
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (strncmp(arg, "--", 2) != 0) {
+      options->wal_path = arg;
+      continue;
+    }
+    const char *value = strchr(arg, '=');
+    if (value == nullptr) {
+      *error = string("expected --name=value, got ") + arg;
+      return false;
+    }
+    string name(arg + 2, value++);
+    if (name == "config") {
+      if (!LoadServerConfig(value, options, error)) {
+        return false;
+      }
+    } else if (!server_options::Set(name, value, options, error)) {
+      return false;
+    }
+  }
+  if ((options->workers > 1 || !options->bus.empty()) &&
+      !options->wal_path.empty()) {
+    *error = "workers and buses share their log in memory and cannot use a wal";
+    return false;
+  }
+  if (options->snapshot_interval.count() > 0 && options->wal_path.empty()) {
+    *error = "snapshots are of the wal; snapshot_ms needs a wal";
+    return false;
+  }
+  if (!options->leader.empty() &&
+      (options->workers > 1 || !options->bus.empty() ||
+       !options->wal_path.empty())) {
+    *error = "a follower's log comes from its leader; it cannot also have "
+             "workers, a bus or a wal";
+    return false;
+  }
+  if (!options->nodes.empty()) {
+    if (options->workers > 1 || !options->bus.empty() ||
+        !options->leader.empty()) {
+      *error = "a sharded node serves its rooms alone; it cannot also have "
+               "workers, a bus or a leader";
+      return false;
+    }
+    if (options->node.empty()) {
+      options->node = options->address;
+    }
+    auto listed = [&options](const vector<string> &nodes) {
+      return find(nodes.begin(), nodes.end(), options->node) != nodes.end();
+    };
+    if (!listed(options->nodes) && !listed(options->previous_nodes)) {
+      *error = "this node, " + options->node + ", is not one of the nodes";
+      return false;
+    }
+  } else if (!options->previous_nodes.empty()) {
+    *error = "previous_nodes needs nodes";
+    return false;
+  }
+  return true;
+}
+
+// Applies the gRPC knobs that are set to builder.
+inline void ConfigureServerBuilder(const ServerOptions &options,
+                                   ServerBuilder *builder) {
+  if (options.workers > 1) {
+    // The default on Linux, but the workers depend on it.
+    builder->AddChannelArgument(GRPC_ARG_ALLOW_REUSEPORT, 1);
+  }
+  if (options.max_concurrent_streams > 0) {
+    builder->AddChannelArgument(GRPC_ARG_MAX_CONCURRENT_STREAMS,
+                                options.max_concurrent_streams);
+  }
+  if (options.max_receive_message_size > 0) {
+    builder->SetMaxReceiveMessageSize(options.max_receive_message_size);
+  }
+  if (options.max_send_message_size > 0) {
+    builder->SetMaxSendMessageSize(options.max_send_message_size);
+  }
+  if (options.keepalive_ms > 0) {
+    builder->AddChannelArgument(GRPC_ARG_KEEPALIVE_TIME_MS,
+                                options.keepalive_ms);
+    builder->AddChannelArgument(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+    // Clients may ping as often as the server does.
+    builder->AddChannelArgument(
+        GRPC_ARG_HTTP2_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS,
+        options.keepalive_ms);
+  }
+  if (options.keepalive_timeout_ms > 0) {
+    builder->AddChannelArgument(GRPC_ARG_KEEPALIVE_TIMEOUT_MS,
+                                options.keepalive_timeout_ms);
+  }
+  if (options.memory_limit > 0) {
+    ResourceQuota quota("chatserver");
+    quota.Resize(options.memory_limit);
+    builder->SetResourceQuota(quota);
+  }
+}
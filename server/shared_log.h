@@ -0,0 +1,448 @@
+#pragma once
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "message_log.h"
+
+// A ring of serialized ChatMessages in shared memory that several processes
+// append to and tail. Appends take a process-shared lock, so every process
+// reads the records in the same order; tailing takes no lock at all.
+//
+// Positions are byte offsets that only grow. The ring keeps the newest
+// records that fit in its capacity: an append that needs the room moves the
+// head past the oldest records before overwriting them, and a reader that
+// finds its position behind the head has been lapped and skips ahead.
+//
+// Appends wake tailers through a futex in the shared memory, so a process
+// blocked in Wait sleeps in the kernel until something is appended.
+//
+// Every record carries its seq within its room, counted in a table in the
+// shared memory, so a process that starts tailing after the ring has wrapped
+// still numbers each room's messages as the others do.
+class SharedLog {
+public:
+  // A record read back from the ring.
+  struct Record {
+    // The serialized ChatMessage, without its seq
+    std::string payload;
+    // When it was appended, in MonotonicNs, which every process on the host
+    // shares
+    uint64_t received_ns = 0;
+    // Its seq within its room, 0 if the room table had no slot for it
+    uint64_t seq = 0;
+  };
+
+  // Maps capacity bytes, rounded up to whole pages, of anonymous shared
+  // memory. Processes forked afterwards share it.
+  explicit SharedLog(size_t capacity) {
+    capacity = RoundToPages(capacity);
+    if (Map(-1, kDataOffset + capacity)) {
+      Initialize(capacity);
+    }
+  }
+
+  // Opens the ring called name in /dev/shm, so unrelated processes on the
+  // host can share it. The first to open it creates it with capacity bytes;
+  // the rest map it at the size it was created with. It stays there after
+  // they all exit, until it is removed.
+  SharedLog(const std::string &name, size_t capacity) {
+    std::string path = name[0] == '/' ? name : "/" + name;
+    int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+      return;
+    }
+    // Keeps a second process from initializing it too, or from mapping it
+    // half initialized.
+    flock(fd, LOCK_EX);
+    struct stat st;
+    if (fstat(fd, &st) == 0) {
+      if (st.st_size == 0) {
+        capacity = RoundToPages(capacity);
+        if (ftruncate(fd, kDataOffset + capacity) == 0 &&
+            Map(fd, kDataOffset + capacity)) {
+          Initialize(capacity);
+        }
+      } else if (size_t(st.st_size) > kDataOffset && Map(fd, st.st_size)) {
+        Header *header = reinterpret_cast<Header *>(memory_);
+        if (header->magic == kMagic &&
+            header->capacity == size_ - kDataOffset) {
+          header_ = header;
+        }
+      }
+    }
+    flock(fd, LOCK_UN);
+    close(fd);
+  }
+
+  ~SharedLog() {
+    if (memory_ != nullptr) {
+      munmap(memory_, size_);
+    }
+  }
+
+  SharedLog(const SharedLog &) = delete;
+  SharedLog &operator=(const SharedLog &) = delete;
+
+  bool ok() const { return header_ != nullptr; }
+
+  size_t capacity() const { return header_->capacity; }
+
+  // Position of the oldest record still in the ring.
+  uint64_t Head() const {
+    return header_->head.load(std::memory_order_acquire);
+  }
+
+  // Position just past the newest record.
+  uint64_t End() const { return header_->end.load(std::memory_order_acquire); }
+
+  // How many messages have been appended to room, 0 if none or if the room
+  // table has no slot for it.
+  uint64_t Appended(const std::string &room) const {
+    const RoomSlot *slot = FindRoom(room);
+    return slot ? slot->appended.load(std::memory_order_acquire) : 0;
+  }
+
+  // Every room's count as of one position, as Counts took them.
+  class RoomCounts {
+  public:
+    // As Appended, but as of that position.
+    uint64_t Appended(const std::string &room) const {
+      size_t i = FindSlot(RoomHash(room),
+                          [this](size_t slot) { return hashes_[slot]; });
+      return i < hashes_.size() ? counts_[i] : 0;
+    }
+
+  private:
+    friend class SharedLog;
+    std::vector<uint64_t> hashes_;
+    std::vector<uint64_t> counts_;
+  };
+
+  // Every room's count as of the position just past the newest record,
+  // which goes in end, taken together under the lock.
+  RoomCounts Counts(uint64_t *end) {
+    RoomCounts counts;
+    counts.hashes_.resize(kRoomSlots);
+    counts.counts_.resize(kRoomSlots);
+    Lock();
+    for (size_t i = 0; i < kRoomSlots; i++) {
+      const RoomSlot &slot = header_->rooms[i];
+      counts.hashes_[i] = slot.hash.load(std::memory_order_relaxed);
+      counts.counts_[i] = slot.appended.load(std::memory_order_relaxed);
+    }
+    *end = header_->end.load(std::memory_order_relaxed);
+    pthread_mutex_unlock(&header_->mu);
+    return counts;
+  }
+
+  // Appends the messages' wire encodings together and returns the position
+  // just past the last, or 0 if they could never fit in the ring.
+  uint64_t Append(const std::vector<LoggedMessage> &messages) {
+    size_t total = 0;
+    for (const LoggedMessage &m : messages) {
+      total += RecordSize(m.wire.Length());
+    }
+    // Leaves room for the padding a wrap may need.
+    if (total > header_->capacity / 2) {
+      return 0;
+    }
+    uint64_t received_ns = MonotonicNs();
+    std::vector<grpc::Slice> slices;
+    // Room counts are only stored once the records are written, so a process
+    // that dies mid-append leaves no gap in a room's seqs.
+    std::vector<std::pair<RoomSlot *, uint64_t>> counts;
+    Lock();
+    uint64_t end = header_->end.load(std::memory_order_relaxed);
+    for (const LoggedMessage &m : messages) {
+      uint64_t seq = NextSeq(m.message.room(), &counts);
+      size_t length = m.wire.Length();
+      size_t size = RecordSize(length);
+      size_t offset = end % header_->capacity;
+      if (offset + size > header_->capacity) {
+        // Records never wrap; the rest of the ring is skipped instead.
+        size_t padding = header_->capacity - offset;
+        MakeRoom(end + padding);
+        WriteHeader(offset, RecordHeader{uint32_t(padding - kHeaderSize),
+                                         kPadding, 0, 0, 0});
+        end += padding;
+        offset = 0;
+      }
+      MakeRoom(end + size);
+      WriteHeader(offset,
+                  RecordHeader{uint32_t(length), 0, received_ns, seq, 0});
+      char *data = Data() + offset + kHeaderSize;
+      slices.clear();
+      m.wire.Dump(&slices);
+      for (const grpc::Slice &s : slices) {
+        memcpy(data, s.begin(), s.size());
+        data += s.size();
+      }
+      end += size;
+    }
+    for (const auto &count : counts) {
+      count.first->appended.store(count.second, std::memory_order_release);
+    }
+    header_->end.store(end, std::memory_order_release);
+    header_->appends.fetch_add(1, std::memory_order_seq_cst);
+    pthread_mutex_unlock(&header_->mu);
+    // Pairs with Wait: either the waiter is seen here or it sees the append.
+    if (header_->waiters.load(std::memory_order_seq_cst) > 0) {
+      Futex(FUTEX_WAKE, INT_MAX, nullptr);
+    }
+    return end;
+  }
+
+  // Copies the record at position into out and moves position past it.
+  // Returns false once position has caught up. A position the ring has
+  // overwritten moves to the head first, adding the bytes skipped to lost.
+  bool Read(uint64_t *position, Record *out, uint64_t *lost) {
+    while (true) {
+      if (*position >= End()) {
+        return false;
+      }
+      uint64_t head = Head();
+      if (*position < head) {
+        *lost += head - *position;
+        *position = head;
+        continue;
+      }
+      size_t offset = *position % header_->capacity;
+      RecordHeader record;
+      memcpy(&record, Data() + offset, sizeof(record));
+      size_t size = RecordSize(record.length);
+      bool fits = offset + size <= header_->capacity;
+      if (fits && record.flags != kPadding) {
+        out->payload.assign(Data() + offset + kHeaderSize, record.length);
+      }
+      // Whatever was copied is only good if the head has not passed it
+      // since; appends move the head before overwriting.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (header_->head.load(std::memory_order_relaxed) > *position) {
+        continue;
+      }
+      if (!fits) {
+        // Only a torn copy looks like this, and the head check catches it.
+        continue;
+      }
+      *position += size;
+      if (record.flags == kPadding) {
+        continue;
+      }
+      out->received_ns = record.received_ns;
+      out->seq = record.seq;
+      return true;
+    }
+  }
+
+  // Blocks until something has been appended past position, or timeout has
+  // passed.
+  void Wait(uint64_t position, std::chrono::milliseconds timeout) {
+    uint32_t appends = header_->appends.load(std::memory_order_acquire);
+    if (End() > position) {
+      return;
+    }
+    header_->waiters.fetch_add(1, std::memory_order_seq_cst);
+    if (header_->appends.load(std::memory_order_seq_cst) == appends) {
+      timespec ts{time_t(timeout.count() / 1000),
+                  long(timeout.count() % 1000 * 1000000)};
+      Futex(FUTEX_WAIT, appends, &ts);
+    }
+    header_->waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+private:
+  struct RecordHeader {
+    uint32_t length;
+    uint32_t flags;
+    uint64_t received_ns;
+    uint64_t seq;
+    // Pads the header to a power of two
+    uint64_t reserved;
+  };
+
+  // A room's message count, found by open addressing on a hash of its name.
+  // Slots are claimed under the lock and never freed.
+  struct RoomSlot {
+    std::atomic<uint64_t> hash{0};
+    std::atomic<uint64_t> appended{0};
+  };
+
+  // Bumped whenever the layout changes, so a ring left in /dev/shm by an
+  // older build is refused rather than misread.
+  static constexpr uint64_t kMagic = 0x63686174726e6702;
+  static constexpr size_t kRoomSlots = 4096;
+  static constexpr size_t kMaxProbes = 64;
+
+  struct Header {
+    uint64_t magic = 0;
+    size_t capacity = 0;
+    pthread_mutex_t mu;
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> end{0};
+    alignas(64) std::atomic<uint32_t> appends{0};
+    std::atomic<uint32_t> waiters{0};
+    alignas(64) RoomSlot rooms[kRoomSlots];
+  };
+
+  static constexpr uint32_t kPadding = 1;
+  static constexpr size_t kHeaderSize = sizeof(RecordHeader);
+  static constexpr size_t kDataOffset = (sizeof(Header) + 63) / 64 * 64;
+
+  // Records start on a kHeaderSize boundary, so the space left before a
+  // wrap always has room for a padding record's header.
+  static size_t RecordSize(size_t length) {
+    return (kHeaderSize + length + kHeaderSize - 1) / kHeaderSize *
+           kHeaderSize;
+  }
+
+  static size_t RoundToPages(size_t size) {
+    size_t page = sysconf(_SC_PAGESIZE);
+    return (std::max(size, page) + page - 1) / page * page;
+  }
+
+  // FNV-1a, which unlike std::hash is the same in every build. 0 marks a
+  // free slot.
+  static uint64_t RoomHash(const std::string &room) {
+    uint64_t hash = 0xcbf29ce484222325;
+    for (char c : room) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+    }
+    return hash ? hash : 1;
+  }
+
+  bool Map(int fd, size_t size) {
+    void *memory =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE,
+             fd < 0 ? MAP_SHARED | MAP_ANONYMOUS : MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+      return false;
+    }
+    memory_ = static_cast<char *>(memory);
+    size_ = size;
+    return true;
+  }
+
+  void Initialize(size_t capacity) {
+    header_ = new (memory_) Header;
+    header_->capacity = capacity;
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&header_->mu, &attr);
+    pthread_mutexattr_destroy(&attr);
+    header_->magic = kMagic;
+  }
+
+  // The slot holding hash, where hash_at gives the hash each slot holds, or
+  // kRoomSlots if there is none.
+  template <typename HashAt>
+  static size_t FindSlot(uint64_t hash, HashAt hash_at) {
+    for (size_t i = 0; i < kMaxProbes; i++) {
+      size_t slot = (hash + i) % kRoomSlots;
+      uint64_t found = hash_at(slot);
+      if (found == hash) {
+        return slot;
+      }
+      if (found == 0) {
+        return kRoomSlots;
+      }
+    }
+    return kRoomSlots;
+  }
+
+  const RoomSlot *FindRoom(const std::string &room) const {
+    size_t i = FindSlot(RoomHash(room), [this](size_t slot) {
+      return header_->rooms[slot].hash.load(std::memory_order_acquire);
+    });
+    return i < kRoomSlots ? &header_->rooms[i] : nullptr;
+  }
+
+  // Under the lock: the seq the next message in room gets, counting those
+  // earlier in the same append, or 0 if the table has no slot for it.
+  uint64_t NextSeq(const std::string &room,
+                   std::vector<std::pair<RoomSlot *, uint64_t>> *counts) {
+    uint64_t hash = RoomHash(room);
+    RoomSlot *slot = nullptr;
+    for (size_t i = 0; i < kMaxProbes && slot == nullptr; i++) {
+      RoomSlot &candidate = header_->rooms[(hash + i) % kRoomSlots];
+      uint64_t found = candidate.hash.load(std::memory_order_relaxed);
+      if (found == 0) {
+        candidate.hash.store(hash, std::memory_order_release);
+        slot = &candidate;
+      } else if (found == hash) {
+        slot = &candidate;
+      }
+    }
+    if (slot == nullptr) {
+      return 0;
+    }
+    for (auto &count : *counts) {
+      if (count.first == slot) {
+        return ++count.second;
+      }
+    }
+    counts->emplace_back(slot,
+                         slot->appended.load(std::memory_order_relaxed) + 1);
+    return counts->back().second;
+  }
+
+  char *Data() const { return memory_ + kDataOffset; }
+
+  // A process that died holding the lock can only have left records past
+  // the published end, which the next append overwrites.
+  void Lock() {
+    if (pthread_mutex_lock(&header_->mu) == EOWNERDEAD) {
+      pthread_mutex_consistent(&header_->mu);
+    }
+  }
+
+  // Moves the head past the oldest records until the ring has room for
+  // everything up to end. The release fence keeps readers from trusting a
+  // copy of what is about to be overwritten.
+  void MakeRoom(uint64_t end) {
+    uint64_t head = header_->head.load(std::memory_order_relaxed);
+    if (end - head <= header_->capacity) {
+      return;
+    }
+    while (end - head > header_->capacity) {
+      RecordHeader record;
+      memcpy(&record, Data() + head % header_->capacity, sizeof(record));
+      head += RecordSize(record.length);
+    }
+    header_->head.store(head, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  void WriteHeader(size_t offset, const RecordHeader &record) {
+    memcpy(Data() + offset, &record, sizeof(record));
+  }
+
+  long Futex(int op, uint32_t value, const timespec *timeout) {
+    return syscall(SYS_futex, &header_->appends, op, value, timeout, nullptr,
+                   0);
+  }
+
+  char *memory_ = nullptr;
+  size_t size_ = 0;
+  Header *header_ = nullptr;
+};
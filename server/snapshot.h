@@ -0,0 +1,117 @@
+#pragma once
+#include <fcntl.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "logger.h"
+#include "proto/chatservice.pb.h"
+#include "wal.h"
+
+// A room's retained history as a snapshot keeps it: the index of its first
+// retained message, and the messages' encodings, which carry their seqs.
+struct RoomImage {
+  std::string name;
+  uint64_t first = 0;
+  std::vector<grpc::ByteBuffer> entries;
+};
+
+// A room as read back from a snapshot. The messages keep their seqs.
+struct SavedRoom {
+  std::string name;
+  uint64_t first = 0;
+  std::vector<chat::ChatMessage> messages;
+};
+
+// Writes rooms to a snapshot at path, along with the write-ahead log
+// generation that carries on from it. The file is written beside path,
+// synced and renamed over it, so a crash leaves the previous snapshot or
+// the new one whole, never a mix.
+inline bool WriteSnapshot(const std::string &path, uint64_t wal_generation,
+                          const std::vector<RoomImage> &rooms) {
+  const std::string temp = path + ".tmp";
+  int fd = open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    CHAT_LOG(kError) << "System: Failed to create snapshot " << temp;
+    return false;
+  }
+  chat::SnapshotHeader header;
+  header.set_wal_generation(wal_generation);
+  header.set_rooms(rooms.size());
+  std::string buffer;
+  AppendRecord(header.SerializeAsString(), &buffer);
+  bool written = true;
+  for (const RoomImage &image : rooms) {
+    chat::SnapshotRoom room;
+    room.set_name(image.name);
+    room.set_first(image.first);
+    room.set_messages(image.entries.size());
+    AppendRecord(room.SerializeAsString(), &buffer);
+    for (const grpc::ByteBuffer &entry : image.entries) {
+      AppendRecord(entry, &buffer);
+      // Written in pieces so a large history is not held twice.
+      if (buffer.size() >= 1 << 20) {
+        written = written && WriteFully(fd, buffer);
+        buffer.clear();
+      }
+    }
+  }
+  written = written && WriteFully(fd, buffer) && fdatasync(fd) == 0;
+  close(fd);
+  if (!written || rename(temp.c_str(), path.c_str()) != 0) {
+    CHAT_LOG(kError) << "System: Failed to write snapshot " << path;
+    unlink(temp.c_str());
+    return false;
+  }
+  // Makes the rename itself durable.
+  size_t slash = path.rfind('/');
+  std::string dir = slash == std::string::npos ? "." : path.substr(0, slash);
+  int dir_fd = open(dir.empty() ? "/" : dir.c_str(), O_RDONLY | O_CLOEXEC);
+  if (dir_fd >= 0) {
+    fsync(dir_fd);
+    close(dir_fd);
+  }
+  return true;
+}
+
+// Reads the snapshot at path into rooms and wal_generation. Returns false,
+// leaving them untouched, if there is no snapshot or it is damaged.
+inline bool ReadSnapshot(const std::string &path, uint64_t *wal_generation,
+                         std::vector<SavedRoom> *rooms) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  off_t offset = 0;
+  std::string payload;
+  chat::SnapshotHeader header;
+  std::vector<SavedRoom> saved;
+  bool intact = ReadRecord(fd, &offset, &payload) &&
+                header.ParseFromString(payload);
+  for (uint64_t i = 0; intact && i < header.rooms(); i++) {
+    chat::SnapshotRoom room;
+    intact = ReadRecord(fd, &offset, &payload) &&
+             room.ParseFromString(payload);
+    SavedRoom image;
+    image.name = room.name();
+    image.first = room.first();
+    image.messages.resize(intact ? room.messages() : 0);
+    for (chat::ChatMessage &m : image.messages) {
+      intact = intact && ReadRecord(fd, &offset, &payload) &&
+               m.ParseFromString(payload);
+    }
+    saved.push_back(std::move(image));
+  }
+  close(fd);
+  if (!intact) {
+    CHAT_LOG(kError) << "System: Ignoring damaged snapshot " << path;
+    return false;
+  }
+  *wal_generation = header.wal_generation();
+  *rooms = std::move(saved);
+  return true;
+}
@@ -0,0 +1,431 @@
+#pragma once
+#include <dirent.h>
+#include <fcntl.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "logger.h"
+#include "proto/chatservice.pb.h"
+
+// When an appended record counts as committed.
+enum class Durability {
+  // Written to the page cache. Survives a server crash, not a machine crash.
+  kNone,
+  // Appends that arrive together share one fdatasync (group commit).
+  kBatched,
+  // Every append is synced before it commits.
+  kPerMessage,
+};
+
+inline uint32_t Crc32(const char *data, size_t size) {
+  static const std::vector<uint32_t> table = [] {
+    std::vector<uint32_t> t(256);
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++) {
+        c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      t[i] = c;
+    }
+    return t;
+  }();
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < size; i++) {
+    crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+inline void EncodeFixed32(uint32_t v, std::string *out) {
+  for (int i = 0; i < 4; i++) {
+    out->push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+  }
+}
+
+inline uint32_t DecodeFixed32(const char *p) {
+  uint32_t v = 0;
+  for (int i = 0; i < 4; i++) {
+    v |= static_cast<uint32_t>(static_cast<uint8_t>(p[i])) << (8 * i);
+  }
+  return v;
+}
+
+// Records of the write-ahead log and of snapshots are framed as a
+// little-endian 32-bit payload length, a CRC-32 of the payload and the
+// payload itself, so a record torn by a crash is detected.
+constexpr uint32_t kMaxRecordSize = 64 * 1024 * 1024;
+
+inline void AppendRecord(const std::string &payload, std::string *out) {
+  EncodeFixed32(static_cast<uint32_t>(payload.size()), out);
+  EncodeFixed32(Crc32(payload.data(), payload.size()), out);
+  out->append(payload);
+}
+
+inline void AppendRecord(const grpc::ByteBuffer &wire, std::string *out) {
+  std::vector<grpc::Slice> slices;
+  wire.Dump(&slices);
+  std::string payload;
+  payload.reserve(wire.Length());
+  for (const grpc::Slice &s : slices) {
+    payload.append(reinterpret_cast<const char *>(s.begin()), s.size());
+  }
+  AppendRecord(payload, out);
+}
+
+inline bool ReadFullyAt(int fd, off_t offset, char *data, size_t size) {
+  while (size > 0) {
+    ssize_t n = pread(fd, data, size, offset);
+    if (n <= 0) {
+      return false;
+    }
+    data += n;
+    size -= n;
+    offset += n;
+  }
+  return true;
+}
+
+// Reads the record at *offset into payload and moves *offset past it.
+// Returns false at the end of the file or at a damaged record.
+inline bool ReadRecord(int fd, off_t *offset, std::string *payload) {
+  char header[8];
+  if (!ReadFullyAt(fd, *offset, header, sizeof(header))) {
+    return false;
+  }
+  uint32_t length = DecodeFixed32(header);
+  uint32_t crc = DecodeFixed32(header + 4);
+  if (length > kMaxRecordSize) {
+    return false;
+  }
+  payload->resize(length);
+  if (!ReadFullyAt(fd, *offset + sizeof(header), &(*payload)[0], length) ||
+      Crc32(payload->data(), length) != crc) {
+    return false;
+  }
+  *offset += sizeof(header) + length;
+  return true;
+}
+
+inline bool WriteFully(int fd, const std::string &data) {
+  const char *p = data.data();
+  size_t left = data.size();
+  while (left > 0) {
+    ssize_t n = write(fd, p, left);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    p += n;
+    left -= n;
+  }
+  return true;
+}
+
+// Append-only files of serialized ChatMessages, framed as AppendRecord
+// does. The log is a sequence of generations: generation 0 is the file at
+// path and generation N after it is path.N. Rotate starts the next one and
+// Compact deletes the old ones once a snapshot has made them redundant, so
+// the files on disk only hold what came after the last snapshot.
+//
+// Commit callbacks run in append order on the log's flusher thread, so no
+// appending thread waits for the disk. With kBatched they run once the
+// batch containing the record has been synced, with kPerMessage once the
+// append itself has, and with kNone once it has been written.
+class WriteAheadLog {
+public:
+  using CommitCallback = std::function<void(bool durable)>;
+
+  // Appends go to the newest generation on disk.
+  WriteAheadLog(const std::string &path, Durability durability)
+      : path_(path), durability_(durability) {
+    FindGenerations();
+    fd_ = open(FileName(generation_).c_str(),
+               O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      CHAT_LOG(kError) << "System: Failed to open write-ahead log "
+                       << FileName(generation_);
+      return;
+    }
+    struct stat st;
+    end_ = fstat(fd_, &st) == 0 ? st.st_size : 0;
+    flusher_ = std::thread(&WriteAheadLog::FlushLoop, this);
+  }
+
+  // Commits everything still pending before closing the file.
+  ~WriteAheadLog() {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      stopped_ = true;
+      flush_.notify_one();
+    }
+    if (flusher_.joinable()) {
+      flusher_.join();
+    }
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  bool ok() const { return fd_ >= 0; }
+
+  const std::string &path() const { return path_; }
+
+  // How many records have been appended since the log was opened.
+  uint64_t appended() const {
+    return appended_.load(std::memory_order_relaxed);
+  }
+
+  std::string FileName(uint64_t generation) const {
+    return generation == 0 ? path_ : path_ + "." + std::to_string(generation);
+  }
+
+  // Calls visit for every intact record of every generation from from on,
+  // oldest first, and returns how many there were. Anything after the first
+  // damaged record of the newest generation is truncated away so new
+  // appends follow the last good one. Must run before the first Append.
+  size_t Replay(const std::function<void(const chat::ChatMessage &)> &visit,
+                uint64_t from = 0) {
+    if (fd_ < 0) {
+      return 0;
+    }
+    size_t records = 0;
+    for (uint64_t g = std::max(from, oldest_); g <= generation_; g++) {
+      int fd = g == generation_
+                   ? fd_
+                   : open(FileName(g).c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) {
+        continue;
+      }
+      off_t good = 0;
+      std::string payload;
+      chat::ChatMessage message;
+      while (ReadRecord(fd, &good, &payload) &&
+             message.ParseFromString(payload)) {
+        visit(message);
+        records++;
+      }
+
+      struct stat st;
+      if (fstat(fd, &st) == 0 && st.st_size > good) {
+        CHAT_LOG(kWarning) << "System: Dropping " << st.st_size - good
+                           << " bytes of damaged write-ahead log "
+                           << FileName(g);
+        if (fd == fd_ && ftruncate(fd_, good) != 0) {
+          CHAT_LOG(kError) << "System: Failed to truncate write-ahead log";
+        }
+      }
+      if (fd == fd_) {
+        end_ = good;
+      }
+      if (fd != fd_) {
+        close(fd);
+      }
+    }
+    return records;
+  }
+
+  // Appends the serialized ChatMessage in wire and calls done once it has
+  // committed under this log's durability mode, or failed to.
+  void Append(const grpc::ByteBuffer &wire, CommitCallback done) {
+    Append(std::vector<grpc::ByteBuffer>{wire}, std::move(done));
+  }
+
+  // Appends several records that commit, or fail, together.
+  void Append(const std::vector<grpc::ByteBuffer> &records,
+              CommitCallback done) {
+    std::unique_lock<std::mutex> lock(mu_);
+    idle_.wait(lock, [this] { return !rotating_; });
+    if (fd_ < 0 || failed_) {
+      if (done) {
+        done(false);
+      }
+      return;
+    }
+    for (const grpc::ByteBuffer &wire : records) {
+      AppendRecord(wire, &pending_);
+    }
+    appended_.fetch_add(records.size(), std::memory_order_relaxed);
+    pending_ends_.push_back(pending_.size());
+    pending_done_.push_back(std::move(done));
+    flush_.notify_one();
+  }
+
+  // Starts the next generation and returns it, or 0 if its file could not
+  // be created. at_cut runs first, once every earlier append has committed
+  // and had its callback run, with later appends held off until it returns,
+  // so what it sees is exactly what the older generations hold.
+  uint64_t Rotate(const std::function<void()> &at_cut) {
+    std::unique_lock<std::mutex> lock(mu_);
+    if (fd_ < 0) {
+      return 0;
+    }
+    rotating_ = true;
+    idle_.wait(lock, [this] { return pending_.empty() && !flushing_; });
+    at_cut();
+    int fd = open(FileName(generation_ + 1).c_str(),
+                  O_RDWR | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+    rotating_ = false;
+    idle_.notify_all();
+    if (fd < 0) {
+      CHAT_LOG(kError) << "System: Failed to create write-ahead log "
+                       << FileName(generation_ + 1);
+      return 0;
+    }
+    close(fd_);
+    fd_ = fd;
+    end_ = 0;
+    return ++generation_;
+  }
+
+  // Deletes the generations before generation.
+  void Compact(uint64_t generation) {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (generation = std::min(generation, generation_); oldest_ < generation;
+         oldest_++) {
+      if (unlink(FileName(oldest_).c_str()) != 0 && errno != ENOENT) {
+        CHAT_LOG(kError) << "System: Failed to delete write-ahead log "
+                         << FileName(oldest_);
+      }
+    }
+  }
+
+private:
+  // Finds the oldest and newest generations in the directory of path.
+  void FindGenerations() {
+    size_t slash = path_.rfind('/');
+    std::string dir = "./";
+    std::string base = path_;
+    if (slash != std::string::npos) {
+      dir = path_.substr(0, slash + 1);
+      base = path_.substr(slash + 1);
+    }
+    DIR *d = opendir(dir.c_str());
+    if (d == nullptr) {
+      return;
+    }
+    bool found = false;
+    while (dirent *entry = readdir(d)) {
+      std::string name = entry->d_name;
+      uint64_t g = 0;
+      if (name != base) {
+        if (name.size() <= base.size() + 1 ||
+            name.compare(0, base.size() + 1, base + ".") != 0 ||
+            name.find_first_not_of("0123456789", base.size() + 1) !=
+                std::string::npos) {
+          continue;
+        }
+        g = std::stoull(name.substr(base.size() + 1));
+      }
+      oldest_ = found ? std::min(oldest_, g) : g;
+      generation_ = found ? std::max(generation_, g) : g;
+      found = true;
+    }
+    closedir(d);
+  }
+
+  // Writes data at the end of the file, and syncs it if sync is set. A
+  // failed write can leave a torn record behind, and Replay stops at the
+  // first damaged record, so anything appended after it would be lost on
+  // restart: the file is cut back to where it ended instead, and if even
+  // that fails the log refuses every later append.
+  bool Commit(const std::string &data, bool sync) {
+    if (failed_) {
+      return false;
+    }
+    if (WriteFully(fd_, data) && (!sync || fdatasync(fd_) == 0)) {
+      end_ += data.size();
+      return true;
+    }
+    CHAT_LOG(kError) << "System: Write-ahead log write failed";
+    if (ftruncate(fd_, end_) != 0) {
+      CHAT_LOG(kError) << "System: Failed to cut the write-ahead log back, "
+                          "refusing further appends";
+      failed_ = true;
+    }
+    return false;
+  }
+
+  // Everything appended while the previous batch was being written and
+  // synced forms the next batch, so the sync rate adapts to the load
+  // instead of capping it. With kPerMessage each append in the batch is
+  // still written and synced on its own.
+  void FlushLoop() {
+    std::unique_lock<std::mutex> lock(mu_);
+    while (true) {
+      flush_.wait(lock, [this] { return !pending_.empty() || stopped_; });
+      if (pending_.empty()) {
+        break;
+      }
+      std::string batch;
+      batch.swap(pending_);
+      std::vector<size_t> ends;
+      ends.swap(pending_ends_);
+      std::vector<CommitCallback> done;
+      done.swap(pending_done_);
+      flushing_ = true;
+      lock.unlock();
+
+      // Rotate waits for flushing_ to clear, so fd_ stays put meanwhile.
+      if (durability_ == Durability::kPerMessage) {
+        size_t begin = 0;
+        for (size_t i = 0; i < done.size(); i++) {
+          bool durable = Commit(batch.substr(begin, ends[i] - begin), true);
+          begin = ends[i];
+          if (done[i]) {
+            done[i](durable);
+          }
+        }
+      } else {
+        bool durable = Commit(batch, durability_ == Durability::kBatched);
+        for (CommitCallback &d : done) {
+          if (d) {
+            d(durable);
+          }
+        }
+      }
+      lock.lock();
+      flushing_ = false;
+      idle_.notify_all();
+    }
+  }
+
+  const std::string path_;
+  const Durability durability_;
+  // The generations on disk; fd_ is the newest's.
+  uint64_t oldest_ = 0;
+  uint64_t generation_ = 0;
+  int fd_ = -1;
+  // Where the last committed record ends. Only touched by whichever thread
+  // writes, and by Replay and Rotate while nothing does.
+  off_t end_ = 0;
+  // Set once a failed write could not be cut back.
+  std::atomic<bool> failed_{false};
+  std::atomic<uint64_t> appended_{0};
+  std::mutex mu_;
+  std::condition_variable flush_;
+  std::string pending_;
+  // Where each append in pending_ ends, and its callback.
+  std::vector<size_t> pending_ends_;
+  std::vector<CommitCallback> pending_done_;
+  // Set while the flusher writes a batch and runs its callbacks, and while
+  // Rotate holds appends off. idle_ signals either clearing.
+  bool flushing_ = false;
+  bool rotating_ = false;
+  std::condition_variable idle_;
+  bool stopped_ = false;
+  std::thread flusher_;
+};
@@ -3,6 +3,7 @@
 
 #include "client/client.h"
 #include "server/server.h"
+#include "server/server_options.h"
 #include <chrono>
 
 TEST_CASE("Server::CreateServer") {
@@ -140,3 +141,1938 @@ TEST_CASE("Server::ClientServerIntegration_MultipleClientsReadMessage") {
   service.EndServer();
   notify_thread.join();
 }
+
+TEST_CASE("MessageLog::AppendAcrossSegments") {
+  MessageLog log(2);
+  MessageLog::Cursor cursor = log.Begin();
+  CHECK(log.Next(&cursor) == nullptr);
+
+  ChatMessage m;
+  m.set_name("user");
+  m.set_message("Hello, World 1");
+  log.Append(MakeLoggedMessage(m));
+  const LoggedMessage *first = log.Next(&cursor);
+  REQUIRE(first != nullptr);
+  CHECK(log.Next(&cursor) == nullptr);
+
+  for (int i = 2; i <= 5; i++) {
+    m.set_message("Hello, World " + to_string(i));
+    log.Append(MakeLoggedMessage(m));
+  }
+  REQUIRE(log.Size() == 5);
+  CHECK(first->message.message() == "Hello, World 1");
+  for (int i = 2; i <= 5; i++) {
+    const LoggedMessage *next = log.Next(&cursor);
+    REQUIRE(next != nullptr);
+    CHECK(next->message.message() == "Hello, World " + to_string(i));
+  }
+  CHECK(log.Next(&cursor) == nullptr);
+}
+
+TEST_CASE("MessageLog::RetentionByCount") {
+  MessageLog log(2, RetentionPolicy{4});
+  MessageLog::Cursor slow = log.Begin();
+
+  ChatMessage m;
+  m.set_name("user");
+  for (int i = 0; i < 10; i++) {
+    m.set_message("Hello, World " + to_string(i));
+    log.Append(MakeLoggedMessage(m));
+  }
+  REQUIRE(log.Size() == 10);
+  CHECK(log.First() == 6);
+
+  const LoggedMessage *next = log.Next(&slow);
+  REQUIRE(next != nullptr);
+  CHECK(slow.skipped == 6);
+  CHECK(next->message.message() == "Hello, World 6");
+
+  MessageLog::Cursor cursor = log.Begin();
+  CHECK(cursor.index == 6);
+  for (int i = 6; i < 10; i++) {
+    next = log.Next(&cursor);
+    REQUIRE(next != nullptr);
+    CHECK(next->message.message() == "Hello, World " + to_string(i));
+  }
+  CHECK(cursor.skipped == 0);
+}
+
+TEST_CASE("MessageLog::RetentionByBytesAndAge") {
+  ChatMessage m;
+  m.set_name("user");
+  m.set_message(string(100, 'x'));
+  // Every entry is stamped with a one-byte seq field on append.
+  size_t entry_bytes = MakeLoggedMessage(m).wire.Length() + 2;
+
+  MessageLog by_bytes(2, RetentionPolicy{0, 5 * entry_bytes});
+  for (int i = 0; i < 10; i++) {
+    by_bytes.Append(MakeLoggedMessage(m));
+  }
+  CHECK(by_bytes.Bytes() <= 5 * entry_bytes);
+  CHECK(by_bytes.Bytes() == (by_bytes.Size() - by_bytes.First()) * entry_bytes);
+
+  MessageLog by_age(2, RetentionPolicy{0, 0, chrono::milliseconds(50)});
+  for (int i = 0; i < 4; i++) {
+    by_age.Append(MakeLoggedMessage(m));
+  }
+  CHECK(by_age.First() == 0);
+  this_thread::sleep_for(chrono::milliseconds(100));
+  by_age.Append(MakeLoggedMessage(m));
+  CHECK(by_age.First() == 4);
+}
+
+TEST_CASE("Server::ClientServerIntegration_Retention") {
+  ServerBuilder builder;
+  ChatServiceImpl service(1, RetentionPolicy{8}, 4);
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server(builder.BuildAndStart());
+
+  ChatServiceClient chatter(
+      "user", CreateChannel("localhost:9090", InsecureChannelCredentials()));
+  for (int i = 0; i < 20; i++) {
+    chatter.Send("Hello, World " + to_string(i));
+  }
+
+  auto messages = service.GetReceivedMessages();
+  REQUIRE(messages.size() <= 8);
+  CHECK(messages.back().message() == "Hello, World 19");
+}
+
+TEST_CASE("Server::ClientServerIntegration_IdleRoomExpires") {
+  ServerBuilder builder;
+  ChatServiceImpl service(1, RetentionPolicy{0, 0, chrono::milliseconds(50)},
+                          1);
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server(builder.BuildAndStart());
+  thread notify_thread(&ChatServiceImpl::NotifyReadersThread, &service);
+
+  ChatServiceClient chatter(
+      "user", CreateChannel("localhost:9090", InsecureChannelCredentials()));
+  for (int i = 0; i < 3; i++) {
+    chatter.Send("Hello, World " + to_string(i));
+  }
+
+  // Nothing more is sent, yet everything but the segment being appended to
+  // expires.
+  auto deadline = chrono::steady_clock::now() + chrono::seconds(5);
+  while (service.GetReceivedMessages().size() > 1 &&
+         chrono::steady_clock::now() < deadline) {
+    this_thread::sleep_for(chrono::milliseconds(10));
+  }
+  auto messages = service.GetReceivedMessages();
+  REQUIRE(messages.size() == 1);
+  CHECK(messages[0].message() == "Hello, World 2");
+
+  service.EndServer();
+  notify_thread.join();
+}
+
+TEST_CASE("Server::ClientServerIntegration_ReadChatBatched") {
+  ServerBuilder builder;
+  ChatServiceImpl service;
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  unique_ptr<Server> server(builder.BuildAndStart());
+  thread notify_thread(&ChatServiceImpl::NotifyReadersThread, &service);
+
+  auto channel = CreateChannel("localhost:9090", InsecureChannelCredentials());
+  ChatServiceClient chatter("user", channel);
+  for (int i = 1; i <= 10; i++) {
+    chatter.Send("Hello, World " + to_string(i));
+  }
+
+  auto stub = ChatService::NewStub(channel);
+  ClientContext context;
+  ChatReader reader;
+  reader.set_name("user");
+  reader.set_max_batch_messages(4);
+  auto stream = stub->ReadChatBatched(&context, reader);
+
+  std::vector<int> batch_sizes;
+  std::vector<ChatMessage> messages;
+  ChatMessageBatch batch;
+  while (messages.size() < 11 && stream->Read(&batch)) {
+    batch_sizes.push_back(batch.messages_size());
+    messages.insert(messages.end(), batch.messages().begin(),
+                    batch.messages().end());
+  }
+  context.TryCancel();
+  stream->Finish();
+
+  CHECK(batch_sizes == std::vector<int>{4, 4, 3});
+  REQUIRE(messages.size() == 11);
+  for (int i = 0; i < 10; i++) {
+    CHECK(messages[i].message() == "Hello, World " + to_string(i + 1));
+  }
+  CHECK(messages[10].message() == "user has joined the chat!");
+
+  service.EndServer();
+  notify_thread.join();
+}
+
+TEST_CASE("Server::ClientServerIntegration_ShardedNotifier") {
+  ServerBuilder builder;
+  ChatServiceImpl service(3);
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  unique_ptr<Server> server(builder.BuildAndStart());
+  thread notify_thread(&ChatServiceImpl::NotifyReadersThread, &service);
+
+  auto channel = CreateChannel("localhost:9090", InsecureChannelCredentials());
+  auto stub = ChatService::NewStub(channel);
+  const int kReaders = 5;
+  std::vector<unique_ptr<ClientContext>> contexts;
+  std::vector<unique_ptr<ClientReader<ChatMessage>>> streams;
+  for (int i = 0; i < kReaders; i++) {
+    ChatReader reader;
+    reader.set_name("reader" + to_string(i));
+    contexts.push_back(make_unique<ClientContext>());
+    streams.push_back(stub->ReadChat(contexts.back().get(), reader));
+  }
+
+  ChatServiceClient chatter("user", channel);
+  chatter.Send("Hello, shards");
+
+  for (int i = 0; i < kReaders; i++) {
+    ChatMessage m;
+    bool received = false;
+    while (!received && streams[i]->Read(&m)) {
+      received = m.message() == "Hello, shards";
+    }
+    CHECK(received);
+    contexts[i]->TryCancel();
+    streams[i]->Finish();
+  }
+
+  service.EndServer();
+  notify_thread.join();
+}
+
+TEST_CASE("Server::ClientServerIntegration_ReadersReceiveEveryMessage") {
+  ServerBuilder builder;
+  ChatServiceImpl service(2);
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  unique_ptr<Server> server(builder.BuildAndStart());
+  thread notify_thread(&ChatServiceImpl::NotifyReadersThread, &service);
+
+  auto channel = CreateChannel("localhost:9090", InsecureChannelCredentials());
+  auto stub = ChatService::NewStub(channel);
+  const int kReaders = 8;
+  const int kMessages = 200;
+  std::vector<unique_ptr<ClientContext>> contexts;
+  std::vector<unique_ptr<ClientReader<ChatMessage>>> streams;
+  for (int i = 0; i < kReaders; i++) {
+    ChatReader reader;
+    reader.set_name("reader" + to_string(i));
+    contexts.push_back(make_unique<ClientContext>());
+    streams.push_back(stub->ReadChat(contexts.back().get(), reader));
+  }
+
+  std::vector<thread> senders;
+  for (int s = 0; s < 2; s++) {
+    senders.emplace_back([&channel, s]() {
+      ChatServiceClient chatter("sender" + to_string(s), channel);
+      for (int i = 0; i < kMessages / 2; i++) {
+        chatter.Send(to_string(i));
+      }
+    });
+  }
+  for (thread &t : senders) {
+    t.join();
+  }
+
+  for (int i = 0; i < kReaders; i++) {
+    int next[2] = {0, 0};
+    ChatMessage m;
+    while ((next[0] < kMessages / 2 || next[1] < kMessages / 2) &&
+           streams[i]->Read(&m)) {
+      if (m.name() == "System") {
+        continue;
+      }
+      int sender = m.name() == "sender1";
+      CHECK(m.message() == to_string(next[sender]));
+      next[sender]++;
+    }
+    CHECK(next[0] == kMessages / 2);
+    CHECK(next[1] == kMessages / 2);
+    contexts[i]->TryCancel();
+    streams[i]->Finish();
+  }
+
+  service.EndServer();
+  notify_thread.join();
+}
+
+TEST_CASE("WriteAheadLog::ReplayDropsTornTail") {
+  const string path = "unittest_replay.wal";
+  remove(path.c_str());
+
+  ChatMessage m;
+  m.set_name("user");
+  int committed = 0;
+  {
+    WriteAheadLog wal(path, Durability::kBatched);
+    REQUIRE(wal.ok());
+    CHECK(wal.Replay([](const ChatMessage &) {}) == 0);
+    for (int i = 0; i < 3; i++) {
+      m.set_message("Hello, World " + to_string(i));
+      wal.Append(MakeLoggedMessage(m).wire,
+                 [&committed](bool durable) { committed += durable; });
+    }
+    // Destroying the log commits what is still pending.
+  }
+  CHECK(committed == 3);
+
+  FILE *file = fopen(path.c_str(), "ab");
+  REQUIRE(file != nullptr);
+  fputs("torn", file);
+  fclose(file);
+
+  for (int reopen = 0; reopen < 2; reopen++) {
+    WriteAheadLog wal(path, Durability::kPerMessage);
+    std::vector<string> replayed;
+    wal.Replay([&replayed](const ChatMessage &m) {
+      replayed.push_back(m.message());
+    });
+    REQUIRE(replayed.size() == 3 + reopen);
+    for (int i = 0; i < 3; i++) {
+      CHECK(replayed[i] == "Hello, World " + to_string(i));
+    }
+    m.set_message("After restart");
+    promise<bool> durable;
+    wal.Append(MakeLoggedMessage(m).wire,
+               [&durable](bool d) { durable.set_value(d); });
+    CHECK(durable.get_future().get());
+  }
+  remove(path.c_str());
+}
+
+TEST_CASE("WriteAheadLog::CommitsOffTheAppendingThread") {
+  const string path = "unittest_commit.wal";
+  remove(path.c_str());
+  WriteAheadLog wal(path, Durability::kPerMessage);
+  REQUIRE(wal.ok());
+  ChatMessage m;
+  m.set_name("user");
+  m.set_message("Hello, World");
+  ByteBuffer wire = MakeLoggedMessage(m).wire;
+
+  // The sync and the callback run on the flusher, where a callback can
+  // append again.
+  promise<thread::id> first;
+  promise<bool> second;
+  wal.Append(wire, [&](bool durable) {
+    CHECK(durable);
+    first.set_value(this_thread::get_id());
+    wal.Append(wire, [&second](bool d) { second.set_value(d); });
+  });
+  CHECK(first.get_future().get() != this_thread::get_id());
+  CHECK(second.get_future().get());
+  CHECK(wal.appended() == 2);
+  remove(path.c_str());
+}
+
+TEST_CASE("WriteAheadLog::FailedWriteRefusesLaterAppends") {
+  // Every write to /dev/full fails, and it cannot be truncated, so the torn
+  // write cannot be cut back and nothing may be appended after it.
+  WriteAheadLog wal("/dev/full", Durability::kPerMessage);
+  REQUIRE(wal.ok());
+  ChatMessage m;
+  m.set_name("user");
+  m.set_message("Hello, World");
+  for (int i = 0; i < 2; i++) {
+    promise<bool> durable;
+    wal.Append(MakeLoggedMessage(m).wire,
+               [&durable](bool d) { durable.set_value(d); });
+    CHECK(!durable.get_future().get());
+  }
+}
+
+TEST_CASE("Server::ClientServerIntegration_WriteAheadLog") {
+  const string path = "unittest_server.wal";
+  remove(path.c_str());
+
+  for (int restart = 0; restart < 2; restart++) {
+    ServerBuilder builder;
+    ChatServiceImpl service(
+        1, {}, MessageLog::kDefaultSegmentSize,
+        make_unique<WriteAheadLog>(path, Durability::kBatched));
+    builder.AddListeningPort("0.0.0.0:9090",
+                             grpc::InsecureServerCredentials());
+    builder.RegisterService(&service);
+    std::unique_ptr<Server> server(builder.BuildAndStart());
+
+    ChatServiceClient chatter(
+        "user", CreateChannel("localhost:9090", InsecureChannelCredentials()));
+    chatter.Send("Hello, restart " + to_string(restart));
+
+    // Send only returns once the message is durable and published.
+    auto messages = service.GetReceivedMessages();
+    REQUIRE(messages.size() == restart + 1);
+    for (int i = 0; i <= restart; i++) {
+      CHECK(messages[i].message() == "Hello, restart " + to_string(i));
+    }
+  }
+  remove(path.c_str());
+}
+
+TEST_CASE("Server::ClientServerIntegration_Snapshot") {
+  const string path = "unittest_snapshot.wal";
+  auto clean = [&path] {
+    for (const char *suffix : {"", ".1", ".2", ".snapshot"}) {
+      remove((path + suffix).c_str());
+    }
+  };
+  clean();
+
+  RetentionPolicy retention;
+  retention.max_messages = 4;
+  for (int restart = 0; restart < 3; restart++) {
+    ServerBuilder builder;
+    ChatServiceImpl service(
+        1, retention, 1,
+        make_unique<WriteAheadLog>(path, Durability::kBatched));
+    builder.AddListeningPort("0.0.0.0:9090",
+                             grpc::InsecureServerCredentials());
+    builder.RegisterService(&service);
+    std::unique_ptr<Server> server(builder.BuildAndStart());
+
+    // Each run adds 5 messages, snapshotting after the first 3, so a restart
+    // loads the snapshot and replays the last 2.
+    ChatServiceClient chatter(
+        "user", CreateChannel("localhost:9090", InsecureChannelCredentials()));
+    for (int i = 0; i < 5; i++) {
+      chatter.Send("Hello, " + to_string(restart * 5 + i));
+      if (i == 2) {
+        REQUIRE(service.Snapshot());
+      }
+    }
+
+    // The retained window and the seqs carry on across restarts.
+    auto messages = service.GetReceivedMessages();
+    REQUIRE(messages.size() == 4);
+    for (int i = 0; i < 4; i++) {
+      CHECK(messages[i].seq() == restart * 5 + 2 + i);
+      CHECK(messages[i].message() ==
+            "Hello, " + to_string(restart * 5 + 1 + i));
+    }
+  }
+  // Only the generation after the last snapshot is left.
+  CHECK(access(path.c_str(), F_OK) != 0);
+  CHECK(access((path + ".2").c_str(), F_OK) != 0);
+  clean();
+  remove((path + ".3").c_str());
+}
+
+TEST_CASE("MessageLog::SeekBySequence") {
+  MessageLog log(2, RetentionPolicy{4});
+  ChatMessage m;
+  m.set_name("user");
+  for (int i = 1; i <= 5; i++) {
+    m.set_message("Hello, World " + to_string(i));
+    log.Append(MakeLoggedMessage(m));
+  }
+
+  // Resuming after seq 3 starts at seq 4, whose cached encoding carries it.
+  MessageLog::Cursor cursor = log.Seek(3);
+  const LoggedMessage *next = log.Next(&cursor);
+  REQUIRE(next != nullptr);
+  CHECK(next->message.seq() == 4);
+  ChatMessage decoded;
+  ByteBuffer wire(next->wire);
+  REQUIRE(SerializationTraits<ChatMessage>::Deserialize(&wire, &decoded).ok());
+  CHECK(decoded.seq() == 4);
+  CHECK(decoded.message() == "Hello, World 4");
+
+  // Seeking past the end waits for the next append.
+  cursor = log.Seek(100);
+  CHECK(log.Next(&cursor) == nullptr);
+  log.Append(MakeLoggedMessage(m));
+  next = log.Next(&cursor);
+  REQUIRE(next != nullptr);
+  CHECK(next->message.seq() == 6);
+
+  // Seeking before the retained window reports what was evicted.
+  REQUIRE(log.First() == 2);
+  cursor = log.Seek(1);
+  next = log.Next(&cursor);
+  REQUIRE(next != nullptr);
+  CHECK(cursor.skipped == 1);
+  CHECK(next->message.seq() == 3);
+}
+
+TEST_CASE("Server::ClientServerIntegration_ResumeFromSequence") {
+  ServerBuilder builder;
+  ChatServiceImpl service(1);
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  unique_ptr<Server> server(builder.BuildAndStart());
+  thread notify_thread(&ChatServiceImpl::NotifyReadersThread, &service);
+
+  auto channel = CreateChannel("localhost:9090", InsecureChannelCredentials());
+  ChatServiceClient chatter("user", channel);
+  for (int i = 1; i <= 5; i++) {
+    chatter.Send("Hello, World " + to_string(i));
+  }
+
+  auto stub = ChatService::NewStub(channel);
+  ChatReader reader;
+  reader.set_name("resumed");
+  reader.set_since_seq(3);
+  ClientContext resumed_context;
+  auto resumed = stub->ReadChat(&resumed_context, reader);
+  ChatMessage m;
+  REQUIRE(resumed->Read(&m));
+  CHECK(m.seq() == 4);
+  CHECK(m.message() == "Hello, World 4");
+  REQUIRE(resumed->Read(&m));
+  CHECK(m.seq() == 5);
+  REQUIRE(resumed->Read(&m));
+  CHECK(m.message() == "resumed has joined the chat!");
+
+  // The history is now 5 messages and a join; tailing 2 adds another join.
+  // The first reader stays connected so no leave message lands in between.
+  reader.set_name("tail");
+  reader.set_since_seq(0);
+  reader.set_tail_n(2);
+  ClientContext tail_context;
+  auto tail = stub->ReadChat(&tail_context, reader);
+  REQUIRE(tail->Read(&m));
+  CHECK(m.seq() == 6);
+  CHECK(m.message() == "resumed has joined the chat!");
+  tail_context.TryCancel();
+  tail->Finish();
+  resumed_context.TryCancel();
+  resumed->Finish();
+
+  service.EndServer();
+  notify_thread.join();
+}
+
+TEST_CASE("Logger::DisabledLevelsSkipFormatting") {
+  Logger &logger = Logger::Get();
+  logger.SetLevel(LogLevel::kWarning);
+  int evaluated = 0;
+  auto count = [&evaluated]() { return ++evaluated; };
+  CHAT_LOG(kDebug) << "System: debug " << count();
+  CHAT_LOG(kInfo) << "System: info " << count();
+  CHECK(evaluated == 0);
+  CHAT_LOG(kWarning) << "System: warning " << count();
+  CHECK(evaluated == 1);
+  CHECK(logger.Enabled(LogLevel::kError));
+  CHECK_FALSE(logger.Enabled(LogLevel::kInfo));
+  logger.SetLevel(LogLevel::kInfo);
+  logger.Flush();
+}
+
+TEST_CASE("Server::ClientServerIntegration_SendStream") {
+  ServerBuilder builder;
+  ChatServiceImpl service;
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server(builder.BuildAndStart());
+
+  ChatServiceClient chatter(
+      "bot", CreateChannel("localhost:9090", InsecureChannelCredentials()));
+  auto stream = chatter.OpenSendStream();
+  for (int i = 0; i < 100; i++) {
+    REQUIRE(stream->Send("Hello, Stream " + to_string(i)));
+  }
+  REQUIRE(stream->Close().ok());
+
+  // Close returns once every message is in the log, in order.
+  auto messages = service.GetReceivedMessages();
+  REQUIRE(messages.size() == 100);
+  for (int i = 0; i < 100; i++) {
+    CHECK(messages[i].name() == "bot");
+    CHECK(messages[i].message() == "Hello, Stream " + to_string(i));
+    CHECK(messages[i].seq() == i + 1);
+  }
+}
+
+TEST_CASE("Server::ClientServerIntegration_Chat") {
+  ServerBuilder builder;
+  ChatServiceImpl service(1);
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  unique_ptr<Server> server(builder.BuildAndStart());
+  thread notify_thread(&ChatServiceImpl::NotifyReadersThread, &service);
+
+  auto channel = CreateChannel("localhost:9090", InsecureChannelCredentials());
+  ChatServiceClient chatter("user", channel);
+  for (int i = 1; i <= 3; i++) {
+    chatter.Send("Hello, World " + to_string(i));
+  }
+
+  // The first message names the user, resumes after seq 2 and is posted.
+  auto stub = ChatService::NewStub(channel);
+  ClientContext context;
+  auto stream = stub->Chat(&context);
+  ChatMessage m;
+  m.set_name("talker");
+  m.set_seq(2);
+  m.set_message("Hi");
+  REQUIRE(stream->Write(m));
+  REQUIRE(stream->Read(&m));
+  CHECK(m.seq() == 3);
+  CHECK(m.message() == "Hello, World 3");
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "talker has joined the chat!");
+  REQUIRE(stream->Read(&m));
+  CHECK(m.seq() == 5);
+  CHECK(m.name() == "talker");
+  CHECK(m.message() == "Hi");
+
+  // Later messages are posted under the session's name and acknowledged by
+  // coming back with their seq.
+  m.Clear();
+  m.set_name("someone else");
+  m.set_message("Bye");
+  REQUIRE(stream->Write(m));
+  REQUIRE(stream->Read(&m));
+  CHECK(m.seq() == 6);
+  CHECK(m.name() == "talker");
+  CHECK(m.message() == "Bye");
+
+  // Closing the sending side leaves the session reading.
+  REQUIRE(stream->WritesDone());
+  chatter.Send("Still there?");
+  REQUIRE(stream->Read(&m));
+  CHECK(m.seq() == 7);
+  CHECK(m.message() == "Still there?");
+  context.TryCancel();
+  stream->Finish();
+
+  service.EndServer();
+  notify_thread.join();
+}
+
+TEST_CASE("Server::ClientServerIntegration_SendAsync") {
+  ServerBuilder builder;
+  ChatServiceImpl service;
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server(builder.BuildAndStart());
+
+  ChatServiceClient chatter(
+      "bot", CreateChannel("localhost:9090", InsecureChannelCredentials()), 4);
+  vector<std::future<Status>> sent;
+  for (int i = 0; i < 50; i++) {
+    sent.push_back(chatter.SendAsync("Hello, Async " + to_string(i)));
+  }
+  atomic<int> completed{0};
+  for (int i = 50; i < 100; i++) {
+    chatter.SendAsync("Hello, Async " + to_string(i),
+                      [&completed](const Status &s) {
+                        if (s.ok()) {
+                          completed++;
+                        }
+                      });
+  }
+  for (auto &s : sent) {
+    CHECK(s.get().ok());
+  }
+  chatter.Flush();
+  CHECK(completed == 50);
+
+  // Concurrent sends may land in any order, but every one lands.
+  auto messages = service.GetReceivedMessages();
+  REQUIRE(messages.size() == 100);
+  vector<bool> seen(100);
+  for (const auto &m : messages) {
+    seen[stoi(m.message().substr(strlen("Hello, Async ")))] = true;
+  }
+  CHECK(all_of(seen.begin(), seen.end(), [](bool b) { return b; }));
+}
+
+TEST_CASE("Server::ClientServerIntegration_Rooms") {
+  ServerBuilder builder;
+  ChatServiceImpl service(2);
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  unique_ptr<Server> server(builder.BuildAndStart());
+  thread notify_thread(&ChatServiceImpl::NotifyReadersThread, &service);
+
+  auto channel = CreateChannel("localhost:9090", InsecureChannelCredentials());
+  ChatServiceClient lobby("lobby", channel);
+  ChatServiceClient kitchen("cook", channel);
+  kitchen.SetRoom("kitchen");
+
+  auto stub = ChatService::NewStub(channel);
+  ChatReader reader;
+  reader.set_name("reader");
+  reader.set_room("kitchen");
+  ClientContext context;
+  auto stream = stub->ReadChat(&context, reader);
+  ChatMessage m;
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "reader has joined the chat!");
+  CHECK(m.room() == "kitchen");
+
+  lobby.Send("Hello, Lobby");
+  kitchen.Send("Hello, Kitchen");
+  REQUIRE(stream->Read(&m));
+  CHECK(m.name() == "cook");
+  CHECK(m.message() == "Hello, Kitchen");
+  CHECK(m.room() == "kitchen");
+  // Sequence numbers count within the room.
+  CHECK(m.seq() == 2);
+  context.TryCancel();
+  stream->Finish();
+
+  auto messages = service.GetReceivedMessages();
+  REQUIRE(messages.size() == 1);
+  CHECK(messages[0].message() == "Hello, Lobby");
+  CHECK(messages[0].seq() == 1);
+
+  service.EndServer();
+  notify_thread.join();
+}
+
+TEST_CASE("MessageFilter::Matches") {
+  auto message = [](const string &name, const string &text) {
+    ChatMessage m;
+    m.set_name(name);
+    m.set_message(text);
+    return m;
+  };
+
+  ChatFilter names;
+  names.add_include_names("alice");
+  names.add_include_names("bob");
+  names.add_exclude_names("bob");
+  MessageFilter by_name(names);
+  CHECK(by_name.Matches(message("alice", "hi")));
+  CHECK_FALSE(by_name.Matches(message("bob", "hi")));
+  CHECK_FALSE(by_name.Matches(message("carol", "hi")));
+
+  ChatFilter text;
+  text.set_prefix("/me ");
+  text.set_keyword("waves");
+  MessageFilter by_text(text);
+  CHECK(by_text.Matches(message("alice", "/me waves hello")));
+  CHECK_FALSE(by_text.Matches(message("alice", "/me smiles")));
+  CHECK_FALSE(by_text.Matches(message("alice", "waves")));
+
+  ChatFilter system;
+  system.set_system_only(true);
+  MessageFilter system_only(system);
+  CHECK(system_only.Matches(message("System", "alice has joined the chat!")));
+  CHECK_FALSE(system_only.Matches(message("alice", "hi")));
+}
+
+TEST_CASE("Server::ClientServerIntegration_ReadChatFiltered") {
+  ServerBuilder builder;
+  ChatServiceImpl service(1);
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  unique_ptr<Server> server(builder.BuildAndStart());
+  thread notify_thread(&ChatServiceImpl::NotifyReadersThread, &service);
+
+  auto channel = CreateChannel("localhost:9090", InsecureChannelCredentials());
+  ChatServiceClient alice("alice", channel);
+  ChatServiceClient bob("bob", channel);
+  alice.Send("Hello from alice");
+  bob.Send("Hello from bob");
+  alice.Send("Bye from alice");
+
+  auto stub = ChatService::NewStub(channel);
+  ChatReader reader;
+  reader.set_name("reader");
+  reader.mutable_filter()->add_include_names("alice");
+  reader.mutable_filter()->set_keyword("Bye");
+  ClientContext context;
+  auto stream = stub->ReadChat(&context, reader);
+  ChatMessage m;
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "Bye from alice");
+  CHECK(m.seq() == 3);
+
+  // Messages are filtered as they arrive too.
+  bob.Send("Bye from bob");
+  alice.Send("Bye again from alice");
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "Bye again from alice");
+  context.TryCancel();
+  stream->Finish();
+
+  service.EndServer();
+  notify_thread.join();
+}
+
+TEST_CASE("Server::ClientServerIntegration_LagPolicy") {
+  // The notifier only starts once everything is in the log, so the reader
+  // is exactly 12 messages behind when it first writes.
+  auto run = [](LagAction action, vector<ChatMessage> *received) {
+    LagPolicy lag;
+    lag.max_messages = 5;
+    lag.action = action;
+    ServerBuilder builder;
+    ChatServiceImpl service(1, {}, MessageLog::kDefaultSegmentSize, nullptr,
+                            lag);
+    builder.AddListeningPort("0.0.0.0:9090",
+                             grpc::InsecureServerCredentials());
+    builder.RegisterService(&service);
+    unique_ptr<Server> server(builder.BuildAndStart());
+
+    auto channel =
+        CreateChannel("localhost:9090", InsecureChannelCredentials());
+    auto stub = ChatService::NewStub(channel);
+    auto join = [&service, &stub](const string &name, ClientContext *context) {
+      ChatReader reader;
+      reader.set_name(name);
+      size_t before = service.GetReceivedMessages().size();
+      auto stream = stub->ReadChat(context, reader);
+      while (service.GetReceivedMessages().size() == before) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+      }
+      return stream;
+    };
+    ChatServiceClient alice("alice", channel);
+    ClientContext context;
+    auto stream = join("reader", &context);
+    for (int i = 1; i <= 5; i++) {
+      alice.Send("Hello" + to_string(i));
+    }
+    ClientContext other_context;
+    auto other = join("other", &other_context);
+    for (int i = 6; i <= 10; i++) {
+      alice.Send("Hello" + to_string(i));
+    }
+    REQUIRE(service.GetReceivedMessages().size() == 12);
+
+    thread notify_thread(&ChatServiceImpl::NotifyReadersThread, &service);
+    ChatMessage m;
+    while (received->empty() || received->back().message() != "Hello10") {
+      if (!stream->Read(&m)) {
+        break;
+      }
+      received->push_back(m);
+    }
+    if (!received->empty()) {
+      context.TryCancel();
+    }
+    Status status = stream->Finish();
+    other_context.TryCancel();
+    other->Finish();
+    service.EndServer();
+    notify_thread.join();
+    return status;
+  };
+
+  SUBCASE("Skip to latest") {
+    vector<ChatMessage> received;
+    run(LagAction::kSkipToLatest, &received);
+    REQUIRE(received.size() == 2);
+    CHECK(received[0].message() == "11 messages were dropped from the history");
+    CHECK(received[1].message() == "Hello10");
+    CHECK(received[1].seq() == 12);
+  }
+
+  SUBCASE("Drop chat") {
+    vector<ChatMessage> received;
+    run(LagAction::kDropChat, &received);
+    vector<string> texts;
+    for (const ChatMessage &m : received) {
+      texts.push_back(m.message());
+    }
+    REQUIRE(texts.size() == 8);
+    CHECK(texts[0] == "reader has joined the chat!");
+    CHECK(texts[1] == "5 messages were dropped from the history");
+    CHECK(texts[2] == "other has joined the chat!");
+    for (int i = 6; i <= 10; i++) {
+      CHECK(texts[i - 3] == "Hello" + to_string(i));
+    }
+  }
+
+  SUBCASE("Disconnect") {
+    vector<ChatMessage> received;
+    Status status = run(LagAction::kDisconnect, &received);
+    CHECK(received.empty());
+    CHECK(status.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED);
+  }
+}
+
+TEST_CASE("Server::Metrics") {
+  ServerBuilder builder;
+  ChatServiceImpl service(1);
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  unique_ptr<Server> server(builder.BuildAndStart());
+  thread notify_thread(&ChatServiceImpl::NotifyReadersThread, &service);
+  MetricsServer metrics(0, [&service] { return service.Metrics(); });
+  REQUIRE(metrics.ok());
+
+  auto get = [&metrics](const string &path) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(metrics.port());
+    REQUIRE(connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) ==
+            0);
+    string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    REQUIRE(write(fd, request.data(), request.size()) ==
+            ssize_t(request.size()));
+    string response;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+      response.append(buffer, n);
+    }
+    close(fd);
+    return response;
+  };
+
+  auto channel = CreateChannel("localhost:9090", InsecureChannelCredentials());
+  ChatServiceClient alice("alice", channel);
+  alice.Send("Hello");
+  alice.Send("World");
+  auto stub = ChatService::NewStub(channel);
+  ChatReader reader;
+  reader.set_name("reader");
+  ClientContext context;
+  auto stream = stub->ReadChat(&context, reader);
+  ChatMessage m;
+  for (int i = 0; i < 3; i++) {
+    REQUIRE(stream->Read(&m));
+  }
+  CHECK(m.message() == "reader has joined the chat!");
+
+  string response = get("/metrics");
+  CHECK(response.find("HTTP/1.1 200 OK") == 0);
+  CHECK(response.find("\nchat_messages_received_total 2\n") != string::npos);
+  CHECK(response.find("\nchat_active_readers 1\n") != string::npos);
+  CHECK(response.find("\nchat_rooms 1\n") != string::npos);
+  CHECK(response.find("\nchat_reader_lag_messages_bucket{le=\"0\"} 1\n") !=
+        string::npos);
+  CHECK(response.find("\nchat_reader_lag_messages_count 1\n") !=
+        string::npos);
+  CHECK(response.find("# TYPE chat_notifier_wake_latency_seconds histogram") !=
+        string::npos);
+  CHECK(response.find("chat_lock_wait_seconds_total{lock=\"room\"}") !=
+        string::npos);
+  CHECK(response.find("chat_lock_wait_seconds_total{lock=\"append\"}") !=
+        string::npos);
+  CHECK(get("/").find("HTTP/1.1 404 Not Found") == 0);
+
+  context.TryCancel();
+  stream->Finish();
+  service.EndServer();
+  notify_thread.join();
+}
+
+TEST_CASE("Server::ClientServerIntegration_Trace") {
+  ServerBuilder builder;
+  ChatServiceImpl service(1);
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  unique_ptr<Server> server(builder.BuildAndStart());
+  thread notify_thread(&ChatServiceImpl::NotifyReadersThread, &service);
+
+  auto channel = CreateChannel("localhost:9090", InsecureChannelCredentials());
+  auto stub = ChatService::NewStub(channel);
+  ChatReader reader;
+  reader.set_name("reader");
+  reader.set_trace(true);
+  ClientContext context;
+  auto stream = stub->ReadChat(&context, reader);
+  ChatMessage m;
+  REQUIRE(stream->Read(&m));
+
+  ChatServiceClient alice("alice", channel);
+  alice.Send("Hello");
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "Hello");
+  CHECK(m.seq() == 2);
+  REQUIRE(m.has_trace());
+  const MessageTrace &trace = m.trace();
+  CHECK(trace.received_ns() > 0);
+  CHECK(trace.received_ns() <= trace.appended_ns());
+  CHECK(trace.appended_ns() <= trace.picked_ns());
+  CHECK(trace.picked_ns() <= trace.write_ns());
+
+  // Readers that did not ask get the message as it was sent.
+  ChatReader plain;
+  plain.set_name("plain");
+  plain.set_tail_n(2);
+  ClientContext plain_context;
+  auto plain_stream = stub->ReadChat(&plain_context, plain);
+  REQUIRE(plain_stream->Read(&m));
+  CHECK(m.message() == "Hello");
+  CHECK(!m.has_trace());
+
+  context.TryCancel();
+  stream->Finish();
+  plain_context.TryCancel();
+  plain_stream->Finish();
+
+  string metrics = service.Metrics();
+  CHECK(metrics.find("\nchat_delivery_latency_seconds_count 0\n") ==
+        string::npos);
+  CHECK(metrics.find("# TYPE chat_pickup_latency_seconds histogram") !=
+        string::npos);
+
+  service.EndServer();
+  notify_thread.join();
+}
+
+TEST_CASE("ServerOptions::Parse") {
+  string path = "server_options_test.conf";
+  {
+    ofstream config(path);
+    config << "# Tuned for many readers\n"
+           << "address = 127.0.0.1:9191\n"
+           << "\n"
+           << "notifier_shards = 8\n"
+           << "lag_messages = 1000\n"
+           << "lag_action = disconnect\n"
+           << "max_concurrent_streams = 50000\n";
+  }
+  vector<string> args = {"server",
+                         "--config=" + path,
+                         "--notifier_shards=4",
+                         "--durability=per-message",
+                         "--retain_ms=60000",
+                         "--memory_limit=1073741824",
+                         "--log_level=warning",
+                         "--snapshot_ms=30000",
+                         "chat.wal"};
+  vector<char *> argv;
+  for (string &arg : args) {
+    argv.push_back(&arg[0]);
+  }
+
+  ServerOptions options;
+  string error;
+  REQUIRE(ParseServerOptions(argv.size(), argv.data(), &options, &error));
+  CHECK(options.address == "127.0.0.1:9191");
+  // Flags after the config file override it.
+  CHECK(options.notifier_shards == 4);
+  CHECK(options.lag.max_messages == 1000);
+  CHECK(options.lag.action == LagAction::kDisconnect);
+  CHECK(options.max_concurrent_streams == 50000);
+  CHECK(options.durability == Durability::kPerMessage);
+  CHECK(options.retention.max_age == chrono::seconds(60));
+  CHECK(options.memory_limit == 1073741824);
+  CHECK(options.log_level == LogLevel::kWarning);
+  CHECK(options.wal_path == "chat.wal");
+  CHECK(options.snapshot_interval == chrono::seconds(30));
+  CHECK(options.metrics_port == 9091);
+
+  ServerBuilder builder;
+  ConfigureServerBuilder(options, &builder);
+
+  auto fails = [](string arg, const string &expected) {
+    char *argv[] = {nullptr, &arg[0]};
+    ServerOptions options;
+    string error;
+    CHECK(!ParseServerOptions(2, argv, &options, &error));
+    CHECK(error == expected);
+  };
+  fails("--bogus=1", "unknown option bogus");
+  fails("--metrics_port=70000", "bad value for metrics_port: 70000");
+  fails("--lag_action=wait", "bad value for lag_action: wait");
+  fails("--segment_size=-1", "bad value for segment_size: -1");
+  fails("--address", "expected --name=value, got --address");
+  fails("--nodes=a:1,b:2", "this node, 0.0.0.0:9090, is not one of the nodes");
+  fails("--previous_nodes=a:1", "previous_nodes needs nodes");
+  fails("--snapshot_ms=1000",
+        "snapshots are of the wal; snapshot_ms needs a wal");
+
+  {
+    ofstream config(path);
+    config << "notifier_shards 8\n";
+  }
+  fails("--config=" + path, path + ":1: expected name = value");
+  remove(path.c_str());
+}
+
+TEST_CASE("SharedLog::AppendReadAndLap") {
+  auto record = [](int i) {
+    ChatMessage m;
+    m.set_name("writer" + to_string(i % 2));
+    m.set_message("Hello" + to_string(i));
+    return MakeLoggedMessage(m);
+  };
+  auto parse = [](const string &payload) {
+    ChatMessage m;
+    REQUIRE(m.ParseFromString(payload));
+    return m;
+  };
+
+  SharedLog log(4096);
+  REQUIRE(log.ok());
+  uint64_t position = log.Head();
+  SharedLog::Record read;
+  uint64_t lost = 0;
+  CHECK(!log.Read(&position, &read, &lost));
+  uint64_t end = log.Append({record(0), record(1)});
+  CHECK(end == log.End());
+  REQUIRE(log.Read(&position, &read, &lost));
+  CHECK(parse(read.payload).message() == "Hello0");
+  CHECK(read.received_ns > 0);
+  CHECK(read.seq == 1);
+  REQUIRE(log.Read(&position, &read, &lost));
+  CHECK(parse(read.payload).message() == "Hello1");
+  CHECK(read.seq == 2);
+  CHECK(!log.Read(&position, &read, &lost));
+
+  // Far more than fits: the reader is lapped and resumes at the oldest
+  // record still there, then reads the rest in order across the wraps.
+  for (int i = 2; i < 500; i++) {
+    log.Append({record(i)});
+  }
+  int expected = -1;
+  while (log.Read(&position, &read, &lost)) {
+    int i = stoi(parse(read.payload).message().substr(5));
+    if (expected >= 0) {
+      CHECK(i == expected);
+    }
+    expected = i + 1;
+  }
+  CHECK(lost > 0);
+  CHECK(expected == 500);
+  CHECK(log.End() - log.Head() <= log.capacity());
+
+  // Too large to ever fit.
+  ChatMessage big;
+  big.set_message(string(4096, 'x'));
+  CHECK(log.Append({MakeLoggedMessage(big)}) == 0);
+}
+
+TEST_CASE("SharedLog::ConcurrentWritersAndTailer") {
+  SharedLog log(1 << 20);
+  REQUIRE(log.ok());
+  const int kPerWriter = 2000;
+  vector<thread> writers;
+  for (int w = 0; w < 2; w++) {
+    writers.emplace_back([&log, w] {
+      for (int i = 0; i < kPerWriter; i++) {
+        ChatMessage m;
+        m.set_name(to_string(w));
+        m.set_message(to_string(i));
+        m.set_room(to_string(w));
+        log.Append({MakeLoggedMessage(m)});
+      }
+    });
+  }
+  uint64_t position = 0;
+  uint64_t lost = 0;
+  vector<int> next(2, 0);
+  SharedLog::Record record;
+  while (next[0] + next[1] < 2 * kPerWriter) {
+    log.Wait(position, chrono::milliseconds(100));
+    while (log.Read(&position, &record, &lost)) {
+      ChatMessage m;
+      REQUIRE(m.ParseFromString(record.payload));
+      int w = stoi(m.name());
+      CHECK(stoi(m.message()) == next[w]);
+      next[w]++;
+      // Each writer has a room of its own, numbered from 1.
+      CHECK(record.seq == uint64_t(next[w]));
+    }
+  }
+  for (thread &t : writers) {
+    t.join();
+  }
+  CHECK(lost == 0);
+  CHECK(log.Appended("0") == kPerWriter);
+  CHECK(log.Appended("1") == kPerWriter);
+  CHECK(log.Appended("2") == 0);
+}
+
+TEST_CASE("SharedLog::NamedBusLateInstance") {
+  const string name = "chatserver-test-" + to_string(getpid());
+  shm_unlink(("/" + name).c_str());
+  SharedLog creator(name, 4096);
+  REQUIRE(creator.ok());
+  // Opening it again maps it at the size it was created with.
+  SharedLog opener(name, 1 << 20);
+  REQUIRE(opener.ok());
+  CHECK(opener.capacity() == creator.capacity());
+
+  // Message i goes to quiet if it is a multiple of 3, otherwise to busy.
+  for (int i = 1; i <= 300; i++) {
+    ChatMessage m;
+    m.set_room(i % 3 ? "busy" : "quiet");
+    m.set_message(to_string(i));
+    creator.Append({MakeLoggedMessage(m)});
+  }
+  CHECK(opener.Appended("busy") == 200);
+  CHECK(opener.Appended("quiet") == 100);
+
+  // A service that starts after the ring has wrapped only has the newest
+  // messages, numbered as they were when appended.
+  ChatServiceImpl late(1, {}, MessageLog::kDefaultSegmentSize, nullptr, {},
+                       &opener);
+  for (const string room : {"busy", "quiet"}) {
+    auto messages = late.GetReceivedMessages(room);
+    REQUIRE(!messages.empty());
+    CHECK(messages.size() < opener.Appended(room));
+    for (const ChatMessage &m : messages) {
+      int i = stoi(m.message());
+      CHECK(m.seq() == uint64_t(room == "busy" ? i - i / 3 : i / 3));
+    }
+    CHECK(messages.back().seq() == opener.Appended(room));
+  }
+  shm_unlink(("/" + name).c_str());
+}
+
+TEST_CASE("Server::ClientServerIntegration_SharedLog") {
+  // Two services sharing one log stand in for two worker processes.
+  SharedLog shared_log(1 << 20);
+  ChatServiceImpl first(1, {}, MessageLog::kDefaultSegmentSize, nullptr, {},
+                        &shared_log);
+  ChatServiceImpl second(1, {}, MessageLog::kDefaultSegmentSize, nullptr, {},
+                         &shared_log);
+  ServerBuilder first_builder;
+  first_builder.AddListeningPort("0.0.0.0:9090",
+                                 grpc::InsecureServerCredentials());
+  first_builder.RegisterService(&first);
+  unique_ptr<Server> first_server(first_builder.BuildAndStart());
+  ServerBuilder second_builder;
+  second_builder.AddListeningPort("0.0.0.0:9092",
+                                  grpc::InsecureServerCredentials());
+  second_builder.RegisterService(&second);
+  unique_ptr<Server> second_server(second_builder.BuildAndStart());
+  thread first_thread(&ChatServiceImpl::NotifyReadersThread, &first);
+  thread second_thread(&ChatServiceImpl::NotifyReadersThread, &second);
+
+  ChatServiceClient alice(
+      "alice", CreateChannel("localhost:9090", InsecureChannelCredentials()));
+  ChatServiceClient bob(
+      "bob", CreateChannel("localhost:9092", InsecureChannelCredentials()));
+  alice.Send("Hello from the first");
+  // Send returns once the sender's own service has published the message.
+  CHECK(first.GetReceivedMessages().size() == 1);
+  bob.Send("Hello from the second");
+  CHECK(second.GetReceivedMessages().size() == 2);
+
+  auto stub = ChatService::NewStub(
+      CreateChannel("localhost:9092", InsecureChannelCredentials()));
+  ChatReader reader;
+  reader.set_name("reader");
+  ClientContext context;
+  auto stream = stub->ReadChat(&context, reader);
+  ChatMessage m;
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "Hello from the first");
+  CHECK(m.seq() == 1);
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "Hello from the second");
+  CHECK(m.seq() == 2);
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "reader has joined the chat!");
+  alice.Send("Hello again");
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "Hello again");
+  CHECK(m.seq() == 4);
+  context.TryCancel();
+  stream->Finish();
+
+  // Both have the same history.
+  while (first.GetReceivedMessages().size() < 5 ||
+         second.GetReceivedMessages().size() < 5) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+  auto a = first.GetReceivedMessages();
+  auto b = second.GetReceivedMessages();
+  REQUIRE(a.size() == b.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    CHECK(a[i].message() == b[i].message());
+    CHECK(a[i].seq() == b[i].seq());
+  }
+
+  first.EndServer();
+  second.EndServer();
+  first_thread.join();
+  second_thread.join();
+}
+
+TEST_CASE("Server::ClientServerIntegration_SharedLogRoomBeforeTail") {
+  SharedLog shared_log(1 << 20);
+  ChatServiceImpl first(1, {}, MessageLog::kDefaultSegmentSize, nullptr, {},
+                        &shared_log);
+  ChatServiceImpl second(1, {}, MessageLog::kDefaultSegmentSize, nullptr, {},
+                         &shared_log);
+  ServerBuilder builder;
+  builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  builder.RegisterService(&first);
+  unique_ptr<Server> server(builder.BuildAndStart());
+  thread first_thread(&ChatServiceImpl::NotifyReadersThread, &first);
+
+  // second creates the room before its tail has reached what first sent
+  // to it, which still comes in, numbered as first numbered it.
+  ChatServiceClient alice(
+      "alice", CreateChannel("localhost:9090", InsecureChannelCredentials()));
+  alice.SetRoom("late");
+  alice.Send("Before the room");
+  CHECK(second.GetReceivedMessages("late").empty());
+  thread second_thread(&ChatServiceImpl::NotifyReadersThread, &second);
+  auto deadline = chrono::steady_clock::now() + chrono::seconds(5);
+  while (second.GetReceivedMessages("late").empty() &&
+         chrono::steady_clock::now() < deadline) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+  auto history = second.GetReceivedMessages("late");
+  REQUIRE(history.size() == 1);
+  CHECK(history[0].message() == "Before the room");
+  CHECK(history[0].seq() == 1);
+
+  first.EndServer();
+  second.EndServer();
+  first_thread.join();
+  second_thread.join();
+}
+
+TEST_CASE("Server::ClientServerIntegration_Replication") {
+  ChatServiceImpl leader(1, {}, MessageLog::kDefaultSegmentSize, nullptr, {},
+                         nullptr, ReplicationOptions{true});
+  ServerBuilder leader_builder;
+  leader_builder.AddListeningPort("0.0.0.0:9090",
+                                  grpc::InsecureServerCredentials());
+  leader_builder.RegisterService(&leader);
+  unique_ptr<Server> leader_server(leader_builder.BuildAndStart());
+  thread leader_thread(&ChatServiceImpl::NotifyReadersThread, &leader);
+
+  ChatServiceClient alice(
+      "alice", CreateChannel("localhost:9090", InsecureChannelCredentials()));
+  alice.Send("Before the follower");
+
+  ChatServiceImpl follower(1, {}, MessageLog::kDefaultSegmentSize, nullptr,
+                           {}, nullptr,
+                           ReplicationOptions{false, "localhost:9090", "f1"});
+  ServerBuilder follower_builder;
+  follower_builder.AddListeningPort("0.0.0.0:9092",
+                                    grpc::InsecureServerCredentials());
+  follower_builder.RegisterService(&follower);
+  unique_ptr<Server> follower_server(follower_builder.BuildAndStart());
+  thread follower_thread(&ChatServiceImpl::NotifyReadersThread, &follower);
+
+  // Sending to the follower forwards to the leader, which has it once Send
+  // returns.
+  ChatServiceClient bob(
+      "bob", CreateChannel("localhost:9092", InsecureChannelCredentials()));
+  bob.Send("Through the follower");
+  CHECK(leader.GetReceivedMessages().size() == 2);
+
+  // Readers of the follower get the leader's history with its seqs,
+  // including their own join, which went through the leader too.
+  auto stub = ChatService::NewStub(
+      CreateChannel("localhost:9092", InsecureChannelCredentials()));
+  ChatReader reader;
+  reader.set_name("reader");
+  ClientContext context;
+  auto stream = stub->ReadChat(&context, reader);
+  ChatMessage m;
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "Before the follower");
+  CHECK(m.seq() == 1);
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "Through the follower");
+  CHECK(m.seq() == 2);
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "reader has joined the chat!");
+  CHECK(m.seq() == 3);
+  alice.Send("After the reader");
+  REQUIRE(stream->Read(&m));
+  CHECK(m.message() == "After the reader");
+  CHECK(m.seq() == 4);
+  context.TryCancel();
+  stream->Finish();
+
+  CHECK(follower.Metrics().find("chat_replication_connected 1\n") !=
+        string::npos);
+  CHECK(leader.Metrics().find("chat_replica_lag_messages{replica=\"f1\"}") !=
+        string::npos);
+  // The lag is as of the last batch, which may have raced an append.
+  while (follower.Metrics().find("chat_replication_lag_messages 0\n") ==
+         string::npos) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+
+  // Only a server keeping a feed serves Replicate.
+  ClientContext replicate_context;
+  ReplicatedBatch batch;
+  auto replicate = stub->Replicate(&replicate_context, ChatReader());
+  CHECK(!replicate->Read(&batch));
+  CHECK(replicate->Finish().error_code() ==
+        grpc::StatusCode::FAILED_PRECONDITION);
+
+  while (follower.GetReceivedMessages().size() <
+         leader.GetReceivedMessages().size()) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+  auto a = leader.GetReceivedMessages();
+  auto b = follower.GetReceivedMessages();
+  REQUIRE(a.size() == b.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    CHECK(a[i].message() == b[i].message());
+    CHECK(a[i].seq() == b[i].seq());
+  }
+
+  follower.EndServer();
+  leader.EndServer();
+  follower_thread.join();
+  leader_thread.join();
+}
+
+TEST_CASE("HashRing::BalanceAndMinimalMovement") {
+  CHECK(ParseNodeList(" a:1, b:2,,c:3 ") ==
+        vector<string>{"a:1", "b:2", "c:3"});
+
+  HashRing ring({"a:1", "b:2", "c:3"});
+  // The same nodes in any order, even repeated, make the same ring.
+  HashRing shuffled({"c:3", "a:1", "b:2", "a:1"});
+  HashRing added({"a:1", "b:2", "c:3", "d:4"});
+  HashRing removed({"a:1", "c:3"});
+  const size_t kRooms = 3000;
+  map<string, size_t> owned;
+  size_t moved_on_add = 0;
+  for (size_t i = 0; i < kRooms; i++) {
+    string room = "room" + to_string(i);
+    const string &owner = ring.Owner(room);
+    owned[owner]++;
+    CHECK(shuffled.Owner(room) == owner);
+    // Only the new node takes rooms, and only the removed node gives them.
+    if (added.Owner(room) != owner) {
+      CHECK(added.Owner(room) == "d:4");
+      moved_on_add++;
+    }
+    if (removed.Owner(room) != owner) {
+      CHECK(owner == "b:2");
+    } else {
+      CHECK(owner != "b:2");
+    }
+  }
+  for (const auto &node : owned) {
+    CHECK(node.second > kRooms / 5);
+  }
+  CHECK(moved_on_add > kRooms / 8);
+  CHECK(moved_on_add < kRooms / 2);
+}
+
+TEST_CASE("Server::ClientServerIntegration_Sharding") {
+  const string a_address = "localhost:9090";
+  const string b_address = "localhost:9092";
+  const string c_address = "localhost:9094";
+  HashRing two({a_address, b_address});
+  HashRing three({a_address, b_address, c_address});
+  auto start = [](ChatServiceImpl *service, const string &address) {
+    ServerBuilder builder;
+    builder.AddListeningPort(address, grpc::InsecureServerCredentials());
+    builder.RegisterService(service);
+    return unique_ptr<Server>(builder.BuildAndStart());
+  };
+  auto find_room = [](function<bool(const string &)> wanted) {
+    for (size_t i = 0;; i++) {
+      string room = "room" + to_string(i);
+      if (wanted(room)) {
+        return room;
+      }
+    }
+  };
+
+  ChatServiceImpl a(1), b(1);
+  a.SetMembership(a_address, two);
+  b.SetMembership(b_address, two);
+  auto a_server = start(&a, "0.0.0.0:9090");
+  auto b_server = start(&b, "0.0.0.0:9092");
+  thread a_thread(&ChatServiceImpl::NotifyReadersThread, &a);
+  thread b_thread(&ChatServiceImpl::NotifyReadersThread, &b);
+
+  // moving goes to c once it joins; staying is b's throughout.
+  string moving = find_room([&](const string &room) {
+    return two.Owner(room) == a_address && three.Owner(room) == c_address;
+  });
+  string staying = find_room([&](const string &room) {
+    return two.Owner(room) == b_address && three.Owner(room) == b_address;
+  });
+
+  // A node refuses a room it does not own and names the owner.
+  auto a_stub = ChatService::NewStub(
+      CreateChannel(a_address, InsecureChannelCredentials()));
+  {
+    ClientContext context;
+    ChatMessage m;
+    m.set_room(staying);
+    Response response;
+    Status status = a_stub->Send(&context, m, &response);
+    CHECK(status.error_code() == grpc::StatusCode::FAILED_PRECONDITION);
+    auto owner = context.GetServerTrailingMetadata().find(kOwnerMetadata);
+    REQUIRE(owner != context.GetServerTrailingMetadata().end());
+    CHECK(string(owner->second.data(), owner->second.size()) == b_address);
+  }
+
+  // A client with the ring goes straight to the owner; one with a channel
+  // to the wrong node follows the redirect.
+  ChatServiceClient carol("carol", two);
+  carol.SetRoom(moving);
+  carol.Send("First");
+  carol.Send("Second");
+  ChatServiceClient dave(
+      "dave", CreateChannel(a_address, InsecureChannelCredentials()));
+  dave.SetRoom(staying);
+  dave.Send("Elsewhere");
+  CHECK(a.GetReceivedMessages(moving).size() == 2);
+  CHECK(b.GetReceivedMessages(staying).size() == 1);
+
+  ChatReader reader;
+  reader.set_name("reader");
+  reader.set_room(moving);
+  ClientContext read_context;
+  auto stream = a_stub->ReadChat(&read_context, reader);
+  ChatMessage m;
+  for (int i = 0; i < 3; i++) {
+    REQUIRE(stream->Read(&m));
+  }
+  CHECK(m.message() == "reader has joined the chat!");
+
+  // c joins. Only the room that moved to it changes hands, on its first
+  // request there, history and seqs included.
+  ChatServiceImpl c(1);
+  c.SetMembership(c_address, two);
+  c.SetMembership(c_address, three);
+  auto c_server = start(&c, "0.0.0.0:9094");
+  thread c_thread(&ChatServiceImpl::NotifyReadersThread, &c);
+  a.SetMembership(a_address, three);
+  b.SetMembership(b_address, three);
+
+  ChatServiceClient erin("erin", three);
+  erin.SetRoom(moving);
+  erin.Send("Third");
+  auto history = c.GetReceivedMessages(moving);
+  REQUIRE(history.size() == 4);
+  CHECK(history[0].message() == "First");
+  CHECK(history[2].message() == "reader has joined the chat!");
+  CHECK(history[3].message() == "Third");
+  CHECK(history[3].seq() == 4);
+  // a's reader of the room is told it moved, and a refuses the room.
+  CHECK(!stream->Read(&m));
+  CHECK(stream->Finish().error_code() == grpc::StatusCode::UNAVAILABLE);
+  carol.Send("Redirected");
+  CHECK(c.GetReceivedMessages(moving).size() == 5);
+  CHECK(a.Metrics().find("chat_rooms_handed_off_total 1\n") != string::npos);
+  CHECK(c.Metrics().find("chat_rooms_taken_over_total 1\n") != string::npos);
+  CHECK(b.Metrics().find("chat_rooms_handed_off_total 0\n") != string::npos);
+
+  // c leaves, and the room goes back to a, which catches up on what it
+  // missed.
+  c.SetMembership(c_address, two);
+  a.SetMembership(a_address, two);
+  b.SetMembership(b_address, two);
+  ChatServiceClient frank("frank", two);
+  frank.SetRoom(moving);
+  frank.Send("Back");
+  history = a.GetReceivedMessages(moving);
+  REQUIRE(history.size() == 6);
+  for (size_t i = 0; i < history.size(); i++) {
+    CHECK(history[i].seq() == i + 1);
+  }
+  CHECK(history[3].message() == "Third");
+  CHECK(history[4].message() == "Redirected");
+  CHECK(history[5].message() == "Back");
+
+  a.EndServer();
+  b.EndServer();
+  c.EndServer();
+  a_thread.join();
+  b_thread.join();
+  c_thread.join();
+}
+
+TEST_CASE("Server::ClientServerIntegration_HandOffKeepsCommitted") {
+  const string a_address = "localhost:9090";
+  const string b_address = "localhost:9092";
+  const string path = "unittest_handoff.wal";
+  remove(path.c_str());
+  HashRing one({a_address});
+  HashRing two({a_address, b_address});
+  vector<string> rooms;
+  for (size_t i = 0; rooms.size() < 2; i++) {
+    if (two.Owner("room" + to_string(i)) == b_address) {
+      rooms.push_back("room" + to_string(i));
+    }
+  }
+  const string room = rooms[0];
+
+  ChatServiceImpl a(1, {}, MessageLog::kDefaultSegmentSize,
+                    make_unique<WriteAheadLog>(path, Durability::kPerMessage));
+  ChatServiceImpl b(1);
+  a.SetMembership(a_address, one);
+  b.SetMembership(b_address, one);
+  b.SetMembership(b_address, two);
+  ServerBuilder a_builder, b_builder;
+  a_builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  a_builder.RegisterService(&a);
+  b_builder.AddListeningPort("0.0.0.0:9092", grpc::InsecureServerCredentials());
+  b_builder.RegisterService(&b);
+  unique_ptr<Server> a_server(a_builder.BuildAndStart());
+  unique_ptr<Server> b_server(b_builder.BuildAndStart());
+
+  // Senders keep a's room busy until a refuses it, so some of their
+  // messages are still committing when the room is handed off.
+  const int kSenders = 8;
+  vector<vector<string>> committed(kSenders);
+  vector<thread> senders;
+  for (int i = 0; i < kSenders; i++) {
+    senders.emplace_back([&, i] {
+      auto stub = ChatService::NewStub(
+          CreateChannel(a_address, InsecureChannelCredentials()));
+      for (int n = 0;; n++) {
+        ClientContext context;
+        ChatMessage m;
+        m.set_name("sender" + to_string(i));
+        m.set_message(to_string(i) + "." + to_string(n));
+        m.set_room(room);
+        Response response;
+        if (!stub->Send(&context, m, &response).ok()) {
+          return;
+        }
+        committed[i].push_back(m.message());
+      }
+    });
+  }
+  // b's channel is connected up front, so it takes the room over while
+  // those are still committing. a refuses to hand off a room its ring still
+  // gives it.
+  auto send_b = [b_stub = ChatService::NewStub(CreateChannel(
+                     b_address, InsecureChannelCredentials()))](
+                    const string &room) {
+    ClientContext context;
+    ChatMessage m;
+    m.set_room(room);
+    Response response;
+    return b_stub->Send(&context, m, &response).ok();
+  };
+  CHECK(!send_b(rooms[1]));
+  this_thread::sleep_for(chrono::milliseconds(50));
+  a.SetMembership(a_address, two);
+  REQUIRE(send_b(room));
+  for (thread &t : senders) {
+    t.join();
+  }
+
+  // Every message a acknowledged made it to b.
+  unordered_set<string> history;
+  for (const ChatMessage &m : b.GetReceivedMessages(room)) {
+    history.insert(m.message());
+  }
+  size_t total = 0;
+  for (const vector<string> &messages : committed) {
+    for (const string &message : messages) {
+      CHECK(history.count(message) == 1);
+    }
+    total += messages.size();
+  }
+  CHECK(total > 0);
+
+  a.EndServer();
+  b.EndServer();
+  remove(path.c_str());
+}
+
+TEST_CASE("Server::ClientServerIntegration_TakeOverSurvivesRestart") {
+  const string a_address = "localhost:9090";
+  const string b_address = "localhost:9092";
+  const string path = "unittest_takeover.wal";
+  remove(path.c_str());
+  HashRing one({a_address});
+  HashRing two({a_address, b_address});
+  string room;
+  for (size_t i = 0; two.Owner(room) != b_address; i++) {
+    room = "room" + to_string(i);
+  }
+
+  // a keeps only the last 2 of its 3 messages, so b's copy starts at seq 2.
+  RetentionPolicy retention;
+  retention.max_messages = 2;
+  ChatServiceImpl a(1, retention, 1);
+  a.SetMembership(a_address, one);
+  ServerBuilder a_builder;
+  a_builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  a_builder.RegisterService(&a);
+  unique_ptr<Server> a_server(a_builder.BuildAndStart());
+  ChatServiceClient carol("carol", one);
+  carol.SetRoom(room);
+  for (int i = 1; i <= 3; i++) {
+    carol.Send("Message " + to_string(i));
+  }
+  a.SetMembership(a_address, two);
+
+  for (int restart = 0; restart < 2; restart++) {
+    ChatServiceImpl b(1, {}, MessageLog::kDefaultSegmentSize,
+                      make_unique<WriteAheadLog>(path, Durability::kBatched));
+    if (restart == 0) {
+      b.SetMembership(b_address, one);
+    }
+    b.SetMembership(b_address, two);
+    ServerBuilder b_builder;
+    b_builder.AddListeningPort("0.0.0.0:9092",
+                               grpc::InsecureServerCredentials());
+    b_builder.RegisterService(&b);
+    unique_ptr<Server> b_server(b_builder.BuildAndStart());
+    if (restart == 0) {
+      ChatServiceClient dave("dave", two);
+      dave.SetRoom(room);
+      dave.Send("Message 4");
+    }
+
+    // The copy was logged with its seqs, so the restarted b numbers the
+    // room as a did.
+    auto history = b.GetReceivedMessages(room);
+    REQUIRE(history.size() == 3);
+    for (size_t i = 0; i < history.size(); i++) {
+      CHECK(history[i].seq() == i + 2);
+      CHECK(history[i].message() == "Message " + to_string(i + 2));
+    }
+    b.EndServer();
+  }
+  a.EndServer();
+  remove(path.c_str());
+}
+
+TEST_CASE("Server::ClientServerIntegration_TakeOverPerRoom") {
+  const string a_address = "localhost:9090";
+  const string b_address = "localhost:9092";
+  HashRing one({a_address});
+  HashRing two({a_address, b_address});
+  vector<string> rooms;
+  for (size_t i = 0; rooms.size() < 2; i++) {
+    if (two.Owner("room" + to_string(i)) == b_address) {
+      rooms.push_back("room" + to_string(i));
+    }
+  }
+
+  // The old owner hands the first room off only once released.
+  class OldOwner : public ChatService::Service {
+  public:
+    string stuck;
+    promise<void> release;
+    shared_future<void> released = release.get_future().share();
+
+    Status HandOff(ServerContext *, const ChatReader *request,
+                   ServerWriter<ChatMessageBatch> *) override {
+      if (request->room() == stuck) {
+        released.wait();
+      }
+      return Status::OK;
+    }
+  } a;
+  a.stuck = rooms[0];
+  ChatServiceImpl b(1);
+  b.SetMembership(b_address, one);
+  b.SetMembership(b_address, two);
+  ServerBuilder a_builder, b_builder;
+  a_builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  a_builder.RegisterService(&a);
+  b_builder.AddListeningPort("0.0.0.0:9092", grpc::InsecureServerCredentials());
+  b_builder.RegisterService(&b);
+  unique_ptr<Server> a_server(a_builder.BuildAndStart());
+  unique_ptr<Server> b_server(b_builder.BuildAndStart());
+  thread b_thread(&ChatServiceImpl::NotifyReadersThread, &b);
+
+  auto stub = ChatService::NewStub(
+      CreateChannel(b_address, InsecureChannelCredentials()));
+  auto send = [&stub](const string &room) {
+    ClientContext context;
+    ChatMessage m;
+    m.set_room(room);
+    Response response;
+    return stub->Send(&context, m, &response);
+  };
+  auto stuck = async(launch::async, send, rooms[0]);
+  auto also_stuck = async(launch::async, send, rooms[0]);
+  ChatReader reader;
+  reader.set_name("reader");
+  reader.set_room(rooms[0]);
+  ClientContext read_context, cancelled_context;
+  auto stream = stub->ReadChat(&read_context, reader);
+  auto cancelled = stub->ReadChat(&cancelled_context, reader);
+  this_thread::sleep_for(chrono::milliseconds(100));
+
+  // A stuck takeover holds up requests for its room, not for others.
+  CHECK(send(rooms[1]).ok());
+  CHECK(stuck.wait_for(chrono::seconds(0)) == future_status::timeout);
+  // A reader can leave while it waits.
+  cancelled_context.TryCancel();
+  CHECK(cancelled->Finish().error_code() == grpc::StatusCode::CANCELLED);
+  a.release.set_value();
+  CHECK(stuck.get().ok());
+  CHECK(also_stuck.get().ok());
+  ChatMessage m;
+  do {
+    REQUIRE(stream->Read(&m));
+  } while (m.message() != "reader has joined the chat!");
+  read_context.TryCancel();
+  stream->Finish();
+
+  b.EndServer();
+  b_thread.join();
+}
+
+TEST_CASE("Server::ClientServerIntegration_ColdStartWithNodeDown") {
+  const string a_address = "localhost:9090";
+  const string b_address = "localhost:9092";
+  HashRing two({a_address, b_address});
+  string room;
+  for (size_t i = 0; two.Owner(room) != b_address; i++) {
+    room = "room" + to_string(i);
+  }
+
+  // b starts while a is down. Its ring has not changed, so it starts its
+  // rooms afresh rather than asking a for them.
+  ChatServiceImpl b(1);
+  b.SetMembership(b_address, two);
+  ServerBuilder builder;
+  builder.AddListeningPort("0.0.0.0:9092", grpc::InsecureServerCredentials());
+  builder.RegisterService(&b);
+  unique_ptr<Server> server(builder.BuildAndStart());
+
+  ChatServiceClient carol("carol", two);
+  carol.SetRoom(room);
+  carol.Send("First");
+  auto history = b.GetReceivedMessages(room);
+  REQUIRE(history.size() == 1);
+  CHECK(history[0].seq() == 1);
+  CHECK(b.Metrics().find("chat_rooms_taken_over_total 0\n") != string::npos);
+  b.EndServer();
+}
+
+TEST_CASE("Server::ClientServerIntegration_Relay") {
+  const string a_address = "localhost:9090";
+  const string b_address = "localhost:9092";
+  HashRing ring({a_address, b_address});
+  ChatServiceImpl a(1), b(1);
+  a.SetMembership(a_address, ring);
+  b.SetMembership(b_address, ring);
+  ServerBuilder a_builder, b_builder;
+  a_builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  a_builder.RegisterService(&a);
+  b_builder.AddListeningPort("0.0.0.0:9092", grpc::InsecureServerCredentials());
+  b_builder.RegisterService(&b);
+  unique_ptr<Server> a_server(a_builder.BuildAndStart());
+  unique_ptr<Server> b_server(b_builder.BuildAndStart());
+  thread a_thread(&ChatServiceImpl::NotifyReadersThread, &a);
+  thread b_thread(&ChatServiceImpl::NotifyReadersThread, &b);
+
+  string room;
+  for (size_t i = 0; ring.Owner(room) != b_address; i++) {
+    room = "room" + to_string(i);
+  }
+  ChatServiceClient carol("carol", ring);
+  carol.SetRoom(room);
+  carol.Send("Before the readers");
+
+  // Readers of b's room on a are all fed by one relay.
+  auto a_stub = ChatService::NewStub(
+      CreateChannel(a_address, InsecureChannelCredentials()));
+  const int kReaders = 3;
+  ClientContext contexts[kReaders];
+  vector<unique_ptr<ClientReader<ChatMessage>>> streams;
+  ChatMessage m;
+  for (int i = 0; i < kReaders; i++) {
+    ChatReader reader;
+    reader.set_name("reader" + to_string(i));
+    reader.set_room(room);
+    streams.push_back(a_stub->ReadChat(&contexts[i], reader));
+    REQUIRE(streams[i]->Read(&m));
+    CHECK(m.message() == "Before the readers");
+    CHECK(m.seq() == 1);
+    // Joins go to the owner and come back through the relay.
+    do {
+      REQUIRE(streams[i]->Read(&m));
+    } while (m.message() != "reader" + to_string(i) + " has joined the chat!");
+  }
+  CHECK(a.Metrics().find("chat_relays 1\n") != string::npos);
+  CHECK(b.Metrics().find("chat_active_readers 1\n") != string::npos);
+
+  carol.Send("To every reader");
+  uint64_t seq = b.GetReceivedMessages(room).back().seq();
+  for (auto &stream : streams) {
+    do {
+      REQUIRE(stream->Read(&m));
+    } while (m.message() != "To every reader");
+    CHECK(m.seq() == seq);
+  }
+  CHECK(a.GetReceivedMessages(room).empty());
+
+  // Once its last reader leaves, the relay stops and the leaves reach the
+  // owner.
+  for (int i = 0; i < kReaders; i++) {
+    contexts[i].TryCancel();
+    streams[i]->Finish();
+  }
+  auto leaves = [&] {
+    int count = 0;
+    for (const ChatMessage &message : b.GetReceivedMessages(room)) {
+      count += message.message().find("has left") != string::npos;
+    }
+    return count;
+  };
+  while (b.Metrics().find("chat_active_readers 0\n") == string::npos ||
+         a.Metrics().find("chat_relays 0\n") == string::npos ||
+         leaves() < kReaders) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+
+  a.EndServer();
+  b.EndServer();
+  a_thread.join();
+  b_thread.join();
+}
+
+TEST_CASE("Server::ClientServerIntegration_RelayStartsOffThread") {
+  const string a_address = "localhost:9090";
+  const string b_address = "localhost:9092";
+  HashRing ring({a_address, b_address});
+  string room;
+  for (size_t i = 0; ring.Owner(room) != a_address; i++) {
+    room = "room" + to_string(i);
+  }
+
+  // An owner that never sends a relay its first batch.
+  class Owner : public ChatService::Service {
+  public:
+    Status Relay(ServerContext *context, const ChatReader *,
+                 ServerWriter<RelayBatch> *) override {
+      while (!context->IsCancelled()) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+      }
+      return Status::CANCELLED;
+    }
+  } a;
+  ChatServiceImpl b(1);
+  b.SetMembership(b_address, ring);
+  ServerBuilder a_builder, b_builder;
+  a_builder.AddListeningPort("0.0.0.0:9090", grpc::InsecureServerCredentials());
+  a_builder.RegisterService(&a);
+  b_builder.AddListeningPort("0.0.0.0:9092", grpc::InsecureServerCredentials());
+  b_builder.RegisterService(&b);
+  unique_ptr<Server> a_server(a_builder.BuildAndStart());
+  unique_ptr<Server> b_server(b_builder.BuildAndStart());
+  thread b_thread(&ChatServiceImpl::NotifyReadersThread, &b);
+
+  auto stub = ChatService::NewStub(
+      CreateChannel(b_address, InsecureChannelCredentials()));
+  ChatReader reader;
+  reader.set_name("reader");
+  reader.set_room(room);
+  ClientContext context, cancelled_context;
+  auto stream = stub->ReadChat(&context, reader);
+  auto cancelled = stub->ReadChat(&cancelled_context, reader);
+  this_thread::sleep_for(chrono::milliseconds(100));
+
+  // Readers can leave while the relay starts, and shutting down stops it.
+  cancelled_context.TryCancel();
+  CHECK(cancelled->Finish().error_code() == grpc::StatusCode::CANCELLED);
+  b.EndServer();
+  ChatMessage m;
+  CHECK(!stream->Read(&m));
+  CHECK(stream->Finish().error_code() == grpc::StatusCode::UNAVAILABLE);
+  b_thread.join();
+}